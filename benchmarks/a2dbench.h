@@ -0,0 +1,302 @@
+#ifndef A2D_BENCH_H
+#define A2D_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "a2ddefs.h"
+
+namespace A2D {
+
+namespace Bench {
+
+/*
+  Prevent the compiler from optimizing away a value or from caching memory
+  across iterations of the timing loop
+*/
+template <class T>
+inline void DoNotOptimize(T const& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <class T>
+inline void DoNotOptimize(T& value) {
+  asm volatile("" : "+r,m"(value) : : "memory");
+}
+
+inline void ClobberMemory() { asm volatile("" : : : "memory"); }
+
+/*
+  Type names used to label the benchmarks
+*/
+template <typename T>
+struct type_name {
+  static std::string get() { return "unknown"; }
+};
+
+template <>
+struct type_name<float> {
+  static std::string get() { return "float"; }
+};
+
+template <>
+struct type_name<double> {
+  static std::string get() { return "double"; }
+};
+
+template <>
+struct type_name<A2D_complex_t<double>> {
+  static std::string get() { return "complex"; }
+};
+
+/*
+  Number of real floating point operations per scalar operation: complex
+  arithmetic is counted as four real operations per multiply-add pair
+*/
+template <typename T>
+struct flop_factor {
+  static constexpr double value = 1.0;
+};
+
+template <typename T>
+struct flop_factor<A2D_complex_t<T>> {
+  static constexpr double value = 4.0;
+};
+
+/*
+  Produce a label of the form name<arg0,arg1,...>
+*/
+template <class... Args>
+std::string label(const std::string& name, const Args&... args) {
+  std::stringstream s;
+  s << name << "<";
+  int count = 0;
+  ((s << (count++ ? "," : "") << args), ...);
+  s << ">";
+  return s.str();
+}
+
+/*
+  Fill an object with random values in [-1, 1]
+*/
+template <typename T>
+inline T random_value() {
+  return T(-1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX);
+}
+
+template <typename T>
+inline void randomize(T* data, index_t size) {
+  for (index_t i = 0; i < size; i++) {
+    data[i] = random_value<T>();
+  }
+}
+
+/**
+ * @brief The timing result of a single benchmark
+ */
+struct Result {
+  std::string name;
+  double ns_per_op;   // Minimum time per operation over all repetitions
+  double flops;       // Floating point operations per operation (0 = unknown)
+  double bytes;       // Bytes read and written per operation (0 = unknown)
+  index_t iterations; // Iterations per repetition
+
+  // Floating point operations per byte, the abscissa of a roofline plot
+  double intensity() const { return bytes > 0.0 ? flops / bytes : 0.0; }
+};
+
+/**
+ * @brief Collection of benchmarks with a common command line driver
+ *
+ * Each benchmark is a callable that executes the timed operation a given
+ * number of times. The driver calibrates the iteration count so that each
+ * repetition runs for at least the minimum time, then reports the fastest
+ * repetition.
+ *
+ * Command line options:
+ *
+ * --filter <substring>  only run benchmarks whose name contains the substring
+ * --json <file>         write the results to a JSON file
+ * --min-time <seconds>  minimum time per repetition (default 0.02)
+ * --repeat <n>          number of repetitions (default 5)
+ * --list                list the benchmark names and exit
+ */
+class Registry {
+ public:
+  using Kernel = std::function<void(index_t)>;
+
+  /**
+   * @brief Add a benchmark
+   *
+   * @param name The unique name of the benchmark
+   * @param flops Floating point operations per call (0 if unknown)
+   * @param kernel Callable that runs the operation niters times
+   */
+  void add(const std::string& name, double flops, Kernel kernel) {
+    add(name, flops, 0.0, kernel);
+  }
+
+  /**
+   * @brief Add a benchmark with a model of its memory traffic
+   *
+   * @param name The unique name of the benchmark
+   * @param flops Floating point operations per call (0 if unknown)
+   * @param bytes Bytes read and written per call (0 if unknown)
+   * @param kernel Callable that runs the operation niters times
+   */
+  void add(const std::string& name, double flops, double bytes,
+           Kernel kernel) {
+    entries.push_back({name, flops, bytes, kernel});
+  }
+
+  int run(int argc, char* argv[]) {
+    std::string filter, json;
+    double min_time = 0.02;
+    int repeat = 5;
+    bool list = false;
+
+    for (int i = 1; i < argc; i++) {
+      if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+        filter = argv[++i];
+      } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+        json = argv[++i];
+      } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+        min_time = std::atof(argv[++i]);
+      } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+        repeat = std::max(1, std::atoi(argv[++i]));
+      } else if (std::strcmp(argv[i], "--list") == 0) {
+        list = true;
+      } else {
+        std::fprintf(stderr, "Unknown argument %s\n", argv[i]);
+        return 1;
+      }
+    }
+
+    std::vector<Result> results;
+    std::printf("%-56s %12s %10s %8s %12s\n", "benchmark", "ns/op", "GFLOP/s",
+                "flop/B", "iterations");
+    for (const auto& entry : entries) {
+      if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+        continue;
+      }
+      if (list) {
+        std::printf("%s\n", entry.name.c_str());
+        continue;
+      }
+
+      Result res = time(entry, min_time, repeat);
+      results.push_back(res);
+
+      char gflops[32] = "-", intensity[32] = "-";
+      if (res.flops > 0.0) {
+        std::snprintf(gflops, sizeof(gflops), "%.3f",
+                      res.flops / res.ns_per_op);
+      }
+      if (res.bytes > 0.0) {
+        std::snprintf(intensity, sizeof(intensity), "%.3f", res.intensity());
+      }
+      std::printf("%-56s %12.3f %10s %8s %12d\n", res.name.c_str(),
+                  res.ns_per_op, gflops, intensity, res.iterations);
+      std::fflush(stdout);
+    }
+
+    if (!json.empty()) {
+      write_json(json, results);
+    }
+
+    return 0;
+  }
+
+ private:
+  struct Entry {
+    std::string name;
+    double flops;
+    double bytes;
+    Kernel kernel;
+  };
+
+  std::vector<Entry> entries;
+
+  static double elapsed(const Kernel& kernel, index_t niters) {
+    auto t0 = std::chrono::steady_clock::now();
+    kernel(niters);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+  }
+
+  static Result time(const Entry& entry, double min_time, int repeat) {
+    // Calibrate the number of iterations
+    index_t niters = 1;
+    double t = elapsed(entry.kernel, niters);
+    while (t < min_time && niters < MAX_INDEX / 16) {
+      double scale = (t > 0.0 ? 1.5 * min_time / t : 16.0);
+      niters = static_cast<index_t>(
+          std::min(16.0 * niters, std::max(2.0 * niters, scale * niters)));
+      t = elapsed(entry.kernel, niters);
+    }
+
+    double best = t;
+    for (int i = 1; i < repeat; i++) {
+      best = std::min(best, elapsed(entry.kernel, niters));
+    }
+
+    return Result{entry.name, 1e9 * best / niters, entry.flops, entry.bytes,
+                  niters};
+  }
+
+  static void write_json(const std::string& filename,
+                         const std::vector<Result>& results) {
+    FILE* fp = std::fopen(filename.c_str(), "w");
+    if (!fp) {
+      std::fprintf(stderr, "Could not open %s\n", filename.c_str());
+      return;
+    }
+    std::fprintf(fp, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+      const Result& r = results[i];
+      std::fprintf(fp,
+                   "    {\"name\": \"%s\", \"ns_per_op\": %.6e, "
+                   "\"gflops\": %.6e, \"intensity\": %.6e, "
+                   "\"iterations\": %d}%s\n",
+                   r.name.c_str(), r.ns_per_op,
+                   (r.flops > 0.0 ? r.flops / r.ns_per_op : 0.0),
+                   r.intensity(), r.iterations,
+                   (i + 1 < results.size() ? "," : ""));
+    }
+    std::fprintf(fp, "  ]\n}\n");
+    std::fclose(fp);
+  }
+};
+
+/**
+ * @brief Register a benchmark that calls a kernel on fixed arguments
+ *
+ * The arguments are stored on the heap and passed to the kernel by reference
+ * at every iteration. Memory is clobbered between calls so that the inputs
+ * are re-read and the outputs re-written every time.
+ */
+template <class Args, class Func>
+void add_kernel(Registry& reg, const std::string& name, double flops,
+                std::shared_ptr<Args> args, Func func) {
+  reg.add(name, flops, [args, func](index_t niters) {
+    for (index_t i = 0; i < niters; i++) {
+      func(*args);
+      ClobberMemory();
+    }
+  });
+}
+
+}  // namespace Bench
+
+}  // namespace A2D
+
+#endif  // A2D_BENCH_H
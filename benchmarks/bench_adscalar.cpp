@@ -0,0 +1,98 @@
+/*
+  Forward-mode scalar benchmarks: ADScalar<T, N> with a plain derivative
+  array against PackedADScalar<T, N> with the padded and aligned derivative
+  block, for the operator and function derivative updates and for a short
+  chain of operations, at the sizes used by the element codes.
+*/
+
+#include "a2dbench.h"
+#include "adscalarpacked.h"
+
+using namespace A2D;
+using namespace A2D::Bench;
+
+/*
+  Arguments for a scalar operation applied to a block of independent scalars
+*/
+template <class S, int N>
+struct ScalarArgs {
+  static constexpr int size = 16;
+  using T = typename S::type;
+
+  ScalarArgs() {
+    for (int k = 0; k < size; k++) {
+      a[k] = T(1.5) + random_value<T>();
+      b[k] = T(1.5) + random_value<T>();
+      for (int i = 0; i < N; i++) {
+        a[k].deriv[i] = random_value<T>();
+        b[k].deriv[i] = random_value<T>();
+      }
+    }
+  }
+
+  S a[size], b[size], c[size];
+};
+
+template <class S, int N, class Func>
+void add_scalar_op(Registry& reg, const std::string& scalar,
+                   const std::string& op, double flops_per_deriv,
+                   Func func) {
+  using T = typename S::type;
+  const std::string t = type_name<T>::get();
+  const int size = ScalarArgs<S, N>::size;
+  auto args = std::make_shared<ScalarArgs<S, N>>();
+  add_kernel(reg, label(scalar + "::" + op, t, N),
+             size * flops_per_deriv * N, args, [func](auto& x) {
+               for (int k = 0; k < size; k++) {
+                 x.c[k] = func(x.a[k], x.b[k]);
+               }
+             });
+}
+
+template <class S, int N>
+void add_scalar(Registry& reg, const std::string& scalar) {
+  // The results are converted to S explicitly: with the ADScalar expression
+  // templates, the deduced type would be an expression that refers to locals
+  using Args = const S&;
+  add_scalar_op<S, N>(reg, scalar, "add", 1.0,
+                      [](Args a, Args b) -> S { return a + b; });
+  add_scalar_op<S, N>(reg, scalar, "mul", 3.0,
+                      [](Args a, Args b) -> S { return a * b; });
+  add_scalar_op<S, N>(reg, scalar, "div", 3.0,
+                      [](Args a, Args b) -> S { return a / b; });
+  add_scalar_op<S, N>(reg, scalar, "sqrt", 1.0,
+                      [](Args a, Args b) -> S { return sqrt(a); });
+  add_scalar_op<S, N>(reg, scalar, "exp", 1.0,
+                      [](Args a, Args b) -> S { return exp(a); });
+  add_scalar_op<S, N>(reg, scalar, "atan2", 3.0,
+                      [](Args a, Args b) -> S { return atan2(a, b); });
+
+  // A single expression
+  add_scalar_op<S, N>(reg, scalar, "expr", 9.0, [](Args a, Args b) -> S {
+    return a * b + a / b - sqrt(b);
+  });
+
+  // A short chain typical of a constitutive law
+  add_scalar_op<S, N>(reg, scalar, "chain", 12.0, [](Args a, Args b) -> S {
+    S J = a * b;
+    S logJ = log(J);
+    return 0.5 * (a * a + b * b) - logJ + 0.25 * logJ * logJ / J;
+  });
+}
+
+template <typename T, int N>
+void add_all(Registry& reg) {
+  add_scalar<ADScalar<T, N>, N>(reg, "ADScalar");
+  add_scalar<PackedADScalar<T, N>, N>(reg, "PackedADScalar");
+}
+
+int main(int argc, char* argv[]) {
+  Registry reg;
+  add_all<double, 8>(reg);
+  add_all<double, 12>(reg);
+  add_all<double, 16>(reg);
+  add_all<double, 24>(reg);
+  add_all<float, 8>(reg);
+  add_all<float, 24>(reg);
+  return reg.run(argc, argv);
+}
@@ -0,0 +1,400 @@
+/*
+  End-to-end cost of one Newton step of linear elasticity on a structured
+  tetrahedral mesh of a cube: the element residuals with the JacobianProduct
+  executor, the element Jacobians with the ExtractJacobian executor, the
+  colored assembly of the residual and of the block-sparse (BSR) matrix and a
+  fixed number of conjugate gradient iterations with the threaded BSR SpMV.
+  The matrix-free Newton step replaces the Jacobians, the assembly and the
+  SpMV with the HessianOperator, with and without its cache. The products of
+  the HessianOperator are also timed for a much more expensive stack, the
+  principal strain energy computed with SymEigs. The stages are timed
+  separately, as a function of the number of threads.
+*/
+
+#include <thread>
+#include <vector>
+
+#include "a2dbench.h"
+#include "a2dcore.h"
+#include "ad/a2dbsrmat.h"
+#include "ad/a2dexecutor.h"
+#include "ad/a2dhessianop.h"
+#include "test_energies.h"
+
+using namespace A2D;
+using namespace A2D::Bench;
+
+using T = double;
+constexpr int nodes_per_elem = 4;
+constexpr int M = 3;
+
+using DataType = Vec<T, 1>;
+using GeoType = Mat<T, nodes_per_elem, M>;    // Shape function gradients
+using StateType = Mat<T, nodes_per_elem, M>;  // Nodal displacements
+using JacType = Mat<T, M * nodes_per_elem, M * nodes_per_elem>;
+
+// Number of conjugate gradient iterations in the Newton step
+constexpr index_t cg_iters = 50;
+
+// Strain energy of a linear tetrahedron
+auto make_builder() {
+  return MakeNodalStrainEnergyBuilder<T, nodes_per_elem, M,
+                                            GreenStrainType::LINEAR>();
+}
+
+/*
+  Cube of n x n x n hexahedra, each split into six tetrahedra along the main
+  diagonal, clamped on the face x = 0
+*/
+struct Mesh {
+  Mesh(index_t n) : n(n), nnodes((n + 1) * (n + 1) * (n + 1)) {
+    auto node = [n](index_t i, index_t j, index_t k) {
+      return i + (n + 1) * (j + (n + 1) * k);
+    };
+
+    // The six paths from corner (0, 0, 0) to corner (1, 1, 1) of a hexahedron
+    const int perms[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2},
+                             {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (index_t k = 0; k < n; k++) {
+      for (index_t j = 0; j < n; j++) {
+        for (index_t i = 0; i < n; i++) {
+          for (const auto& p : perms) {
+            index_t c[3] = {i, j, k};
+            conn.push_back(node(c[0], c[1], c[2]));
+            for (int d = 0; d < 3; d++) {
+              c[p[d]]++;
+              conn.push_back(node(c[0], c[1], c[2]));
+            }
+
+            // Gradients of the barycentric coordinates: the rows of the
+            // inverse of the edge matrix, and minus their sum
+            T X[9] = {0.0}, Xinv[9];
+            for (int d = 0; d < 3; d++) {
+              for (int l = 0; l <= d; l++) {
+                X[3 * p[l] + d] = 1.0 / n;
+              }
+            }
+            MatInvCore<T, 3>(X, Xinv);
+            GeoType G;
+            for (int l = 0; l < 3; l++) {
+              for (int d = 0; d < 3; d++) {
+                G(d + 1, l) = Xinv[3 * d + l];
+                G(0, l) -= Xinv[3 * d + l];
+              }
+            }
+            geo.push_back(G);
+          }
+        }
+      }
+    }
+    nelems = geo.size();
+    data.assign(nelems, DataType());
+    for (auto& d : data) {
+      d(0) = 1.0;
+    }
+
+    for (index_t k = 0; k <= n; k++) {
+      for (index_t j = 0; j <= n; j++) {
+        bcs.push_back(node(0, j, k));
+      }
+    }
+  }
+
+  index_t n, nnodes, nelems;
+  std::vector<index_t> conn, bcs;
+  std::vector<DataType> data;
+  std::vector<GeoType> geo;
+};
+
+/*
+  Vector operations split over the threads of the pool. The dot product sums
+  a fixed number of partial sums, so the result does not depend on the
+  number of threads.
+*/
+T dot(ThreadPool& pool, index_t size, const T x[], const T y[]) {
+  constexpr index_t nparts = 64;
+  T part[nparts];
+  pool.parallel_for(nparts, 1, [&](int tid, index_t start, index_t end) {
+    for (index_t p = start; p < end; p++) {
+      T sum = 0.0;
+      for (index_t i = (p * size) / nparts; i < ((p + 1) * size) / nparts;
+           i++) {
+        sum += x[i] * y[i];
+      }
+      part[p] = sum;
+    }
+  });
+  T sum = 0.0;
+  for (index_t p = 0; p < nparts; p++) {
+    sum += part[p];
+  }
+  return sum;
+}
+
+// y = alpha * x + beta * y
+void axpby(ThreadPool& pool, index_t size, T alpha, const T x[], T beta,
+           T y[]) {
+  pool.parallel_for(size, 0, [&](int tid, index_t start, index_t end) {
+    for (index_t i = start; i < end; i++) {
+      y[i] = alpha * x[i] + beta * y[i];
+    }
+  });
+}
+
+// Sum of the squares of the principal strains, computed with SymEigs
+auto make_eigs_builder() {
+  return PrincipalStrainEnergyBuilder<T, nodes_per_elem, M>();
+}
+
+using Hessian =
+    HessianOperator<DataType, GeoType, StateType, decltype(make_builder())>;
+using EigsHessian = HessianOperator<DataType, GeoType, StateType,
+                                    decltype(make_eigs_builder())>;
+
+struct Problem {
+  Problem(index_t n, int nthreads)
+      : mesh(n),
+        pool(nthreads),
+        coloring(mesh.nnodes, mesh.nelems, nodes_per_elem, mesh.conn.data()),
+        mat(mesh.nnodes, mesh.nelems, nodes_per_elem, mesh.conn.data()),
+        hess(pool, mesh.nnodes, mesh.nelems, mesh.conn.data(),
+             mesh.data.data(), mesh.geo.data(), make_builder()),
+        hess_cache(pool, mesh.nnodes, mesh.nelems, mesh.conn.data(),
+                   mesh.data.data(), mesh.geo.data(), make_builder(), true),
+        eigs_hess(pool, mesh.nnodes, mesh.nelems, mesh.conn.data(),
+                  mesh.data.data(), mesh.geo.data(), make_eigs_builder()),
+        eigs_hess_cache(pool, mesh.nnodes, mesh.nelems, mesh.conn.data(),
+                        mesh.data.data(), mesh.geo.data(),
+                        make_eigs_builder(), true),
+        size(M * mesh.nnodes),
+        state(mesh.nelems),
+        res(mesh.nelems),
+        jac(mesh.nelems),
+        u(size, 0.0),
+        f(size, 0.0),
+        r(size),
+        du(size),
+        p(size),
+        Ap(size) {
+    // Uniform load in the z-direction
+    for (index_t i = 0; i < mesh.nnodes; i++) {
+      f[M * i + 2] = -1.0 / mesh.nnodes;
+    }
+  }
+
+  // Gather the nodal displacements of each element
+  void gather() {
+    pool.parallel_for(mesh.nelems, 0, [&](int tid, index_t start,
+                                          index_t end) {
+      for (index_t e = start; e < end; e++) {
+        for (int i = 0; i < nodes_per_elem; i++) {
+          for (int k = 0; k < M; k++) {
+            state[e](i, k) = u[M * mesh.conn[nodes_per_elem * e + i] + k];
+          }
+        }
+      }
+    });
+  }
+
+  // r = f - K * u, from the element products K_e * u_e
+  void residual() {
+    gather();
+    JacobianProduct<FEVarType::STATE, FEVarType::STATE>(
+        pool, mesh.nelems, mesh.data.data(), mesh.geo.data(), state.data(),
+        state.data(), res.data(), make_builder());
+    r = f;
+    coloring.parallel_for(pool, [&](int tid, index_t e) {
+      for (int i = 0; i < nodes_per_elem; i++) {
+        for (int k = 0; k < M; k++) {
+          r[M * mesh.conn[nodes_per_elem * e + i] + k] -= res[e](i, k);
+        }
+      }
+    });
+    apply_bcs(r.data());
+  }
+
+  void jacobian() {
+    ExtractJacobian<FEVarType::STATE, FEVarType::STATE>(
+        pool, mesh.nelems, mesh.data.data(), mesh.geo.data(), state.data(),
+        jac.data(), make_builder());
+  }
+
+  void assemble() {
+    mat.zero();
+    mat.add_values(pool, coloring, mesh.conn.data(), jac.data());
+  }
+
+  // Zero the clamped degrees of freedom
+  void apply_bcs(T x[]) {
+    for (index_t node : mesh.bcs) {
+      for (int k = 0; k < M; k++) {
+        x[M * node + k] = 0.0;
+      }
+    }
+  }
+
+  // Conjugate gradient iterations for K * du = r on the free degrees of
+  // freedom, with mult(p, Ap) computing Ap = K * p
+  template <class Mult>
+  void solve(const Mult& mult) {
+    std::fill(du.begin(), du.end(), 0.0);
+    std::vector<T> z = r;
+    p = r;
+    T rz = dot(pool, size, z.data(), z.data());
+    for (index_t k = 0; k < cg_iters; k++) {
+      mult(p.data(), Ap.data());
+      apply_bcs(Ap.data());
+      T alpha = rz / dot(pool, size, p.data(), Ap.data());
+      axpby(pool, size, alpha, p.data(), 1.0, du.data());
+      axpby(pool, size, -alpha, Ap.data(), 1.0, z.data());
+      T rz_new = dot(pool, size, z.data(), z.data());
+      axpby(pool, size, 1.0, z.data(), rz_new / rz, p.data());
+      rz = rz_new;
+    }
+  }
+
+  void newton_step() {
+    residual();
+    jacobian();
+    assemble();
+    solve([this](const T x[], T y[]) { mat.mult(pool, x, y); });
+    axpby(pool, size, 1.0, du.data(), 1.0, u.data());
+  }
+
+  void newton_step_matrix_free(Hessian& h) {
+    residual();
+    h.linearize(u.data());
+    solve([&h](const T x[], T y[]) { h.mult(x, y); });
+    axpby(pool, size, 1.0, du.data(), 1.0, u.data());
+  }
+
+  Mesh mesh;
+  ThreadPool pool;
+  ElementColoring coloring;
+  BSRMat<T, M> mat;
+  Hessian hess, hess_cache;
+  EigsHessian eigs_hess, eigs_hess_cache;
+  index_t size;
+  std::vector<StateType> state, res;
+  std::vector<JacType> jac;
+  std::vector<T> u, f, r, du, p, Ap;
+};
+
+int main(int argc, char* argv[]) {
+  constexpr index_t n = 24;
+
+  Registry reg;
+
+  int max_threads = std::max(1u, std::thread::hardware_concurrency());
+  for (int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+    auto prob = std::make_shared<Problem>(n, nthreads);
+    prob->jacobian();
+    prob->assemble();
+
+    // A point with distinct principal strains for the SymEigs stack
+    std::vector<T> x(prob->size);
+    for (index_t i = 0; i < prob->size; i++) {
+      x[i] = 0.01 * rand() / RAND_MAX;
+    }
+    prob->hess.linearize(prob->u.data());
+    prob->hess_cache.linearize(prob->u.data());
+    prob->eigs_hess.linearize(x.data());
+    prob->eigs_hess_cache.linearize(x.data());
+
+    const double nelems = prob->mesh.nelems;
+    const double nblocks = prob->mat.get_num_blocks();
+    const double nrows = prob->mat.get_num_block_rows();
+
+    reg.add(label("Jacobian", nthreads), 0.0, [=](index_t niters) {
+      for (index_t i = 0; i < niters; i++) {
+        prob->jacobian();
+      }
+    });
+
+    // Read the element matrices, read and write the blocks
+    reg.add(label("Assemble", nthreads), nelems * JacType::ncomp,
+            sizeof(T) * nelems * JacType::ncomp +
+                2.0 * sizeof(T) * M * M * nblocks,
+            [=](index_t niters) {
+              for (index_t i = 0; i < niters; i++) {
+                prob->assemble();
+              }
+            });
+
+    // Serial assembly in the element order, without coloring
+    if (nthreads == 1) {
+      reg.add("Assemble::serial", nelems * JacType::ncomp,
+              sizeof(T) * nelems * JacType::ncomp +
+                  2.0 * sizeof(T) * M * M * nblocks,
+              [=](index_t niters) {
+                const index_t* conn = prob->mesh.conn.data();
+                for (index_t i = 0; i < niters; i++) {
+                  prob->mat.zero();
+                  for (index_t e = 0; e < prob->mesh.nelems; e++) {
+                    prob->mat.add_element(&conn[nodes_per_elem * e],
+                                          prob->jac[e]);
+                  }
+                }
+              });
+    }
+
+    // Read the blocks, the column indices and x (at least once), write y
+    reg.add(label("SpMV", nthreads), 2.0 * M * M * nblocks,
+            (sizeof(T) * M * M + sizeof(index_t)) * nblocks +
+                2.0 * sizeof(T) * M * nrows,
+            [=](index_t niters) {
+              for (index_t i = 0; i < niters; i++) {
+                prob->mat.mult(prob->pool, prob->p.data(), prob->Ap.data());
+                ClobberMemory();
+              }
+            });
+
+    reg.add(label("NewtonStep", nthreads, cg_iters), 0.0,
+            [=](index_t niters) {
+              for (index_t i = 0; i < niters; i++) {
+                prob->newton_step();
+              }
+            });
+
+    // Matrix-free products. Without the cache, the element stacks are
+    // evaluated and reversed at every product. With the cache, linearize()
+    // does this once and the products run the second-order sweeps only.
+    reg.add(label("HessianOperator::linearize", nthreads, true), 0.0,
+            [=](index_t niters) {
+              for (index_t i = 0; i < niters; i++) {
+                prob->hess_cache.linearize(prob->u.data());
+              }
+            });
+
+    for (bool cache : {false, true}) {
+      Hessian* h = cache ? &prob->hess_cache : &prob->hess;
+      reg.add(label("HessianOperator::mult", nthreads, cache), 0.0,
+              [=](index_t niters) {
+                for (index_t i = 0; i < niters; i++) {
+                  h->mult(prob->p.data(), prob->Ap.data());
+                  ClobberMemory();
+                }
+              });
+
+      reg.add(label("NewtonStepMatrixFree", nthreads, cg_iters, cache), 0.0,
+              [=](index_t niters) {
+                for (index_t i = 0; i < niters; i++) {
+                  prob->newton_step_matrix_free(*h);
+                }
+              });
+    }
+
+    for (bool cache : {false, true}) {
+      EigsHessian* h = cache ? &prob->eigs_hess_cache : &prob->eigs_hess;
+      reg.add(label("HessianOperator::mult::SymEigs", nthreads, cache), 0.0,
+              [=](index_t niters) {
+                for (index_t i = 0; i < niters; i++) {
+                  h->mult(prob->p.data(), prob->Ap.data());
+                  ClobberMemory();
+                }
+              });
+    }
+  }
+
+  return reg.run(argc, argv);
+}
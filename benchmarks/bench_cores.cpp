@@ -0,0 +1,317 @@
+/*
+  Microbenchmarks for the core kernels in include/ad/core/ and the
+  eigenvalue/constitutive kernels for float, double and complex types at all
+  supported sizes up to N = 4.
+*/
+
+#include "a2dbench.h"
+#include "a2dcore.h"
+#include "ad/core/a2dgemmcore.h"
+#include "ad/core/a2dgreenstraincore.h"
+#include "ad/core/a2dmatdetcore.h"
+#include "ad/core/a2dmatinvcore.h"
+#include "ad/core/a2dmatveccore.h"
+#include "ad/core/a2dsymmatmulttracecore.h"
+#include "ad/core/a2dsymmatveccore.h"
+#include "ad/core/a2dsymrkcore.h"
+#include "ad/core/a2dveccore.h"
+
+using namespace A2D;
+using namespace A2D::Bench;
+
+/*
+  Arguments for a kernel with up to three array arguments and a scalar
+*/
+template <typename T, int NA, int NB = 1, int NC = 1>
+struct Args {
+  Args() {
+    randomize(a, NA);
+    randomize(b, NB);
+    randomize(c, NC);
+    alpha = random_value<T>();
+  }
+  T a[NA], b[NB], c[NC];
+  T alpha;
+};
+
+// Make the leading N x N block of a row-major array diagonally dominant
+template <typename T, int N>
+void make_invertible(T* A) {
+  for (int i = 0; i < N; i++) {
+    A[i * (N + 1)] += T(2.0 * N);
+  }
+}
+
+// Make a packed symmetric matrix diagonally dominant
+template <typename T, int N>
+void make_sym_invertible(T* S) {
+  for (int i = 0; i < N; i++) {
+    S[i + i * (i + 1) / 2] += T(2.0 * N);
+  }
+}
+
+template <MatOp op>
+const char* opname() {
+  return op == MatOp::NORMAL ? "N" : "T";
+}
+
+template <typename T, int N, MatOp opA, MatOp opB>
+void add_gemm(Registry& reg) {
+  const std::string t = type_name<T>::get();
+  const double flops = flop_factor<T>::value * 2.0 * N * N * N;
+  auto args = std::make_shared<Args<T, N * N, N * N, N * N>>();
+
+  add_kernel(reg, label("MatMatMultCore", t, N, opname<opA>(), opname<opB>()),
+             flops, args, [](auto& x) {
+               MatMatMultCore<T, N, N, N, N, N, N, opA, opB>(x.a, x.b, x.c);
+             });
+  add_kernel(
+      reg, label("MatMatMultCoreAdd", t, N, opname<opA>(), opname<opB>()),
+      flops + flop_factor<T>::value * N * N, args, [](auto& x) {
+        MatMatMultCore<T, N, N, N, N, N, N, opA, opB, true>(x.a, x.b, x.c);
+      });
+  add_kernel(
+      reg, label("MatMatMultScaleCore", t, N, opname<opA>(), opname<opB>()),
+      flops + flop_factor<T>::value * N * N, args, [](auto& x) {
+        MatMatMultScaleCore<T, N, N, N, N, N, N, opA, opB>(x.alpha, x.a, x.b,
+                                                           x.c);
+      });
+}
+
+/*
+  Medium-sized products C = op(A) * op(B), where op(A) is M x P and op(B) is
+  P x N, through the dispatcher (which selects the register-blocked kernel)
+  and through the general kernel for comparison
+*/
+template <typename T, int M, int P, int N, MatOp opA, MatOp opB>
+void add_gemm_medium(Registry& reg) {
+  const std::string t = type_name<T>::get();
+  const std::string size =
+      std::to_string(M) + "x" + std::to_string(P) + "x" + std::to_string(N);
+  const double flops = flop_factor<T>::value * 2.0 * M * N * P;
+  auto args = std::make_shared<Args<T, M * P, P * N, M * N>>();
+
+  constexpr int Anrows = opA == MatOp::NORMAL ? M : P;
+  constexpr int Ancols = opA == MatOp::NORMAL ? P : M;
+  constexpr int Bnrows = opB == MatOp::NORMAL ? P : N;
+  constexpr int Bncols = opB == MatOp::NORMAL ? N : P;
+
+  add_kernel(
+      reg, label("MatMatMultCore", t, size, opname<opA>(), opname<opB>()),
+      flops, args, [](auto& x) {
+        MatMatMultCore<T, Anrows, Ancols, Bnrows, Bncols, M, N, opA, opB>(
+            x.a, x.b, x.c);
+      });
+  add_kernel(reg,
+             label("MatMatMultCoreGeneral", t, size, opname<opA>(),
+                   opname<opB>()),
+             flops, args, [](auto& x) {
+               MatMatMultCoreGeneral<T, Anrows, Ancols, Bnrows, Bncols, M, N,
+                                     opA, opB>(x.a, x.b, x.c);
+             });
+}
+
+/*
+  Medium-sized products y = op(A) * x, where A is M x N
+*/
+template <typename T, int M, int N, MatOp opA>
+void add_gemv_medium(Registry& reg) {
+  const std::string t = type_name<T>::get();
+  const std::string size = std::to_string(M) + "x" + std::to_string(N);
+  const double flops = flop_factor<T>::value * 2.0 * M * N;
+  auto args = std::make_shared<Args<T, M * N, M + N, M + N>>();
+
+  add_kernel(reg, label("MatVecCore", t, size, opname<opA>()), flops, args,
+             [](auto& x) { MatVecCore<T, M, N, opA>(x.a, x.b, x.c); });
+}
+
+template <typename T, int N>
+void add_gemm_family(Registry& reg) {
+  const std::string t = type_name<T>::get();
+  const double flops = flop_factor<T>::value * 2.0 * N * N * N;
+
+  add_gemm<T, N, MatOp::NORMAL, MatOp::NORMAL>(reg);
+  add_gemm<T, N, MatOp::NORMAL, MatOp::TRANSPOSE>(reg);
+  add_gemm<T, N, MatOp::TRANSPOSE, MatOp::NORMAL>(reg);
+  add_gemm<T, N, MatOp::TRANSPOSE, MatOp::TRANSPOSE>(reg);
+
+  constexpr int S = (N * (N + 1)) / 2;
+  auto args = std::make_shared<Args<T, N * N, N * N, N * N>>();
+
+  add_kernel(reg, label("SMatSMatMultCore", t, N), flops, args, [](auto& x) {
+    SMatSMatMultCore<T, N, N, N, N>(x.a, x.b, x.c);
+  });
+  add_kernel(reg, label("SMatMatMultCore", t, N, "N"), flops, args,
+             [](auto& x) {
+               SMatMatMultCore<T, N, N, N, N, N, MatOp::NORMAL>(x.a, x.b, x.c);
+             });
+  add_kernel(
+      reg, label("SMatMatMultCore", t, N, "T"), flops, args, [](auto& x) {
+        SMatMatMultCore<T, N, N, N, N, N, MatOp::TRANSPOSE>(x.a, x.b, x.c);
+      });
+  add_kernel(reg, label("MatSMatMultCore", t, N, "N"), flops, args,
+             [](auto& x) {
+               MatSMatMultCore<T, N, N, N, N, N, MatOp::NORMAL>(x.a, x.b, x.c);
+             });
+  add_kernel(
+      reg, label("MatSMatMultCore", t, N, "T"), flops, args, [](auto& x) {
+        MatSMatMultCore<T, N, N, N, N, N, MatOp::TRANSPOSE>(x.a, x.b, x.c);
+      });
+
+  // Symmetric rank-k updates
+  const double rkflops = flop_factor<T>::value * 2.0 * S * N;
+  add_kernel(reg, label("SymMatRKCore", t, N, "N"), rkflops, args,
+             [](auto& x) { SymMatRKCore<T, N, N, MatOp::NORMAL>(x.a, x.c); });
+  add_kernel(
+      reg, label("SymMatRKCore", t, N, "T"), rkflops, args,
+      [](auto& x) { SymMatRKCore<T, N, N, MatOp::TRANSPOSE>(x.a, x.c); });
+  add_kernel(reg, label("SymMatRKCoreScale", t, N, "N"),
+             rkflops + flop_factor<T>::value * S, args, [](auto& x) {
+               SymMatRKCoreScale<T, N, N, MatOp::NORMAL>(x.alpha, x.a, x.c);
+             });
+  add_kernel(reg, label("SymMatR2KCore", t, N, "N"), 2.0 * rkflops, args,
+             [](auto& x) {
+               SymMatR2KCore<T, N, N, MatOp::NORMAL>(x.a, x.b, x.c);
+             });
+  add_kernel(reg, label("SymMatRKCoreReverse", t, N, "N"), 2.0 * rkflops,
+             args, [](auto& x) {
+               SymMatRKCoreReverse<T, N, N, MatOp::NORMAL>(x.a, x.b, x.c);
+             });
+
+  // Matrix-vector products
+  const double mvflops = flop_factor<T>::value * 2.0 * N * N;
+  add_kernel(reg, label("MatVecCore", t, N, "N"), mvflops, args, [](auto& x) {
+    MatVecCore<T, N, N, MatOp::NORMAL>(x.a, x.b, x.c);
+  });
+  add_kernel(reg, label("MatVecCore", t, N, "T"), mvflops, args, [](auto& x) {
+    MatVecCore<T, N, N, MatOp::TRANSPOSE>(x.a, x.b, x.c);
+  });
+  add_kernel(reg, label("SymMatVecCore", t, N), mvflops, args,
+             [](auto& x) { SymMatVecCore<T, N>(x.a, x.b, x.c); });
+  add_kernel(reg, label("MatInnerCore", t, N), mvflops + 2.0 * N, args,
+             [](auto& x) {
+               x.alpha = MatInnerCore<T, N, N>(x.a, x.b, x.c);
+             });
+
+  // Vector operations
+  add_kernel(reg, label("VecOuterCore", t, N), flop_factor<T>::value * N * N,
+             args, [](auto& x) { VecOuterCore<T, N, N>(x.a, x.b, x.c); });
+  add_kernel(reg, label("VecSymOuterCore", t, N), flop_factor<T>::value * S,
+             args, [](auto& x) { VecSymOuterCore<T, N>(x.a, x.c); });
+  add_kernel(reg, label("VecDotCore", t, N), flop_factor<T>::value * 2.0 * N,
+             args, [](auto& x) { x.alpha = VecDotCore<T, N>(x.a, x.b); });
+  add_kernel(reg, label("VecSumCore", t, N), flop_factor<T>::value * 3.0 * N,
+             args, [](auto& x) {
+               VecSumCore<T, N>(x.alpha, x.a, x.alpha, x.b, x.c);
+             });
+  add_kernel(reg, label("VecHadamardCore", t, N), flop_factor<T>::value * N,
+             args, [](auto& x) { VecHadamardCore<T, N>(x.a, x.b, x.c); });
+
+  // Symmetric trace product
+  add_kernel(reg, label("SymMatMultTraceCore", t, N),
+             flop_factor<T>::value * 2.0 * S, args, [](auto& x) {
+               x.alpha = SymMatMultTraceCore<T, N>(x.a, x.b);
+             });
+
+  // Eigenvalues of a symmetric matrix
+  add_kernel(reg, label("SymEigsGeneral", t, N), 0.0, args,
+             [](auto& x) { SymEigsGeneral<T, N>(x.a, x.b, x.c); });
+  if constexpr (N == 3) {
+    add_kernel(reg, label("SymEigs3x3", t, N), 0.0, args,
+               [](auto& x) { SymEigs3x3<T>(x.a, x.b, x.c); });
+  }
+}
+
+// Closed-form kernels, generated for N <= A2D_MAX_GEN_SIZE
+template <typename T, int N>
+void add_small_kernels(Registry& reg) {
+  const std::string t = type_name<T>::get();
+  constexpr double det_flops[] = {0.0, 0.0, 3.0, 14.0, 42.0};
+  constexpr double inv_flops[] = {0.0, 1.0, 8.0, 42.0, 158.0};
+
+  auto args = std::make_shared<Args<T, N * N, N * N, N * N>>();
+  make_invertible<T, N>(args->a);
+  make_sym_invertible<T, N>(args->b);
+
+  add_kernel(reg, label("MatDetCore", t, N),
+             flop_factor<T>::value * det_flops[N], args,
+             [](auto& x) { x.alpha = MatDetCore<T, N>(x.a); });
+  add_kernel(reg, label("MatDetForwardCore", t, N),
+             flop_factor<T>::value * 2.0 * det_flops[N], args,
+             [](auto& x) { x.alpha = MatDetForwardCore<T, N>(x.a, x.c); });
+  add_kernel(reg, label("MatDetReverseCore", t, N),
+             flop_factor<T>::value * 2.0 * det_flops[N], args,
+             [](auto& x) { MatDetReverseCore<T, N>(x.alpha, x.a, x.c); });
+  add_kernel(reg, label("SymMatDetCore", t, N),
+             flop_factor<T>::value * det_flops[N], args,
+             [](auto& x) { x.alpha = SymMatDetCore<T, N>(x.b); });
+  add_kernel(reg, label("MatInvCore", t, N),
+             flop_factor<T>::value * inv_flops[N], args,
+             [](auto& x) { MatInvCore<T, N>(x.a, x.c); });
+  add_kernel(reg, label("SymMatInvCore", t, N),
+             flop_factor<T>::value * inv_flops[N], args,
+             [](auto& x) { SymMatInvCore<T, N>(x.b, x.c); });
+}
+
+// Continuum mechanics kernels, generated for N <= A2D_MAX_GEN_SIZE
+template <typename T, int N>
+void add_continuum_kernels(Registry& reg) {
+  const std::string t = type_name<T>::get();
+  constexpr int S = (N * (N + 1)) / 2;
+  auto args = std::make_shared<Args<T, N * N, N * N, N * N>>();
+
+  add_kernel(reg, label("SymIsotropicCore", t, N),
+             flop_factor<T>::value * (3.0 * S + N), args, [](auto& x) {
+               SymIsotropicCore<T, N>(x.alpha, x.alpha, x.a, x.c);
+             });
+  add_kernel(reg, label("LinearGreenStrainCore", t, N),
+             flop_factor<T>::value * S, args,
+             [](auto& x) { LinearGreenStrainCore<T, N>(x.a, x.c); });
+  add_kernel(reg, label("NonlinearGreenStrainCore", t, N),
+             flop_factor<T>::value * S * (2.0 * N + 1.0), args,
+             [](auto& x) { NonlinearGreenStrainCore<T, N>(x.a, x.c); });
+  add_kernel(reg, label("NonlinearGreenStrainForwardCore", t, N),
+             flop_factor<T>::value * S * (4.0 * N + 1.0), args, [](auto& x) {
+               NonlinearGreenStrainForwardCore<T, N>(x.a, x.b, x.c);
+             });
+  add_kernel(reg, label("NonlinearGreenStrainReverseCore", t, N),
+             flop_factor<T>::value * S * (4.0 * N + 1.0), args, [](auto& x) {
+               NonlinearGreenStrainReverseCore<T, N>(x.a, x.b, x.c);
+             });
+}
+
+template <typename T>
+void add_all(Registry& reg) {
+  add_gemm_family<T, 1>(reg);
+  add_gemm_family<T, 2>(reg);
+  add_gemm_family<T, 3>(reg);
+  add_gemm_family<T, 4>(reg);
+
+  add_gemm_medium<T, 27, 27, 27, MatOp::NORMAL, MatOp::NORMAL>(reg);
+  add_gemm_medium<T, 27, 27, 27, MatOp::TRANSPOSE, MatOp::NORMAL>(reg);
+  add_gemm_medium<T, 27, 27, 27, MatOp::NORMAL, MatOp::TRANSPOSE>(reg);
+  add_gemm_medium<T, 64, 24, 24, MatOp::NORMAL, MatOp::NORMAL>(reg);
+  add_gemm_medium<T, 24, 64, 24, MatOp::TRANSPOSE, MatOp::NORMAL>(reg);
+
+  add_gemv_medium<T, 27, 27, MatOp::NORMAL>(reg);
+  add_gemv_medium<T, 27, 27, MatOp::TRANSPOSE>(reg);
+  add_gemv_medium<T, 64, 24, MatOp::NORMAL>(reg);
+  add_gemv_medium<T, 64, 24, MatOp::TRANSPOSE>(reg);
+
+  add_small_kernels<T, 1>(reg);
+  add_small_kernels<T, 2>(reg);
+  add_small_kernels<T, 3>(reg);
+  add_small_kernels<T, 4>(reg);
+
+  add_continuum_kernels<T, 2>(reg);
+  add_continuum_kernels<T, 3>(reg);
+  add_continuum_kernels<T, 4>(reg);
+}
+
+int main(int argc, char* argv[]) {
+  Registry reg;
+  add_all<double>(reg);
+  add_all<float>(reg);
+  add_all<A2D_complex_t<double>>(reg);
+  return reg.run(argc, argv);
+}
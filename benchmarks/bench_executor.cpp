@@ -0,0 +1,152 @@
+/*
+  Throughput of the multithreaded batched JacobianProduct and ExtractJacobian
+  executors for a hyperelastic strain energy, as a function of the number of
+  threads and the chunk size. The serial ElementLoop benchmarks compare
+  copying the element values into A2DObj inputs with views of the global
+  arrays (MatView). The cached benchmarks take the inverse of the mapping
+  Jacobian from a GeometryFactorCache, with a passive geometry.
+*/
+
+#include <thread>
+#include <vector>
+
+#include "a2dbench.h"
+#include "a2dcore.h"
+#include "ad/a2dexecutor.h"
+#include "ad/a2dgeocache.h"
+#include "test_energies.h"
+
+using namespace A2D;
+using namespace A2D::Bench;
+
+using T = double;
+using DataType = Vec<T, 1>;
+using GeoType = Mat<T, 3, 3>;
+using StateType = Mat<T, 3, 3>;
+
+// Builder for the strain energy in terms of the displacement gradient only
+auto make_state_builder() {
+  return [E = A2DObj<SymMat<T, 3>>(), S = A2DObj<SymMat<T, 3>>(),
+          out = A2DObj<T>()](auto& Ux) mutable {
+    out.bvalue() = 1.0;
+    return MakeStack(MatGreenStrain<GreenStrainType::NONLINEAR>(Ux, E),
+                     SymIsotropic(T(0.35), T(0.51), E, S),
+                     SymMatMultTrace(E, S, out));
+  };
+}
+
+struct Elements {
+  Elements(index_t nelems)
+      : data(nelems),
+        geo(nelems),
+        state(nelems),
+        p(nelems),
+        res(nelems),
+        jac(nelems),
+        cached_geo(nelems),
+        cache(nelems) {
+    auto J = cached_geo.modify();
+    for (index_t e = 0; e < nelems; e++) {
+      RandomStrainEnergyElement(data[e], geo[e], state[e], p[e]);
+      J[e].copy(geo[e]);
+    }
+  }
+
+  std::vector<DataType> data;
+  std::vector<GeoType> geo;
+  std::vector<StateType> state, p, res;
+  std::vector<Mat<T, 9, 9>> jac;
+  VersionedArray<GeoType> cached_geo;
+  GeometryFactorCache<T, 3> cache;
+};
+
+int main(int argc, char* argv[]) {
+  constexpr index_t nelems = 1 << 14;
+  auto elems = std::make_shared<Elements>(nelems);
+
+  Registry reg;
+
+  reg.add("ElementLoop::copy", 0.0, [=](index_t niters) {
+    auto build = make_state_builder();
+    A2DObj<DataType> data;
+    A2DObj<GeoType> geo;
+    A2DObj<StateType> Ux;
+    for (index_t i = 0; i < niters; i++) {
+      for (index_t e = 0; e < nelems; e++) {
+        Ux.value().copy(elems->state[e]);
+        Ux.bvalue().zero();
+        Ux.hvalue().zero();
+        auto stack = build(Ux);
+        JacobianProduct<FEVarType::STATE, FEVarType::STATE>(
+            stack, data, geo, Ux, elems->p[e], elems->res[e]);
+        stack.bzero();
+        stack.hzero();
+      }
+    }
+  });
+
+  reg.add("ElementLoop::view", 0.0, [=](index_t niters) {
+    using View = MatView<T, 3, 3>;
+    auto build = make_state_builder();
+    StateType ub;
+    for (index_t i = 0; i < niters; i++) {
+      for (index_t e = 0; e < nelems; e++) {
+        A2DObj<View> Ux(View(elems->state[e]), View(ub), View(elems->p[e]),
+                        View(elems->res[e]));
+        Ux.bvalue().zero();
+        Ux.hvalue().zero();
+        auto stack = build(Ux);
+        stack.hproduct();
+        stack.bzero();
+        stack.hzero();
+      }
+    }
+  });
+
+  int max_threads = std::max(1u, std::thread::hardware_concurrency());
+  for (int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+    auto pool = std::make_shared<ThreadPool>(nthreads);
+
+    for (index_t chunk : {0, 16, 256}) {
+      reg.add(label("JacobianProduct", nthreads, chunk), 0.0,
+              [=](index_t niters) {
+                for (index_t i = 0; i < niters; i++) {
+                  JacobianProduct<FEVarType::STATE, FEVarType::STATE>(
+                      *pool, nelems, elems->data.data(), elems->geo.data(),
+                      elems->state.data(), elems->p.data(),
+                      elems->res.data(), MakeStrainEnergyBuilder<T>(), chunk);
+                }
+              });
+    }
+
+    reg.add(label("ExtractJacobian", nthreads, 0), 0.0, [=](index_t niters) {
+      for (index_t i = 0; i < niters; i++) {
+        ExtractJacobian<FEVarType::STATE, FEVarType::STATE>(
+            *pool, nelems, elems->data.data(), elems->geo.data(),
+            elems->state.data(), elems->jac.data(), MakeStrainEnergyBuilder<T>());
+      }
+    });
+
+    reg.add(label("JacobianProduct::cached", nthreads, 0), 0.0,
+            [=](index_t niters) {
+              for (index_t i = 0; i < niters; i++) {
+                JacobianProduct<FEVarType::STATE, FEVarType::STATE>(
+                    *pool, nelems, elems->data.data(), elems->cached_geo,
+                    elems->state.data(), elems->p.data(), elems->res.data(),
+                    MakeCachedStrainEnergyBuilder<T>(), elems->cache);
+              }
+            });
+
+    reg.add(label("ExtractJacobian::cached", nthreads, 0), 0.0,
+            [=](index_t niters) {
+              for (index_t i = 0; i < niters; i++) {
+                ExtractJacobian<FEVarType::STATE, FEVarType::STATE>(
+                    *pool, nelems, elems->data.data(), elems->cached_geo,
+                    elems->state.data(), elems->jac.data(),
+                    MakeCachedStrainEnergyBuilder<T>(), elems->cache);
+              }
+            });
+  }
+
+  return reg.run(argc, argv);
+}
@@ -0,0 +1,325 @@
+/*
+  Benchmarks for the eval, forward, reverse and hreverse paths of the
+  expressions for float, double and complex types at all supported sizes up
+  to N = 4. The second-order objects (A2DObj) are used throughout so that all
+  four paths run on the same expression: "forward" is the second-order
+  forward (pvalue) sweep. The Hessian-vector product of a complete stack is
+  timed on the StrainTest pipeline, as is a quadrature loop that builds a
+  new stack at each point or re-evaluates one stack.
+
+  The flops and bytes of each path are taken from the compile-time cost
+  model (OpCost) where one exists, so that the GFLOP/s and flop/B columns
+  place the expressions and the stack on a roofline plot.
+*/
+
+#include "a2dbench.h"
+#include "a2dcore.h"
+
+using namespace A2D;
+using namespace A2D::Bench;
+
+// Fill all the entries of an object with random values
+template <class Type>
+void randomize_data(Type& x) {
+  if constexpr (get_a2d_object_type<Type>::value == ADObjType::SCALAR) {
+    x = random_value<Type>();
+  } else {
+    using T = typename get_object_numeric_type<Type>::type;
+    for (index_t i = 0; i < Type::ncomp; i++) {
+      x[i] = random_value<T>();
+    }
+  }
+}
+
+// Randomize all seeds and make square matrix values diagonally dominant
+template <class Type>
+void randomize_obj(A2DObj<Type>& obj) {
+  randomize_data(obj.value());
+  randomize_data(obj.bvalue());
+  randomize_data(obj.pvalue());
+  randomize_data(obj.hvalue());
+
+  constexpr ADObjType otype = get_a2d_object_type<Type>::value;
+  if constexpr (otype == ADObjType::MATRIX || otype == ADObjType::SYMMAT) {
+    if constexpr (Type::nrows == Type::ncols) {
+      for (int i = 0; i < Type::nrows; i++) {
+        obj.value()(i, i) += 2.0 * Type::nrows;
+      }
+    }
+  }
+}
+
+// Register a benchmark with the modelled cost of a call
+template <typename T>
+void add_modelled(Registry& reg, const std::string& name, OpCostCounts cost,
+                  Registry::Kernel kernel) {
+  reg.add(name, flop_factor<T>::value * cost.flops, cost.bytes, kernel);
+}
+
+/**
+ * @brief Register the eval/forward/reverse/hreverse benchmarks of an
+ * expression
+ *
+ * @tparam Objs The A2DObj types that the expression operates on
+ * @param name Label of the expression
+ * @param build Callable that builds the expression from the objects
+ */
+template <class... Objs, class Builder>
+void add_expr(Registry& reg, const std::string& name, Builder build) {
+  auto objs = std::make_shared<std::tuple<Objs...>>();
+  std::apply([](auto&... obj) { (randomize_obj(obj), ...); }, *objs);
+
+  using Expr = decltype(std::apply(build, *objs));
+  auto expr = std::make_shared<Expr>(std::apply(build, *objs));
+  expr->eval();
+
+  using T = typename Expr::T;
+  using Cost = OpCost<Expr>;
+  add_modelled<T>(reg, name + "::eval", Cost::eval,
+                  [objs, expr](index_t niters) {
+                    for (index_t i = 0; i < niters; i++) {
+                      expr->eval();
+                      ClobberMemory();
+                    }
+                  });
+  add_modelled<T>(reg, name + "::forward", Cost::forward,
+                  [objs, expr](index_t niters) {
+                    for (index_t i = 0; i < niters; i++) {
+                      expr->template forward<ADorder::SECOND>();
+                      ClobberMemory();
+                    }
+                  });
+  add_modelled<T>(reg, name + "::reverse", Cost::reverse,
+                  [objs, expr](index_t niters) {
+                    for (index_t i = 0; i < niters; i++) {
+                      expr->reverse();
+                      ClobberMemory();
+                    }
+                  });
+  add_modelled<T>(reg, name + "::hreverse", Cost::hreverse,
+                  [objs, expr](index_t niters) {
+                    for (index_t i = 0; i < niters; i++) {
+                      expr->hreverse();
+                      ClobberMemory();
+                    }
+                  });
+}
+
+template <typename T, int N>
+void add_exprs(Registry& reg) {
+  const std::string t = type_name<T>::get();
+  using M = A2DObj<Mat<T, N, N>>;
+  using S = A2DObj<SymMat<T, N>>;
+  using V = A2DObj<Vec<T, N>>;
+  using D = A2DObj<T>;
+
+  add_expr<M, M, M>(reg, label("MatMatMultExpr", t, N, "N", "N"),
+                    [](auto& A, auto& B, auto& C) {
+                      return MatMatMult(A, B, C);
+                    });
+  add_expr<M, M, M>(reg, label("MatMatMultExpr", t, N, "T", "N"),
+                    [](auto& A, auto& B, auto& C) {
+                      return MatMatMult<MatOp::TRANSPOSE, MatOp::NORMAL>(A, B,
+                                                                         C);
+                    });
+  add_expr<M, V, V>(reg, label("MatVecMultExpr", t, N),
+                    [](auto& A, auto& x, auto& y) {
+                      return MatVecMult(A, x, y);
+                    });
+  add_expr<M, M, M>(reg, label("MatSumExpr", t, N),
+                    [](auto& A, auto& B, auto& C) { return MatSum(A, B, C); });
+  add_expr<M, S>(reg, label("SymMatRKExpr", t, N, "N"),
+                 [](auto& A, auto& S) { return SymMatRK(A, S); });
+  add_expr<M, S>(reg, label("SymMatRKExpr", t, N, "T"), [](auto& A, auto& S) {
+    return SymMatRK<MatOp::TRANSPOSE>(A, S);
+  });
+  add_expr<S, S, D>(reg, label("SymMatMultTraceExpr", t, N),
+                    [](auto& S, auto& E, auto& d) {
+                      return SymMatMultTrace(S, E, d);
+                    });
+  add_expr<S, S, S>(reg, label("SymMatSumExpr", t, N),
+                    [](auto& A, auto& B, auto& C) { return MatSum(A, B, C); });
+  add_expr<M, S>(reg, label("SymMatSumExpr", t, N, "A+AT"),
+                 [](auto& A, auto& S) { return SymMatSum(A, S); });
+  add_expr<S, V, V>(reg, label("SymMatVecMultExpr", t, N),
+                    [](auto& S, auto& x, auto& y) {
+                      return MatVecMult(S, x, y);
+                    });
+  add_expr<V, V, M>(reg, label("VecOuterExpr", t, N),
+                    [](auto& x, auto& y, auto& A) {
+                      return VecOuter(x, y, A);
+                    });
+  add_expr<V, V, D>(reg, label("VecDotExpr", t, N),
+                    [](auto& x, auto& y, auto& d) { return VecDot(x, y, d); });
+  add_expr<M, D>(reg, label("MatTraceExpr", t, N),
+                 [](auto& A, auto& d) { return MatTrace(A, d); });
+
+  if constexpr (N <= A2D_MAX_GEN_SIZE) {
+    add_expr<M, M>(reg, label("MatInvExpr", t, N),
+                   [](auto& A, auto& Ainv) { return MatInv(A, Ainv); });
+    add_expr<M, D>(reg, label("MatDetExpr", t, N),
+                   [](auto& A, auto& d) { return MatDet(A, d); });
+  }
+
+  if constexpr (N >= 2 && N <= A2D_MAX_GEN_SIZE) {
+    add_expr<S, S>(reg, label("SymIsotropicExpr", t, N),
+                   [](auto& E, auto& S) {
+                     return SymIsotropic(T(0.35), T(0.51), E, S);
+                   });
+    add_expr<M, S>(reg, label("MatGreenStrainExpr", t, N, "LINEAR"),
+                   [](auto& U, auto& E) {
+                     return MatGreenStrain<GreenStrainType::LINEAR>(U, E);
+                   });
+    add_expr<M, S>(reg, label("MatGreenStrainExpr", t, N, "NONLINEAR"),
+                   [](auto& U, auto& E) {
+                     return MatGreenStrain<GreenStrainType::NONLINEAR>(U, E);
+                   });
+  }
+
+  if constexpr (N >= 2) {
+    add_expr<S, V>(reg, label("SymEigsExpr", t, N),
+                   [](auto& S, auto& e) { return SymEigs(S, e); });
+  }
+}
+
+/*
+  The strain energy pipeline of StrainTest in test_ad_expressions.cpp, used to
+  compare the fused Hessian-vector product of the stack against separate
+  reverse, hforward and hreverse sweeps
+*/
+template <typename T, int N>
+struct StrainPipeline {
+  A2DObj<Mat<T, N, N>> Uxi, J, Jinv, Ux;
+  A2DObj<SymMat<T, N>> E1, E2, E, S;
+  A2DObj<T> output;
+
+  auto make_stack() {
+    return MakeStack(MatInv(J, Jinv), MatMatMult(Uxi, Jinv, Ux),
+                     SymMatSum(T(0.5), Ux, E1),
+                     SymMatRK<MatOp::TRANSPOSE>(Ux, E2),
+                     MatSum(T(1.0), E1, T(0.5), E2, E),
+                     SymIsotropic(T(0.35), T(0.51), E, S),
+                     SymMatMultTrace(E, S, output));
+  }
+};
+
+template <typename T, int N>
+void add_strain_stack(Registry& reg) {
+  using Pipeline = StrainPipeline<T, N>;
+  using Stack = decltype(std::declval<Pipeline&>().make_stack());
+
+  auto x = std::make_shared<Pipeline>();
+  randomize_obj(x->Uxi);
+  randomize_obj(x->J);
+  auto stack = std::make_shared<Stack>(x->make_stack());
+  x->output.bvalue() = T(1.0);
+
+  // The unfused sweeps do the same work as the fused product
+  constexpr OpCostCounts cost = OpCost<Stack>::hproduct;
+  const std::string name = label("StrainStack", type_name<T>::get(), N);
+  add_modelled<T>(reg, name + "::hproduct", cost, [x, stack](index_t niters) {
+    for (index_t i = 0; i < niters; i++) {
+      stack->hzero();
+      stack->hproduct();
+      ClobberMemory();
+    }
+  });
+  add_modelled<T>(reg, name + "::hproduct_unfused", cost,
+                  [x, stack](index_t niters) {
+                    for (index_t i = 0; i < niters; i++) {
+                      stack->hzero();
+                      stack->reverse();
+                      stack->hforward();
+                      stack->hreverse();
+                      ClobberMemory();
+                    }
+                  });
+}
+
+/*
+  A quadrature loop over the StrainTest pipeline: a new stack with new
+  intermediates at every point against one stack that is re-evaluated
+*/
+template <typename T, int N>
+struct StrainPoints {
+  static constexpr int npoints = 8;
+  Mat<T, N, N> Uxi[npoints], J[npoints], P[npoints];
+  T result[npoints];
+
+  StrainPoints() {
+    for (int q = 0; q < npoints; q++) {
+      randomize(get_data(Uxi[q]), N * N);
+      randomize(get_data(J[q]), N * N);
+      randomize(get_data(P[q]), N * N);
+      for (int i = 0; i < N; i++) {
+        J[q](i, i) += 2.0 * N;
+      }
+    }
+  }
+};
+
+template <typename T, int N>
+void add_strain_points(Registry& reg) {
+  using Pipeline = StrainPipeline<T, N>;
+  using Points = StrainPoints<T, N>;
+  auto pts = std::make_shared<Points>();
+
+  const std::string name = label("StrainPoints", type_name<T>::get(), N);
+  reg.add(name + "::build", 0.0, [pts](index_t niters) {
+    for (index_t i = 0; i < niters; i++) {
+      for (int q = 0; q < Points::npoints; q++) {
+        Pipeline y;
+        y.Uxi.value() = pts->Uxi[q];
+        y.J.value() = pts->J[q];
+        y.Uxi.pvalue() = pts->P[q];
+        auto s = y.make_stack();
+        y.output.bvalue() = T(1.0);
+        s.hproduct();
+        pts->result[q] = y.Uxi.hvalue()(0, 0);
+      }
+      ClobberMemory();
+    }
+  });
+  reg.add(name + "::reuse", 0.0, [pts](index_t niters) {
+    // Built once, as it would be once per thread
+    Pipeline x;
+    auto stack = x.make_stack();
+    for (index_t i = 0; i < niters; i++) {
+      for (int q = 0; q < Points::npoints; q++) {
+        x.Uxi.value() = pts->Uxi[q];
+        x.J.value() = pts->J[q];
+        x.Uxi.pvalue() = pts->P[q];
+        x.Uxi.bzero();
+        x.Uxi.hzero();
+        x.J.bzero();
+        x.J.hzero();
+        stack.eval();
+        stack.reset();
+        x.output.bvalue() = T(1.0);
+        stack.hproduct();
+        pts->result[q] = x.Uxi.hvalue()(0, 0);
+      }
+      ClobberMemory();
+    }
+  });
+}
+
+template <typename T>
+void add_all(Registry& reg) {
+  add_exprs<T, 1>(reg);
+  add_exprs<T, 2>(reg);
+  add_exprs<T, 3>(reg);
+  add_exprs<T, 4>(reg);
+  add_strain_stack<T, 2>(reg);
+  add_strain_stack<T, 3>(reg);
+  add_strain_points<T, 2>(reg);
+  add_strain_points<T, 3>(reg);
+}
+
+int main(int argc, char* argv[]) {
+  Registry reg;
+  add_all<double>(reg);
+  add_all<float>(reg);
+  add_all<A2D_complex_t<double>>(reg);
+  return reg.run(argc, argv);
+}
@@ -0,0 +1,130 @@
+/*
+  Throughput of large batches of 3 x 3 element kernels with double storage
+  and with float storage and double accumulation. This target is built with
+  A2D_MIXED_PRECISION, so the float kernels accumulate in double.
+
+  Each benchmark is one sweep over the batch and the bytes are the element
+  data that is streamed from memory. Once the batch no longer fits in cache
+  the sweeps are bound by the memory bandwidth, and float storage moves half
+  the bytes of double storage.
+*/
+
+#include <vector>
+
+#include "a2dbench.h"
+#include "a2dcore.h"
+
+using namespace A2D;
+using namespace A2D::Bench;
+
+// Sizes of the batches: resident in the L2 cache and streamed from memory
+constexpr index_t small_batch = 1 << 10;
+constexpr index_t large_batch = 1 << 19;
+
+template <typename T>
+std::shared_ptr<std::vector<T>> make_array(index_t size) {
+  auto x = std::make_shared<std::vector<T>>(size);
+  randomize(x->data(), size);
+  return x;
+}
+
+template <typename T>
+std::string storage_name() {
+  return is_mixed_precision<T>::value ? "float+double" : type_name<T>::get();
+}
+
+// The Hessian-vector product of a strain energy at one element
+template <typename T>
+struct StrainEnergy {
+  A2DObj<Mat<T, 3, 3>> Ux;
+  A2DObj<SymMat<T, 3>> E, S;
+  A2DObj<T> energy;
+
+  auto make_stack() {
+    return MakeStack(MatGreenStrain<GreenStrainType::NONLINEAR>(Ux, E),
+                     SymIsotropic(T(0.35), T(0.51), E, S),
+                     SymMatMultTrace(E, S, energy));
+  }
+};
+
+template <typename T>
+void add_batch(Registry& reg, index_t nelems) {
+  using M = ADObj<Mat<T, 3, 3>>;
+  const std::string t = storage_name<T>();
+  const double n = nelems;
+  auto A = make_array<T>(9 * nelems);
+  auto B = make_array<T>(9 * nelems);
+  auto C = make_array<T>(9 * nelems);
+  for (index_t e = 0; e < nelems; e++) {
+    for (int i = 0; i < 3; i++) {
+      (*A)[9 * e + 4 * i] += T(6.0);
+    }
+  }
+
+  using Mult = OpCost<MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, M, M, M>>;
+  reg.add(label("BatchMatMatMult", t, nelems), Mult::eval.flops * n,
+          27.0 * sizeof(T) * n, [A, B, C, nelems](index_t niters) {
+            for (index_t i = 0; i < niters; i++) {
+              for (index_t e = 0; e < nelems; e++) {
+                MatMatMultCore<T, 3, 3, 3, 3, 3, 3>(
+                    &(*A)[9 * e], &(*B)[9 * e], &(*C)[9 * e]);
+              }
+              ClobberMemory();
+            }
+          });
+
+  using Inv = OpCost<MatInvExpr<M, M>>;
+  reg.add(label("BatchMatInv", t, nelems), Inv::eval.flops * n,
+          18.0 * sizeof(T) * n, [A, C, nelems](index_t niters) {
+            for (index_t i = 0; i < niters; i++) {
+              for (index_t e = 0; e < nelems; e++) {
+                MatInvCore<T, 3>(&(*A)[9 * e], &(*C)[9 * e]);
+              }
+              ClobberMemory();
+            }
+          });
+
+  // The product reads the point and the direction and writes the gradient
+  // and the product
+  using Stack = decltype(std::declval<StrainEnergy<T>&>().make_stack());
+  auto D = make_array<T>(9 * nelems);
+  reg.add(label("BatchStrainHProduct", t, nelems),
+          OpCost<Stack>::hproduct.flops * n, 36.0 * sizeof(T) * n,
+          [A, B, C, D, nelems](index_t niters) {
+            StrainEnergy<T> x;
+            auto stack = x.make_stack();
+            for (index_t i = 0; i < niters; i++) {
+              for (index_t e = 0; e < nelems; e++) {
+                T* ux = get_data(x.Ux.value());
+                T* px = get_data(x.Ux.pvalue());
+                for (int j = 0; j < 9; j++) {
+                  ux[j] = (*A)[9 * e + j];
+                  px[j] = (*B)[9 * e + j];
+                }
+                x.Ux.bvalue().zero();
+                x.Ux.hvalue().zero();
+                stack.eval();
+                stack.reset();
+                x.energy.bvalue() = T(1.0);
+                stack.hproduct();
+
+                const T* g = get_data(x.Ux.bvalue());
+                const T* h = get_data(x.Ux.hvalue());
+                for (int j = 0; j < 9; j++) {
+                  (*C)[9 * e + j] = g[j];
+                  (*D)[9 * e + j] = h[j];
+                }
+              }
+              ClobberMemory();
+            }
+          });
+}
+
+int main(int argc, char* argv[]) {
+  Registry reg;
+  add_batch<double>(reg, small_batch);
+  add_batch<float>(reg, small_batch);
+  add_batch<double>(reg, large_batch);
+  add_batch<float>(reg, large_batch);
+  return reg.run(argc, argv);
+}
@@ -0,0 +1,166 @@
+/*
+  Element residuals, Jacobian-vector products and Jacobians of an 8-node
+  hexahedron with 2 x 2 x 2 quadrature points. The point loop evaluates a
+  stack at each point and sums the weighted contributions by hand, while the
+  quadrature versions evaluate one stack over all the points with
+  Batch<T, 8> entries (a2dquadrature.h).
+*/
+
+#include <vector>
+
+#include "a2dbench.h"
+#include "a2dcore.h"
+#include "ad/a2dquadrature.h"
+
+using namespace A2D;
+using namespace A2D::Bench;
+
+using T = double;
+constexpr int nnodes = 8, dim = 3, NQ = 8;
+constexpr index_t nelems = 1 << 11;
+
+using Q = Batch<T, NQ>;
+using GeoType = Mat<T, nnodes, dim>;
+using StateType = Mat<T, nnodes, dim>;
+using JacType = Mat<T, nnodes * dim, nnodes * dim>;
+
+// Strain energy at the quadrature points in terms of the nodal displacements
+// U and the basis function gradients G
+template <typename S>
+struct Element {
+  A2DObj<Vec<S, 1>> data;
+  A2DObj<Mat<S, nnodes, dim>> G, U;
+  A2DObj<Mat<S, dim, dim>> Ux;
+  A2DObj<SymMat<S, dim>> E, Sx;
+  A2DObj<S> out;
+
+  auto make_stack() {
+    return MakeStack(MatMatMult<MatOp::TRANSPOSE, MatOp::NORMAL>(U, G, Ux),
+                     MatGreenStrain<GreenStrainType::NONLINEAR>(Ux, E),
+                     SymIsotropic(T(0.35), T(0.51), E, Sx),
+                     SymMatMultTrace(E, Sx, out));
+  }
+};
+
+struct Elements {
+  Elements()
+      : geo(NQ * nelems), state(nelems), p(nelems), res(nelems), jac(nelems) {
+    for (int q = 0; q < NQ; q++) {
+      weights[q] = 1.0;
+    }
+    for (index_t e = 0; e < nelems; e++) {
+      for (int q = 0; q < NQ; q++) {
+        randomize(get_data(geo[NQ * e + q]), GeoType::ncomp);
+      }
+      randomize(get_data(state[e]), StateType::ncomp);
+      randomize(get_data(p[e]), StateType::ncomp);
+    }
+  }
+
+  T weights[NQ];
+  std::vector<GeoType> geo;
+  std::vector<StateType> state, p, res;
+  std::vector<JacType> jac;
+};
+
+enum class Kernel { RESIDUAL, PRODUCT, JACOBIAN };
+
+// One stack per point, reused through eval() and reset()
+template <Kernel kernel>
+void point_loop(Elements& elems) {
+  Element<T> x;
+  auto stack = x.make_stack();
+  JacType jac_q;
+  StateType prod_q;
+  for (index_t e = 0; e < nelems; e++) {
+    elems.res[e].zero();
+    elems.jac[e].zero();
+    for (int q = 0; q < NQ; q++) {
+      x.G.value().copy(elems.geo[NQ * e + q]);
+      x.U.value().copy(elems.state[e]);
+      x.G.bvalue().zero();
+      x.U.bvalue().zero();
+      x.U.hvalue().zero();
+      stack.eval();
+      stack.reset();
+      x.out.bvalue() = elems.weights[q];
+
+      if constexpr (kernel == Kernel::RESIDUAL) {
+        stack.reverse();
+        for (int i = 0; i < StateType::ncomp; i++) {
+          elems.res[e][i] += x.U.bvalue()[i];
+        }
+      } else if constexpr (kernel == Kernel::PRODUCT) {
+        JacobianProduct<FEVarType::STATE, FEVarType::STATE>(
+            stack, x.data, x.G, x.U, elems.p[e], prod_q);
+        for (int i = 0; i < StateType::ncomp; i++) {
+          elems.res[e][i] += prod_q[i];
+        }
+      } else {
+        ExtractJacobian<FEVarType::STATE, FEVarType::STATE>(
+            stack, x.data, x.G, x.U, jac_q);
+        for (int i = 0; i < JacType::ncomp; i++) {
+          elems.jac[e][i] += jac_q[i];
+        }
+      }
+    }
+  }
+}
+
+// One stack over all the points of an element
+template <Kernel kernel>
+void quadrature(Elements& elems) {
+  Element<Q> x;
+  auto stack = x.make_stack();
+  const Q weights(elems.weights);
+  for (index_t e = 0; e < nelems; e++) {
+    for (int q = 0; q < NQ; q++) {
+      BatchSetLane(q, elems.geo[NQ * e + q], x.G.value());
+    }
+    x.U.value().copy(elems.state[e]);
+    x.G.bvalue().zero();
+    x.U.bvalue().zero();
+    x.U.hvalue().zero();
+    stack.eval();
+    stack.reset();
+    x.out.bvalue() = weights;
+
+    if constexpr (kernel == Kernel::RESIDUAL) {
+      QuadratureResidual<FEVarType::STATE>(stack, x.data, x.G, x.U,
+                                           elems.res[e]);
+    } else if constexpr (kernel == Kernel::PRODUCT) {
+      QuadratureJacobianProduct<FEVarType::STATE, FEVarType::STATE>(
+          stack, x.data, x.G, x.U, elems.p[e], elems.res[e]);
+    } else {
+      QuadratureExtractJacobian<FEVarType::STATE, FEVarType::STATE>(
+          stack, x.data, x.G, x.U, elems.jac[e]);
+    }
+  }
+}
+
+template <Kernel kernel>
+void add_kernels(Registry& reg, const std::string& name,
+                 std::shared_ptr<Elements> elems) {
+  reg.add(label("PointLoop::" + name, nelems), 0.0, [=](index_t niters) {
+    for (index_t i = 0; i < niters; i++) {
+      point_loop<kernel>(*elems);
+      ClobberMemory();
+    }
+  });
+  reg.add(label("Quadrature::" + name, nelems), 0.0, [=](index_t niters) {
+    for (index_t i = 0; i < niters; i++) {
+      quadrature<kernel>(*elems);
+      ClobberMemory();
+    }
+  });
+}
+
+int main(int argc, char* argv[]) {
+  auto elems = std::make_shared<Elements>();
+
+  Registry reg;
+  add_kernels<Kernel::RESIDUAL>(reg, "residual", elems);
+  add_kernels<Kernel::PRODUCT>(reg, "product", elems);
+  add_kernels<Kernel::JACOBIAN>(reg, "jacobian", elems);
+  return reg.run(argc, argv);
+}
@@ -0,0 +1,57 @@
+"""
+Compare two benchmark JSON files written with the --json option.
+
+Usage:
+    python compare.py baseline.json new.json [--threshold 0.05]
+
+Prints the change in ns/op for every benchmark present in both files and
+returns a non-zero exit code when any benchmark is slower than the baseline by
+more than the threshold (relative change).
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(filename):
+    with open(filename, "r") as fp:
+        data = json.load(fp)
+    return {b["name"]: b for b in data["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline")
+    parser.add_argument("new")
+    parser.add_argument("--threshold", type=float, default=0.05)
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    new = load(args.new)
+
+    regressions = 0
+    print("%-56s %12s %12s %8s" % ("benchmark", "base ns/op", "new ns/op", "change"))
+    for name in sorted(base.keys() & new.keys()):
+        t0 = base[name]["ns_per_op"]
+        t1 = new[name]["ns_per_op"]
+        change = (t1 - t0) / t0
+        flag = ""
+        if change > args.threshold:
+            flag = "  <-- slower"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  faster"
+        print("%-56s %12.3f %12.3f %+7.1f%%%s" % (name, t0, t1, 100.0 * change, flag))
+
+    for name in sorted(base.keys() - new.keys()):
+        print("%-56s missing from %s" % (name, args.new))
+
+    if regressions:
+        print("%d benchmark(s) slower by more than %.1f%%" % (regressions, 100.0 * args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
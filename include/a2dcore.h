@@ -3,6 +3,8 @@
 
 // Key objects
 
+#include "ad/a2dbatch.h"
+#include "ad/a2dhyperdual.h"
 #include "ad/a2dmat.h"
 #include "ad/a2dobj.h"
 #include "ad/a2dstack.h"
@@ -31,4 +33,8 @@
 #include "ad/a2dvecouter.h"
 #include "ad/a2dvecsum.h"
 
+// Cost model
+
+#include "ad/a2dcost.h"
+
 #endif  //  A2D_CORE_H
@@ -5,6 +5,8 @@
 #include <cmath>
 #include <complex>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
 
 #ifndef __CUDACC__
 template <typename T>
@@ -27,6 +29,15 @@ using A2D_complex_t = cuda::std::complex<T>;
 #endif
 #endif
 
+// Qualifier for pointers to arrays that do not overlap any other array
+#ifndef A2D_RESTRICT
+#ifdef _MSC_VER
+#define A2D_RESTRICT __restrict
+#else
+#define A2D_RESTRICT __restrict__
+#endif
+#endif
+
 namespace A2D {
 
 /**
@@ -89,6 +100,17 @@ struct is_complex : public std::false_type {};
 template <typename T>
 struct is_complex<A2D_complex_t<T>> : public std::true_type {};
 
+/**
+ * @brief Check if a type is a Batch of lanes. The specialization is in
+ * ad/a2dbatch.h, so that the core kernels can test for batches without
+ * including it.
+ */
+template <class>
+struct is_batch : std::false_type {};
+
+template <class X>
+inline constexpr bool is_batch_v = is_batch<X>::value;
+
 /*
  Convert scalar value to printf-able format
 */
@@ -115,6 +137,14 @@ A2D_FUNCTION inline double absfunc(double a) {
   }
 }
 
+A2D_FUNCTION inline double absfunc(float a) {
+  if (a >= 0.0f) {
+    return a;
+  } else {
+    return -a;
+  }
+}
+
 A2D_FUNCTION inline double RealPart(double a) { return a; }
 
 A2D_FUNCTION inline double RealPart(A2D_complex_t<double> a) {
@@ -127,6 +157,51 @@ A2D_FUNCTION inline double ImagPart(A2D_complex_t<double> a) {
   return a.imag();
 }
 
+/*
+  The type used for the sums of the reductions (matrix and vector products,
+  traces) and for the factorizations (determinants, inverses, LU and the
+  tridiagonal reduction of the eigensolver) of values of type T.
+
+  By default this is T itself. When A2D_MIXED_PRECISION is defined, float
+  values and seeds are accumulated in double: the storage stays float, which
+  halves the memory traffic of the element data, while the results are
+  rounded to float only once. Short closed forms and elementwise kernels are
+  evaluated in T.
+*/
+template <typename T>
+struct accum_type {
+  using type = T;
+};
+
+#ifdef A2D_MIXED_PRECISION
+template <>
+struct accum_type<float> {
+  using type = double;
+};
+#endif  // A2D_MIXED_PRECISION
+
+template <typename T>
+using accum_t = typename accum_type<T>::type;
+
+// Is T accumulated in a wider type
+template <typename T>
+struct is_mixed_precision
+    : std::integral_constant<bool, !std::is_same<accum_t<T>, T>::value> {};
+
+// Promote a value to its accumulation type
+template <typename T>
+A2D_FUNCTION accum_t<T> accum(const T &value) {
+  return accum_t<T>(value);
+}
+
+// Copy an array into an array of another numeric type
+template <int size, typename T, typename R>
+A2D_FUNCTION void ConvertCopyCore(const T src[], R dest[]) {
+  for (int i = 0; i < size; i++) {
+    dest[i] = static_cast<R>(src[i]);
+  }
+}
+
 /*
   Remove the const-ness and references for a type
 */
@@ -134,6 +209,120 @@ template <class T>
 struct remove_const_and_refs
     : std::remove_const<typename std::remove_reference<T>::type> {};
 
+/*
+  Compile-time unrolled loops
+
+  Unroll<N>(f) calls f(i) for i = 0, ..., N - 1, where i is an
+  std::integral_constant<int, i>. The index converts to int, so the body is
+  written as for an ordinary loop, but every index expression in it is a
+  constant and the loop is fully unrolled without any index arithmetic at
+  run time. Loops longer than A2D_MAX_UNROLL iterations are run as ordinary
+  loops with an int index instead, so the body must be a generic callable
+  (e.g. a lambda taking auto).
+*/
+#ifndef A2D_MAX_UNROLL
+#define A2D_MAX_UNROLL 32
+#endif
+
+template <class Func, int... I>
+A2D_FUNCTION constexpr void __unroll(Func &&f,
+                                     std::integer_sequence<int, I...>) {
+  (f(std::integral_constant<int, I>()), ...);
+}
+
+template <int N, class Func>
+A2D_FUNCTION constexpr void Unroll(Func &&f) {
+  if constexpr (N <= A2D_MAX_UNROLL) {
+    __unroll(f, std::make_integer_sequence<int, N>());
+  } else {
+    for (int i = 0; i < N; i++) {
+      f(i);
+    }
+  }
+}
+
+// Unrolled loop over the entries of an M x N matrix: f(i, j) in row order
+template <int M, int N, class Func>
+A2D_FUNCTION constexpr void Unroll(Func &&f) {
+  if constexpr (M * N <= A2D_MAX_UNROLL) {
+    Unroll<M>([&](auto i) { Unroll<N>([&](auto j) { f(i, j); }); });
+  } else {
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++) {
+        f(i, j);
+      }
+    }
+  }
+}
+
+// Unrolled loop over the lower triangle of an N x N matrix: f(i, j) for
+// j <= i, in the order of the packed storage of SymMat
+template <int N, class Func>
+A2D_FUNCTION constexpr void UnrollLower(Func &&f) {
+  if constexpr (N * (N + 1) / 2 <= A2D_MAX_UNROLL) {
+    Unroll<N>([&](auto i) {
+      Unroll<decltype(i)::value + 1>([&](auto j) { f(i, j); });
+    });
+  } else {
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j <= i; j++) {
+        f(i, j);
+      }
+    }
+  }
+}
+
+/*
+  Largest size of the kernels generated by python/a2dcodegen.py (in
+  include/ad/core/generated). The cores use them for N <= A2D_MAX_GEN_SIZE,
+  the generator reads the size from here.
+*/
+#define A2D_MAX_GEN_SIZE 4
+
+/*
+  Largest size of the generated inverses. Cofactor expansion is not backward
+  stable, so the larger inverses use the LU factorization with partial
+  pivoting instead.
+*/
+#define A2D_MAX_GEN_INV_SIZE 3
+
+/*
+  Index of entry (i, j) of a symmetric N x N matrix in the packed storage of
+  its lower triangle (see SymMat)
+
+  The indices of all the entries are held in a table that is computed at
+  compile time, so that the lookup is a single load at N * i + j with no
+  branch, and folds to a constant when i and j are constants.
+*/
+A2D_FUNCTION constexpr int __sym_mat_index(int i, int j) {
+  return i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2;
+}
+
+template <int N>
+struct __sym_mat_index_table {
+  constexpr __sym_mat_index_table() : index() {
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j < N; j++) {
+        index[N * i + j] = __sym_mat_index(i, j);
+      }
+    }
+  }
+  int index[N * N];
+};
+
+template <int N>
+inline constexpr __sym_mat_index_table<N> sym_mat_index_table = {};
+
+template <int N>
+A2D_FUNCTION constexpr int SymMatIndex(int i, int j) {
+#ifdef __CUDA_ARCH__
+  // Host tables are not visible from device code
+  return __sym_mat_index(i, j);
+#else
+  return sym_mat_index_table<N>.index[N * i + j];
+#endif
+}
+
 /*
   Check if a type is numeric or not - this includes complex numbers
 */
@@ -207,11 +396,21 @@ struct __get_a2d_object_type {
   static constexpr ADObjType value = T::obj_type;
 };
 
+template <>
+struct __get_a2d_object_type<float> {
+  static constexpr ADObjType value = ADObjType::SCALAR;
+};
+
 template <>
 struct __get_a2d_object_type<double> {
   static constexpr ADObjType value = ADObjType::SCALAR;
 };
 
+template <>
+struct __get_a2d_object_type<A2D_complex_t<float>> {
+  static constexpr ADObjType value = ADObjType::SCALAR;
+};
+
 template <>
 struct __get_a2d_object_type<A2D_complex_t<double>> {
   static constexpr ADObjType value = ADObjType::SCALAR;
@@ -342,6 +541,27 @@ A2D_FUNCTION T acos(T val) {
 #endif
 }
 
+/*
+  Branch-free selection: x when the real part of a is less than the real part
+  of b, y otherwise. The selected operand is returned as a whole, so that
+  complex-step and hyper-dual derivatives follow it. Batch (a2dbatch.h)
+  selects lane by lane, since comparisons of batches are not defined.
+*/
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T select_less(const T &a, const T &b, const T &x, const T &y) {
+  return RealPart(a) < RealPart(b) ? x : y;
+}
+
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T fmin(const T &a, const T &b) {
+  return select_less(b, a, b, a);
+}
+
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T fmax(const T &a, const T &b) {
+  return select_less(a, b, b, a);
+}
+
 template <class ForwardIt, class T>
 A2D_FUNCTION void fill(ForwardIt first, ForwardIt last, const T &value) {
 #ifdef __CUDACC__
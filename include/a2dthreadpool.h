@@ -0,0 +1,191 @@
+#ifndef A2D_THREAD_POOL_H
+#define A2D_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "a2ddefs.h"
+
+namespace A2D {
+
+// Size of a cache line used to pad data owned by different threads
+static constexpr std::size_t A2D_CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Persistent pool of worker threads with work-stealing loops
+ *
+ * The calling thread participates as thread 0, so a pool with nthreads
+ * threads starts nthreads - 1 workers. Loops are split into chunks and each
+ * thread is initially assigned a contiguous range of chunks. A thread takes
+ * chunks from the front of its own range and, once that is exhausted, steals
+ * chunks from the ranges of the other threads. The chunk counters of each
+ * thread are padded to a full cache line so that threads do not falsely
+ * share them.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @brief Function executed on the chunk [start, end) by thread thread_id
+   */
+  using ChunkFunc = std::function<void(int, index_t, index_t)>;
+
+  /**
+   * @brief Create the thread pool
+   *
+   * @param nthreads Number of threads (including the calling thread). If
+   * nthreads <= 0, use the number of hardware threads.
+   */
+  explicit ThreadPool(int nthreads = 0) {
+    if (nthreads <= 0) {
+      nthreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = nthreads;
+    ranges = std::vector<Range>(num_threads);
+
+    for (int i = 1; i < num_threads; i++) {
+      workers.emplace_back([this, i]() { worker(i); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      shutdown = true;
+      generation++;
+    }
+    start_cv.notify_all();
+    for (auto& w : workers) {
+      w.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  int get_num_threads() const { return num_threads; }
+
+  /**
+   * @brief Execute func(thread_id, start, end) over the chunks of [0, size)
+   *
+   * Each chunk is executed exactly once. The call returns when all chunks
+   * have been executed.
+   *
+   * @param size Number of loop iterations
+   * @param chunk_size Number of iterations per chunk (<= 0 selects a default
+   * of roughly eight chunks per thread)
+   * @param func Function called with the thread index and the chunk range
+   */
+  void parallel_for(index_t size, index_t chunk_size, const ChunkFunc& func) {
+    if (size <= 0) {
+      return;
+    }
+    if (chunk_size <= 0) {
+      chunk_size = std::max<index_t>(1, size / (8 * num_threads));
+    }
+
+    if (num_threads == 1 || size <= chunk_size) {
+      func(0, 0, size);
+      return;
+    }
+
+    // Assign a contiguous range of chunks to each thread
+    index_t nchunks = (size + chunk_size - 1) / chunk_size;
+    for (int i = 0; i < num_threads; i++) {
+      ranges[i].next.store((i * nchunks) / num_threads,
+                           std::memory_order_relaxed);
+      ranges[i].end = ((i + 1) * nchunks) / num_threads;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      job = &func;
+      job_size = size;
+      job_chunk = chunk_size;
+      active = num_threads - 1;
+      generation++;
+    }
+    start_cv.notify_all();
+
+    run(0);
+
+    // Wait for the workers to finish
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [this]() { return active == 0; });
+    job = nullptr;
+  }
+
+ private:
+  // Chunk counters owned by one thread, padded to avoid false sharing
+  struct alignas(A2D_CACHE_LINE_SIZE) Range {
+    std::atomic<index_t> next{0};
+    index_t end = 0;
+  };
+
+  int num_threads;
+  std::vector<Range> ranges;
+  std::vector<std::thread> workers;
+
+  // Synchronization for starting and completing jobs
+  std::mutex mutex;
+  std::condition_variable start_cv, done_cv;
+  std::size_t generation = 0;
+  bool shutdown = false;
+  int active = 0;
+
+  // The current job
+  const ChunkFunc* job = nullptr;
+  index_t job_size = 0;
+  index_t job_chunk = 0;
+
+  // Execute the chunks of the current job from thread tid
+  void run(int tid) {
+    const ChunkFunc& func = *job;
+
+    // Process the chunks of the own range first, then steal from the others
+    for (int k = 0; k < num_threads; k++) {
+      Range& range = ranges[(tid + k) % num_threads];
+      while (true) {
+        index_t chunk = range.next.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= range.end) {
+          break;
+        }
+        index_t start = chunk * job_chunk;
+        index_t end = std::min(job_size, start + job_chunk);
+        func(tid, start, end);
+      }
+    }
+  }
+
+  void worker(int tid) {
+    std::size_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        start_cv.wait(lock, [&]() { return generation != seen; });
+        seen = generation;
+        if (shutdown) {
+          return;
+        }
+      }
+
+      run(tid);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        active--;
+        if (active == 0) {
+          done_cv.notify_one();
+        }
+      }
+    }
+  }
+};
+
+}  // namespace A2D
+
+#endif  // A2D_THREAD_POOL_H
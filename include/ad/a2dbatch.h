@@ -0,0 +1,386 @@
+#ifndef A2D_BATCH_H
+#define A2D_BATCH_H
+
+#include <type_traits>
+
+#include "../a2ddefs.h"
+#include "a2dmat.h"
+#include "a2dvec.h"
+
+/*
+  Width of the vector registers targeted by Batch, in bytes. The default is
+  taken from the instruction set the translation unit is compiled for and may
+  be overridden by defining A2D_SIMD_BYTES before including this header.
+*/
+#ifndef A2D_SIMD_BYTES
+#if defined(__AVX512F__)
+#define A2D_SIMD_BYTES 64
+#elif defined(__AVX__)
+#define A2D_SIMD_BYTES 32
+#else
+#define A2D_SIMD_BYTES 16
+#endif
+#endif
+
+// Use the GCC/Clang vector extensions for the lane storage when available
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__CUDACC__)
+#define A2D_BATCH_NATIVE_VECTOR
+#endif
+
+namespace A2D {
+
+/**
+ * @brief The default number of lanes of type T that fit in a vector register
+ */
+template <typename T>
+struct default_batch_width {
+  static constexpr int value =
+      (A2D_SIMD_BYTES >= int(sizeof(T)) ? A2D_SIMD_BYTES / int(sizeof(T)) : 1);
+};
+
+template <typename T, int W = default_batch_width<T>::value>
+class Batch;
+
+/*
+  Detection for the batch type (see is_batch in a2ddefs.h)
+*/
+template <class T, int W>
+struct is_batch<Batch<T, W>> : std::true_type {};
+
+// Number of lanes of a batch (one for any other type)
+template <class>
+struct batch_width {
+  static constexpr int value = 1;
+};
+template <class T, int W>
+struct batch_width<Batch<T, W>> {
+  static constexpr int value = W;
+};
+
+// A batch is a (vector-valued) numeric type
+template <class T, int W>
+struct __is_numeric_type<Batch<T, W>> : __is_numeric_type<T> {};
+
+template <class T, int W>
+struct __get_object_numeric_type<Batch<T, W>> {
+  using type = Batch<T, W>;
+};
+
+template <class T, int W>
+struct __get_a2d_object_type<Batch<T, W>> {
+  static constexpr ADObjType value = ADObjType::SCALAR;
+};
+
+/*
+  Scalar types that are broadcast to all lanes when mixed with a batch
+*/
+template <class R>
+struct __is_batch_broadcast_type {
+  static const bool value =
+      std::is_arithmetic<R>::value || is_complex<R>::value;
+};
+
+/*
+  Storage for the lanes. Arithmetic types use the compiler vector extensions
+  so that each operation maps to a single vector instruction, all other types
+  (e.g. complex) fall back to a plain array. So do batches wider than the
+  vector registers (A2D_SIMD_BYTES): the compiler would split their
+  operations anyway, and passing them by value has no stable ABI without the
+  wider instruction set (GCC -Wpsabi).
+*/
+template <typename T, int W, class Enable = void>
+struct __batch_storage {
+  static constexpr bool native = false;
+  static constexpr int alignment = alignof(T);
+  typedef T type[W];
+};
+
+#ifdef A2D_BATCH_NATIVE_VECTOR
+template <typename T, int W>
+struct __batch_storage<T, W,
+                       std::enable_if_t<std::is_arithmetic<T>::value &&
+                                        (W & (W - 1)) == 0 &&
+                                        W * sizeof(T) <= A2D_SIMD_BYTES>> {
+  static constexpr bool native = true;
+  static constexpr int alignment = W * sizeof(T);
+  typedef T type __attribute__((vector_size(W * sizeof(T))));
+};
+#endif
+
+/**
+ * @brief Structure-of-arrays scalar that holds W independent values (lanes).
+ *
+ * Every arithmetic operation is applied lane by lane, so that a Mat, SymMat or
+ * Vec instantiated with Batch<T, W> entries stores W matrices in
+ * structure-of-arrays layout. The *Core kernels, which are templated on the
+ * scalar type, then process W elements per call with vector instructions.
+ *
+ * Only branch-free code can be batched: comparisons between batches are not
+ * defined.
+ *
+ * @tparam T the underlying numeric type
+ * @tparam W the number of lanes
+ */
+template <typename T, int W>
+class alignas(__batch_storage<T, W>::alignment) Batch {
+ public:
+  static_assert(W >= 1, "Batch width must be positive");
+
+  using value_type = T;
+  static constexpr int width = W;
+  static constexpr bool native = __batch_storage<T, W>::native;
+  typedef typename __batch_storage<T, W>::type storage_t;
+
+  A2D_FUNCTION Batch() {}
+
+  // Broadcast constructor (sets all lanes to the same value)
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION Batch(const R r) {
+    if constexpr (native) {
+      v = storage_t{} + T(r);
+    } else {
+      for (int i = 0; i < W; i++) {
+        v[i] = T(r);
+      }
+    }
+  }
+
+  // Load the lanes from an array
+  A2D_FUNCTION explicit Batch(const T* vals) {
+    for (int i = 0; i < W; i++) {
+      (*this)[i] = vals[i];
+    }
+  }
+
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION Batch& operator=(const R r) {
+    return *this = Batch(r);
+  }
+
+  // Access individual lanes
+  template <typename I>
+  A2D_FUNCTION T& operator[](const I i) {
+    return reinterpret_cast<T*>(&v)[i];
+  }
+  template <typename I>
+  A2D_FUNCTION const T& operator[](const I i) const {
+    return reinterpret_cast<const T*>(&v)[i];
+  }
+
+  // Operator +=, -=, *=, /=
+  A2D_FUNCTION Batch& operator+=(const Batch& r) {
+    if constexpr (native) {
+      v += r.v;
+    } else {
+      for (int i = 0; i < W; i++) {
+        v[i] += r.v[i];
+      }
+    }
+    return *this;
+  }
+  A2D_FUNCTION Batch& operator-=(const Batch& r) {
+    if constexpr (native) {
+      v -= r.v;
+    } else {
+      for (int i = 0; i < W; i++) {
+        v[i] -= r.v[i];
+      }
+    }
+    return *this;
+  }
+  A2D_FUNCTION Batch& operator*=(const Batch& r) {
+    if constexpr (native) {
+      v *= r.v;
+    } else {
+      for (int i = 0; i < W; i++) {
+        v[i] *= r.v[i];
+      }
+    }
+    return *this;
+  }
+  A2D_FUNCTION Batch& operator/=(const Batch& r) {
+    if constexpr (native) {
+      v /= r.v;
+    } else {
+      for (int i = 0; i < W; i++) {
+        v[i] /= r.v[i];
+      }
+    }
+    return *this;
+  }
+
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION Batch& operator+=(const R r) {
+    return *this += Batch(r);
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION Batch& operator-=(const R r) {
+    return *this -= Batch(r);
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION Batch& operator*=(const R r) {
+    return *this *= Batch(r);
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION Batch& operator/=(const R r) {
+    return *this /= Batch(r);
+  }
+
+  A2D_FUNCTION Batch operator-() const {
+    Batch out;
+    if constexpr (native) {
+      out.v = -v;
+    } else {
+      for (int i = 0; i < W; i++) {
+        out.v[i] = -v[i];
+      }
+    }
+    return out;
+  }
+  A2D_FUNCTION Batch operator+() const { return *this; }
+
+  storage_t v;
+};
+
+#define A2D_BATCH_BINARY_OPERATOR(OP, COMPOUND_OP)                          \
+  template <typename T, int W>                                              \
+  A2D_FUNCTION inline Batch<T, W> operator OP(const Batch<T, W>& l,         \
+                                              const Batch<T, W>& r) {       \
+    Batch<T, W> out(l);                                                     \
+    return out COMPOUND_OP r;                                               \
+  }                                                                         \
+  template <typename T, int W, typename R,                                  \
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> =   \
+                true>                                                       \
+  A2D_FUNCTION inline Batch<T, W> operator OP(const Batch<T, W>& l,         \
+                                              const R r) {                  \
+    Batch<T, W> out(l);                                                     \
+    return out COMPOUND_OP Batch<T, W>(r);                                  \
+  }                                                                         \
+  template <typename T, int W, typename R,                                  \
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> =   \
+                true>                                                       \
+  A2D_FUNCTION inline Batch<T, W> operator OP(const R l,                    \
+                                              const Batch<T, W>& r) {       \
+    Batch<T, W> out(l);                                                     \
+    return out COMPOUND_OP r;                                               \
+  }
+
+A2D_BATCH_BINARY_OPERATOR(+, +=)
+A2D_BATCH_BINARY_OPERATOR(-, -=)
+A2D_BATCH_BINARY_OPERATOR(*, *=)
+A2D_BATCH_BINARY_OPERATOR(/, /=)
+
+#undef A2D_BATCH_BINARY_OPERATOR
+
+/*
+  Lane-wise math functions
+*/
+#define A2D_BATCH_UNARY_FUNCTION(FUNCNAME, STDFUNC)                   \
+  template <typename T, int W>                                        \
+  A2D_FUNCTION inline Batch<T, W> FUNCNAME(const Batch<T, W>& a) {    \
+    Batch<T, W> out;                                                  \
+    for (int i = 0; i < W; i++) {                                     \
+      out[i] = STDFUNC(a[i]);                                         \
+    }                                                                 \
+    return out;                                                       \
+  }
+
+A2D_BATCH_UNARY_FUNCTION(fabs, std::fabs)
+A2D_BATCH_UNARY_FUNCTION(sqrt, std::sqrt)
+A2D_BATCH_UNARY_FUNCTION(exp, std::exp)
+A2D_BATCH_UNARY_FUNCTION(log, std::log)
+A2D_BATCH_UNARY_FUNCTION(sin, std::sin)
+A2D_BATCH_UNARY_FUNCTION(asin, std::asin)
+A2D_BATCH_UNARY_FUNCTION(cos, std::cos)
+A2D_BATCH_UNARY_FUNCTION(acos, std::acos)
+
+#undef A2D_BATCH_UNARY_FUNCTION
+
+template <typename T, int W, typename R,
+          std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+A2D_FUNCTION inline Batch<T, W> pow(const Batch<T, W>& a, R exponent) {
+  Batch<T, W> out;
+  for (int i = 0; i < W; i++) {
+    out[i] = std::pow(a[i], exponent);
+  }
+  return out;
+}
+
+// Lane-wise select_less (see a2ddefs.h)
+template <typename T, int W>
+A2D_FUNCTION inline Batch<T, W> select_less(const Batch<T, W>& a,
+                                            const Batch<T, W>& b,
+                                            const Batch<T, W>& x,
+                                            const Batch<T, W>& y) {
+  Batch<T, W> out;
+  for (int i = 0; i < W; i++) {
+    out[i] = RealPart(a[i]) < RealPart(b[i]) ? x[i] : y[i];
+  }
+  return out;
+}
+
+/*
+  Batched versions of the matrix and vector objects. Entry (i, j) of the
+  batched matrix holds entry (i, j) of W independent matrices.
+*/
+template <typename T, int M, int N, int W = default_batch_width<T>::value>
+using BatchMat = Mat<Batch<T, W>, M, N>;
+
+template <typename T, int N, int W = default_batch_width<T>::value>
+using BatchSymMat = SymMat<Batch<T, W>, N>;
+
+template <typename T, int N, int W = default_batch_width<T>::value>
+using BatchVec = Vec<Batch<T, W>, N>;
+
+/**
+ * @brief Copy an object into one lane of its batched counterpart
+ *
+ * @param lane the lane index
+ * @param src the object (scalar, Vec, Mat or SymMat) to copy
+ * @param dest the batched object
+ */
+template <class Type, class BatchType>
+A2D_FUNCTION void BatchSetLane(const int lane, const Type& src,
+                               BatchType& dest) {
+  if constexpr (get_a2d_object_type<Type>::value == ADObjType::SCALAR) {
+    dest[lane] = src;
+  } else {
+    static_assert(Type::ncomp == BatchType::ncomp,
+                  "Batched and unbatched objects must have the same size");
+    for (int i = 0; i < Type::ncomp; i++) {
+      dest[i][lane] = src[i];
+    }
+  }
+}
+
+/**
+ * @brief Copy one lane of a batched object into its unbatched counterpart
+ *
+ * @param lane the lane index
+ * @param src the batched object
+ * @param dest the object (scalar, Vec, Mat or SymMat) to copy into
+ */
+template <class BatchType, class Type>
+A2D_FUNCTION void BatchGetLane(const int lane, const BatchType& src,
+                               Type& dest) {
+  if constexpr (get_a2d_object_type<Type>::value == ADObjType::SCALAR) {
+    dest = src[lane];
+  } else {
+    static_assert(Type::ncomp == BatchType::ncomp,
+                  "Batched and unbatched objects must have the same size");
+    for (int i = 0; i < Type::ncomp; i++) {
+      dest[i] = src[i][lane];
+    }
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_BATCH_H
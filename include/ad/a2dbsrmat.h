@@ -0,0 +1,356 @@
+#ifndef A2D_BSR_MAT_H
+#define A2D_BSR_MAT_H
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "../a2ddefs.h"
+#include "../a2dthreadpool.h"
+#include "a2dmat.h"
+
+namespace A2D {
+
+/*
+  Global block-sparse matrices assembled from element matrices.
+
+  The meshes are described by an element-to-node connectivity with a fixed
+  number of nodes per element, stored element by element:
+
+    conn[nodes_per_elem * e + i] = i-th node of element e
+
+  Each node carries M degrees of freedom, so the global matrix is made of
+  M x M blocks, one for each pair of nodes that share an element. The element
+  matrices are ordered node by node: the row M * i + k of the element matrix
+  is the degree of freedom k of the i-th node of the element. This is the
+  order of ExtractJacobian for a Mat<T, nodes_per_elem, M> state.
+*/
+
+namespace detail {
+
+// Compute the elements that contain each node: the elements of node n are
+// node_elems[node_ptr[n]:node_ptr[n + 1]]
+inline void NodeToElements(index_t nnodes, index_t nelems,
+                           index_t nodes_per_elem, const index_t conn[],
+                           std::vector<index_t>& node_ptr,
+                           std::vector<index_t>& node_elems) {
+  node_ptr.assign(nnodes + 1, 0);
+  for (index_t i = 0; i < nelems * nodes_per_elem; i++) {
+    node_ptr[conn[i] + 1]++;
+  }
+  for (index_t n = 0; n < nnodes; n++) {
+    node_ptr[n + 1] += node_ptr[n];
+  }
+  node_elems.resize(node_ptr[nnodes]);
+  std::vector<index_t> pos(node_ptr.begin(), node_ptr.end() - 1);
+  for (index_t e = 0; e < nelems; e++) {
+    for (index_t i = 0; i < nodes_per_elem; i++) {
+      node_elems[pos[conn[nodes_per_elem * e + i]]++] = e;
+    }
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Partition of the elements into colors such that no two elements of
+ * the same color share a node
+ *
+ * The elements of one color can be assembled concurrently without atomics,
+ * since they write to disjoint block rows. The colors are found with a
+ * greedy first-fit pass over the elements.
+ */
+class ElementColoring {
+ public:
+  /**
+   * @brief Color the elements of a mesh
+   *
+   * @param nnodes Number of nodes
+   * @param nelems Number of elements
+   * @param nodes_per_elem Number of nodes per element
+   * @param conn Element-to-node connectivity
+   */
+  ElementColoring(index_t nnodes, index_t nelems, index_t nodes_per_elem,
+                  const index_t conn[])
+      : color(nelems, NO_INDEX) {
+    std::vector<index_t> node_ptr, node_elems;
+    detail::NodeToElements(nnodes, nelems, nodes_per_elem, conn, node_ptr,
+                           node_elems);
+
+    // Give each element the smallest color not used by a colored neighbor.
+    // mark[c] == e when color c is taken by a neighbor of e.
+    std::vector<index_t> mark;
+    index_t ncolors = 0;
+    for (index_t e = 0; e < nelems; e++) {
+      for (index_t i = 0; i < nodes_per_elem; i++) {
+        index_t n = conn[nodes_per_elem * e + i];
+        for (index_t k = node_ptr[n]; k < node_ptr[n + 1]; k++) {
+          index_t c = color[node_elems[k]];
+          if (c != NO_INDEX) {
+            mark[c] = e;
+          }
+        }
+      }
+      index_t c = 0;
+      while (c < ncolors && mark[c] == e) {
+        c++;
+      }
+      if (c == ncolors) {
+        ncolors++;
+        mark.push_back(NO_INDEX);
+      }
+      color[e] = c;
+    }
+
+    // Sort the elements by color
+    color_ptr.assign(ncolors + 1, 0);
+    for (index_t e = 0; e < nelems; e++) {
+      color_ptr[color[e] + 1]++;
+    }
+    for (index_t c = 0; c < ncolors; c++) {
+      color_ptr[c + 1] += color_ptr[c];
+    }
+    elems.resize(nelems);
+    std::vector<index_t> pos(color_ptr.begin(), color_ptr.end() - 1);
+    for (index_t e = 0; e < nelems; e++) {
+      elems[pos[color[e]]++] = e;
+    }
+  }
+
+  index_t get_num_colors() const { return color_ptr.size() - 1; }
+
+  /**
+   * @brief Execute func(thread_id, e) for every element, one color at a time
+   *
+   * The elements of a color are split over the threads of the pool and the
+   * colors are executed in sequence, so concurrent calls never share a node.
+   *
+   * @param pool Thread pool
+   * @param func Function called with the thread index and the element index
+   * @param chunk_size Number of elements per chunk (<= 0 for the default)
+   */
+  template <class Func>
+  void parallel_for(ThreadPool& pool, const Func& func,
+                    index_t chunk_size = 0) const {
+    for (index_t c = 0; c < get_num_colors(); c++) {
+      const index_t* list = &elems[color_ptr[c]];
+      pool.parallel_for(color_ptr[c + 1] - color_ptr[c], chunk_size,
+                        [&](int tid, index_t start, index_t end) {
+                          for (index_t k = start; k < end; k++) {
+                            func(tid, list[k]);
+                          }
+                        });
+    }
+  }
+
+  std::vector<index_t> color;      // Color of each element
+  std::vector<index_t> color_ptr;  // Elements of color c are in
+  std::vector<index_t> elems;      // elems[color_ptr[c]:color_ptr[c + 1]]
+};
+
+/**
+ * @brief Square block compressed sparse row (BSR) matrix with M x M blocks
+ *
+ * The block columns of each block row are sorted. The blocks are stored as
+ * Mat<T, M, M> objects so that the core kernels apply directly to them.
+ *
+ * @tparam T Scalar type
+ * @tparam M Block size: the number of degrees of freedom per node
+ */
+template <typename T, int M>
+class BSRMat {
+ public:
+  using BlockType = Mat<T, M, M>;
+
+  /**
+   * @brief Create the nonzero pattern of the matrix from the connectivity
+   *
+   * Block (i, j) is nonzero when the nodes i and j share an element. The
+   * diagonal blocks are always included. The values are zero.
+   *
+   * @param nnodes Number of nodes (block rows and columns)
+   * @param nelems Number of elements
+   * @param nodes_per_elem Number of nodes per element
+   * @param conn Element-to-node connectivity
+   */
+  BSRMat(index_t nnodes, index_t nelems, index_t nodes_per_elem,
+         const index_t conn[])
+      : nbrows(nnodes), rowp(nnodes + 1, 0) {
+    std::vector<index_t> node_ptr, node_elems;
+    detail::NodeToElements(nnodes, nelems, nodes_per_elem, conn, node_ptr,
+                           node_elems);
+
+    // Collect the sorted, unique neighbors of each node. mark[j] == i when
+    // node j is already in row i.
+    std::vector<index_t> mark(nnodes, NO_INDEX);
+    for (index_t i = 0; i < nnodes; i++) {
+      index_t start = cols.size();
+      mark[i] = i;
+      cols.push_back(i);
+      for (index_t k = node_ptr[i]; k < node_ptr[i + 1]; k++) {
+        const index_t* nodes = &conn[nodes_per_elem * node_elems[k]];
+        for (index_t j = 0; j < nodes_per_elem; j++) {
+          if (mark[nodes[j]] != i) {
+            mark[nodes[j]] = i;
+            cols.push_back(nodes[j]);
+          }
+        }
+      }
+      std::sort(cols.begin() + start, cols.end());
+      rowp[i + 1] = cols.size();
+    }
+
+    vals.resize(cols.size());
+  }
+
+  index_t get_num_block_rows() const { return nbrows; }
+  index_t get_num_blocks() const { return cols.size(); }
+
+  /**
+   * @brief Zero the values, keeping the nonzero pattern
+   */
+  void zero() {
+    for (auto& block : vals) {
+      block.zero();
+    }
+  }
+
+  /**
+   * @brief Find the index of block (i, j) in vals
+   *
+   * @return The block index, or NO_INDEX if (i, j) is not in the pattern
+   */
+  index_t find_block(index_t i, index_t j) const {
+    if (i < 0 || i >= nbrows) {
+      return NO_INDEX;
+    }
+    auto begin = cols.begin() + rowp[i], end = cols.begin() + rowp[i + 1];
+    auto it = std::lower_bound(begin, end, j);
+    if (it == end || *it != j) {
+      return NO_INDEX;
+    }
+    return it - cols.begin();
+  }
+
+  /**
+   * @brief Add an element matrix to the blocks of its nodes
+   *
+   * Blocks that are not in the pattern (when the nodes do not belong to the
+   * connectivity used to create the matrix) are skipped.
+   *
+   * @param nodes The nodes of the element
+   * @param jac Element matrix, ordered node by node
+   * @return false if any block of the element is not in the pattern
+   */
+  template <class JacType>
+  bool add_element(const index_t nodes[], const JacType& jac) {
+    static_assert(JacType::nrows == JacType::ncols &&
+                      JacType::nrows % M == 0,
+                  "Element matrix size must be a multiple of the block size");
+    constexpr int nodes_per_elem = JacType::nrows / M;
+
+    bool found = true;
+    for (int i = 0; i < nodes_per_elem; i++) {
+      for (int j = 0; j < nodes_per_elem; j++) {
+        index_t jp = find_block(nodes[i], nodes[j]);
+        if (jp == NO_INDEX) {
+          found = false;
+          continue;
+        }
+        BlockType& block = vals[jp];
+        for (int k = 0; k < M; k++) {
+          for (int l = 0; l < M; l++) {
+            block(k, l) += jac(M * i + k, M * j + l);
+          }
+        }
+      }
+    }
+    return found;
+  }
+
+  /**
+   * @brief Add the element matrices of all elements
+   *
+   * The elements of each color are added concurrently. Elements of the same
+   * color share no node, so they write to disjoint block rows.
+   *
+   * @param pool Thread pool
+   * @param coloring Coloring of the elements of conn
+   * @param conn Element-to-node connectivity
+   * @param jac Array of element matrices, ordered node by node
+   * @param chunk_size Number of elements per chunk (<= 0 for the default)
+   * @return false if any element block is not in the pattern (see
+   * add_element)
+   */
+  template <class JacType>
+  bool add_values(ThreadPool& pool, const ElementColoring& coloring,
+                  const index_t conn[], const JacType jac[],
+                  index_t chunk_size = 0) {
+    constexpr int nodes_per_elem = JacType::nrows / M;
+    std::atomic<bool> found(true);
+    coloring.parallel_for(
+        pool,
+        [&](int tid, index_t e) {
+          if (!add_element(&conn[nodes_per_elem * e], jac[e])) {
+            found.store(false, std::memory_order_relaxed);
+          }
+        },
+        chunk_size);
+    return found.load();
+  }
+
+  /**
+   * @brief Compute y = A * x
+   *
+   * The block rows are split over the threads of the pool. The sums of each
+   * row are accumulated in accum_t<T>.
+   *
+   * @param pool Thread pool
+   * @param x Input vector of length M * nbrows
+   * @param y Output vector of length M * nbrows
+   * @param chunk_size Number of block rows per chunk (<= 0 for the default)
+   */
+  void mult(ThreadPool& pool, const T x[], T y[],
+            index_t chunk_size = 0) const {
+    pool.parallel_for(nbrows, chunk_size,
+                      [&](int tid, index_t start, index_t end) {
+                        mult_rows(start, end, x, y);
+                      });
+  }
+
+  /**
+   * @brief Compute y = A * x in serial
+   */
+  void mult(const T x[], T y[]) const { mult_rows(0, nbrows, x, y); }
+
+  index_t nbrows;              // Number of block rows and columns
+  std::vector<index_t> rowp;   // Row pointer
+  std::vector<index_t> cols;   // Block column indices
+  std::vector<BlockType> vals;  // Block values
+
+ private:
+  void mult_rows(index_t start, index_t end, const T x[], T y[]) const {
+    for (index_t i = start; i < end; i++) {
+      accum_t<T> yi[M];
+      for (int k = 0; k < M; k++) {
+        yi[k] = 0.0;
+      }
+      for (index_t jp = rowp[i]; jp < rowp[i + 1]; jp++) {
+        const BlockType& block = vals[jp];
+        const T* xj = &x[M * cols[jp]];
+        for (int k = 0; k < M; k++) {
+          for (int l = 0; l < M; l++) {
+            yi[k] += accum(block(k, l)) * accum(xj[l]);
+          }
+        }
+      }
+      for (int k = 0; k < M; k++) {
+        y[M * i + k] = yi[k];
+      }
+    }
+  }
+};
+
+}  // namespace A2D
+
+#endif  // A2D_BSR_MAT_H
@@ -0,0 +1,363 @@
+#ifndef A2D_COST_H
+#define A2D_COST_H
+
+#include "../a2ddefs.h"
+#include "a2dgemm.h"
+#include "a2dgreenstrain.h"
+#include "a2disotropic.h"
+#include "a2dmatdet.h"
+#include "a2dmatinv.h"
+#include "a2dmatsum.h"
+#include "a2dmattrace.h"
+#include "a2dmatvecmult.h"
+#include "a2dobj.h"
+#include "a2dstack.h"
+#include "a2dsymmatmulttrace.h"
+#include "a2dsymrk.h"
+#include "a2dsymsum.h"
+
+namespace A2D {
+
+/*
+  Compile-time cost model of the expressions and stacks
+
+  OpCost<Op> gives the number of floating point operations (a multiply-add
+  counts as two) and the number of bytes of the objects read or written by
+  eval(), forward(), reverse() and hreverse() of an expression, from the
+  dimensions and the activity encoded in its type. The first- and
+  second-order forward sweeps do the same work. The counts are rough: they
+  follow the structure of the kernels (number of matrix products, number of
+  arrays touched) rather than the exact instruction count, temporaries on
+  the stack are not counted and each array is counted once per sweep.
+
+  The operations are counted on the numeric type T of the expression: a
+  complex or Batch<T, W> operation is one operation, and the bytes include
+  sizeof(T). Expressions without a model have known == false and zero
+  costs.
+
+  OpCost<OperationStack<...>> sums the costs of the operations. Passive
+  operations only contribute to eval, and hproduct is the cost of a
+  Hessian-vector product: forward, reverse and hreverse.
+
+    using Cost = OpCost<decltype(stack)>;
+    constexpr double intensity = Cost::hproduct.intensity();
+*/
+struct OpCostCounts {
+  index_t flops;
+  index_t bytes;
+
+  // Floating point operations per byte
+  constexpr double intensity() const {
+    return bytes > 0 ? static_cast<double>(flops) / bytes : 0.0;
+  }
+
+  constexpr OpCostCounts operator+(const OpCostCounts& c) const {
+    return {flops + c.flops, bytes + c.bytes};
+  }
+};
+
+/**
+ * @brief Cost of an expression for each sweep, with the sizes in numbers of
+ * entries of type T
+ */
+template <typename T>
+struct OpCostModel {
+  static constexpr bool known = true;
+  static constexpr OpCostCounts counts(index_t flops, index_t entries) {
+    return {flops, entries * static_cast<index_t>(sizeof(T))};
+  }
+};
+
+template <class Op>
+struct OpCost {
+  static constexpr bool known = false;
+  static constexpr OpCostCounts eval = {0, 0};
+  static constexpr OpCostCounts forward = {0, 0};
+  static constexpr OpCostCounts reverse = {0, 0};
+  static constexpr OpCostCounts hreverse = {0, 0};
+};
+
+namespace detail {
+
+constexpr index_t is_active_diff(ADiffType t) {
+  return t == ADiffType::ACTIVE ? 1 : 0;
+}
+
+constexpr index_t sym_size(index_t N) { return N * (N + 1) / 2; }
+
+// The cost of a derivative sweep, which is skipped for passive operations
+template <class Op>
+constexpr OpCostCounts active_cost(OpCostCounts c) {
+  return is_passive_op<Op>::value ? OpCostCounts{0, 0} : c;
+}
+
+// Operations may be stored in a stack by reference
+template <class Op>
+using op_cost = OpCost<typename remove_const_and_refs<Op>::type>;
+
+}  // namespace detail
+
+// C = opA(A) * opB(B): one product for eval, one per active input for forward
+// and reverse, and two more for hreverse when both are active
+template <MatOp opA, MatOp opB, class Atype, class Btype, class Ctype>
+struct OpCost<MatMatMultExpr<opA, opB, Atype, Btype, Ctype>>
+    : OpCostModel<typename MatMatMultExpr<opA, opB, Atype, Btype, Ctype>::T> {
+  using Expr = MatMatMultExpr<opA, opB, Atype, Btype, Ctype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t a = detail::is_active_diff(Expr::adA);
+  static constexpr index_t b = detail::is_active_diff(Expr::adB);
+  static constexpr index_t sA = Expr::N * Expr::M, sB = Expr::K * Expr::L,
+                           sC = Expr::P * Expr::Q;
+  static constexpr index_t g =
+      2 * sC * (opA == MatOp::NORMAL ? Expr::M : Expr::N);
+
+  static constexpr OpCostCounts eval = counts(g, sA + sB + sC);
+  static constexpr OpCostCounts forward =
+      counts((a + b) * g, sC + (a + b) * (sA + sB));
+  static constexpr OpCostCounts reverse =
+      counts((a + b) * g, sC + a * (sB + 2 * sA) + b * (sA + 2 * sB));
+  static constexpr OpCostCounts hreverse =
+      counts((a + b + 2 * a * b) * g, sC + a * (sB + 2 * sA) +
+                                          b * (sA + 2 * sB) +
+                                          a * b * (sC + sA + sB));
+};
+
+// y = op(A) * x
+template <MatOp op, class Atype, class xtype, class ytype>
+struct OpCost<MatVecMultExpr<op, Atype, xtype, ytype>>
+    : OpCostModel<typename MatVecMultExpr<op, Atype, xtype, ytype>::T> {
+  using Expr = MatVecMultExpr<op, Atype, xtype, ytype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t a = detail::is_active_diff(Expr::adA);
+  static constexpr index_t b = detail::is_active_diff(Expr::adx);
+  static constexpr index_t sA = Expr::N * Expr::M, sx = Expr::K,
+                           sy = Expr::P;
+  static constexpr index_t g = 2 * sA;
+
+  static constexpr OpCostCounts eval = counts(g, sA + sx + sy);
+  static constexpr OpCostCounts forward =
+      counts((a + b) * g, sy + (a + b) * (sA + sx));
+  static constexpr OpCostCounts reverse =
+      counts((a + b) * g, sy + a * (sx + 2 * sA) + b * (sA + 2 * sx));
+  static constexpr OpCostCounts hreverse =
+      counts((a + b + 2 * a * b) * g, sy + a * (sx + 2 * sA) +
+                                          b * (sA + 2 * sx) +
+                                          a * b * (sy + sA + sx));
+};
+
+// B = A^{-1}: closed forms up to N = A2D_MAX_GEN_INV_SIZE and LU with
+// pivoting beyond, about 2 N^3 flops for the factorization and the inverse.
+// The derivatives take two N x N products for forward and reverse and eight
+// for hreverse.
+template <class Atype, class Btype>
+struct OpCost<MatInvExpr<Atype, Btype>>
+    : OpCostModel<typename MatInvExpr<Atype, Btype>::T> {
+  using Expr = MatInvExpr<Atype, Btype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t N = Expr::N;
+  static constexpr index_t a = detail::is_active_diff(Expr::adA);
+  static constexpr index_t s = N * N, g = 2 * N * N * N;
+
+  static constexpr OpCostCounts eval =
+      counts(N > A2D_MAX_GEN_INV_SIZE ? 2 * N * N * N
+             : N == 1                 ? 1
+             : N == 2                 ? 10
+                                      : 45,
+             2 * s);
+  static constexpr OpCostCounts forward = counts(a * 2 * g, s + a * 2 * s);
+  static constexpr OpCostCounts reverse = counts(a * 2 * g, a * 4 * s);
+  static constexpr OpCostCounts hreverse = counts(a * 8 * g, a * 6 * s);
+};
+
+// det(A) for N <= 4 from the generated cofactor expressions
+template <class Atype, class dtype>
+struct OpCost<MatDetExpr<Atype, dtype>>
+    : OpCostModel<typename MatDetExpr<Atype, dtype>::T> {
+  using Expr = MatDetExpr<Atype, dtype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t N = Expr::N;
+  static constexpr index_t a = detail::is_active_diff(Expr::adA);
+  static constexpr index_t s = N * N;
+
+  static constexpr OpCostCounts eval =
+      counts(N == 1 ? 0 : N == 2 ? 3 : N == 3 ? 14 : 42, s + 1);
+  static constexpr OpCostCounts forward =
+      counts(a * (N == 1 ? 0 : N == 2 ? 7 : N == 3 ? 44 : 128), 1 + a * 2 * s);
+  static constexpr OpCostCounts reverse =
+      counts(a * (N == 1 ? 1 : N == 2 ? 8 : N == 3 ? 45 : 146),
+             a * (3 * s + 1));
+  static constexpr OpCostCounts hreverse =
+      counts(a * (N == 1 ? 1 : N == 2 ? 16 : N == 3 ? 126 : 370),
+             a * (4 * s + 2));
+};
+
+// C = A + B
+template <class Atype, class Btype, class Ctype>
+struct OpCost<MatSumExpr<Atype, Btype, Ctype>>
+    : OpCostModel<typename MatSumExpr<Atype, Btype, Ctype>::T> {
+  using Expr = MatSumExpr<Atype, Btype, Ctype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t a = detail::is_active_diff(Expr::adA);
+  static constexpr index_t b = detail::is_active_diff(Expr::adB);
+  static constexpr index_t s = get_num_matrix_entries<Ctype>::size;
+
+  static constexpr OpCostCounts eval = counts(s, 3 * s);
+  static constexpr OpCostCounts forward = counts(s, (1 + a + b) * s);
+  static constexpr OpCostCounts reverse =
+      counts((a + b) * s, (1 + 2 * a + 2 * b) * s);
+  static constexpr OpCostCounts hreverse = reverse;
+};
+
+// C = alpha * A + beta * B
+template <class atype, class Atype, class btype, class Btype, class Ctype>
+struct OpCost<MatSumScaleExpr<atype, Atype, btype, Btype, Ctype>>
+    : OpCostModel<
+          typename MatSumScaleExpr<atype, Atype, btype, Btype, Ctype>::T> {
+  using Expr = MatSumScaleExpr<atype, Atype, btype, Btype, Ctype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t a = detail::is_active_diff(Expr::adA);
+  static constexpr index_t b = detail::is_active_diff(Expr::adB);
+  static constexpr index_t sa = detail::is_active_diff(Expr::ada);
+  static constexpr index_t sb = detail::is_active_diff(Expr::adb);
+  static constexpr index_t s = get_num_matrix_entries<Ctype>::size;
+
+  static constexpr OpCostCounts eval = counts(3 * s, 3 * s);
+  static constexpr OpCostCounts forward =
+      counts(2 * (a + b + sa + sb) * s, (1 + 2 * a + 2 * b) * s);
+  static constexpr OpCostCounts reverse =
+      counts(2 * (a + b + sa + sb) * s, (1 + 2 * a + 2 * b + sa + sb) * s);
+  static constexpr OpCostCounts hreverse =
+      counts(2 * (a + b + 2 * sa + 2 * sb) * s,
+             (2 + 3 * a + 3 * b + sa + sb) * s);
+};
+
+// S = alpha * (A + A^{T})
+template <class atype, class Atype, class Stype>
+struct OpCost<SymMatSumExpr<atype, Atype, Stype>>
+    : OpCostModel<typename SymMatSumExpr<atype, Atype, Stype>::T> {
+  using Expr = SymMatSumExpr<atype, Atype, Stype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t sA = Expr::M * Expr::K;
+  static constexpr index_t sS = detail::sym_size(Expr::N);
+
+  static constexpr OpCostCounts eval = counts(2 * sS, sA + sS);
+  static constexpr OpCostCounts forward = eval;
+  static constexpr OpCostCounts reverse = counts(2 * sA, sS + 2 * sA);
+  static constexpr OpCostCounts hreverse = reverse;
+};
+
+// S = op(A) * op(A)^{T}, each entry of S is a dot product of length K
+template <class Atype, class Stype, MatOp op>
+struct OpCost<SymMatRKExpr<Atype, Stype, op>>
+    : OpCostModel<typename SymMatRKExpr<Atype, Stype, op>::T> {
+  using Expr = SymMatRKExpr<Atype, Stype, op>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t P = Expr::P;
+  static constexpr index_t K = (op == MatOp::NORMAL ? Expr::K : Expr::N);
+  static constexpr index_t sA = Expr::N * Expr::K;
+  static constexpr index_t sS = detail::sym_size(P);
+
+  static constexpr OpCostCounts eval = counts(2 * K * sS, sA + sS);
+  static constexpr OpCostCounts forward = counts(4 * K * sS, 2 * sA + sS);
+  static constexpr OpCostCounts reverse = counts(2 * P * P * K, sS + 3 * sA);
+  static constexpr OpCostCounts hreverse =
+      counts(4 * P * P * K, 2 * sS + 4 * sA);
+};
+
+// S = 2 * mu * E + lambda * tr(E) * I
+template <class mutype, class lamtype, class Etype, class Stype>
+struct OpCost<SymIsotropicExpr<mutype, lamtype, Etype, Stype>>
+    : OpCostModel<
+          typename SymIsotropicExpr<mutype, lamtype, Etype, Stype>::T> {
+  using Expr = SymIsotropicExpr<mutype, lamtype, Etype, Stype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t N = Expr::N;
+  static constexpr index_t s = detail::sym_size(N);
+  static constexpr index_t c = detail::is_active_diff(Expr::mudiff) +
+                               detail::is_active_diff(Expr::lamdiff);
+
+  static constexpr OpCostCounts eval = counts(2 * s + 2 * N, 2 * s);
+  static constexpr OpCostCounts forward =
+      counts((2 + 2 * c) * s + 2 * N, 2 * s);
+  static constexpr OpCostCounts reverse =
+      counts((2 + 2 * c) * s + 2 * N, 3 * s);
+  static constexpr OpCostCounts hreverse =
+      counts((2 + 4 * c) * s + 2 * N, (3 + c) * s);
+};
+
+// d = tr(S * E)
+template <class Stype, class Etype, class dtype>
+struct OpCost<SymMatMultTraceExpr<Stype, Etype, dtype>>
+    : OpCostModel<typename SymMatMultTraceExpr<Stype, Etype, dtype>::T> {
+  using Expr = SymMatMultTraceExpr<Stype, Etype, dtype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t N = Expr::N;
+  static constexpr index_t s = detail::sym_size(N);
+
+  static constexpr OpCostCounts eval = counts(2 * N * N, 2 * s + 1);
+  static constexpr OpCostCounts forward = counts(4 * N * N, 4 * s + 1);
+  static constexpr OpCostCounts reverse = counts(4 * s, 6 * s + 1);
+  static constexpr OpCostCounts hreverse = counts(8 * s, 8 * s + 2);
+};
+
+// d = tr(A)
+template <class Atype, class dtype>
+struct OpCost<MatTraceExpr<Atype, dtype>>
+    : OpCostModel<typename MatTraceExpr<Atype, dtype>::T> {
+  using Expr = MatTraceExpr<Atype, dtype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t N = Expr::N;
+
+  static constexpr OpCostCounts eval = counts(N, N + 1);
+  static constexpr OpCostCounts forward = eval;
+  static constexpr OpCostCounts reverse = counts(N, 2 * N + 1);
+  static constexpr OpCostCounts hreverse = reverse;
+};
+
+// E = 0.5 * (U + U^{T}) for LINEAR, plus 0.5 * U^{T} * U for NONLINEAR
+template <GreenStrainType etype, class Utype, class Etype>
+struct OpCost<MatGreenStrainExpr<etype, Utype, Etype>>
+    : OpCostModel<typename MatGreenStrainExpr<etype, Utype, Etype>::T> {
+  using Expr = MatGreenStrainExpr<etype, Utype, Etype>;
+  using OpCostModel<typename Expr::T>::counts;
+  static constexpr index_t M = Expr::M, K = Expr::K;
+  static constexpr index_t n = (etype == GreenStrainType::NONLINEAR ? 1 : 0);
+  static constexpr index_t sU = M * K;
+  static constexpr index_t sE = detail::sym_size(Expr::N);
+
+  static constexpr OpCostCounts eval =
+      counts(2 * sE + n * 2 * M * sE, sU + sE);
+  static constexpr OpCostCounts forward =
+      counts(2 * sE + n * 4 * M * sE, (1 + n) * sU + sE);
+  static constexpr OpCostCounts reverse =
+      counts(2 * sU + n * 2 * M * K * K, sE + (2 + n) * sU);
+  static constexpr OpCostCounts hreverse =
+      counts(2 * sU + n * 4 * M * K * K, (1 + n) * sE + (2 + 2 * n) * sU);
+};
+
+// The total cost of the operations of a stack
+template <class... Operations>
+struct OpCost<OperationStack<Operations...>> {
+  // Are all the operations modelled
+  static constexpr bool known =
+      (true && ... && detail::op_cost<Operations>::known);
+
+  static constexpr OpCostCounts eval =
+      (OpCostCounts{0, 0} + ... + detail::op_cost<Operations>::eval);
+  static constexpr OpCostCounts forward =
+      (OpCostCounts{0, 0} + ... + detail::active_cost<Operations>(
+                                      detail::op_cost<Operations>::forward));
+  static constexpr OpCostCounts reverse =
+      (OpCostCounts{0, 0} + ... + detail::active_cost<Operations>(
+                                      detail::op_cost<Operations>::reverse));
+  static constexpr OpCostCounts hreverse =
+      (OpCostCounts{0, 0} + ... + detail::active_cost<Operations>(
+                                      detail::op_cost<Operations>::hreverse));
+
+  // A Hessian-vector product, hproduct()
+  static constexpr OpCostCounts hproduct = forward + reverse + hreverse;
+};
+
+}  // namespace A2D
+
+#endif  // A2D_COST_H
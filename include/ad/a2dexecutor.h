@@ -0,0 +1,171 @@
+#ifndef A2D_EXECUTOR_H
+#define A2D_EXECUTOR_H
+
+#include <memory>
+#include <vector>
+
+#include "../a2ddefs.h"
+#include "../a2dthreadpool.h"
+#include "a2dobj.h"
+#include "a2dstack.h"
+
+namespace A2D {
+
+/*
+  Batched, multithreaded execution of JacobianProduct and ExtractJacobian over
+  arrays of elements.
+
+  The stack is created by a user-provided builder callable with the signature
+
+    auto build(A2DObj<Data>& data, A2DObj<Geo>& geo, A2DObj<State>& state);
+
+  that returns the OperationStack for one element. The intermediate variables
+  referenced by the stack must be owned by the builder itself, typically as
+  init-captures of a mutable lambda, and the builder must set the seed of the
+  output (e.g. output.bvalue() = 1.0):
+
+    auto build = [E = A2DObj<SymMat<T, 3>>(), S = A2DObj<SymMat<T, 3>>(),
+                  out = A2DObj<T>()](auto& data, auto& geo,
+                                     auto& state) mutable {
+      out.bvalue() = 1.0;
+      return MakeStack(MatGreenStrain<GreenStrainType::LINEAR>(state, E),
+                       SymIsotropic(T(0.35), T(0.51), E, S),
+                       SymMatMultTrace(E, S, out));
+    };
+
+  Each thread works on a private copy of the builder and of the A2DObj
+  inputs, so that no intermediate is shared between threads. After each
+  element, the derivatives of the stack and of the inputs are zeroed so that
+  the private objects can be reused for the next element.
+*/
+
+namespace detail {
+
+// Thread-private copy of the builder and the inputs, padded to avoid false
+// sharing between threads
+template <class Builder, class Data, class Geo, class State>
+struct alignas(A2D_CACHE_LINE_SIZE) ExecutorThreadData {
+  ExecutorThreadData(const Builder& build) : build(build) {}
+
+  Builder build;
+  A2DObj<Data> data;
+  A2DObj<Geo> geo;
+  A2DObj<State> state;
+
+  // Copy the element values into the inputs and zero their derivatives
+  void set_values(const Data& d, const Geo& g, const State& s) {
+    data.value().copy(d);
+    geo.value().copy(g);
+    state.value().copy(s);
+    zero_seeds(data);
+    zero_seeds(geo);
+    zero_seeds(state);
+  }
+
+  template <class T>
+  static void zero_seeds(A2DObj<T>& obj) {
+    obj.bvalue().zero();
+    obj.pvalue().zero();
+    obj.hvalue().zero();
+  }
+};
+
+template <class Builder, class Data, class Geo, class State>
+using ExecutorThreadDataList =
+    std::vector<std::unique_ptr<ExecutorThreadData<Builder, Data, Geo, State>>>;
+
+template <class Builder, class Data, class Geo, class State>
+ExecutorThreadDataList<Builder, Data, Geo, State> make_thread_data(
+    int nthreads, const Builder& build) {
+  ExecutorThreadDataList<Builder, Data, Geo, State> list;
+  for (int i = 0; i < nthreads; i++) {
+    list.emplace_back(
+        new ExecutorThreadData<Builder, Data, Geo, State>(build));
+  }
+  return list;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Compute the Jacobian-vector products for an array of elements
+ *
+ * For each element e, res[e] = d(of)/d(wrt) * p[e], computed with
+ * JacobianProduct on the stack returned by the builder.
+ *
+ * @tparam of Residual type
+ * @tparam wrt Derivative type
+ * @param pool Thread pool
+ * @param nelems Number of elements
+ * @param data Array of element data
+ * @param geo Array of element geometry
+ * @param state Array of element states
+ * @param p Array of direction vectors - same type as wrt
+ * @param res Array of results - same type as of
+ * @param build Stack builder
+ * @param chunk_size Number of elements per chunk (<= 0 for the default)
+ */
+template <FEVarType of, FEVarType wrt, class Data, class Geo, class State,
+          class PType, class RType, class Builder>
+void JacobianProduct(ThreadPool& pool, index_t nelems, const Data data[],
+                     const Geo geo[], const State state[], const PType p[],
+                     RType res[], const Builder& build,
+                     index_t chunk_size = 0) {
+  auto tdata = detail::make_thread_data<Builder, Data, Geo, State>(
+      pool.get_num_threads(), build);
+
+  pool.parallel_for(nelems, chunk_size, [&](int tid, index_t start,
+                                            index_t end) {
+    auto& td = *tdata[tid];
+    for (index_t e = start; e < end; e++) {
+      td.set_values(data[e], geo[e], state[e]);
+      auto stack = td.build(td.data, td.geo, td.state);
+      JacobianProduct<of, wrt>(stack, td.data, td.geo, td.state, p[e],
+                               res[e]);
+      stack.bzero();
+      stack.hzero();
+    }
+  });
+}
+
+/**
+ * @brief Extract the element Jacobian matrices for an array of elements
+ *
+ * For each element e, jac[e] = d(of)/d(wrt), computed with ExtractJacobian
+ * on the stack returned by the builder.
+ *
+ * @tparam of Residual type
+ * @tparam wrt Derivative type
+ * @param pool Thread pool
+ * @param nelems Number of elements
+ * @param data Array of element data
+ * @param geo Array of element geometry
+ * @param state Array of element states
+ * @param jac Array of output Jacobian matrices
+ * @param build Stack builder
+ * @param chunk_size Number of elements per chunk (<= 0 for the default)
+ */
+template <FEVarType of, FEVarType wrt, class Data, class Geo, class State,
+          class MatType, class Builder>
+void ExtractJacobian(ThreadPool& pool, index_t nelems, const Data data[],
+                     const Geo geo[], const State state[], MatType jac[],
+                     const Builder& build, index_t chunk_size = 0) {
+  auto tdata = detail::make_thread_data<Builder, Data, Geo, State>(
+      pool.get_num_threads(), build);
+
+  pool.parallel_for(nelems, chunk_size, [&](int tid, index_t start,
+                                            index_t end) {
+    auto& td = *tdata[tid];
+    for (index_t e = start; e < end; e++) {
+      td.set_values(data[e], geo[e], state[e]);
+      auto stack = td.build(td.data, td.geo, td.state);
+      ExtractJacobian<of, wrt>(stack, td.data, td.geo, td.state, jac[e]);
+      stack.bzero();
+      stack.hzero();
+    }
+  });
+}
+
+}  // namespace A2D
+
+#endif  // A2D_EXECUTOR_H
@@ -216,10 +216,65 @@ class MatMatMultExpr {
     }
   }
 
+  // Combined reverse() and hreverse(): the b- and h-seeds of each input are
+  // computed in one pass over the operands
+  A2D_FUNCTION void hproduct_reverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hproduct_reverse() can be called for only second order "
+                  "objects.");
+    constexpr bool actA = (adA == ADiffType::ACTIVE);
+    constexpr bool actB = (adB == ADiffType::ACTIVE);
+
+    if constexpr (actA) {
+      if constexpr (opA == MatOp::NORMAL) {
+        // bar{A} += bar{C} * not_opB(B)
+        MatMatMultDualAddCore<T, P, Q, K, L, N, M, MatOp::NORMAL, not_opB,
+                              true, actB>(
+            GetSeed<ADseed::b>::get_data(C), GetSeed<ADseed::h>::get_data(C),
+            get_data(B), pseed<adB>(B), GetSeed<ADseed::b>::get_data(A),
+            GetSeed<ADseed::h>::get_data(A));
+      } else {
+        // bar{A} += opB(B) * bar{C}^{T}
+        MatMatMultDualAddCore<T, K, L, P, Q, N, M, opB, MatOp::TRANSPOSE,
+                              actB, true>(
+            get_data(B), pseed<adB>(B), GetSeed<ADseed::b>::get_data(C),
+            GetSeed<ADseed::h>::get_data(C), GetSeed<ADseed::b>::get_data(A),
+            GetSeed<ADseed::h>::get_data(A));
+      }
+    }
+    if constexpr (actB) {
+      if constexpr (opB == MatOp::NORMAL) {
+        // bar{B} += not_opA(A) * bar{C}
+        MatMatMultDualAddCore<T, N, M, P, Q, K, L, not_opA, MatOp::NORMAL,
+                              actA, true>(
+            get_data(A), pseed<adA>(A), GetSeed<ADseed::b>::get_data(C),
+            GetSeed<ADseed::h>::get_data(C), GetSeed<ADseed::b>::get_data(B),
+            GetSeed<ADseed::h>::get_data(B));
+      } else {
+        // bar{B} += bar{C}^{T} * opA(A)
+        MatMatMultDualAddCore<T, P, Q, N, M, K, L, MatOp::TRANSPOSE, opA,
+                              true, actA>(
+            GetSeed<ADseed::b>::get_data(C), GetSeed<ADseed::h>::get_data(C),
+            get_data(A), pseed<adA>(A), GetSeed<ADseed::b>::get_data(B),
+            GetSeed<ADseed::h>::get_data(B));
+      }
+    }
+  }
+
  private:
   Atype& A;
   Btype& B;
   Ctype& C;
+
+  // The p-seed of an active input, or nullptr for a passive input
+  template <ADiffType ad, class Type>
+  A2D_FUNCTION static const T* pseed(Type& X) {
+    if constexpr (ad == ADiffType::ACTIVE) {
+      return GetSeed<ADseed::p>::get_data(X);
+    } else {
+      return nullptr;
+    }
+  }
 };
 
 // compute C = op(A) * op(B) and return an expression, where A and B are all
@@ -375,6 +430,7 @@ bool MatMatMultTestHelper(bool component = false, bool write_output = true) {
   const MatOp NORMAL = MatOp::NORMAL;
   const MatOp TRANSPOSE = MatOp::TRANSPOSE;
   using Tc = A2D_complex_t<T>;
+  using Td = HyperDual<T>;
 
   bool passed = true;
   MatMatMultTest<NORMAL, NORMAL, Tc, N, M, M, K, N, K> test1;
@@ -386,6 +442,16 @@ bool MatMatMultTestHelper(bool component = false, bool write_output = true) {
   MatMatMultTest<TRANSPOSE, TRANSPOSE, Tc, N, M, K, N, M, K> test4;
   passed = passed && Run(test4, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  MatMatMultTest<NORMAL, NORMAL, Td, N, M, M, K, N, K> test5;
+  passed = passed && Run(test5, component, write_output);
+  MatMatMultTest<NORMAL, TRANSPOSE, Td, N, M, K, M, N, K> test6;
+  passed = passed && Run(test6, component, write_output);
+  MatMatMultTest<TRANSPOSE, NORMAL, Td, N, M, N, K, M, K> test7;
+  passed = passed && Run(test7, component, write_output);
+  MatMatMultTest<TRANSPOSE, TRANSPOSE, Td, N, M, K, N, M, K> test8;
+  passed = passed && Run(test8, component, write_output);
+
   return passed;
 }
 
@@ -0,0 +1,434 @@
+#ifndef A2D_GEOMETRY_CACHE_H
+#define A2D_GEOMETRY_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../a2ddefs.h"
+#include "../a2dthreadpool.h"
+#include "a2dexecutor.h"
+#include "a2dmat.h"
+#include "a2dmatdet.h"
+#include "a2dmatinv.h"
+#include "a2dobj.h"
+
+namespace A2D {
+
+/*
+  Cache of the inverse and the determinant of the mapping Jacobians
+
+  When the geometry is fixed, as in a Newton solve for the state, the inverse
+  Jinv and the determinant detJ of the mapping Jacobian J are the same at each
+  evaluation of the element stacks. GeometryFactorCache computes them once per
+  element and quadrature point and keeps the version stamp of the geometry
+  array they were computed from. The geometry is stored in a VersionedArray,
+  whose stamp changes after each write, so that the cache is refilled only
+  after the geometry changes.
+
+  The builders of the executor overloads below receive the cached factors of
+  the element, and the geometry as a passive object when neither of nor wrt
+  is FEVarType::GEOMETRY:
+
+    auto build = [Jinv = A2DObj<Mat<T, 3, 3>>(), F = A2DObj<Mat<T, 3, 3>>(),
+                  ...](auto& data, auto& J, auto& Ux,
+                       const GeometryFactors<T, 3> factors[]) mutable {
+      out.bvalue() = 1.0;
+      return MakeStack(
+          CachedMatInv(J, factors[0].Jinv, Jinv),
+          MatMatMult(Ux, GeometrySelect(J, factors[0].Jinv, Jinv), F), ...);
+    };
+
+  With a passive J, CachedMatInv only copies the cached inverse and the
+  following operations use the cached Mat as a passive input, so no
+  derivative is propagated through the geometry. With an active J, the
+  inverse is still copied from the cache, but the derivative sweeps of
+  CachedMatInv are those of MatInv, so the geometry derivatives are exact.
+*/
+
+namespace detail {
+
+// Version stamps are unique across all the versioned arrays, and never zero
+inline std::uint64_t next_geometry_version() {
+  static std::atomic<std::uint64_t> version(0);
+  return ++version;
+}
+
+// The geometry of the element is the mapping Jacobian at its only point
+struct GeometryIsJacobian {
+  template <class Geo, class JType>
+  void operator()(const Geo& geo, index_t q, JType& J) const {
+    J.copy(geo);
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Array whose version stamp changes each time it is modified
+ *
+ * The entries are written either one at a time with set(), or through the
+ * Modifier returned by modify(). Both issue a new version stamp after the
+ * write, so a cache updated from the array before or during the write is
+ * never current afterwards.
+ *
+ * @tparam Obj Type of the entries
+ */
+template <class Obj>
+class VersionedArray {
+ public:
+  /**
+   * @brief Scoped mutable access to the entries
+   *
+   * The version stamp is renewed when the modifier is created and when it is
+   * destroyed. The references it returns must not be used after that.
+   */
+  class Modifier {
+   public:
+    Modifier(VersionedArray& array) : array(array) {
+      array.version = detail::next_geometry_version();
+    }
+    Modifier(const Modifier&) = delete;
+    Modifier& operator=(const Modifier&) = delete;
+    ~Modifier() { array.version = detail::next_geometry_version(); }
+
+    Obj* data() { return array.entries.data(); }
+    Obj& operator[](index_t i) { return array.entries[i]; }
+
+   private:
+    VersionedArray& array;
+  };
+
+  VersionedArray(index_t size)
+      : entries(size), version(detail::next_geometry_version()) {}
+
+  index_t size() const { return entries.size(); }
+  std::uint64_t get_version() const { return version; }
+
+  const Obj* data() const { return entries.data(); }
+  const Obj& operator[](index_t i) const { return entries[i]; }
+
+  // Set entry i and issue a new version stamp
+  void set(index_t i, const Obj& obj) {
+    entries[i] = obj;
+    version = detail::next_geometry_version();
+  }
+
+  // Mutable access to the entries until the modifier goes out of scope
+  Modifier modify() { return Modifier(*this); }
+
+ private:
+  std::vector<Obj> entries;
+  std::uint64_t version;
+};
+
+/**
+ * @brief Inverse and determinant of the mapping Jacobian at a point
+ */
+template <typename T, int N>
+struct GeometryFactors {
+  Mat<T, N, N> Jinv;
+  T detJ;
+};
+
+/**
+ * @brief Per-element, per-quadrature-point cache of the geometry factors
+ *
+ * @tparam T Numeric type
+ * @tparam N Dimension of the mapping Jacobian
+ * @tparam JacobianFunc Callable jacobian(geo[e], q, J) that computes the
+ * mapping Jacobian J at point q from the geometry of element e
+ */
+template <typename T, int N, class JacobianFunc = detail::GeometryIsJacobian>
+class GeometryFactorCache {
+ public:
+  GeometryFactorCache(index_t nelems, index_t nquad = 1,
+                      const JacobianFunc& jacobian = JacobianFunc())
+      : nelems(nelems),
+        nquad(nquad),
+        jacobian(jacobian),
+        version(0),
+        factors(nelems * nquad) {}
+
+  index_t get_num_elements() const { return nelems; }
+  index_t get_num_quadrature_points() const { return nquad; }
+
+  // Whether the factors were computed from the current geometry
+  template <class Geo>
+  bool is_current(const VersionedArray<Geo>& geo) const {
+    return version == geo.get_version();
+  }
+
+  // Force the factors to be recomputed at the next update
+  void invalidate() { version = 0; }
+
+  /**
+   * @brief Recompute the factors if the geometry has changed
+   *
+   * @param pool Thread pool
+   * @param geo Element geometry, one entry per element of the cache
+   * @return true if the factors were recomputed
+   */
+  template <class Geo>
+  bool update(ThreadPool& pool, const VersionedArray<Geo>& geo) {
+    check_size(geo);
+    if (is_current(geo)) {
+      return false;
+    }
+    pool.parallel_for(nelems, 0, [&](int tid, index_t start, index_t end) {
+      compute(geo.data(), start, end);
+    });
+    version = geo.get_version();
+    return true;
+  }
+
+  template <class Geo>
+  bool update(const VersionedArray<Geo>& geo) {
+    check_size(geo);
+    if (is_current(geo)) {
+      return false;
+    }
+    compute(geo.data(), 0, nelems);
+    version = geo.get_version();
+    return true;
+  }
+
+  // The factors at the nquad points of element e
+  const GeometryFactors<T, N>* get_factors(index_t e) const {
+    return &factors[nquad * e];
+  }
+
+ private:
+  template <class Geo>
+  void check_size(const VersionedArray<Geo>& geo) const {
+    if (geo.size() != nelems) {
+      throw std::invalid_argument(
+          "GeometryFactorCache: the geometry array has " +
+          std::to_string(geo.size()) + " entries for " +
+          std::to_string(nelems) + " elements");
+    }
+  }
+
+  template <class Geo>
+  void compute(const Geo geo[], index_t start, index_t end) {
+    Mat<T, N, N> J;
+    for (index_t e = start; e < end; e++) {
+      for (index_t q = 0; q < nquad; q++) {
+        GeometryFactors<T, N>& f = factors[nquad * e + q];
+        jacobian(geo[e], q, J);
+        MatInvCore<T, N>(get_data(J), get_data(f.Jinv));
+        f.detJ = MatDetCore<T, N>(get_data(J));
+      }
+    }
+  }
+
+  index_t nelems, nquad;
+  JacobianFunc jacobian;
+  std::uint64_t version;
+  std::vector<GeometryFactors<T, N>> factors;
+};
+
+/**
+ * @brief MatInv with the value of the inverse taken from a cache
+ *
+ * eval() copies the cached inverse, which must be the inverse of A. The
+ * derivative sweeps are those of MatInv.
+ */
+template <class Atype, class Btype>
+class CachedMatInvExpr : public MatInvExpr<Atype, Btype> {
+ public:
+  using typename MatInvExpr<Atype, Btype>::T;
+  static constexpr int N = MatInvExpr<Atype, Btype>::N;
+
+  A2D_FUNCTION CachedMatInvExpr(Atype& A, const Mat<T, N, N>& cached,
+                                Btype& Ainv)
+      : MatInvExpr<Atype, Btype>(A, Ainv), cached(cached) {}
+
+  A2D_FUNCTION void eval() {
+    VecCopyCore<T, N * N>(get_data(cached), get_data(this->Ainv));
+  }
+
+  const Mat<T, N, N>& cached;
+};
+
+template <class Atype, class T, int N, class Btype>
+A2D_FUNCTION auto CachedMatInv(ADObj<Atype>& A, const Mat<T, N, N>& cached,
+                               ADObj<Btype>& Ainv) {
+  return CachedMatInvExpr<ADObj<Atype>, ADObj<Btype>>(A, cached, Ainv);
+}
+
+template <class Atype, class T, int N, class Btype>
+A2D_FUNCTION auto CachedMatInv(A2DObj<Atype>& A, const Mat<T, N, N>& cached,
+                               A2DObj<Btype>& Ainv) {
+  return CachedMatInvExpr<A2DObj<Atype>, A2DObj<Btype>>(A, cached, Ainv);
+}
+
+template <class Atype, class T, int N, class Btype,
+          std::enable_if_t<get_diff_type<Atype>::diff_type ==
+                               ADiffType::PASSIVE,
+                           bool> = true>
+A2D_FUNCTION auto CachedMatInv(const Atype& A, const Mat<T, N, N>& cached,
+                               ADObj<Btype>& Ainv) {
+  return CachedMatInvExpr<const Atype, ADObj<Btype>>(A, cached, Ainv);
+}
+
+template <class Atype, class T, int N, class Btype,
+          std::enable_if_t<get_diff_type<Atype>::diff_type ==
+                               ADiffType::PASSIVE,
+                           bool> = true>
+A2D_FUNCTION auto CachedMatInv(const Atype& A, const Mat<T, N, N>& cached,
+                               A2DObj<Btype>& Ainv) {
+  return CachedMatInvExpr<const Atype, A2DObj<Btype>>(A, cached, Ainv);
+}
+
+/**
+ * @brief MatDet with the value of the determinant taken from a cache
+ */
+template <class Atype, class dtype>
+class CachedMatDetExpr : public MatDetExpr<Atype, dtype> {
+ public:
+  using typename MatDetExpr<Atype, dtype>::T;
+
+  A2D_FUNCTION CachedMatDetExpr(Atype& A, const T& cached, dtype& det)
+      : MatDetExpr<Atype, dtype>(A, det), cached(cached) {}
+
+  A2D_FUNCTION void eval() { get_data(this->det) = cached; }
+
+  const T& cached;
+};
+
+template <class Atype, class T, class dtype>
+A2D_FUNCTION auto CachedMatDet(ADObj<Atype>& A, const T& cached,
+                               ADObj<dtype>& det) {
+  return CachedMatDetExpr<ADObj<Atype>, ADObj<dtype>>(A, cached, det);
+}
+
+template <class Atype, class T, class dtype>
+A2D_FUNCTION auto CachedMatDet(A2DObj<Atype>& A, const T& cached,
+                               A2DObj<dtype>& det) {
+  return CachedMatDetExpr<A2DObj<Atype>, A2DObj<dtype>>(A, cached, det);
+}
+
+template <class Atype, class T, class dtype,
+          std::enable_if_t<get_diff_type<Atype>::diff_type ==
+                               ADiffType::PASSIVE,
+                           bool> = true>
+A2D_FUNCTION auto CachedMatDet(const Atype& A, const T& cached,
+                               ADObj<dtype>& det) {
+  return CachedMatDetExpr<const Atype, ADObj<dtype>>(A, cached, det);
+}
+
+template <class Atype, class T, class dtype,
+          std::enable_if_t<get_diff_type<Atype>::diff_type ==
+                               ADiffType::PASSIVE,
+                           bool> = true>
+A2D_FUNCTION auto CachedMatDet(const Atype& A, const T& cached,
+                               A2DObj<dtype>& det) {
+  return CachedMatDetExpr<const Atype, A2DObj<dtype>>(A, cached, det);
+}
+
+/**
+ * @brief The cached value when J is passive, otherwise the active object
+ *
+ * @param J Mapping Jacobian
+ * @param cached Cached factor of J
+ * @param obj Active object computed from J by CachedMatInv or CachedMatDet
+ */
+template <class Jtype, class Cached, class Obj>
+A2D_FUNCTION decltype(auto) GeometrySelect(Jtype& J, const Cached& cached,
+                                           Obj& obj) {
+  if constexpr (get_diff_type<typename remove_const_and_refs<
+                    Jtype>::type>::diff_type == ADiffType::PASSIVE) {
+    return cached;
+  } else {
+    return obj;
+  }
+}
+
+namespace detail {
+
+// Build the stack with a passive geometry unless its derivatives are needed
+template <FEVarType of, FEVarType wrt, class ThreadData, class Factors>
+auto BuildWithFactors(ThreadData& td, const Factors factors[]) {
+  if constexpr (of == FEVarType::GEOMETRY || wrt == FEVarType::GEOMETRY) {
+    return td.build(td.data, td.geo, td.state, factors);
+  } else {
+    return td.build(td.data, td.geo.value(), td.state, factors);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Compute the Jacobian-vector products for an array of elements with
+ * the cached geometry factors
+ *
+ * The cache is updated first, which only recomputes the factors if the
+ * geometry has changed. The builder takes the factors of the element as a
+ * fourth argument.
+ *
+ * @param cache Geometry factor cache for the elements
+ */
+template <FEVarType of, FEVarType wrt, class Data, class Geo, class State,
+          class PType, class RType, class Builder, typename T, int N,
+          class JacobianFunc>
+void JacobianProduct(ThreadPool& pool, index_t nelems, const Data data[],
+                     const VersionedArray<Geo>& geo, const State state[],
+                     const PType p[], RType res[], const Builder& build,
+                     GeometryFactorCache<T, N, JacobianFunc>& cache,
+                     index_t chunk_size = 0) {
+  cache.update(pool, geo);
+  auto tdata = detail::make_thread_data<Builder, Data, Geo, State>(
+      pool.get_num_threads(), build);
+
+  pool.parallel_for(nelems, chunk_size, [&](int tid, index_t start,
+                                            index_t end) {
+    auto& td = *tdata[tid];
+    for (index_t e = start; e < end; e++) {
+      td.set_values(data[e], geo[e], state[e]);
+      auto stack =
+          detail::BuildWithFactors<of, wrt>(td, cache.get_factors(e));
+      JacobianProduct<of, wrt>(stack, td.data, td.geo, td.state, p[e],
+                               res[e]);
+      stack.bzero();
+      stack.hzero();
+    }
+  });
+}
+
+/**
+ * @brief Extract the element Jacobian matrices for an array of elements with
+ * the cached geometry factors
+ *
+ * @param cache Geometry factor cache for the elements
+ */
+template <FEVarType of, FEVarType wrt, class Data, class Geo, class State,
+          class MatType, class Builder, typename T, int N, class JacobianFunc>
+void ExtractJacobian(ThreadPool& pool, index_t nelems, const Data data[],
+                     const VersionedArray<Geo>& geo, const State state[],
+                     MatType jac[], const Builder& build,
+                     GeometryFactorCache<T, N, JacobianFunc>& cache,
+                     index_t chunk_size = 0) {
+  cache.update(pool, geo);
+  auto tdata = detail::make_thread_data<Builder, Data, Geo, State>(
+      pool.get_num_threads(), build);
+
+  pool.parallel_for(nelems, chunk_size, [&](int tid, index_t start,
+                                            index_t end) {
+    auto& td = *tdata[tid];
+    for (index_t e = start; e < end; e++) {
+      td.set_values(data[e], geo[e], state[e]);
+      auto stack =
+          detail::BuildWithFactors<of, wrt>(td, cache.get_factors(e));
+      ExtractJacobian<of, wrt>(stack, td.data, td.geo, td.state, jac[e]);
+      stack.bzero();
+      stack.hzero();
+    }
+  });
+}
+
+}  // namespace A2D
+
+#endif  // A2D_GEOMETRY_CACHE_H
@@ -116,6 +116,46 @@ A2D_FUNCTION auto MatGreenStrain(A2DObj<UxMat>& Ux, A2DObj<EMat>& E) {
   return MatGreenStrainExpr<etype, A2DObj<UxMat>, A2DObj<EMat>>(Ux, E);
 }
 
+// Structural sparsity of dE/dUx
+template <GreenStrainType etype, int N>
+constexpr SparsityPattern<(N * (N + 1)) / 2, N * N> MatGreenStrainSparsity() {
+  SparsityPattern<(N * (N + 1)) / 2, N * N> P;
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      int r = j + i * (i + 1) / 2;
+      P.set(r, N * i + j);
+      P.set(r, N * j + i);
+
+      // E_ij also depends on the columns i and j of Ux
+      if constexpr (etype == GreenStrainType::NONLINEAR) {
+        for (int k = 0; k < N; k++) {
+          P.set(r, N * k + i);
+          P.set(r, N * k + j);
+        }
+      }
+    }
+  }
+  return P;
+}
+
+// Union of the structural sparsity of the Hessians d^2E_ij/dUx^2. This is
+// empty for the linear strain and couples the entries within each row of Ux
+// for the nonlinear strain.
+template <GreenStrainType etype, int N>
+constexpr SparsityPattern<N * N, N * N> MatGreenStrainHessianSparsity() {
+  SparsityPattern<N * N, N * N> P;
+  if constexpr (etype == GreenStrainType::NONLINEAR) {
+    for (int k = 0; k < N; k++) {
+      for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+          P.set(N * k + i, N * k + j);
+        }
+      }
+    }
+  }
+  return P;
+}
+
 namespace Test {
 
 template <GreenStrainType etype, typename T, int N>
@@ -177,6 +217,7 @@ class MatGreenStrainTest : public A2DTest<T, SymMat<T, N>, Mat<T, N, N>> {
 inline bool MatGreenStrainTestAll(bool component = false,
                                   bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   MatGreenStrainTest<GreenStrainType::LINEAR, Tc, 2> test1;
@@ -189,6 +230,17 @@ inline bool MatGreenStrainTestAll(bool component = false,
   MatGreenStrainTest<GreenStrainType::NONLINEAR, Tc, 3> test4;
   passed = passed && Run(test4, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  MatGreenStrainTest<GreenStrainType::LINEAR, Td, 2> test5;
+  passed = passed && Run(test5, component, write_output);
+  MatGreenStrainTest<GreenStrainType::NONLINEAR, Td, 2> test6;
+  passed = passed && Run(test6, component, write_output);
+
+  MatGreenStrainTest<GreenStrainType::LINEAR, Td, 3> test7;
+  passed = passed && Run(test7, component, write_output);
+  MatGreenStrainTest<GreenStrainType::NONLINEAR, Td, 3> test8;
+  passed = passed && Run(test8, component, write_output);
+
   return passed;
 }
 
@@ -134,6 +134,12 @@ A2D_FUNCTION auto VecHadamard(A2DObj<xtype> &x, const ytype &y,
   return VecHadamardExpr<A2DObj<xtype>, const ytype, A2DObj<ztype>>(x, y, z);
 }
 
+// Structural sparsity of dz/dx (and dz/dy)
+template <int N>
+constexpr SparsityPattern<N, N> VecHadamardSparsity() {
+  return IdentitySparsity<N>();
+}
+
 namespace Test {
 
 template <typename T, int N>
@@ -184,11 +190,16 @@ class VecHadamardTest : public A2DTest<T, Vec<T, N>, Vec<T, N>, Vec<T, N>> {
 inline bool VecHadamardTestAll(bool component = false,
                                bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   VecHadamardTest<Tc, 3> test1;
   passed = passed && Run(test1, component, write_output);
 
+  // The same test with an exact hyper-dual reference
+  VecHadamardTest<Td, 3> test2;
+  passed = passed && Run(test2, component, write_output);
+
   return passed;
 }
 
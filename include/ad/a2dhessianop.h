@@ -0,0 +1,305 @@
+#ifndef A2D_HESSIAN_OP_H
+#define A2D_HESSIAN_OP_H
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../a2ddefs.h"
+#include "../a2dthreadpool.h"
+#include "a2dbsrmat.h"
+#include "a2dexecutor.h"
+#include "a2dobj.h"
+#include "a2dstack.h"
+
+namespace A2D {
+
+/**
+ * @brief Values and first-order adjoints of the intermediates of a builder
+ *
+ * A convenience for the save()/restore() hook of the builders used with the
+ * cache of HessianOperator:
+ *
+ *   using Cache = HessianCache<Mat<T, 3, 3>, SymMat<T, 3>, T>;
+ *   void save(Cache& c) const { c.save(Ux, E, out); }
+ *   void restore(const Cache& c) { c.restore(Ux, E, out); }
+ */
+template <class... Types>
+class HessianCache {
+ public:
+  void save(const A2DObj<Types>&... objs) {
+    save_(std::index_sequence_for<Types...>(), objs...);
+  }
+
+  void restore(A2DObj<Types>&... objs) const {
+    restore_(std::index_sequence_for<Types...>(), objs...);
+  }
+
+ private:
+  template <std::size_t... I>
+  void save_(std::index_sequence<I...>, const A2DObj<Types>&... objs) {
+    ((std::get<I>(values) = objs.value(),
+      std::get<I>(bvalues) = objs.bvalue()),
+     ...);
+  }
+
+  template <std::size_t... I>
+  void restore_(std::index_sequence<I...>, A2DObj<Types>&... objs) const {
+    ((objs.value() = std::get<I>(values),
+      objs.bvalue() = std::get<I>(bvalues)),
+     ...);
+  }
+
+  std::tuple<Types...> values, bvalues;
+};
+
+namespace detail {
+
+// Does the builder provide the save()/restore() hook of its intermediates
+template <class Builder, class = void>
+struct has_cache_hook : std::false_type {};
+
+template <class Builder>
+struct has_cache_hook<Builder, std::void_t<typename Builder::Cache>>
+    : std::true_type {};
+
+// What the cache of HessianOperator keeps for one element
+template <class Builder, class Stack, bool hook>
+struct HessianElementCache {};
+
+template <class Builder, class Stack>
+struct HessianElementCache<Builder, Stack, true> {
+  typename Builder::Cache build;
+  typename Stack::OpState ops;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Matrix-free global Hessian-vector product y = H(x) * p
+ *
+ * H(x) is the sum over the elements of the element Hessians with respect to
+ * the state, computed with the stack returned by the builder (see
+ * a2dexecutor.h). The state of each element is a Mat<T, nodes_per_elem, M>
+ * of the values of its nodes, gathered from the global vectors through the
+ * connectivity as in a2dbsrmat.h. The element products are added into y one
+ * color of elements at a time, so no atomics are needed.
+ *
+ * Without the cache, the stacks are rebuilt on thread-private objects, and
+ * each product evaluates the stack and runs hproduct() as JacobianProduct
+ * does. With the cache, linearize() evaluates the stacks and runs their
+ * first-order reverse sweeps once, and keeps for every element the values
+ * and the first-order adjoints of the intermediates and the op_state data
+ * of the operations (see OperationStack::save_state()). Each product then
+ * restores these on a thread-private stack and runs hforward() and
+ * hreverse() only. Whether this is faster depends on the cost of evaluating
+ * the stack compared to reading the cache from memory, see bench_bsr.
+ *
+ * The cache requires a builder class that provides the hook
+ *
+ *   using Cache = ...;  // e.g. HessianCache<...>
+ *   void save(Cache& c) const;
+ *   void restore(const Cache& c);
+ *
+ * which saves and restores the values and first-order adjoints of all of
+ * its intermediates, the seeded output included.
+ *
+ * The arrays conn, data and geo are referenced, not copied, and must outlive
+ * the operator.
+ */
+template <class Data, class Geo, class State, class Builder>
+class HessianOperator {
+ public:
+  using T = typename State::type;
+  static constexpr int nodes_per_elem = State::nrows;
+  static constexpr int M = State::ncols;
+
+  using Stack = decltype(std::declval<Builder&>()(
+      std::declval<A2DObj<Data>&>(), std::declval<A2DObj<Geo>&>(),
+      std::declval<A2DObj<State>&>()));
+
+  /**
+   * @brief Create the operator
+   *
+   * @param pool Thread pool
+   * @param nnodes Number of nodes
+   * @param nelems Number of elements
+   * @param conn Element-to-node connectivity
+   * @param data Array of element data
+   * @param geo Array of element geometry
+   * @param build Stack builder
+   * @param cache Keep the values and first-order adjoints of the elements
+   * between the products, see the class description
+   */
+  HessianOperator(ThreadPool& pool, index_t nnodes, index_t nelems,
+                  const index_t conn[], const Data data[], const Geo geo[],
+                  const Builder& build, bool cache = false)
+      : pool(pool),
+        nnodes(nnodes),
+        nelems(nelems),
+        conn(conn),
+        data(data),
+        geo(geo),
+        coloring(nnodes, nelems, nodes_per_elem, conn),
+        x(M * nnodes, T(0.0)),
+        tdata(detail::make_thread_data<Builder, Data, Geo, State>(
+            pool.get_num_threads(), build)),
+        cache(cache) {
+    if (cache) {
+      if constexpr (has_hook) {
+        elem_cache.resize(nelems);
+        for (auto& td : tdata) {
+          stacks.emplace_back(
+              new Stack(td->build(td->data, td->geo, td->state)));
+          stacks.back()->hzero();
+        }
+      } else {
+        throw std::invalid_argument(
+            "HessianOperator: the builder has no save()/restore() hook for "
+            "the cache");
+      }
+    }
+  }
+
+  index_t get_size() const { return M * nnodes; }
+
+  /**
+   * @brief Set the point x at which the Hessian is evaluated
+   *
+   * With the cache, the stacks of all the elements are evaluated and
+   * reversed here, and their data saved for the following products.
+   *
+   * @param x0 Global vector of length get_size()
+   */
+  void linearize(const T x0[]) {
+    std::copy(x0, x0 + get_size(), x.begin());
+
+    if constexpr (has_hook) {
+      if (cache) {
+        pool.parallel_for(nelems, 0, [&](int tid, index_t start,
+                                         index_t end) {
+          auto& td = *tdata[tid];
+          for (index_t e = start; e < end; e++) {
+            State s;
+            gather(e, x.data(), s);
+            td.set_values(data[e], geo[e], s);
+            auto stack = td.build(td.data, td.geo, td.state);
+            stack.reverse();
+            td.build.save(elem_cache[e].build);
+            stack.save_state(elem_cache[e].ops);
+            stack.bzero();
+          }
+        });
+      }
+    }
+  }
+
+  /**
+   * @brief Compute y = H(x) * p
+   *
+   * @param p Global direction vector of length get_size()
+   * @param y Global output vector of length get_size()
+   */
+  void mult(const T p[], T y[]) {
+    pool.parallel_for(get_size(), 0, [&](int tid, index_t start,
+                                         index_t end) {
+      std::fill(y + start, y + end, T(0.0));
+    });
+
+    if constexpr (has_hook) {
+      if (cache) {
+        coloring.parallel_for(pool, [&](int tid, index_t e) {
+          auto& td = *tdata[tid];
+          auto& stack = *stacks[tid];
+          State s;
+          gather(e, x.data(), s);
+          td.set_values(data[e], geo[e], s);
+          gather(e, p, td.state.pvalue());
+          td.build.restore(elem_cache[e].build);
+          stack.restore_state(elem_cache[e].ops);
+          stack.hforward();
+          stack.hreverse();
+          scatter_add(e, td.state.hvalue(), y);
+          stack.bzero();
+          stack.hzero();
+        });
+        return;
+      }
+    }
+
+    coloring.parallel_for(pool, [&](int tid, index_t e) {
+      auto& td = *tdata[tid];
+      State s;
+      gather(e, x.data(), s);
+      td.set_values(data[e], geo[e], s);
+      gather(e, p, td.state.pvalue());
+      auto stack = td.build(td.data, td.geo, td.state);
+      stack.hproduct();
+      scatter_add(e, td.state.hvalue(), y);
+      stack.bzero();
+      stack.hzero();
+    });
+  }
+
+ private:
+  static constexpr bool has_hook = detail::has_cache_hook<Builder>::value;
+
+  void gather(index_t e, const T u[], State& ue) const {
+    const index_t* nodes = &conn[nodes_per_elem * e];
+    for (int i = 0; i < nodes_per_elem; i++) {
+      for (int k = 0; k < M; k++) {
+        ue(i, k) = u[M * nodes[i] + k];
+      }
+    }
+  }
+
+  void scatter_add(index_t e, const State& ue, T u[]) const {
+    const index_t* nodes = &conn[nodes_per_elem * e];
+    for (int i = 0; i < nodes_per_elem; i++) {
+      for (int k = 0; k < M; k++) {
+        u[M * nodes[i] + k] += ue(i, k);
+      }
+    }
+  }
+
+  ThreadPool& pool;
+  index_t nnodes, nelems;
+  const index_t* conn;
+  const Data* data;
+  const Geo* geo;
+  ElementColoring coloring;
+
+  // Current point
+  std::vector<T> x;
+
+  // Thread-private objects
+  detail::ExecutorThreadDataList<Builder, Data, Geo, State> tdata;
+
+  // With the cache, the saved data of the elements and a stack on the
+  // objects of each thread
+  bool cache;
+  std::vector<detail::HessianElementCache<Builder, Stack, has_hook>>
+      elem_cache;
+  std::vector<std::unique_ptr<Stack>> stacks;
+};
+
+/**
+ * @brief Make a matrix-free global Hessian-vector product operator
+ *
+ * @tparam State Element state type, Mat<T, nodes_per_elem, M>
+ */
+template <class State, class Data, class Geo, class Builder>
+HessianOperator<Data, Geo, State, Builder> MakeHessianOperator(
+    ThreadPool& pool, index_t nnodes, index_t nelems, const index_t conn[],
+    const Data data[], const Geo geo[], const Builder& build,
+    bool cache = false) {
+  return HessianOperator<Data, Geo, State, Builder>(pool, nnodes, nelems, conn,
+                                                    data, geo, build, cache);
+}
+
+}  // namespace A2D
+
+#endif  // A2D_HESSIAN_OP_H
@@ -0,0 +1,319 @@
+#ifndef A2D_HYPER_DUAL_H
+#define A2D_HYPER_DUAL_H
+
+#include <cmath>
+#include <type_traits>
+
+#include "../a2ddefs.h"
+
+namespace A2D {
+
+template <typename T>
+class HyperDual;
+
+/*
+  Detections for the hyper-dual type
+*/
+template <class>
+struct is_hyperdual : std::false_type {};
+template <class T>
+struct is_hyperdual<HyperDual<T>> : std::true_type {};
+template <class X>
+inline constexpr bool is_hyperdual_v = is_hyperdual<X>::value;
+
+// A hyper-dual number is a numeric type
+template <class T>
+struct __is_numeric_type<HyperDual<T>> : __is_numeric_type<T> {};
+
+template <class T>
+struct __get_object_numeric_type<HyperDual<T>> {
+  using type = HyperDual<T>;
+};
+
+template <class T>
+struct __get_a2d_object_type<HyperDual<T>> {
+  static constexpr ADObjType value = ADObjType::SCALAR;
+};
+
+/*
+  Passive values that are promoted to hyper-dual numbers with zero
+  perturbations when mixed with a hyper-dual number
+*/
+template <class R>
+struct __is_hyperdual_passive_type {
+  static const bool value = std::is_arithmetic<R>::value;
+};
+
+/**
+ * @brief Hyper-dual number x = re + e1 * E1 + e2 * E2 + e12 * E1 * E2.
+ *
+ * The perturbations satisfy E1^2 = E2^2 = 0 and E1 * E2 != 0, so evaluating
+ * f at x + E1 * p + E2 * q gives
+ *
+ * f(x) + E1 * f'(x) p + E2 * f'(x) q + E1 * E2 * q^{T} f''(x) p
+ *
+ * exactly: there is no step size and no subtraction, so the first and second
+ * directional derivatives are exact to rounding. The comparisons use the
+ * real part only, so branches are taken as for the real value.
+ *
+ * @tparam T the underlying real type
+ */
+template <typename T>
+class HyperDual {
+ public:
+  using value_type = T;
+
+  A2D_FUNCTION HyperDual() : re(0.0), e1(0.0), e2(0.0), e12(0.0) {}
+
+  // Passive value with zero perturbations
+  template <typename R, std::enable_if_t<__is_hyperdual_passive_type<R>::value,
+                                         bool> = true>
+  A2D_FUNCTION HyperDual(const R r) : re(r), e1(0.0), e2(0.0), e12(0.0) {}
+
+  A2D_FUNCTION HyperDual(const T re, const T e1, const T e2, const T e12)
+      : re(re), e1(e1), e2(e2), e12(e12) {}
+
+  template <typename R, std::enable_if_t<__is_hyperdual_passive_type<R>::value,
+                                         bool> = true>
+  A2D_FUNCTION HyperDual& operator=(const R r) {
+    return *this = HyperDual(r);
+  }
+
+  // Operator +=, -=, *=, /=
+  A2D_FUNCTION HyperDual& operator+=(const HyperDual& r) {
+    re += r.re;
+    e1 += r.e1;
+    e2 += r.e2;
+    e12 += r.e12;
+    return *this;
+  }
+  A2D_FUNCTION HyperDual& operator-=(const HyperDual& r) {
+    re -= r.re;
+    e1 -= r.e1;
+    e2 -= r.e2;
+    e12 -= r.e12;
+    return *this;
+  }
+  A2D_FUNCTION HyperDual& operator*=(const HyperDual& r) {
+    e12 = re * r.e12 + e1 * r.e2 + e2 * r.e1 + e12 * r.re;
+    e1 = re * r.e1 + e1 * r.re;
+    e2 = re * r.e2 + e2 * r.re;
+    re *= r.re;
+    return *this;
+  }
+  A2D_FUNCTION HyperDual& operator/=(const HyperDual& r) {
+    // Multiply by 1/r: f = 1/a, f' = -1/a^2, f'' = 2/a^3
+    T inv = 1.0 / r.re;
+    T d1 = -inv * inv;
+    T d2 = -2.0 * inv * d1;
+    return *this *= HyperDual(inv, d1 * r.e1, d1 * r.e2,
+                              d1 * r.e12 + d2 * r.e1 * r.e2);
+  }
+
+  template <typename R, std::enable_if_t<__is_hyperdual_passive_type<R>::value,
+                                         bool> = true>
+  A2D_FUNCTION HyperDual& operator+=(const R r) {
+    re += r;
+    return *this;
+  }
+  template <typename R, std::enable_if_t<__is_hyperdual_passive_type<R>::value,
+                                         bool> = true>
+  A2D_FUNCTION HyperDual& operator-=(const R r) {
+    re -= r;
+    return *this;
+  }
+  template <typename R, std::enable_if_t<__is_hyperdual_passive_type<R>::value,
+                                         bool> = true>
+  A2D_FUNCTION HyperDual& operator*=(const R r) {
+    re *= r;
+    e1 *= r;
+    e2 *= r;
+    e12 *= r;
+    return *this;
+  }
+  template <typename R, std::enable_if_t<__is_hyperdual_passive_type<R>::value,
+                                         bool> = true>
+  A2D_FUNCTION HyperDual& operator/=(const R r) {
+    return *this *= T(1.0) / T(r);
+  }
+
+  A2D_FUNCTION HyperDual operator-() const {
+    return HyperDual(-re, -e1, -e2, -e12);
+  }
+  A2D_FUNCTION HyperDual operator+() const { return *this; }
+
+  T re;   // Real part
+  T e1;   // Coefficient of E1
+  T e2;   // Coefficient of E2
+  T e12;  // Coefficient of E1 * E2
+};
+
+#define A2D_HYPERDUAL_BINARY_OPERATOR(OP, COMPOUND_OP)                        \
+  template <typename T>                                                       \
+  A2D_FUNCTION inline HyperDual<T> operator OP(const HyperDual<T>& l,         \
+                                               const HyperDual<T>& r) {       \
+    HyperDual<T> out(l);                                                      \
+    return out COMPOUND_OP r;                                                 \
+  }                                                                           \
+  template <typename T, typename R,                                           \
+            std::enable_if_t<__is_hyperdual_passive_type<R>::value, bool> =   \
+                true>                                                         \
+  A2D_FUNCTION inline HyperDual<T> operator OP(const HyperDual<T>& l,         \
+                                               const R r) {                   \
+    HyperDual<T> out(l);                                                      \
+    return out COMPOUND_OP r;                                                 \
+  }                                                                           \
+  template <typename T, typename R,                                           \
+            std::enable_if_t<__is_hyperdual_passive_type<R>::value, bool> =   \
+                true>                                                         \
+  A2D_FUNCTION inline HyperDual<T> operator OP(const R l,                     \
+                                               const HyperDual<T>& r) {       \
+    HyperDual<T> out(l);                                                      \
+    return out COMPOUND_OP r;                                                 \
+  }
+
+A2D_HYPERDUAL_BINARY_OPERATOR(+, +=)
+A2D_HYPERDUAL_BINARY_OPERATOR(-, -=)
+A2D_HYPERDUAL_BINARY_OPERATOR(*, *=)
+A2D_HYPERDUAL_BINARY_OPERATOR(/, /=)
+
+#undef A2D_HYPERDUAL_BINARY_OPERATOR
+
+// Equality compares all the parts, the ordering only the real parts
+template <typename T>
+A2D_FUNCTION inline bool operator==(const HyperDual<T>& l,
+                                    const HyperDual<T>& r) {
+  return l.re == r.re && l.e1 == r.e1 && l.e2 == r.e2 && l.e12 == r.e12;
+}
+template <typename T>
+A2D_FUNCTION inline bool operator!=(const HyperDual<T>& l,
+                                    const HyperDual<T>& r) {
+  return !(l == r);
+}
+
+#define A2D_HYPERDUAL_COMPARISON(OP)                                          \
+  template <typename T>                                                       \
+  A2D_FUNCTION inline bool operator OP(const HyperDual<T>& l,                 \
+                                       const HyperDual<T>& r) {               \
+    return l.re OP r.re;                                                      \
+  }                                                                           \
+  template <typename T, typename R,                                           \
+            std::enable_if_t<__is_hyperdual_passive_type<R>::value, bool> =   \
+                true>                                                         \
+  A2D_FUNCTION inline bool operator OP(const HyperDual<T>& l, const R r) {    \
+    return l.re OP r;                                                         \
+  }                                                                           \
+  template <typename T, typename R,                                           \
+            std::enable_if_t<__is_hyperdual_passive_type<R>::value, bool> =   \
+                true>                                                         \
+  A2D_FUNCTION inline bool operator OP(const R l, const HyperDual<T>& r) {    \
+    return l OP r.re;                                                         \
+  }
+
+A2D_HYPERDUAL_COMPARISON(<)
+A2D_HYPERDUAL_COMPARISON(<=)
+A2D_HYPERDUAL_COMPARISON(>)
+A2D_HYPERDUAL_COMPARISON(>=)
+
+#undef A2D_HYPERDUAL_COMPARISON
+
+/*
+  Apply a function with value f, first derivative df and second derivative
+  d2f at the real part of x to the perturbations of x
+*/
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> __hyperdual_chain(const HyperDual<T>& x,
+                                                   const T f, const T df,
+                                                   const T d2f) {
+  return HyperDual<T>(f, df * x.e1, df * x.e2,
+                      df * x.e12 + d2f * x.e1 * x.e2);
+}
+
+/*
+  The math functions of a2ddefs.h
+*/
+template <typename T>
+A2D_FUNCTION inline double RealPart(const HyperDual<T>& x) {
+  return RealPart(x.re);
+}
+
+template <typename T>
+A2D_FUNCTION inline double ImagPart(const HyperDual<T>& x) {
+  return 0.0;
+}
+
+template <typename T>
+A2D_FUNCTION inline double fmt(const HyperDual<T>& x) {
+  return RealPart(x.re);
+}
+
+template <typename T>
+A2D_FUNCTION inline double absfunc(const HyperDual<T>& x) {
+  return absfunc(x.re);
+}
+
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> fabs(const HyperDual<T>& x) {
+  return x.re < 0.0 ? -x : x;
+}
+
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> fsgn(const HyperDual<T>& x) {
+  return HyperDual<T>(std::copysign(1.0, x.re));
+}
+
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> sqrt(const HyperDual<T>& x) {
+  T f = std::sqrt(x.re);
+  T df = 0.5 / f;
+  return __hyperdual_chain(x, f, df, -0.5 * df / x.re);
+}
+
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> exp(const HyperDual<T>& x) {
+  T f = std::exp(x.re);
+  return __hyperdual_chain(x, f, f, f);
+}
+
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> log(const HyperDual<T>& x) {
+  T df = 1.0 / x.re;
+  return __hyperdual_chain(x, T(std::log(x.re)), df, -df * df);
+}
+
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> sin(const HyperDual<T>& x) {
+  T s = std::sin(x.re);
+  return __hyperdual_chain(x, s, T(std::cos(x.re)), -s);
+}
+
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> cos(const HyperDual<T>& x) {
+  T c = std::cos(x.re);
+  return __hyperdual_chain(x, c, T(-std::sin(x.re)), -c);
+}
+
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> asin(const HyperDual<T>& x) {
+  T df = 1.0 / std::sqrt(1.0 - x.re * x.re);
+  return __hyperdual_chain(x, T(std::asin(x.re)), df, x.re * df * df * df);
+}
+
+template <typename T>
+A2D_FUNCTION inline HyperDual<T> acos(const HyperDual<T>& x) {
+  T df = -1.0 / std::sqrt(1.0 - x.re * x.re);
+  return __hyperdual_chain(x, T(std::acos(x.re)), df, x.re * df * df * df);
+}
+
+template <typename T, typename R,
+          std::enable_if_t<__is_hyperdual_passive_type<R>::value, bool> = true>
+A2D_FUNCTION inline HyperDual<T> pow(const HyperDual<T>& x, R exponent) {
+  T f = std::pow(x.re, exponent);
+  T df = exponent * std::pow(x.re, exponent - 1.0);
+  T d2f = exponent * (exponent - 1.0) * std::pow(x.re, exponent - 2.0);
+  return __hyperdual_chain(x, f, df, d2f);
+}
+
+}  // namespace A2D
+
+#endif  // A2D_HYPER_DUAL_H
@@ -7,68 +7,26 @@
 #include "a2dmat.h"
 #include "a2dstack.h"
 #include "a2dtest.h"
+#include "core/generated/a2disotropicgen.h"
 
 namespace A2D {
 
 template <typename T, int N>
 A2D_FUNCTION void SymIsotropicCore(const T mu, const T lambda, const T E[],
                                    T S[]) {
-  static_assert(N == 2 || N == 3, "SymIsotropicCore must use N == 2 or N == 3");
-
-  if constexpr (N == 2) {
-    T tr = lambda * (E[0] + E[2]);
-    T mu2 = 2.0 * mu;
-    S[0] = mu2 * E[0] + tr;
-    S[1] = mu2 * E[1];
-    S[2] = mu2 * E[2] + tr;
-  } else {
-    T tr = lambda * (E[0] + E[2] + E[5]);
-    T mu2 = 2.0 * mu;
-    S[0] = mu2 * E[0] + tr;
-    S[1] = mu2 * E[1];
-    S[2] = mu2 * E[2] + tr;
-    S[3] = mu2 * E[3];
-    S[4] = mu2 * E[4];
-    S[5] = mu2 * E[5] + tr;
-  }
+  SymIsotropicCoreGen<T, N>(mu, lambda, E, S);
 }
 
 template <typename T, int N>
 A2D_FUNCTION void SymIsotropicAddCore(const T mu, const T lambda, const T E[],
                                       T S[]) {
-  static_assert(N == 2 || N == 3, "SymIsotropicCore must use N == 2 or N == 3");
-
-  if constexpr (N == 2) {
-    T tr = lambda * (E[0] + E[2]);
-    T mu2 = 2.0 * mu;
-    S[0] += mu2 * E[0] + tr;
-    S[1] += mu2 * E[1];
-    S[2] += mu2 * E[2] + tr;
-  } else {
-    T tr = lambda * (E[0] + E[2] + E[5]);
-    T mu2 = 2.0 * mu;
-    S[0] += mu2 * E[0] + tr;
-    S[1] += mu2 * E[1];
-    S[2] += mu2 * E[2] + tr;
-    S[3] += mu2 * E[3];
-    S[4] += mu2 * E[4];
-    S[5] += mu2 * E[5] + tr;
-  }
+  SymIsotropicCoreGen<T, N, true>(mu, lambda, E, S);
 }
 
 template <typename T, int N>
 A2D_FUNCTION void SymIsotropicReverseCoefCore(const T E[], const T Sb[], T& mu,
                                               T& lambda) {
-  static_assert(N == 2 || N == 3, "SymIsotropicCore must use N == 2 or N == 3");
-
-  if constexpr (N == 2) {
-    lambda += (Sb[0] + Sb[2]) * (E[0] + E[2]);
-    mu += 2.0 * (Sb[0] * E[0] + Sb[1] * E[1] + Sb[2] * E[2]);
-  } else {
-    lambda += (Sb[0] + Sb[2] + Sb[5]) * (E[0] + E[2] + E[5]);
-    mu += 2.0 * (Sb[0] * E[0] + Sb[1] * E[1] + Sb[2] * E[2] + Sb[3] * E[3] +
-                 Sb[4] * E[4] + Sb[5] * E[5]);
-  }
+  SymIsotropicReverseCoefCoreGen<T, N>(E, Sb, mu, lambda);
 }
 
 template <typename T, int N>
@@ -232,6 +190,28 @@ A2D_FUNCTION auto SymIsotropic(mutype mu, lamtype lambda, A2DObj<Etype>& E,
       mu, lambda, E, S);
 }
 
+// Structural sparsity of dS/dE
+template <int N>
+constexpr SparsityPattern<(N * (N + 1)) / 2, (N * (N + 1)) / 2>
+SymIsotropicSparsity() {
+  constexpr int size = (N * (N + 1)) / 2;
+  SparsityPattern<size, size> P;
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      int r = j + i * (i + 1) / 2;
+      P.set(r, r);
+
+      // The diagonal entries depend on the trace of E
+      if (i == j) {
+        for (int k = 0; k < N; k++) {
+          P.set(r, k + k * (k + 1) / 2);
+        }
+      }
+    }
+  }
+  return P;
+}
+
 namespace Test {
 
 template <typename T, int N>
@@ -332,6 +312,7 @@ class SymIsotropicTest : public A2DTest<T, SymMat<T, N>, T, T, SymMat<T, N>> {
 inline bool SymIsotropicTestAll(bool component = false,
                                 bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   SymIsotropicConstTest<Tc, 2> test1;
@@ -344,6 +325,17 @@ inline bool SymIsotropicTestAll(bool component = false,
   SymIsotropicTest<Tc, 3> test4;
   passed = passed && Run(test4, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  SymIsotropicConstTest<Td, 2> test5;
+  passed = passed && Run(test5, component, write_output);
+  SymIsotropicConstTest<Td, 3> test6;
+  passed = passed && Run(test6, component, write_output);
+
+  SymIsotropicTest<Td, 2> test7;
+  passed = passed && Run(test7, component, write_output);
+  SymIsotropicTest<Td, 3> test8;
+  passed = passed && Run(test8, component, write_output);
+
   return passed;
 }
 
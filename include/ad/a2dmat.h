@@ -15,44 +15,26 @@ class Mat {
   static const int ncols = N;
 
   A2D_FUNCTION Mat() {
-    for (int i = 0; i < M * N; i++) {
-      A[i] = 0.0;
-    }
+    Unroll<M * N>([&](auto i) { A[i] = 0.0; });
   }
   template <typename T2>
   A2D_FUNCTION Mat(const T2* vals) {
-    for (int i = 0; i < M * N; i++) {
-      A[i] = vals[i];
-    }
+    Unroll<M * N>([&](auto i) { A[i] = vals[i]; });
   }
   template <typename T2>
   A2D_FUNCTION Mat(const Mat<T2, M, N>& src) {
-    for (int i = 0; i < M; i++) {
-      for (int j = 0; j < N; j++) {
-        A[N * i + j] = src(i, j);
-      }
-    }
+    Unroll<M * N>([&](auto i) { A[i] = src[i]; });
   }
   A2D_FUNCTION void zero() {
-    for (int i = 0; i < M * N; i++) {
-      A[i] = 0.0;
-    }
+    Unroll<M * N>([&](auto i) { A[i] = 0.0; });
   }
   template <typename T2>
   A2D_FUNCTION void copy(const Mat<T2, M, N>& src) {
-    for (int i = 0; i < M; i++) {
-      for (int j = 0; j < N; j++) {
-        A[N * i + j] = src(i, j);
-      }
-    }
+    Unroll<M * N>([&](auto i) { A[i] = src[i]; });
   }
   template <typename T2>
   A2D_FUNCTION void get(Mat<T2, M, N>& mat) {
-    for (int i = 0; i < M; i++) {
-      for (int j = 0; j < N; j++) {
-        mat(i, j) = A[N * i + j];
-      }
-    }
+    Unroll<M * N>([&](auto i) { mat[i] = A[i]; });
   }
   template <class IdxType1, class IdxType2>
   A2D_FUNCTION T& operator()(const IdxType1 i, const IdxType2 j) {
@@ -101,60 +83,34 @@ class SymMat {
   static constexpr int ncols = N;
 
   A2D_FUNCTION SymMat() {
-    for (int i = 0; i < MAT_SIZE; i++) {
-      A[i] = 0.0;
-    }
+    Unroll<MAT_SIZE>([&](auto i) { A[i] = 0.0; });
   }
   A2D_FUNCTION SymMat(const T* vals) {
-    for (int i = 0; i < MAT_SIZE; i++) {
-      A[i] = vals[i];
-    }
+    Unroll<MAT_SIZE>([&](auto i) { A[i] = vals[i]; });
   }
   template <typename T2>
   A2D_FUNCTION SymMat(const SymMat<T2, N>& src) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        A[j + i * (i + 1) / 2] = src(i, j);
-      }
-    }
+    Unroll<MAT_SIZE>([&](auto i) { A[i] = src[i]; });
   }
   A2D_FUNCTION void zero() {
-    for (int i = 0; i < MAT_SIZE; i++) {
-      A[i] = 0.0;
-    }
+    Unroll<MAT_SIZE>([&](auto i) { A[i] = 0.0; });
   }
   template <typename T2>
   A2D_FUNCTION void copy(const SymMat<T2, N>& src) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        A[j + i * (i + 1) / 2] = src(i, j);
-      }
-    }
+    Unroll<MAT_SIZE>([&](auto i) { A[i] = src[i]; });
   }
   template <typename T2>
   A2D_FUNCTION void get(SymMat<T2, N>& mat) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        mat(i, j) = A[j + i * (i + 1) / 2];
-      }
-    }
+    Unroll<MAT_SIZE>([&](auto i) { mat[i] = A[i]; });
   }
 
   template <class IdxType1, class IdxType2>
   A2D_FUNCTION T& operator()(const IdxType1 i, const IdxType2 j) {
-    if (i >= j) {
-      return A[j + i * (i + 1) / 2];
-    } else {
-      return A[i + j * (j + 1) / 2];
-    }
+    return A[SymMatIndex<N>(i, j)];
   }
   template <class IdxType1, class IdxType2>
   A2D_FUNCTION const T& operator()(const IdxType1 i, const IdxType2 j) const {
-    if (i >= j) {
-      return A[j + i * (i + 1) / 2];
-    } else {
-      return A[i + j * (j + 1) / 2];
-    }
+    return A[SymMatIndex<N>(i, j)];
   }
 
   A2D_FUNCTION T* get_data() { return A; }
@@ -173,18 +129,124 @@ class SymMat {
   T A[MAT_SIZE];
 };
 
+/*
+  Views of matrices stored in external (caller-owned) memory
+
+  MatView and SymMatView have the same interface and storage layout as Mat
+  and SymMat, but reference the entries through a pointer instead of owning
+  them. They can be used in place of Mat and SymMat in the AD objects, so
+  that the values and seeds of an A2DObj<MatView<T, M, N>> are read and
+  written directly in global arrays. Copy-construction and assignment rebind
+  the view, while copy() copies the entries.
+*/
+template <typename T, int M, int N>
+class MatView {
+ public:
+  typedef T type;
+  static const ADObjType obj_type = ADObjType::MATRIX;
+  static const index_t ncomp = M * N;
+  static const int nrows = M;
+  static const int ncols = N;
+
+  A2D_FUNCTION MatView() : A(nullptr) {}
+  A2D_FUNCTION explicit MatView(T* A) : A(A) {}
+  A2D_FUNCTION MatView(Mat<T, M, N>& mat) : A(mat.get_data()) {}
+
+  A2D_FUNCTION void zero() {
+    Unroll<M * N>([&](auto i) { A[i] = 0.0; });
+  }
+  template <class MatType>
+  A2D_FUNCTION void copy(const MatType& src) {
+    Unroll<M, N>([&](auto i, auto j) { A[N * i + j] = src(i, j); });
+  }
+  template <class MatType>
+  A2D_FUNCTION void get(MatType& mat) {
+    Unroll<M, N>([&](auto i, auto j) { mat(i, j) = A[N * i + j]; });
+  }
+  template <class IdxType1, class IdxType2>
+  A2D_FUNCTION T& operator()(const IdxType1 i, const IdxType2 j) const {
+    return A[N * i + j];
+  }
+
+  A2D_FUNCTION T* get_data() const { return A; }
+
+  template <typename I>
+  A2D_FUNCTION T& operator[](const I i) const {
+    return A[i];
+  }
+
+ private:
+  T* A;
+};
+
+template <typename T, int N>
+class SymMatView {
+ public:
+  typedef T type;
+  static const ADObjType obj_type = ADObjType::SYMMAT;
+  static const int MAT_SIZE = (N * (N + 1)) / 2;
+  static const index_t ncomp = MAT_SIZE;
+  static constexpr int nrows = N;
+  static constexpr int ncols = N;
+
+  A2D_FUNCTION SymMatView() : A(nullptr) {}
+  A2D_FUNCTION explicit SymMatView(T* A) : A(A) {}
+  A2D_FUNCTION SymMatView(SymMat<T, N>& mat) : A(mat.get_data()) {}
+
+  A2D_FUNCTION void zero() {
+    Unroll<MAT_SIZE>([&](auto i) { A[i] = 0.0; });
+  }
+  template <class MatType>
+  A2D_FUNCTION void copy(const MatType& src) {
+    Unroll<N, N>([&](auto i, auto j) {
+      if (j <= i) {
+        A[SymMatIndex<N>(i, j)] = src(i, j);
+      }
+    });
+  }
+  template <class MatType>
+  A2D_FUNCTION void get(MatType& mat) {
+    Unroll<N, N>([&](auto i, auto j) {
+      if (j <= i) {
+        mat(i, j) = A[SymMatIndex<N>(i, j)];
+      }
+    });
+  }
+
+  template <class IdxType1, class IdxType2>
+  A2D_FUNCTION T& operator()(const IdxType1 i, const IdxType2 j) const {
+    return A[SymMatIndex<N>(i, j)];
+  }
+
+  A2D_FUNCTION T* get_data() const { return A; }
+
+  template <typename I>
+  A2D_FUNCTION T& operator[](const I i) const {
+    return A[i];
+  }
+
+ private:
+  T* A;
+};
+
 template <typename T>
 struct is_a2d_matrix : std::false_type {};
 
 template <typename U, int N, int M>
 struct is_a2d_matrix<Mat<U, N, M>> : std::true_type {};
 
+template <typename U, int N, int M>
+struct is_a2d_matrix<MatView<U, N, M>> : std::true_type {};
+
 template <typename T>
 struct is_a2d_sym_matrix : std::false_type {};
 
 template <typename U, int N>
 struct is_a2d_sym_matrix<SymMat<U, N>> : std::true_type {};
 
+template <typename U, int N>
+struct is_a2d_sym_matrix<SymMatView<U, N>> : std::true_type {};
+
 }  // namespace A2D
 
 #endif  // A2D_MAT_H
@@ -8,16 +8,6 @@
 
 namespace A2D {
 
-template <typename T, int N>
-A2D_FUNCTION void MatDet(const Mat<T, N, N>& A, T& det) {
-  det = MatDetCore<T, N>(get_data(A));
-}
-
-template <typename T, int N>
-A2D_FUNCTION void MatDet(const SymMat<T, N>& S, T& det) {
-  det = SymMatDetCore<T, N>(get_data(S));
-}
-
 template <class Atype, class dtype>
 class MatDetExpr {
  public:
@@ -34,8 +24,12 @@ class MatDetExpr {
   // Assert that the matrix is square
   static_assert(N == M, "Matrix must be square");
 
+  // Get the type of the input matrix
+  static constexpr ADiffType adA = get_diff_type<Atype>::diff_type;
+
   // Make sure that the order is correct
-  static_assert(get_diff_order<Atype>::order == order,
+  static_assert(adA == ADiffType::PASSIVE ||
+                    get_diff_order<Atype>::order == order,
                 "ADorder does not match");
 
   A2D_FUNCTION MatDetExpr(Atype& A, dtype& det) : A(A), det(det) {}
@@ -51,13 +45,19 @@ class MatDetExpr {
         "Can't perform second order forward with first order objects");
     constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
                                               ADseed::b, ADseed::p>::value;
-    GetSeed<seed>::get_data(det) =
-        MatDetForwardCore<T, N>(get_data(A), GetSeed<seed>::get_data(A));
+    if constexpr (adA == ADiffType::ACTIVE) {
+      GetSeed<seed>::get_data(det) =
+          MatDetForwardCore<T, N>(get_data(A), GetSeed<seed>::get_data(A));
+    } else {
+      GetSeed<seed>::get_data(det) = T(0.0);
+    }
   }
 
   A2D_FUNCTION void reverse() {
-    MatDetReverseCore<T, N>(GetSeed<ADseed::b>::get_data(det), get_data(A),
-                            GetSeed<ADseed::b>::get_data(A));
+    if constexpr (adA == ADiffType::ACTIVE) {
+      MatDetReverseCore<T, N>(GetSeed<ADseed::b>::get_data(det), get_data(A),
+                              GetSeed<ADseed::b>::get_data(A));
+    }
   }
 
   A2D_FUNCTION void hzero() { det.hzero(); }
@@ -66,10 +66,12 @@ class MatDetExpr {
     static_assert(order == ADorder::SECOND,
                   "hreverse() can be called for only second order objects.");
 
-    MatDetHReverseCore<T, N>(GetSeed<ADseed::b>::get_data(det),
-                             GetSeed<ADseed::h>::get_data(det), get_data(A),
-                             GetSeed<ADseed::p>::get_data(A),
-                             GetSeed<ADseed::h>::get_data(A));
+    if constexpr (adA == ADiffType::ACTIVE) {
+      MatDetHReverseCore<T, N>(GetSeed<ADseed::b>::get_data(det),
+                               GetSeed<ADseed::h>::get_data(det), get_data(A),
+                               GetSeed<ADseed::p>::get_data(A),
+                               GetSeed<ADseed::h>::get_data(A));
+    }
   }
 
   Atype& A;
@@ -88,8 +90,12 @@ class SymMatDetExpr {
   // Get the differentiation order from the output
   static constexpr ADorder order = get_diff_order<dtype>::order;
 
+  // Get the type of the input matrix
+  static constexpr ADiffType adS = get_diff_type<Stype>::diff_type;
+
   // Make sure that the order is correct
-  static_assert(get_diff_order<Stype>::order == order,
+  static_assert(adS == ADiffType::PASSIVE ||
+                    get_diff_order<Stype>::order == order,
                 "ADorder does not match");
 
   A2D_FUNCTION SymMatDetExpr(Stype& S, dtype& det) : S(S), det(det) {}
@@ -105,13 +111,19 @@ class SymMatDetExpr {
         "Can't perform second order forward with first order objects");
     constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
                                               ADseed::b, ADseed::p>::value;
-    GetSeed<seed>::get_data(det) =
-        SymMatDetForwardCore<T, M>(get_data(S), GetSeed<seed>::get_data(S));
+    if constexpr (adS == ADiffType::ACTIVE) {
+      GetSeed<seed>::get_data(det) =
+          SymMatDetForwardCore<T, M>(get_data(S), GetSeed<seed>::get_data(S));
+    } else {
+      GetSeed<seed>::get_data(det) = T(0.0);
+    }
   }
 
   A2D_FUNCTION void reverse() {
-    SymMatDetReverseCore<T, M>(GetSeed<ADseed::b>::get_data(det), get_data(S),
-                               GetSeed<ADseed::b>::get_data(S));
+    if constexpr (adS == ADiffType::ACTIVE) {
+      SymMatDetReverseCore<T, M>(GetSeed<ADseed::b>::get_data(det), get_data(S),
+                                 GetSeed<ADseed::b>::get_data(S));
+    }
   }
 
   A2D_FUNCTION void hzero() { det.hzero(); }
@@ -120,10 +132,12 @@ class SymMatDetExpr {
     static_assert(order == ADorder::SECOND,
                   "hreverse() can be called for only second order objects.");
 
-    SymMatDetHReverseCore<T, M>(GetSeed<ADseed::b>::get_data(det),
-                                GetSeed<ADseed::h>::get_data(det), get_data(S),
-                                GetSeed<ADseed::p>::get_data(S),
-                                GetSeed<ADseed::h>::get_data(S));
+    if constexpr (adS == ADiffType::ACTIVE) {
+      SymMatDetHReverseCore<T, M>(GetSeed<ADseed::b>::get_data(det),
+                                  GetSeed<ADseed::h>::get_data(det),
+                                  get_data(S), GetSeed<ADseed::p>::get_data(S),
+                                  GetSeed<ADseed::h>::get_data(S));
+    }
   }
 
   Stype& S;
@@ -162,6 +176,20 @@ A2D_FUNCTION auto MatDet(A2DObj<Stype>& S, A2DObj<dtype>& det) {
   return SymMatDetExpr<A2DObj<Stype>, A2DObj<dtype>>(S, det);
 }
 
+// Determinants of passive matrices. The determinant is computed immediately
+// and is a passive scalar, see MatInv.
+template <typename T, int N>
+A2D_FUNCTION auto MatDet(const Mat<T, N, N>& A, T& det) {
+  det = MatDetCore<T, N>(get_data(A));
+  return MatDetExpr<const Mat<T, N, N>, T>(A, det);
+}
+
+template <typename T, int N>
+A2D_FUNCTION auto MatDet(const SymMat<T, N>& S, T& det) {
+  det = SymMatDetCore<T, N>(get_data(S));
+  return SymMatDetExpr<const SymMat<T, N>, T>(S, det);
+}
+
 namespace Test {
 
 template <typename T, int N>
@@ -265,6 +293,7 @@ class SymMatDetTest : public A2DTest<T, T, SymMat<T, N>> {
 
 inline bool MatDetTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   MatDetTest<Tc, 2> test1;
@@ -276,6 +305,16 @@ inline bool MatDetTestAll(bool component = false, bool write_output = true) {
   SymMatDetTest<Tc, 3> test4;
   passed = passed && Run(test4, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  MatDetTest<Td, 2> test5;
+  passed = passed && Run(test5, component, write_output);
+  MatDetTest<Td, 3> test6;
+  passed = passed && Run(test6, component, write_output);
+  SymMatDetTest<Td, 2> test7;
+  passed = passed && Run(test7, component, write_output);
+  SymMatDetTest<Td, 3> test8;
+  passed = passed && Run(test8, component, write_output);
+
   return passed;
 }
 
@@ -7,12 +7,16 @@
 #include "a2dtest.h"
 #include "core/a2dgemmcore.h"
 #include "core/a2dmatinvcore.h"
+#include "core/a2dmatveccore.h"
 #include "core/a2dveccore.h"
 
 namespace A2D {
 
 /*
-  Compute Ainv = A^{-1} for small matrices
+  Compute Ainv = A^{-1}. The generated explicit formulas are used up to
+  N = A2D_MAX_GEN_INV_SIZE and the LU factorization with partial pivoting
+  for larger matrices. The derivatives only use the inverse stored in the
+  output, so nothing is re-factored:
 
   dot{Ainv} = - A^{-1} * dot{A} * A^{-1}
 
@@ -21,10 +25,6 @@ namespace A2D {
     = - (A^{-T} * Ap^{T} * Ab + Ab * Ap^{T} * A^{-T})
 */
 
-template <typename T, int N>
-A2D_FUNCTION void MatInv(const Mat<T, N, N> &A, Mat<T, N, N> &Ainv) {
-  MatInvCore<T, N>(get_data(A), get_data(Ainv));
-}
 template <typename T, int N>
 A2D_FUNCTION void MatInv(const SymMat<T, N> &S, SymMat<T, N> &Sinv) {
   SymMatInvCore<T, N>(get_data(S), get_data(Sinv));
@@ -49,8 +49,12 @@ class MatInvExpr {
   // Get the differentiation order from the output
   static constexpr ADorder order = get_diff_order<Btype>::order;
 
+  // Get the type of the input matrix
+  static constexpr ADiffType adA = get_diff_type<Atype>::diff_type;
+
   // Make sure that the order is correct
-  static_assert(get_diff_order<Atype>::order == order,
+  static_assert(adA == ADiffType::PASSIVE ||
+                    get_diff_order<Atype>::order == order,
                 "ADorder does not match");
 
   static constexpr MatOp NORMAL = MatOp::NORMAL;
@@ -70,20 +74,26 @@ class MatInvExpr {
     constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
                                               ADseed::b, ADseed::p>::value;
 
-    T temp[N * N];
-    MatMatMultCore<T, N, N, N, N, N, N, NORMAL, NORMAL>(
-        get_data(Ainv), GetSeed<seed>::get_data(A), temp);
-    MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, NORMAL>(
-        T(-1.0), temp, get_data(Ainv), GetSeed<seed>::get_data(Ainv));
+    if constexpr (adA == ADiffType::ACTIVE) {
+      T temp[N * N];
+      MatMatMultCore<T, N, N, N, N, N, N, NORMAL, NORMAL>(
+          get_data(Ainv), GetSeed<seed>::get_data(A), temp);
+      MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, NORMAL>(
+          T(-1.0), temp, get_data(Ainv), GetSeed<seed>::get_data(Ainv));
+    } else {
+      VecZeroCore<T, N * N>(GetSeed<seed>::get_data(Ainv));
+    }
   }
 
   A2D_FUNCTION void reverse() {
-    T temp[N * N];
-    const bool additive = true;
-    MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, NORMAL>(
-        get_data(Ainv), GetSeed<ADseed::b>::get_data(Ainv), temp);
-    MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, additive>(
-        T(-1.0), temp, get_data(Ainv), GetSeed<ADseed::b>::get_data(A));
+    if constexpr (adA == ADiffType::ACTIVE) {
+      T temp[N * N];
+      const bool additive = true;
+      MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, NORMAL>(
+          get_data(Ainv), GetSeed<ADseed::b>::get_data(Ainv), temp);
+      MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, additive>(
+          T(-1.0), temp, get_data(Ainv), GetSeed<ADseed::b>::get_data(A));
+    }
   }
 
   A2D_FUNCTION void hzero() { Ainv.hzero(); }
@@ -91,33 +101,34 @@ class MatInvExpr {
   A2D_FUNCTION void hreverse() {
     static_assert(order == ADorder::SECOND,
                   "hreverse() can be called for only second order objects.");
-
-    T Ab[N * N], temp[N * N];
-    const bool additive = true;
-
-    // Compute the derivative contribution
-    MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, NORMAL>(
-        get_data(Ainv), GetSeed<ADseed::b>::get_data(Ainv), temp);
-    MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, false>(
-        T(-1.0), temp, get_data(Ainv), Ab);
-
-    // - A^{-T} * Ap^{T} * Ab
-    MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, TRANSPOSE>(
-        get_data(Ainv), GetSeed<ADseed::p>::get_data(A), temp);
-    MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, NORMAL, additive>(
-        T(-1.0), temp, Ab, GetSeed<ADseed::h>::get_data(A));
-
-    // - Ab * Ap^{T} * A^{-T}
-    MatMatMultCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE>(
-        Ab, GetSeed<ADseed::p>::get_data(A), temp);
-    MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, additive>(
-        T(-1.0), temp, get_data(Ainv), GetSeed<ADseed::h>::get_data(A));
-
-    // - A^{-T} * Ainvh * A^{-T}
-    MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, NORMAL>(
-        get_data(Ainv), GetSeed<ADseed::h>::get_data(Ainv), temp);
-    MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, additive>(
-        T(-1.0), temp, get_data(Ainv), GetSeed<ADseed::h>::get_data(A));
+    if constexpr (adA == ADiffType::ACTIVE) {
+      T Ab[N * N], temp[N * N];
+      const bool additive = true;
+
+      // Compute the derivative contribution
+      MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, NORMAL>(
+          get_data(Ainv), GetSeed<ADseed::b>::get_data(Ainv), temp);
+      MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, false>(
+          T(-1.0), temp, get_data(Ainv), Ab);
+
+      // - A^{-T} * Ap^{T} * Ab
+      MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, TRANSPOSE>(
+          get_data(Ainv), GetSeed<ADseed::p>::get_data(A), temp);
+      MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, NORMAL, additive>(
+          T(-1.0), temp, Ab, GetSeed<ADseed::h>::get_data(A));
+
+      // - Ab * Ap^{T} * A^{-T}
+      MatMatMultCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE>(
+          Ab, GetSeed<ADseed::p>::get_data(A), temp);
+      MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, additive>(
+          T(-1.0), temp, get_data(Ainv), GetSeed<ADseed::h>::get_data(A));
+
+      // - A^{-T} * Ainvh * A^{-T}
+      MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, NORMAL>(
+          get_data(Ainv), GetSeed<ADseed::h>::get_data(Ainv), temp);
+      MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, additive>(
+          T(-1.0), temp, get_data(Ainv), GetSeed<ADseed::h>::get_data(A));
+    }
   }
 
   Atype &A;
@@ -134,6 +145,185 @@ A2D_FUNCTION auto MatInv(A2DObj<Atype> &A, A2DObj<Btype> &Ainv) {
   return MatInvExpr<A2DObj<Atype>, A2DObj<Btype>>(A, Ainv);
 }
 
+// Inverse of a passive matrix. The inverse is computed immediately and is a
+// passive matrix, so the operations that use it in a stack see a passive
+// input. The returned operation lets a stack re-evaluate it in eval().
+template <typename T, int N>
+A2D_FUNCTION auto MatInv(const Mat<T, N, N> &A, Mat<T, N, N> &Ainv) {
+  MatInvCore<T, N>(get_data(A), get_data(Ainv));
+  return MatInvExpr<const Mat<T, N, N>, Mat<T, N, N>>(A, Ainv);
+}
+
+/*
+  Solve A * x = b without forming the inverse
+
+  The factorization P * A = L * U is computed once in eval() and stored in
+  the expression, so the derivatives only need triangular solves:
+
+  dot{x} = A^{-1} * (dot{b} - dot{A} * x)
+
+  bb = A^{-T} * xb
+  Ab = - bb * x^{T}
+
+  The second-order terms use t = A^{-T} * xb and x' from forward():
+
+  bh = A^{-T} * (xh - Ap^{T} * t)
+  Ah = - (bh * x^{T} + t * x'^{T})
+*/
+template <typename T, int N>
+A2D_FUNCTION void MatSolve(const Mat<T, N, N> &A, const Vec<T, N> &b,
+                           Vec<T, N> &x) {
+  accum_t<T> LU[N * N];
+  index_t piv[N];
+  MatLUFactorCore<T, N>(get_data(A), LU, piv);
+  MatLUSolveCore<T, N>(LU, piv, get_data(b), get_data(x));
+}
+
+template <class Atype, class btype, class xtype>
+class MatSolveExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<xtype>::type T;
+
+  // Extract the dimensions of the matrix and vectors
+  static constexpr int N = get_matrix_rows<Atype>::size;
+  static constexpr int M = get_matrix_columns<Atype>::size;
+  static constexpr int K = get_vec_size<btype>::size;
+  static constexpr int P = get_vec_size<xtype>::size;
+
+  static_assert(N == M, "Matrix must be square");
+  static_assert(N == K && N == P, "Matrix and vector dimensions must agree");
+
+  // Get the types of the inputs
+  static constexpr ADiffType adA = get_diff_type<Atype>::diff_type;
+  static constexpr ADiffType adb = get_diff_type<btype>::diff_type;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<xtype>::order;
+
+  A2D_FUNCTION MatSolveExpr(Atype &A, btype &b, xtype &x) : A(A), b(b), x(x) {}
+
+  A2D_FUNCTION void eval() {
+    MatLUFactorCore<T, N>(get_data(A), lu.LU, lu.piv);
+    MatLUSolveCore<T, N>(lu.LU, lu.piv, get_data(b), get_data(x));
+  }
+
+  A2D_FUNCTION void bzero() { x.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+
+    T *xd = GetSeed<seed>::get_data(x);
+    if constexpr (adb == ADiffType::ACTIVE) {
+      VecCopyCore<T, N>(GetSeed<seed>::get_data(b), xd);
+    } else {
+      VecZeroCore<T, N>(xd);
+    }
+    if constexpr (adA == ADiffType::ACTIVE) {
+      T temp[N];
+      MatVecCore<T, N, N>(GetSeed<seed>::get_data(A), get_data(x), temp);
+      VecAddCore<T, N>(T(-1.0), temp, xd);
+    }
+    MatLUSolveCore<T, N>(lu.LU, lu.piv, xd, xd);
+  }
+
+  A2D_FUNCTION void reverse() {
+    T t[N];
+    MatLUSolveCore<T, N, TRANSPOSE>(lu.LU, lu.piv,
+                                    GetSeed<ADseed::b>::get_data(x), t);
+    if constexpr (adb == ADiffType::ACTIVE) {
+      VecAddCore<T, N>(t, GetSeed<ADseed::b>::get_data(b));
+    }
+    if constexpr (adA == ADiffType::ACTIVE) {
+      constexpr bool additive = true;
+      VecOuterCore<T, N, N, additive>(T(-1.0), t, get_data(x),
+                                      GetSeed<ADseed::b>::get_data(A));
+    }
+  }
+
+  A2D_FUNCTION void hzero() { x.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+
+    T t[N], th[N];
+    VecCopyCore<T, N>(GetSeed<ADseed::h>::get_data(x), th);
+    if constexpr (adA == ADiffType::ACTIVE) {
+      MatLUSolveCore<T, N, TRANSPOSE>(lu.LU, lu.piv,
+                                      GetSeed<ADseed::b>::get_data(x), t);
+      T temp[N];
+      MatVecCore<T, N, N, TRANSPOSE>(GetSeed<ADseed::p>::get_data(A), t, temp);
+      VecAddCore<T, N>(T(-1.0), temp, th);
+    }
+    MatLUSolveCore<T, N, TRANSPOSE>(lu.LU, lu.piv, th, th);
+
+    if constexpr (adb == ADiffType::ACTIVE) {
+      VecAddCore<T, N>(th, GetSeed<ADseed::h>::get_data(b));
+    }
+    if constexpr (adA == ADiffType::ACTIVE) {
+      constexpr bool additive = true;
+      VecOuterCore<T, N, N, additive>(T(-1.0), th, get_data(x),
+                                      GetSeed<ADseed::h>::get_data(A));
+      VecOuterCore<T, N, N, additive>(T(-1.0), t,
+                                      GetSeed<ADseed::p>::get_data(x),
+                                      GetSeed<ADseed::h>::get_data(A));
+    }
+  }
+
+  // LU factors and pivots of A, computed in eval(), see op_state
+  struct LUFactors {
+    accum_t<T> LU[N * N];
+    index_t piv[N];
+  };
+
+  A2D_FUNCTION LUFactors &state() { return lu; }
+  A2D_FUNCTION const LUFactors &state() const { return lu; }
+
+ private:
+  static constexpr MatOp TRANSPOSE = MatOp::TRANSPOSE;
+
+  Atype &A;
+  btype &b;
+  xtype &x;
+
+  // LU factors and pivots of A
+  LUFactors lu;
+};
+
+template <class Atype, class btype, class xtype>
+A2D_FUNCTION auto MatSolve(ADObj<Atype> &A, ADObj<btype> &b, ADObj<xtype> &x) {
+  return MatSolveExpr<ADObj<Atype>, ADObj<btype>, ADObj<xtype>>(A, b, x);
+}
+template <class Atype, class btype, class xtype>
+A2D_FUNCTION auto MatSolve(A2DObj<Atype> &A, A2DObj<btype> &b,
+                           A2DObj<xtype> &x) {
+  return MatSolveExpr<A2DObj<Atype>, A2DObj<btype>, A2DObj<xtype>>(A, b, x);
+}
+template <class Atype, class btype, class xtype>
+A2D_FUNCTION auto MatSolve(ADObj<Atype> &A, const btype &b, ADObj<xtype> &x) {
+  return MatSolveExpr<ADObj<Atype>, const btype, ADObj<xtype>>(A, b, x);
+}
+template <class Atype, class btype, class xtype>
+A2D_FUNCTION auto MatSolve(A2DObj<Atype> &A, const btype &b,
+                           A2DObj<xtype> &x) {
+  return MatSolveExpr<A2DObj<Atype>, const btype, A2DObj<xtype>>(A, b, x);
+}
+template <class Atype, class btype, class xtype>
+A2D_FUNCTION auto MatSolve(const Atype &A, ADObj<btype> &b, ADObj<xtype> &x) {
+  return MatSolveExpr<const Atype, ADObj<btype>, ADObj<xtype>>(A, b, x);
+}
+template <class Atype, class btype, class xtype>
+A2D_FUNCTION auto MatSolve(const Atype &A, A2DObj<btype> &b,
+                           A2DObj<xtype> &x) {
+  return MatSolveExpr<const Atype, A2DObj<btype>, A2DObj<xtype>>(A, b, x);
+}
+
 namespace Test {
 
 template <typename T, int N>
@@ -149,6 +339,17 @@ class MatInvTest : public A2DTest<T, Mat<T, N, N>, Mat<T, N, N>> {
     return s.str();
   }
 
+  // Shift the diagonal so that the larger matrices are well conditioned
+  void get_point(Input &x) {
+    Mat<T, N, N> A;
+    x.set_rand();
+    x.get_values(A);
+    for (int i = 0; i < N; i++) {
+      A(i, i) += T(N);
+    }
+    x.set_values(A);
+  }
+
   // Evaluate the matrix-matrix product
   Output eval(const Input &x) {
     Mat<T, N, N> A;
@@ -186,14 +387,114 @@ class MatInvTest : public A2DTest<T, Mat<T, N, N>, Mat<T, N, N>> {
   }
 };
 
+template <typename T, int N>
+class MatSolveTest : public A2DTest<T, Vec<T, N>, Mat<T, N, N>, Vec<T, N>> {
+ public:
+  using Input = VarTuple<T, Mat<T, N, N>, Vec<T, N>>;
+  using Output = VarTuple<T, Vec<T, N>>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "MatSolve<" << N << ">";
+    return s.str();
+  }
+
+  // Shift the diagonal so that the matrix is well conditioned
+  void get_point(Input &X) {
+    Mat<T, N, N> A;
+    Vec<T, N> b;
+    X.set_rand();
+    X.get_values(A, b);
+    for (int i = 0; i < N; i++) {
+      A(i, i) += T(N);
+    }
+    X.set_values(A, b);
+  }
+
+  // Evaluate the solution
+  Output eval(const Input &X) {
+    Mat<T, N, N> A;
+    Vec<T, N> b, x;
+    X.get_values(A, b);
+    MatSolve(A, b, x);
+    return MakeVarTuple<T>(x);
+  }
+
+  // Compute the derivative
+  void deriv(const Output &seed, const Input &X, Input &g) {
+    ADObj<Mat<T, N, N>> A;
+    ADObj<Vec<T, N>> b, x;
+
+    X.get_values(A.value(), b.value());
+    auto stack = MakeStack(MatSolve(A, b, x));
+    seed.get_values(x.bvalue());
+    stack.reverse();
+    g.set_values(A.bvalue(), b.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output &seed, const Output &hval, const Input &X,
+             const Input &p, Input &h) {
+    A2DObj<Mat<T, N, N>> A;
+    A2DObj<Vec<T, N>> b, x;
+
+    X.get_values(A.value(), b.value());
+    p.get_values(A.pvalue(), b.pvalue());
+    auto stack = MakeStack(MatSolve(A, b, x));
+    seed.get_values(x.bvalue());
+    hval.get_values(x.hvalue());
+    stack.hproduct();
+    h.set_values(A.hvalue(), b.hvalue());
+  }
+};
+
 inline bool MatInvTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   MatInvTest<Tc, 2> test1;
   passed = passed && Run(test1, component, write_output);
   MatInvTest<Tc, 3> test2;
   passed = passed && Run(test2, component, write_output);
+  MatInvTest<Tc, 4> test3;
+  passed = passed && Run(test3, component, write_output);
+  MatInvTest<Tc, 6> test4;
+  passed = passed && Run(test4, component, write_output);
+
+  // The same tests with exact hyper-dual references
+  MatInvTest<Td, 2> test5;
+  passed = passed && Run(test5, component, write_output);
+  MatInvTest<Td, 3> test6;
+  passed = passed && Run(test6, component, write_output);
+  MatInvTest<Td, 4> test7;
+  passed = passed && Run(test7, component, write_output);
+  MatInvTest<Td, 6> test8;
+  passed = passed && Run(test8, component, write_output);
+
+  return passed;
+}
+
+inline bool MatSolveTestAll(bool component = false, bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
+
+  bool passed = true;
+  MatSolveTest<Tc, 2> test1;
+  passed = passed && Run(test1, component, write_output);
+  MatSolveTest<Tc, 3> test2;
+  passed = passed && Run(test2, component, write_output);
+  MatSolveTest<Tc, 5> test3;
+  passed = passed && Run(test3, component, write_output);
+
+  // The same tests with exact hyper-dual references
+  MatSolveTest<Td, 2> test4;
+  passed = passed && Run(test4, component, write_output);
+  MatSolveTest<Td, 3> test5;
+  passed = passed && Run(test5, component, write_output);
+  MatSolveTest<Td, 5> test6;
+  passed = passed && Run(test6, component, write_output);
 
   return passed;
 }
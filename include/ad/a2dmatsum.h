@@ -217,7 +217,7 @@ class MatSumScaleExpr {
     }
   }
 
-  A2D_FUNCTION void bzero() { B.bzero(); }
+  A2D_FUNCTION void bzero() { C.bzero(); }
 
   A2D_FUNCTION void reverse() {
     constexpr ADseed seed = ADseed::b;
@@ -313,6 +313,12 @@ A2D_FUNCTION auto MatSum(const atype alpha, A2DObj<Atype> &A, const btype beta,
                          A2DObj<Ctype>>(alpha, A, beta, B, C);
 }
 
+// Structural sparsity of dC/dA (and dC/dB) for Mat or SymMat types
+template <class Mattype>
+constexpr SparsityPattern<Mattype::ncomp, Mattype::ncomp> MatSumSparsity() {
+  return IdentitySparsity<Mattype::ncomp>();
+}
+
 namespace Test {
 
 template <typename T, int N, int M>
@@ -411,6 +417,7 @@ class MatSumScaleTest
 
 inline bool MatSumTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   MatSumTest<Tc, 3, 4> test1;
@@ -421,6 +428,15 @@ inline bool MatSumTestAll(bool component = false, bool write_output = true) {
   MatSumScaleTest<Tc, 3, 4> test3;
   passed = passed && Run(test3, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  MatSumTest<Td, 3, 4> test4;
+  passed = passed && Run(test4, component, write_output);
+  MatSumTest<Td, 5, 3> test5;
+  passed = passed && Run(test5, component, write_output);
+
+  MatSumScaleTest<Td, 3, 4> test6;
+  passed = passed && Run(test6, component, write_output);
+
   return passed;
 }
 
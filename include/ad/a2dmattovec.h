@@ -5,6 +5,7 @@
 
 #include "../a2ddefs.h"
 #include "a2dmat.h"
+#include "a2dsparsity.h"
 
 namespace A2D {
 
@@ -171,6 +172,31 @@ A2D_FUNCTION auto MatRowToVec(I row, A2DObj<Atype> &A, A2DObj<xtype> &x) {
   return MatRowToVecExpr<I, A2DObj<Atype>, A2DObj<xtype>>(row, A, x);
 }
 
+// Structural sparsity of dx/dA for x = A(:, column) and an M x N matrix
+template <int M, int N>
+constexpr SparsityPattern<M, M * N> MatColumnToVecSparsity(int column) {
+  SparsityPattern<M, M * N> P;
+  for (int i = 0; i < M; i++) {
+    P.set(i, N * i + column);
+  }
+  return P;
+}
+
+// Structural sparsity of dx/dA for x = A(:, column) and a symmetric matrix
+template <int N>
+constexpr SparsityPattern<N, (N * (N + 1)) / 2> SymMatColumnToVecSparsity(
+    int column) {
+  SparsityPattern<N, (N * (N + 1)) / 2> P;
+  for (int i = 0; i < N; i++) {
+    if (i >= column) {
+      P.set(i, column + i * (i + 1) / 2);
+    } else {
+      P.set(i, i + column * (column + 1) / 2);
+    }
+  }
+  return P;
+}
+
 }  // namespace A2D
 
 #endif  // A2D_MAT_TO_VEC_H
\ No newline at end of file
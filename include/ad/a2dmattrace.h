@@ -294,6 +294,7 @@ class SymTraceTest : public A2DTest<T, T, SymMat<T, N>> {
 
 inline bool MatTraceTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   MatTraceTest<Tc, 2> test1;
@@ -304,6 +305,15 @@ inline bool MatTraceTestAll(bool component = false, bool write_output = true) {
   SymTraceTest<Tc, 4> test3;
   passed = passed && Run(test3, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  MatTraceTest<Td, 2> test4;
+  passed = passed && Run(test4, component, write_output);
+  MatTraceTest<Td, 4> test5;
+  passed = passed && Run(test5, component, write_output);
+
+  SymTraceTest<Td, 4> test6;
+  passed = passed && Run(test6, component, write_output);
+
   return passed;
 }
 
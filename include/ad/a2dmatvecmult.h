@@ -594,11 +594,16 @@ class SymMatVecMultTest
 template <typename T, int N>
 bool SymMatVecMultTestHelper(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<T>;
+  using Td = HyperDual<T>;
 
   bool passed = true;
   SymMatVecMultTest<Tc, N> test1;
   passed = passed && Run(test1, component, write_output);
 
+  // The same test with an exact hyper-dual reference
+  SymMatVecMultTest<Td, N> test2;
+  passed = passed && Run(test2, component, write_output);
+
   return passed;
 }
 
@@ -607,6 +612,7 @@ bool MatVecMultTestHelper(bool component = false, bool write_output = true) {
   const MatOp NORMAL = MatOp::NORMAL;
   const MatOp TRANSPOSE = MatOp::TRANSPOSE;
   using Tc = A2D_complex_t<T>;
+  using Td = HyperDual<T>;
 
   bool passed = true;
   MatVecMultTest<NORMAL, Tc, N, M, M, N> test1;
@@ -615,6 +621,13 @@ bool MatVecMultTestHelper(bool component = false, bool write_output = true) {
   MatVecMultTest<TRANSPOSE, Tc, M, N, M, N> test2;
   passed = passed && Run(test2, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  MatVecMultTest<NORMAL, Td, N, M, M, N> test3;
+  passed = passed && Run(test3, component, write_output);
+
+  MatVecMultTest<TRANSPOSE, Td, M, N, M, N> test4;
+  passed = passed && Run(test4, component, write_output);
+
   return passed;
 }
 
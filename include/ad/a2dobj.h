@@ -542,6 +542,21 @@ template <FEVarType of, FEVarType wrt, typename T, index_t ndata, index_t ngeo,
 using FEMatSelect = Mat<T, get_var_dim<ndata, ngeo, nstate, of>::value,
                         get_var_dim<ndata, ngeo, nstate, wrt>::value>;
 
+/*
+  Detect the views of objects in external memory
+*/
+template <class T>
+struct is_a2d_view : std::false_type {};
+
+template <typename T, int m, int n>
+struct is_a2d_view<MatView<T, m, n>> : std::true_type {};
+
+template <typename T, int m>
+struct is_a2d_view<SymMatView<T, m>> : std::true_type {};
+
+template <typename T, int n>
+struct is_a2d_view<VecView<T, n>> : std::true_type {};
+
 /**
  * @brief Get objects and pointers to seed data (bvalue(), pvalue(), hvalue)
  */
@@ -664,6 +679,27 @@ class GetSeed {
     }
   }
 
+  template <class View,
+            std::enable_if_t<is_a2d_view<View>::value, bool> = true>
+  static A2D_FUNCTION typename View::type* get_data(ADObj<View>& value) {
+    static_assert(seed == ADseed::b, "Incompatible seed type for ADObj");
+    return value.bvalue().get_data();
+  }
+
+  template <class View,
+            std::enable_if_t<is_a2d_view<View>::value, bool> = true>
+  static A2D_FUNCTION typename View::type* get_data(A2DObj<View>& value) {
+    static_assert(seed == ADseed::b or seed == ADseed::p or seed == ADseed::h,
+                  "Incompatible seed type for A2DObj");
+    if constexpr (seed == ADseed::b) {
+      return value.bvalue().get_data();
+    } else if constexpr (seed == ADseed::p) {
+      return value.pvalue().get_data();
+    } else {  // seed == ADseed::h
+      return value.hvalue().get_data();
+    }
+  }
+
   template <typename T, int N>
   static A2D_FUNCTION T* get_data(ADObj<Vec<T, N>&>& value) {
     static_assert(seed == ADseed::b, "Incompatible seed type for ADObj");
@@ -845,6 +881,21 @@ A2D_FUNCTION T* get_data(A2DObj<Vec<T, n>&>& vec) {
   return vec.value().get_data();
 }
 
+template <class View, std::enable_if_t<is_a2d_view<View>::value, bool> = true>
+A2D_FUNCTION typename View::type* get_data(const View& view) {
+  return view.get_data();
+}
+
+template <class View, std::enable_if_t<is_a2d_view<View>::value, bool> = true>
+A2D_FUNCTION typename View::type* get_data(ADObj<View>& view) {
+  return view.value().get_data();
+}
+
+template <class View, std::enable_if_t<is_a2d_view<View>::value, bool> = true>
+A2D_FUNCTION typename View::type* get_data(A2DObj<View>& view) {
+  return view.value().get_data();
+}
+
 // new ADScalar get_data  (SPE)
 template <class T, int N>
 struct __is_numeric_type<ADScalar<T, N>> : std::is_floating_point<T> {};
@@ -0,0 +1,213 @@
+#ifndef A2D_PROFILE_H
+#define A2D_PROFILE_H
+
+#include "../a2ddefs.h"
+
+/*
+  Optional per-operation instrumentation of OperationStack
+
+  When A2D_ENABLE_PROFILING is defined, every call that a stack makes to one
+  of its operations (eval, forward, reverse, hforward, hreverse and the fused
+  reverse sweep of hproduct) is timed and counted. The counters are kept per
+  thread and per expression, keyed by the name of the expression class
+  template (MatMatMultExpr, SymEigsExpr, ...) so that all its instantiations
+  are aggregated. Profile::report() prints the counters of the calling thread
+  sorted by the total number of cycles, and Profile::reset() zeroes them.
+
+  The timings use the time-stamp counter on x86 and nanoseconds from
+  std::chrono::steady_clock elsewhere. Each timed call adds two counter reads,
+  so the counts of very short operations include some overhead.
+
+  When A2D_ENABLE_PROFILING is not defined, A2D_PROFILE_OP expands to nothing
+  and report() and reset() do nothing. Profiling is not available in CUDA
+  device code.
+*/
+
+#if defined(A2D_ENABLE_PROFILING) && !defined(__CUDACC__)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace A2D {
+
+namespace Profile {
+
+enum class Sweep {
+  EVAL,
+  FORWARD,
+  REVERSE,
+  HFORWARD,
+  HREVERSE,
+  HPRODUCT_REVERSE,
+  NUM_SWEEPS
+};
+
+constexpr int num_sweeps = static_cast<int>(Sweep::NUM_SWEEPS);
+
+inline const char* sweep_name(Sweep sweep) {
+  const char* names[] = {"eval",     "forward",  "reverse",
+                         "hforward", "hreverse", "hproduct_reverse"};
+  return names[static_cast<int>(sweep)];
+}
+
+inline std::uint64_t read_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+struct Counters {
+  std::uint64_t cycles[num_sweeps] = {0};
+  std::uint64_t calls[num_sweeps] = {0};
+};
+
+// The counters of the calling thread, keyed by expression name. The entries
+// are never erased, so references to them stay valid.
+inline std::map<std::string, Counters>& counters_table() {
+  thread_local std::map<std::string, Counters> table;
+  return table;
+}
+
+/**
+ * @brief The name of the class template of Op, without namespaces or
+ * template arguments, extracted from the signature of this function
+ */
+template <class Op>
+std::string op_name() {
+  std::string s = __PRETTY_FUNCTION__;
+  std::size_t start = s.find("Op = ");
+  if (start == std::string::npos) {
+    return s;
+  }
+  start += 5;
+  std::size_t end = s.find_first_of("<;]", start);
+  std::string name = s.substr(start, end - start);
+  std::size_t ns = name.rfind("::");
+  if (ns != std::string::npos) {
+    name = name.substr(ns + 2);
+  }
+  return name;
+}
+
+template <class Op>
+Counters& op_counters() {
+  thread_local Counters& c = counters_table()[op_name<Op>()];
+  return c;
+}
+
+/**
+ * @brief Time the enclosing scope and add it to the counters of Op
+ */
+template <class Op>
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Sweep sweep)
+      : sweep(static_cast<int>(sweep)), start(read_cycles()) {}
+  ~ScopedTimer() {
+    std::uint64_t stop = read_cycles();
+    Counters& c = op_counters<Op>();
+    c.cycles[sweep] += stop - start;
+    c.calls[sweep]++;
+  }
+
+ private:
+  int sweep;
+  std::uint64_t start;
+};
+
+/**
+ * @brief Get the counters of an expression on the calling thread
+ *
+ * @param name Name of the expression, for instance "MatMatMultExpr"
+ * @return Pointer to the counters or nullptr if the expression was not timed
+ */
+inline const Counters* find(const std::string& name) {
+  auto& table = counters_table();
+  auto it = table.find(name);
+  return it == table.end() ? nullptr : &it->second;
+}
+
+// Zero the counters of the calling thread
+inline void reset() {
+  for (auto& entry : counters_table()) {
+    entry.second = Counters();
+  }
+}
+
+// Print the counters of the calling thread sorted by the total cycles
+inline void report(std::FILE* fp = stdout) {
+  struct Row {
+    const std::string* name;
+    Sweep sweep;
+    std::uint64_t cycles, calls;
+  };
+
+  std::vector<Row> rows;
+  std::uint64_t total = 0;
+  for (const auto& entry : counters_table()) {
+    for (int k = 0; k < num_sweeps; k++) {
+      if (entry.second.calls[k] > 0) {
+        rows.push_back({&entry.first, static_cast<Sweep>(k),
+                        entry.second.cycles[k], entry.second.calls[k]});
+        total += entry.second.cycles[k];
+      }
+    }
+  }
+  std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+    return a.cycles > b.cycles;
+  });
+
+  std::fprintf(fp, "%-28s %-17s %12s %16s %12s %7s\n", "expression", "sweep",
+               "calls", "cycles", "cycles/call", "%");
+  for (const Row& row : rows) {
+    std::fprintf(fp, "%-28s %-17s %12llu %16llu %12.1f %7.2f\n",
+                 row.name->c_str(), sweep_name(row.sweep),
+                 static_cast<unsigned long long>(row.calls),
+                 static_cast<unsigned long long>(row.cycles),
+                 static_cast<double>(row.cycles) / row.calls,
+                 100.0 * row.cycles / (total > 0 ? total : 1));
+  }
+}
+
+}  // namespace Profile
+
+}  // namespace A2D
+
+#define A2D_PROFILE_OP(Op, sweep)                      \
+  A2D::Profile::ScopedTimer<Op> a2d_profile_op_timer_( \
+      A2D::Profile::Sweep::sweep)
+
+#else  // Profiling disabled
+
+#include <cstdio>
+
+namespace A2D {
+
+namespace Profile {
+
+inline void reset() {}
+inline void report(std::FILE* fp = stdout) {}
+
+}  // namespace Profile
+
+}  // namespace A2D
+
+#define A2D_PROFILE_OP(Op, sweep)
+
+#endif  // A2D_ENABLE_PROFILING
+
+#endif  // A2D_PROFILE_H
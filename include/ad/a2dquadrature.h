@@ -0,0 +1,213 @@
+#ifndef A2D_QUADRATURE_H
+#define A2D_QUADRATURE_H
+
+#include <type_traits>
+#include <utility>
+
+#include "../a2ddefs.h"
+#include "a2dbatch.h"
+#include "a2dobj.h"
+#include "a2dstack.h"
+
+namespace A2D {
+
+/*
+  Element kernels evaluated at all the quadrature points of an element with
+  one stack.
+
+  The objects of the stack have Batch<T, NQ> entries and lane q holds the
+  values at quadrature point q, in structure-of-arrays layout. Element-level
+  objects, such as the nodal state, hold the same values in all the lanes,
+  while point-level objects, such as the basis function gradients, hold
+  different values in each lane. Each sweep of the stack then processes all
+  the points at once, and the seeds are set and zeroed once per element
+  rather than once per point.
+
+  The quadrature weights are applied through the seed of the output: the
+  builder sets lane q of out.bvalue() to the weight of point q (times the
+  Jacobian determinant), so that the sums over the lanes of the derivatives
+  are the integrals.
+
+  The functions below follow JacobianProduct and ExtractJacobian. The
+  direction, residual and Jacobian arguments decide how the lanes are used:
+  an argument with unbatched entries is an element-level quantity, which is
+  broadcast to all the lanes on input and summed over the lanes on output,
+  while an argument with batched entries is copied lane by lane. The objects
+  must be Vec, Mat or SymMat objects.
+*/
+
+namespace detail {
+
+template <class Obj>
+using quadrature_entry_t =
+    typename remove_const_and_refs<decltype(std::declval<Obj&>()[0])>::type;
+
+// Sum of the lanes of a batch, or the value itself
+template <typename T>
+A2D_FUNCTION T QuadratureLaneSum(const T& value) {
+  return value;
+}
+
+template <typename T, int W>
+A2D_FUNCTION T QuadratureLaneSum(const Batch<T, W>& value) {
+  T sum = value[0];
+  for (int k = 1; k < W; k++) {
+    sum += value[k];
+  }
+  return sum;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Copy a batched object, summing the lanes when dest is not batched
+ *
+ * @param src Object with Batch<T, NQ> entries
+ * @param dest Object of the same size with T or Batch<T, NQ> entries
+ */
+template <class Src, class Dest>
+A2D_FUNCTION void QuadratureSum(const Src& src, Dest& dest) {
+  static_assert(Src::ncomp == Dest::ncomp,
+                "Source and destination must have the same size");
+  for (index_t i = 0; i < Dest::ncomp; i++) {
+    if constexpr (is_batch<detail::quadrature_entry_t<Dest>>::value) {
+      dest[i] = src[i];
+    } else {
+      dest[i] = detail::QuadratureLaneSum(src[i]);
+    }
+  }
+}
+
+/**
+ * @brief Compute the residual of all the quadrature points of an element
+ *
+ * res = sum over the points of d(out)/d(of), weighted by the seed of out.
+ * This runs the first-order reverse sweep, so the seeds of the inputs must
+ * be zero.
+ *
+ * @tparam of Residual type
+ * @param stack Stack of operations on Batch<T, NQ> objects
+ * @param data Data object
+ * @param geo Geometry object
+ * @param state State space object
+ * @param res Result - same size as of
+ */
+template <FEVarType of, class Data, class Geo, class State, class RType,
+          class... Operations>
+A2D_FUNCTION void QuadratureResidual(OperationStack<Operations...>& stack,
+                                     A2DObj<Data>& data, A2DObj<Geo>& geo,
+                                     A2DObj<State>& state, RType& res) {
+  stack.reverse();
+  QuadratureSum(
+      detail::select_fe_var<of>(data.bvalue(), geo.bvalue(), state.bvalue()),
+      res);
+}
+
+/**
+ * @brief Compute the Jacobian-vector product of all the quadrature points of
+ * an element
+ *
+ * The direction is broadcast to all the points when it is not batched.
+ *
+ * @tparam of Residual type
+ * @tparam wrt Derivative type
+ * @param stack Stack of operations on Batch<T, NQ> objects
+ * @param data Data object
+ * @param geo Geometry object
+ * @param state State space object
+ * @param p Direction vector - same size as wrt
+ * @param res Result vector - same size as of
+ */
+template <FEVarType of, FEVarType wrt, class Data, class Geo, class State,
+          class PType, class RType, class... Operations>
+A2D_FUNCTION void QuadratureJacobianProduct(
+    OperationStack<Operations...>& stack, A2DObj<Data>& data,
+    A2DObj<Geo>& geo, A2DObj<State>& state, const PType& p, RType& res) {
+  detail::select_fe_var<wrt>(data.pvalue(), geo.pvalue(), state.pvalue())
+      .copy(p);
+  stack.hproduct();
+  QuadratureSum(
+      detail::select_fe_var<of>(data.hvalue(), geo.hvalue(), state.hvalue()),
+      res);
+}
+
+namespace detail {
+
+// The columns of the Jacobian, after the first-order reverse sweep
+template <FEVarType of, FEVarType wrt, class Data, class Geo, class State,
+          class MatType, class... Operations>
+A2D_FUNCTION void QuadratureJacobianColumns(
+    OperationStack<Operations...>& stack, A2DObj<Data>& data,
+    A2DObj<Geo>& geo, A2DObj<State>& state, MatType& jac) {
+  auto& p = select_fe_var<wrt>(data.pvalue(), geo.pvalue(), state.pvalue());
+  auto& Jp = select_fe_var<of>(data.hvalue(), geo.hvalue(), state.hvalue());
+  using PObj = typename remove_const_and_refs<decltype(p)>::type;
+  using JpObj = typename remove_const_and_refs<decltype(Jp)>::type;
+  using JacEntry = typename remove_const_and_refs<decltype(jac(0, 0))>::type;
+
+  p.zero();
+  for (index_t i = 0; i < PObj::ncomp; i++) {
+    if (i > 0) {
+      p[i - 1] = 0.0;
+    }
+    p[i] = 1.0;
+    Jp.zero();
+    stack.hzero();
+
+    stack.hforward();
+    stack.hreverse();
+
+    for (index_t j = 0; j < JpObj::ncomp; j++) {
+      if constexpr (is_batch<JacEntry>::value) {
+        jac(j, i) = Jp[j];
+      } else {
+        jac(j, i) = QuadratureLaneSum(Jp[j]);
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Extract the Jacobian matrix of all the quadrature points of an
+ * element
+ *
+ * Each column takes one second-order forward and reverse sweep over all the
+ * points. The seed of column i is set in all the lanes.
+ *
+ * @tparam of Residual type
+ * @tparam wrt Derivative type
+ * @param stack Stack of operations on Batch<T, NQ> objects
+ * @param data Data object
+ * @param geo Geometry object
+ * @param state State space object
+ * @param jac Output Jacobian matrix
+ */
+template <FEVarType of, FEVarType wrt, class Data, class Geo, class State,
+          class MatType, class... Operations>
+A2D_FUNCTION void QuadratureExtractJacobian(
+    OperationStack<Operations...>& stack, A2DObj<Data>& data,
+    A2DObj<Geo>& geo, A2DObj<State>& state, MatType& jac) {
+  stack.reverse();
+  detail::QuadratureJacobianColumns<of, wrt>(stack, data, geo, state, jac);
+}
+
+/**
+ * @brief Extract the Jacobian matrix of all the quadrature points of an
+ * element, and the residual from the same first-order reverse sweep
+ *
+ * @param res Result - same size as of
+ */
+template <FEVarType of, FEVarType wrt, class Data, class Geo, class State,
+          class RType, class MatType, class... Operations>
+A2D_FUNCTION void QuadratureExtractJacobian(
+    OperationStack<Operations...>& stack, A2DObj<Data>& data,
+    A2DObj<Geo>& geo, A2DObj<State>& state, RType& res, MatType& jac) {
+  QuadratureResidual<of>(stack, data, geo, state, res);
+  detail::QuadratureJacobianColumns<of, wrt>(stack, data, geo, state, jac);
+}
+
+}  // namespace A2D
+
+#endif  // A2D_QUADRATURE_H
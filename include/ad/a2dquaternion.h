@@ -295,10 +295,15 @@ class QuaternionMatrixTest : public A2DTest<T, Mat<T, 3, 3>, Vec<T, 4>> {
 inline bool QuaternionMatrixTestAll(bool component = false,
                                     bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   QuaternionMatrixTest<Tc> test1;
   bool passed = Run(test1, component, write_output);
 
+  // The same test with an exact hyper-dual reference
+  QuaternionMatrixTest<Td> test2;
+  passed = passed && Run(test2, component, write_output);
+
   return passed;
 }
 
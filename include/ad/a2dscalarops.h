@@ -236,6 +236,7 @@ class ScalarTest : public A2DTest<T, T, T, T> {
 
 inline bool ScalarTestAll(bool component, bool write_output) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   ScalarTest<Tc> test1;
@@ -244,6 +245,10 @@ inline bool ScalarTestAll(bool component, bool write_output) {
                               // with certain underlying implementation
   passed = passed && Run(test1, component, write_output);
 
+  // The same test with an exact hyper-dual reference
+  ScalarTest<Td> test2;
+  passed = passed && Run(test2, component, write_output);
+
   return passed;
 }
 
@@ -0,0 +1,171 @@
+#ifndef A2D_SPARSITY_H
+#define A2D_SPARSITY_H
+
+#include "../a2ddefs.h"
+
+namespace A2D {
+
+/*
+  Compile-time structural sparsity of Jacobian (and Hessian) matrices.
+
+  A SparsityPattern<M, N> records which entries of an M x N Jacobian may be
+  non-zero. The patterns of the local Jacobians of the expressions are
+  provided next to the expressions themselves (for instance
+  SymIsotropicSparsity<N>() or MatGreenStrainSparsity<etype, N>()) and can be
+  combined with the chain rule using SparsityProduct, SparsityUnion and
+  SparsityCongruence. Since all of these are constexpr, the pattern of an
+  element map is assembled by the compiler:
+
+    constexpr auto J = MatGreenStrainSparsity<GreenStrainType::LINEAR, 3>();
+    constexpr auto C = SymIsotropicSparsity<3>();
+    constexpr JacobianColouring<9, 9> colouring(SparsityCongruence(J, C));
+
+  The colouring groups structurally orthogonal columns (columns that do not
+  share a non-zero row) so that they can be seeded together and recovered
+  from a single forward/reverse sweep. See OperationStack::hextract.
+*/
+
+template <int M, int N>
+struct SparsityPattern {
+  static constexpr int nrows = M;
+  static constexpr int ncols = N;
+
+  constexpr SparsityPattern() : nz{} {}
+
+  constexpr bool operator()(int i, int j) const { return nz[N * i + j]; }
+  constexpr void set(int i, int j) { nz[N * i + j] = true; }
+
+  // Number of structurally non-zero entries
+  constexpr int nnz() const {
+    int count = 0;
+    for (int k = 0; k < M * N; k++) {
+      count += nz[k];
+    }
+    return count;
+  }
+
+  bool nz[M * N];
+};
+
+template <int M, int N>
+constexpr SparsityPattern<M, N> DenseSparsity() {
+  SparsityPattern<M, N> P;
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < N; j++) {
+      P.set(i, j);
+    }
+  }
+  return P;
+}
+
+template <int N>
+constexpr SparsityPattern<N, N> IdentitySparsity() {
+  SparsityPattern<N, N> P;
+  for (int i = 0; i < N; i++) {
+    P.set(i, i);
+  }
+  return P;
+}
+
+// Pattern of A^{T}
+template <int M, int N>
+constexpr SparsityPattern<N, M> SparsityTranspose(
+    const SparsityPattern<M, N>& A) {
+  SparsityPattern<N, M> P;
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < N; j++) {
+      if (A(i, j)) {
+        P.set(j, i);
+      }
+    }
+  }
+  return P;
+}
+
+// Pattern of A + B
+template <int M, int N>
+constexpr SparsityPattern<M, N> SparsityUnion(const SparsityPattern<M, N>& A,
+                                              const SparsityPattern<M, N>& B) {
+  SparsityPattern<M, N> P;
+  for (int k = 0; k < M * N; k++) {
+    P.nz[k] = A.nz[k] || B.nz[k];
+  }
+  return P;
+}
+
+// Pattern of A * B (the chain rule for the Jacobians of composed maps)
+template <int M, int K, int N>
+constexpr SparsityPattern<M, N> SparsityProduct(
+    const SparsityPattern<M, K>& A, const SparsityPattern<K, N>& B) {
+  SparsityPattern<M, N> P;
+  for (int i = 0; i < M; i++) {
+    for (int k = 0; k < K; k++) {
+      if (A(i, k)) {
+        for (int j = 0; j < N; j++) {
+          if (B(k, j)) {
+            P.set(i, j);
+          }
+        }
+      }
+    }
+  }
+  return P;
+}
+
+// Pattern of J^{T} * H * J, the Hessian of f(g(x)) with respect to x when g
+// is linear, J is the Jacobian of g and H is the Hessian of f. H is
+// symmetrized first so that the pattern of a non-symmetric map (such as
+// SymIsotropicSparsity) can be used in place of the Hessian of f.
+template <int M, int N>
+constexpr SparsityPattern<N, N> SparsityCongruence(
+    const SparsityPattern<M, N>& J, const SparsityPattern<M, M>& H) {
+  auto Hs = SparsityUnion(H, SparsityTranspose(H));
+  return SparsityProduct(SparsityTranspose(J), SparsityProduct(Hs, J));
+}
+
+/**
+ * @brief Greedy colouring of the columns of a Jacobian sparsity pattern
+ *
+ * Columns with the same colour do not share a non-zero row, so the sum of
+ * these columns can be computed with a single Jacobian-vector product and
+ * each entry can be read back from the row it occupies.
+ *
+ * @tparam M Number of rows of the Jacobian
+ * @tparam N Number of columns of the Jacobian
+ */
+template <int M, int N>
+struct JacobianColouring {
+  constexpr JacobianColouring(const SparsityPattern<M, N>& pattern)
+      : pattern(pattern), ncolours(0), colour{} {
+    for (int j = 0; j < N; j++) {
+      // Find the smallest colour not used by a column sharing a row with j
+      bool used[N] = {};
+      for (int i = 0; i < M; i++) {
+        if (pattern(i, j)) {
+          for (int k = 0; k < j; k++) {
+            if (pattern(i, k)) {
+              used[colour[k]] = true;
+            }
+          }
+        }
+      }
+
+      int c = 0;
+      while (used[c]) {
+        c++;
+      }
+      colour[j] = c;
+      if (c + 1 > ncolours) {
+        ncolours = c + 1;
+      }
+    }
+  }
+
+  SparsityPattern<M, N> pattern;
+  int ncolours;
+  int colour[N];
+};
+
+}  // namespace A2D
+
+#endif  // A2D_SPARSITY_H
@@ -1,24 +1,196 @@
 #ifndef A2D_STACK_H
 #define A2D_STACK_H
 
+#include <tuple>
+
 #include "../a2ddefs.h"
 #include "../a2dtuple.h"
+#include "a2dbatch.h"
 #include "a2dobj.h"
+#include "a2dprofile.h"
+#include "a2dsparsity.h"
 #include "a2dtuple.h"
 
 namespace A2D {
 
+/*
+  Compile-time activity analysis of the operations in a stack
+
+  An operation is passive when all of its arguments are passive objects or
+  scalars, except possibly its output, which is the last argument of the
+  expression type. Such an operation computes its output from fixed data, so
+  it only has to be evaluated. An operation with an active input is active,
+  whatever its output. The activity of the objects is part of their type, so
+  the analysis carries through the stack when the outputs of passive
+  operations are passive objects: MatInv(J, Jinv) and MatDet(J, det) with a
+  passive J (for instance a Mat selected with ADObjSelect) take a plain Jinv
+  and det, and the operations that use these see passive inputs in turn.
+
+  A passive operation with an active output (ADObj or A2DObj), such as
+  CachedMatInv with a passive J, is skipped by the forward sweeps, so bzero()
+  and hzero() zero the seeds of its output that these sweeps would set.
+
+  Operations that do not match these rules, for instance those whose
+  arguments are nested expressions, are conservatively treated as active.
+*/
+template <class T>
+struct __is_active_op_arg
+    : std::integral_constant<bool, get_diff_type<typename remove_const_and_refs<
+                                       T>::type>::diff_type ==
+                                       ADiffType::ACTIVE> {};
+
+template <class T, class U = typename remove_const_and_refs<T>::type>
+struct __is_passive_op_arg
+    : std::integral_constant<
+          bool, is_scalar_type<U>::value || std::is_integral<U>::value ||
+                    is_a2d_vector<U>::value || is_a2d_matrix<U>::value ||
+                    is_a2d_sym_matrix<U>::value> {};
+
+template <class... Args>
+struct __op_args_info {
+  static constexpr int num_active = (0 + ... + __is_active_op_arg<Args>::value);
+  static constexpr int num_passive =
+      (0 + ... + __is_passive_op_arg<Args>::value);
+
+  // The output is the last object argument of the expressions
+  static constexpr int output_active = __is_active_op_arg<
+      std::tuple_element_t<sizeof...(Args) - 1, std::tuple<Args...>>>::value;
+
+  // Every input is passive, the output may be active
+  static constexpr bool passive =
+      (num_active == output_active &&
+       num_active + num_passive == sizeof...(Args));
+
+  // No argument is active, the output included
+  static constexpr bool constant = passive && num_active == 0;
+
+  // Does any argument carry second-order seeds
+  static constexpr bool second_order =
+      (false || ... ||
+       (get_diff_order<typename remove_const_and_refs<Args>::type>::order ==
+        ADorder::SECOND));
+};
+
+template <class Op>
+struct __op_info {
+  static constexpr bool passive = false;
+  static constexpr bool constant = false;
+  static constexpr bool second_order = false;
+};
+
+template <template <class...> class Op, class... Args>
+struct __op_info<Op<Args...>> : __op_args_info<Args...> {};
+
+template <template <auto, class...> class Op, auto V, class... Args>
+struct __op_info<Op<V, Args...>> : __op_args_info<Args...> {};
+
+template <template <auto, auto, class...> class Op, auto V1, auto V2,
+          class... Args>
+struct __op_info<Op<V1, V2, Args...>> : __op_args_info<Args...> {};
+
+template <template <class, class, auto> class Op, class A, class B, auto V>
+struct __op_info<Op<A, B, V>> : __op_args_info<A, B> {};
+
+template <class Op>
+struct is_passive_op
+    : std::integral_constant<
+          bool,
+          __op_info<typename remove_const_and_refs<Op>::type>::passive> {};
+
+/*
+  Does the operation have no active object at all, for instance
+  MatInv(J, Jinv) with a plain J and Jinv. Such operations have no seeds.
+*/
+template <class Op>
+struct is_constant_op
+    : std::integral_constant<
+          bool,
+          __op_info<typename remove_const_and_refs<Op>::type>::constant> {};
+
+/*
+  Is the operation applied to second-order (A2DObj) objects
+*/
+template <class Op>
+struct is_second_order_op
+    : std::integral_constant<
+          bool,
+          __op_info<typename remove_const_and_refs<Op>::type>::second_order> {
+};
+
+/*
+  Does the operation provide a combined kernel for the reverse and
+  second-order reverse products, hproduct_reverse()
+*/
+template <class Op, class = void>
+struct has_hproduct_reverse : std::false_type {};
+
+template <class Op>
+struct has_hproduct_reverse<
+    Op, std::void_t<decltype(std::declval<Op &>().hproduct_reverse())>>
+    : std::true_type {};
+
+/*
+  Data that an operation computes in eval() and reads in its derivative
+  sweeps, other than the values of its arguments, for instance the
+  eigenvectors of SymEigs. Operations with such data return it from
+  state(), so that the stack can save and restore it along with the values
+  of the objects (see OperationStack::save_state()).
+*/
+struct NoOpState {};
+
+template <class Op, class = void>
+struct op_state {
+  using type = NoOpState;
+};
+
+template <class Op>
+struct op_state<Op, std::void_t<decltype(std::declval<Op &>().state())>> {
+  using type = typename remove_const_and_refs<decltype(
+      std::declval<Op &>().state())>::type;
+};
+
 template <class... Operations>
 class OperationStack {
  public:
   using StackTuple = a2d_tuple<Operations...>;
   static constexpr index_t num_ops = sizeof...(Operations);
 
+  // Number of operations that take part in the derivative sweeps
+  static constexpr index_t num_active_ops =
+      (0 + ... + !is_passive_op<Operations>::value);
+
+  // Is the operation at the given index active
+  template <index_t index>
+  static constexpr bool is_active = !is_passive_op<
+      typename extract_type_at<index, Operations...>::type>::value;
+
+  // Highest differentiation order of the objects in the stack
+  static constexpr ADorder order =
+      (false || ... || is_second_order_op<Operations>::value)
+          ? ADorder::SECOND
+          : ADorder::FIRST;
+
   A2D_FUNCTION OperationStack(Operations &&...s)
       : stack(a2d_forward<Operations>(s)...) {
     eval_<0>();
   }
 
+  // Re-evaluate all the operations, including the passive ones, after the
+  // values of the inputs have changed. The operations hold references to the
+  // objects, so a stack can be built once (per thread) and re-run at every
+  // point, see README.md.
+  A2D_FUNCTION void eval() { eval_<0>(); }
+
+  // Zero the derivative seeds of the outputs of all operations: the
+  // first-order seeds, and the second-order seeds for a second-order stack.
+  // The seeds of the inputs of the stack are not modified.
+  A2D_FUNCTION void reset() {
+    bzero();
+    if constexpr (order == ADorder::SECOND) {
+      hzero();
+    }
+  }
+
   // First-order AD
   A2D_FUNCTION void bzero() { bzero_<0>(); }
   A2D_FUNCTION void forward() { forward_<0>(); }
@@ -30,25 +202,136 @@ class OperationStack {
   A2D_FUNCTION void hreverse() { hreverse_<num_ops - 1>(); }
 
   // Perform a Hessian-vector product
+  //
+  // This takes two sweeps instead of reverse(), hforward() and hreverse():
+  // the second-order forward sweep, which does not use the adjoints, and a
+  // single reverse sweep in which each operation computes its first- and
+  // second-order adjoints while its data is still in cache. The adjoints of
+  // the outputs of an operation are complete when the sweep reaches it,
+  // since they only depend on the operations that follow it.
+  //
+  // The first-order adjoints do not depend on the direction. For several
+  // products at the same point, call reverse() once and then hzero(),
+  // hforward() and hreverse() for each direction, as hextract() does.
   A2D_FUNCTION void hproduct() {
-    reverse();
     hforward();
-    hreverse();
+    hproduct_reverse_<num_ops - 1>();
   }
 
+  // The op_state data of all the operations
+  using OpState = std::tuple<typename op_state<Operations>::type...>;
+
+  // Save and restore the op_state data. Once the values and the first-order
+  // adjoints of the objects and the op_state data of a point are restored,
+  // hzero(), hforward() and hreverse() can be run without evaluating the
+  // stack again. Operations that keep other data from eval(), such as the
+  // scalar expressions of Eval, cannot be restored this way.
+  void save_state(OpState &s) const { save_state_<0>(s); }
+  void restore_state(const OpState &s) { restore_state_<0>(s); }
+
   // Apply Hessian-vector products to extract derivatives
+  //
+  // When the entries of the input are of type Batch<T, K> (vector mode), the
+  // values and first-order adjoints are replicated across the lanes and each
+  // lane carries its own direction, so that K columns of the Jacobian are
+  // computed with each forward/reverse sweep.
   template <class Input, class Output, class Jacobian>
   A2D_FUNCTION void hextract(Input &p, Output &Jp, Jacobian &jac) {
+    using PType = typename remove_const_and_refs<decltype(p[0])>::type;
+
+    reverse();
+
+    if constexpr (is_batch<PType>::value) {
+      constexpr index_t K = PType::width;
+
+      for (index_t i = 0; i < Input::ncomp; i += K) {
+        p.zero();
+        Jp.zero();
+        hzero();
+
+        // Seed a different direction in each lane
+        for (index_t k = 0; k < K && i + k < Input::ncomp; k++) {
+          p[i + k][k] = 1.0;
+        }
+
+        // Forward sweep
+        hforward();
+
+        // Reverse sweep
+        hreverse();
+
+        // Extract the columns from the lanes
+        for (index_t j = 0; j < Output::ncomp; j++) {
+          for (index_t k = 0; k < K && i + k < Input::ncomp; k++) {
+            jac(j, i + k) = Jp[j][k];
+          }
+        }
+      }
+    } else {
+      for (index_t i = 0; i < Input::ncomp; i++) {
+        // Zero all the intermeidate values. This inter object must include the
+        // input values, and all values included.
+        p.zero();
+        Jp.zero();
+        hzero();
+
+        p[i] = 1.0;
+
+        // Forward sweep
+        hforward();
+
+        // Reverse sweep
+        hreverse();
+
+        // Extract the number of columns
+        for (index_t j = 0; j < Output::ncomp; j++) {
+          jac(j, i) = Jp[j];
+        }
+      }
+    }
+  }
+
+  // Extract derivatives with a known sparsity pattern
+  //
+  // All the columns of the same colour are seeded at once and the entries of
+  // the Jacobian are recovered from the rows of the pattern, so that the
+  // number of forward/reverse sweeps is the number of colours rather than
+  // the number of inputs. Entries outside the pattern are set to zero. Vector
+  // mode is also supported, in which case each lane carries one colour.
+  template <int M, int N, class Input, class Output, class Jacobian>
+  A2D_FUNCTION void hextract(const JacobianColouring<M, N> &colouring,
+                             Input &p, Output &Jp, Jacobian &jac) {
+    static_assert(Input::ncomp == N && Output::ncomp == M,
+                  "Sparsity pattern and Jacobian dimensions must agree");
+    using PType = typename remove_const_and_refs<decltype(p[0])>::type;
+    constexpr index_t K = batch_width<PType>::value;
+
     reverse();
 
-    for (index_t i = 0; i < Input::ncomp; i++) {
-      // Zero all the intermeidate values. This inter object must include the
-      // input values, and all values included.
+    for (index_t j = 0; j < M; j++) {
+      for (index_t i = 0; i < N; i++) {
+        if (!colouring.pattern(j, i)) {
+          jac(j, i) = 0.0;
+        }
+      }
+    }
+
+    for (index_t c = 0; c < colouring.ncolours; c += K) {
       p.zero();
       Jp.zero();
       hzero();
 
-      p[i] = 1.0;
+      // Seed all the columns of colours c, ..., c + K - 1
+      for (index_t i = 0; i < N; i++) {
+        index_t k = colouring.colour[i] - c;
+        if (k >= 0 && k < K) {
+          if constexpr (is_batch<PType>::value) {
+            p[i][k] = 1.0;
+          } else {
+            p[i] = 1.0;
+          }
+        }
+      }
 
       // Forward sweep
       hforward();
@@ -56,9 +339,18 @@ class OperationStack {
       // Reverse sweep
       hreverse();
 
-      // Extract the number of columns
-      for (index_t j = 0; j < Output::ncomp; j++) {
-        jac(j, i) = Jp[j];
+      // Decompress the columns
+      for (index_t j = 0; j < M; j++) {
+        for (index_t i = 0; i < N; i++) {
+          index_t k = colouring.colour[i] - c;
+          if (k >= 0 && k < K && colouring.pattern(j, i)) {
+            if constexpr (is_batch<PType>::value) {
+              jac(j, i) = Jp[j][k];
+            } else {
+              jac(j, i) = Jp[j];
+            }
+          }
+        }
       }
     }
   }
@@ -66,9 +358,19 @@ class OperationStack {
  private:
   StackTuple stack;
 
+  template <index_t index>
+  using op_type = typename extract_type_at<index, Operations...>::type;
+
+  // Does the operation at the given index have seeds to zero
+  template <index_t index>
+  static constexpr bool has_seeds = !is_constant_op<op_type<index>>::value;
+
   template <index_t index>
   A2D_FUNCTION void eval_() {
-    a2d_get<index>(stack).eval();
+    {
+      A2D_PROFILE_OP(op_type<index>, EVAL);
+      a2d_get<index>(stack).eval();
+    }
     if constexpr (index < num_ops - 1) {
       eval_<index + 1>();
     }
@@ -76,7 +378,11 @@ class OperationStack {
 
   template <index_t index>
   A2D_FUNCTION void bzero_() {
-    a2d_get<index>(stack).bzero();
+    // Passive operations included: the b-seeds are also the forward seeds of
+    // first-order objects
+    if constexpr (has_seeds<index>) {
+      a2d_get<index>(stack).bzero();
+    }
     if constexpr (index < num_ops - 1) {
       bzero_<index + 1>();
     }
@@ -84,7 +390,10 @@ class OperationStack {
 
   template <index_t index>
   A2D_FUNCTION void forward_() {
-    a2d_get<index>(stack).template forward<ADorder::FIRST>();
+    if constexpr (is_active<index>) {
+      A2D_PROFILE_OP(op_type<index>, FORWARD);
+      a2d_get<index>(stack).template forward<ADorder::FIRST>();
+    }
     if constexpr (index < num_ops - 1) {
       forward_<index + 1>();
     }
@@ -92,7 +401,10 @@ class OperationStack {
 
   template <index_t index>
   A2D_FUNCTION void reverse_() {
-    a2d_get<index>(stack).reverse();
+    if constexpr (is_active<index>) {
+      A2D_PROFILE_OP(op_type<index>, REVERSE);
+      a2d_get<index>(stack).reverse();
+    }
     if constexpr (index) {
       reverse_<index - 1>();
     }
@@ -100,7 +412,16 @@ class OperationStack {
 
   template <index_t index>
   A2D_FUNCTION void hzero_() {
-    a2d_get<index>(stack).hzero();
+    if constexpr (has_seeds<index>) {
+      a2d_get<index>(stack).hzero();
+    }
+
+    // The forward sweep of a passive operation, which the hforward() sweeps
+    // skip, sets the p-seeds of its output to zero
+    if constexpr (!is_active<index> && has_seeds<index> &&
+                  is_second_order_op<op_type<index>>::value) {
+      a2d_get<index>(stack).template forward<ADorder::SECOND>();
+    }
     if constexpr (index < num_ops - 1) {
       hzero_<index + 1>();
     }
@@ -108,7 +429,10 @@ class OperationStack {
 
   template <index_t index>
   A2D_FUNCTION void hforward_() {
-    a2d_get<index>(stack).template forward<ADorder::SECOND>();
+    if constexpr (is_active<index>) {
+      A2D_PROFILE_OP(op_type<index>, HFORWARD);
+      a2d_get<index>(stack).template forward<ADorder::SECOND>();
+    }
     if constexpr (index < num_ops - 1) {
       hforward_<index + 1>();
     }
@@ -116,17 +440,59 @@ class OperationStack {
 
   template <index_t index>
   A2D_FUNCTION void hreverse_() {
-    a2d_get<index>(stack).hreverse();
+    if constexpr (is_active<index>) {
+      A2D_PROFILE_OP(op_type<index>, HREVERSE);
+      a2d_get<index>(stack).hreverse();
+    }
     if constexpr (index) {
       hreverse_<index - 1>();
     }
   }
+
+  template <index_t index>
+  A2D_FUNCTION void hproduct_reverse_() {
+    if constexpr (is_active<index>) {
+      A2D_PROFILE_OP(op_type<index>, HPRODUCT_REVERSE);
+      if constexpr (has_hproduct_reverse<op_type<index>>::value) {
+        a2d_get<index>(stack).hproduct_reverse();
+      } else {
+        a2d_get<index>(stack).reverse();
+        a2d_get<index>(stack).hreverse();
+      }
+    }
+    if constexpr (index) {
+      hproduct_reverse_<index - 1>();
+    }
+  }
+
+  template <index_t index>
+  void save_state_(OpState &s) const {
+    if constexpr (!std::is_same<typename op_state<op_type<index>>::type,
+                                NoOpState>::value) {
+      std::get<index>(s) = a2d_get<index>(stack).state();
+    }
+    if constexpr (index < num_ops - 1) {
+      save_state_<index + 1>(s);
+    }
+  }
+
+  template <index_t index>
+  void restore_state_(const OpState &s) {
+    if constexpr (!std::is_same<typename op_state<op_type<index>>::type,
+                                NoOpState>::value) {
+      a2d_get<index>(stack).state() = std::get<index>(s);
+    }
+    if constexpr (index < num_ops - 1) {
+      restore_state_<index + 1>(s);
+    }
+  }
 };
 
 /**
  * @brief Make an operations stack for automatic differentiation
  *
- * Operations are evaluated immediately on construction
+ * Operations are evaluated immediately on construction. Passive operations
+ * (see is_passive_op) are skipped by the derivative sweeps.
  *
  * @tparam Operations Template parameter list deduced from context
  * @param s The operator objects
@@ -227,6 +593,51 @@ A2D_FUNCTION void ExtractJacobian(OperationStack<Operations...> &stack,
   }
 }
 
+namespace detail {
+
+// Select the object associated with the variable type var
+template <FEVarType var, class D, class G, class S>
+A2D_FUNCTION auto &select_fe_var(D &data, G &geo, S &state) {
+  if constexpr (var == FEVarType::DATA) {
+    return data;
+  } else if constexpr (var == FEVarType::GEOMETRY) {
+    return geo;
+  } else {
+    return state;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Extract the Jacobian matrix with a known sparsity pattern, seeding
+ * all the structurally orthogonal columns of the same colour at once
+ *
+ * @tparam of Residual type
+ * @tparam wrt Derivative type
+ * @tparam M Number of rows of the Jacobian
+ * @tparam N Number of columns of the Jacobian
+ * @param stack Stack of operations
+ * @param data Data object
+ * @param geo Geometry object
+ * @param state State space object
+ * @param colouring Column colouring of the Jacobian sparsity pattern
+ * @param jac Output Jacobian matrix
+ */
+template <FEVarType of, FEVarType wrt, int M, int N, class Data, class Geo,
+          class State, class MatType, class... Operations>
+A2D_FUNCTION void ExtractJacobian(OperationStack<Operations...> &stack,
+                                  A2DObj<Data> &data, A2DObj<Geo> &geo,
+                                  A2DObj<State> &state,
+                                  const JacobianColouring<M, N> &colouring,
+                                  MatType &jac) {
+  auto &p = detail::select_fe_var<wrt>(data.pvalue(), geo.pvalue(),
+                                       state.pvalue());
+  auto &Jp = detail::select_fe_var<of>(data.hvalue(), geo.hvalue(),
+                                       state.hvalue());
+  stack.hextract(colouring, p, Jp, jac);
+}
+
 }  // namespace A2D
 
 #endif  // A2D_STACK_H
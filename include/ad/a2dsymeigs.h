@@ -2,6 +2,7 @@
 #define A2D_SYM_MAT_EIGS_H
 
 #include "../a2ddefs.h"
+#include "core/a2dveccore.h"
 
 namespace A2D {
 
@@ -49,6 +50,156 @@ A2D_FUNCTION void SymEigs2x2(const T* A, T* eigs, T* Q = nullptr) {
   }
 }
 
+/**
+ * @brief Sort the eigenvalues, and the eigenvectors with them, so that
+ * eigs[0] <= eigs[1] <= eigs[2]
+ *
+ * The compare-and-swap steps use select_less, so the sort has no branches.
+ */
+template <typename T>
+A2D_FUNCTION void SymEigs3x3Sort(T* eigs, T* Q) {
+  constexpr int sort[] = {0, 1, 1, 2, 0, 1};
+  for (int k = 0; k < 6; k += 2) {
+    const int i = sort[k], j = sort[k + 1];
+    const T ei = eigs[i], ej = eigs[j];
+    eigs[i] = select_less(ej, ei, ej, ei);
+    eigs[j] = select_less(ej, ei, ei, ej);
+    if (Q) {
+      for (int l = 0; l < 3; l++) {
+        const T qi = Q[i + 3 * l], qj = Q[j + 3 * l];
+        Q[i + 3 * l] = select_less(ej, ei, qj, qi);
+        Q[j + 3 * l] = select_less(ej, ei, qi, qj);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Compute y = S * x for a 3x3 symmetric matrix in packed storage
+ */
+template <typename T>
+A2D_FUNCTION void SymEigs3x3Mult(const T* S, const T x[], T y[]) {
+  y[0] = S[0] * x[0] + S[1] * x[1] + S[3] * x[2];
+  y[1] = S[1] * x[0] + S[2] * x[1] + S[4] * x[2];
+  y[2] = S[3] * x[0] + S[4] * x[1] + S[5] * x[2];
+}
+
+/**
+ * @brief Compute the eigenvalues and optionally eigenvectors of a 3x3
+ * symmetric matrix in closed form
+ *
+ * The trace-free part K = A - m * I is scaled by sqrt(p) so that the roots of
+ * its characteristic cubic are 2 * cos(phi + 2 * pi * j / 3) (Cardano). The
+ * root furthest from the other two is separated from them by at least
+ * sqrt(3), so its eigenvector is accurately the largest cross product of two
+ * rows of K / sqrt(p) - mu * I. The two other eigenvectors span the
+ * orthogonal complement, in which a single Jacobi rotation diagonalizes K,
+ * also for close or repeated eigenvalues. The eigenvalues are the resulting
+ * Rayleigh quotients of K, which stay accurate as the gaps close.
+ *
+ * The data-dependent choices use select_less, fmin and fmax, so there is a
+ * single code path without branches and T may be a Batch. The eigenvalues
+ * are sorted in ascending order, consistent with SymEigs2x2.
+ *
+ * @param A Symmetric matrix in packed storage
+ * @param eigs Eigenvalues
+ * @param Q Eigenvectors stored column-wise (optional)
+ */
+template <typename T>
+A2D_FUNCTION void SymEigs3x3(const T* A, T* eigs, T* Q = nullptr) {
+  const T zero(0.0), one(1.0);
+
+  // Shift by the mean so that K = A - m * I is trace-free
+  const T m = (A[0] + A[2] + A[5]) / 3.0;
+  const T K[] = {A[0] - m, A[1], A[2] - m, A[3], A[4], A[5] - m};
+  const T off = K[1] * K[1] + K[3] * K[3] + K[4] * K[4];
+  const T p = (K[0] * K[0] + K[2] * K[2] + K[5] * K[5] + 2.0 * off) / 6.0;
+
+  // Kn = K / sqrt(p), which is zero for a multiple of the identity
+  const T inv = 1.0 / sqrt(select_less(zero, p, p, one));
+  T Kn[6];
+  for (int i = 0; i < 6; i++) {
+    Kn[i] = inv * K[i];
+  }
+
+  // r = det(Kn) / 2, clamped against rounding
+  T r = 0.5 * (Kn[0] * (Kn[2] * Kn[5] - Kn[4] * Kn[4]) -
+               Kn[1] * (Kn[1] * Kn[5] - Kn[4] * Kn[3]) +
+               Kn[3] * (Kn[1] * Kn[4] - Kn[2] * Kn[3]));
+  r = fmin(fmax(r, -one), one);
+
+  // The roots are -c - s <= -c + s <= 2 * c. The largest one is isolated
+  // for r >= 0 (phi <= pi / 6), the smallest one otherwise.
+  const T phi = acos(r) / 3.0;
+  const T c = cos(phi);
+  const T s = 1.7320508075688772 * sin(phi);
+  const T mu = select_less(r, zero, -c - s, c + c);
+
+  // Eigenvector of the isolated root: the largest cross product of the rows
+  const T r0[] = {Kn[0] - mu, Kn[1], Kn[3]};
+  const T r1[] = {Kn[1], Kn[2] - mu, Kn[4]};
+  const T r2[] = {Kn[3], Kn[4], Kn[5] - mu};
+  T v[3], x[3];
+  VecCrossCore(r0, r1, v);
+  T norm = VecDotCore<T, 3>(v, v);
+  for (int k = 0; k < 2; k++) {
+    VecCrossCore(k == 0 ? r0 : r1, r2, x);
+    const T n = VecDotCore<T, 3>(x, x);
+    for (int i = 0; i < 3; i++) {
+      v[i] = select_less(norm, n, x[i], v[i]);
+    }
+    norm = fmax(norm, n);
+  }
+
+  // The largest squared norm is at least 3 unless K = 0, then use e_0
+  const T vinv = 1.0 / sqrt(select_less(norm, one, one, norm));
+  v[0] = select_less(norm, one, one, vinv * v[0]);
+  v[1] = select_less(norm, one, zero, vinv * v[1]);
+  v[2] = select_less(norm, one, zero, vinv * v[2]);
+
+  // Orthonormal basis U, V of the complement of v, built from the larger of
+  // v[0] and v[1] so that the norm of U is at least sqrt(1/2)
+  const T a0 = v[0] * v[0], a1 = v[1] * v[1];
+  const T uinv = 1.0 / sqrt(select_less(a0, a1, a1, a0) + v[2] * v[2]);
+  const T U[] = {select_less(a0, a1, zero, -v[2]) * uinv,
+                 select_less(a0, a1, v[2], zero) * uinv,
+                 select_less(a0, a1, -v[1], v[0]) * uinv};
+  T V[3];
+  VecCrossCore(v, U, V);
+
+  // Projection of K on the complement
+  T Kv[3], KU[3], KV[3];
+  SymEigs3x3Mult(K, v, Kv);
+  SymEigs3x3Mult(K, U, KU);
+  SymEigs3x3Mult(K, V, KV);
+  const T b00 = VecDotCore<T, 3>(U, KU);
+  const T b01 = VecDotCore<T, 3>(V, KU);
+  const T b11 = VecDotCore<T, 3>(V, KV);
+
+  // Jacobi rotation that annihilates b01: t = tan of the rotation angle is
+  // the smaller root of t^2 + 2 * theta * t - 1 = 0 with theta = dx / dy,
+  // written without dividing by dy. No rotation is needed when dx = dy = 0.
+  const T dx = b11 - b00, dy = 2.0 * b01;
+  const T den = fmax(dx, -dx) + sqrt(dx * dx + dy * dy);
+  const T t =
+      select_less(dx, zero, -dy, dy) / select_less(zero, den, den, one);
+  const T ct = 1.0 / sqrt(1.0 + t * t);
+  const T st = t * ct;
+
+  eigs[0] = m + VecDotCore<T, 3>(v, Kv);
+  eigs[1] = m + b00 - t * b01;
+  eigs[2] = m + b11 + t * b01;
+
+  if (Q) {
+    for (int i = 0; i < 3; i++) {
+      Q[3 * i] = v[i];
+      Q[3 * i + 1] = ct * U[i] - st * V[i];
+      Q[3 * i + 2] = st * U[i] + ct * V[i];
+    }
+  }
+  SymEigs3x3Sort(eigs, Q);
+}
+
 /**
  * @brief Reduce a symmetric matrix to tridiagonal form
  *
@@ -269,6 +420,19 @@ void TriSymEigs(T* alpha, T* beta, T* Q) {
 
 template <typename T, int N>
 A2D_FUNCTION void SymEigsGeneral(const T* A, T* eigs, T* Q = nullptr) {
+  if constexpr (is_mixed_precision<T>::value) {
+    // Reduce and iterate in the accumulation type
+    using R = accum_t<T>;
+    R a[N * (N + 1) / 2], e[N], q[N * N];
+    ConvertCopyCore<N * (N + 1) / 2>(A, a);
+    SymEigsGeneral<R, N>(a, e, Q ? q : nullptr);
+    ConvertCopyCore<N>(e, eigs);
+    if (Q) {
+      ConvertCopyCore<N * N>(q, Q);
+    }
+    return;
+  }
+
   T Acopy[N * (N + 1) / 2], work[2 * N];
   for (int i = 0; i < N * (N + 1) / 2; i++) {
     Acopy[i] = A[i];
@@ -292,21 +456,21 @@ A2D_FUNCTION void SymEigsForward(const T* eigs, const T* Q, const T* Ad,
                                  T* eigsd) {
   // eigsd[k] = Q[j, k]^{T} * Ad[j, i] * Q[i, k]
   for (int k = 0; k < N; k++) {
-    T value = 0.0;
+    accum_t<T> value = 0.0;
     for (int j = 0; j < N; j++) {
       const T* ad = &Ad[j * (j + 1) / 2];
 
       int i = 0;
       for (; i < j; i++) {
-        value += ad[0] * Q[k + i * N] * Q[k + j * N];
+        value += accum(ad[0]) * Q[k + i * N] * Q[k + j * N];
         ad++;
       }
       for (; i < N; i++) {
-        value += ad[0] * Q[k + i * N] * Q[k + j * N];
+        value += accum(ad[0]) * Q[k + i * N] * Q[k + j * N];
         ad += i + 1;
       }
     }
-    eigsd[k] += value;
+    eigsd[k] = value;
   }
 }
 
@@ -316,9 +480,9 @@ A2D_FUNCTION void SymEigsReverse(const T* eigs, const T* Q, const T* beigs,
   // bA[i, j] = Q[i, k] * beigs[k] * Q[j, k]
   for (int j = 0; j < N; j++) {
     for (int i = 0; i <= j; i++) {
-      T value = 0.0;
+      accum_t<T> value = 0.0;
       for (int k = 0; k < N; k++) {
-        value += beigs[k] * Q[k + i * N] * Q[k + j * N];
+        value += accum(beigs[k]) * Q[k + i * N] * Q[k + j * N];
       }
 
       if (i == j) {
@@ -340,17 +504,17 @@ A2D_FUNCTION void SymEigsHReverse(const T* eigs, const T* Q, const T* beigs,
   T Bp[N * N];
   for (int i = 0; i < N; i++) {
     for (int j = 0; j < N; j++) {
-      T value = 0.0;
+      accum_t<T> value = 0.0;
       for (int l = 0; l < N; l++) {
         const T* ap = &Ap[l * (l + 1) / 2];
 
         int k = 0;
         for (; k < l; k++) {
-          value += ap[0] * Q[i + k * N] * Q[j + l * N];
+          value += accum(ap[0]) * Q[i + k * N] * Q[j + l * N];
           ap++;
         }
         for (; k < N; k++) {
-          value += ap[0] * Q[i + k * N] * Q[j + l * N];
+          value += accum(ap[0]) * Q[i + k * N] * Q[j + l * N];
           ap += k + 1;
         }
       }
@@ -359,14 +523,19 @@ A2D_FUNCTION void SymEigsHReverse(const T* eigs, const T* Q, const T* beigs,
     }
   }
 
-  // Multiply by the F-matrix
+  // Multiply by the F-matrix, Bp[i, j] *= 2.0 * beigs[i] / (eigs[i] - eigs[j]).
+  // The terms of repeated eigenvalues are dropped with select_less instead of
+  // a comparison, so that T may be a Batch.
+  const T zero(0.0), one(1.0);
   for (int i = 0; i < N; i++) {
     for (int j = 0; j < N; j++) {
-      // Bp[i, j] = 2.0 * beigs[i] / (eigs[i] - eigs[j])
-      if (i == j || eigs[i] == eigs[j]) {
-        Bp[j + i * N] = T(0.0);
+      if (i == j) {
+        Bp[j + i * N] = zero;
       } else {
-        Bp[j + i * N] *= 2.0 * beigs[i] / (eigs[i] - eigs[j]);
+        const T gap = eigs[i] - eigs[j];
+        const T agap = select_less(gap, zero, -gap, gap);
+        const T f = 2.0 * beigs[i] / select_less(zero, agap, gap, one);
+        Bp[j + i * N] *= select_less(zero, agap, f, zero);
       }
     }
   }
@@ -375,16 +544,16 @@ A2D_FUNCTION void SymEigsHReverse(const T* eigs, const T* Q, const T* beigs,
   // Ah[i, j] += Q[i, k] * Bp[k, l] * Q[j, l]
   for (int j = 0; j < N; j++) {
     for (int i = 0; i <= j; i++) {
-      T value = 0.0;
+      accum_t<T> value = 0.0;
       for (int k = 0; k < N; k++) {
         for (int l = 0; l < N; l++) {
-          value += Bp[l + k * N] * Q[k + i * N] * Q[l + j * N];
+          value += accum(Bp[l + k * N]) * Q[k + i * N] * Q[l + j * N];
         }
       }
       if (i != j) {
         for (int k = 0; k < N; k++) {
           for (int l = 0; l < N; l++) {
-            value += Bp[l + k * N] * Q[k + j * N] * Q[l + i * N];
+            value += accum(Bp[l + k * N]) * Q[k + j * N] * Q[l + i * N];
           }
         }
       }
@@ -402,6 +571,8 @@ template <typename T, int N>
 A2D_FUNCTION void SymEigs(const SymMat<T, N>& S, Vec<T, N>& eigs) {
   if constexpr (N == 2) {
     SymEigs2x2(get_data(S), get_data(eigs));
+  } else if constexpr (N == 3) {
+    SymEigs3x3(get_data(S), get_data(eigs));
   } else {
     SymEigsGeneral<T, N>(get_data(S), get_data(eigs));
   }
@@ -425,6 +596,8 @@ class SymEigsExpr {
   A2D_FUNCTION void eval() {
     if constexpr (N == 2) {
       SymEigs2x2(get_data(S), get_data(eigs), get_data(Q));
+    } else if constexpr (N == 3) {
+      SymEigs3x3(get_data(S), get_data(eigs), get_data(Q));
     } else {
       SymEigsGeneral<T, N>(get_data(S), get_data(eigs), get_data(Q));
     }
@@ -459,6 +632,10 @@ class SymEigsExpr {
         GetSeed<ADseed::p>::get_data(S), GetSeed<ADseed::h>::get_data(S));
   }
 
+  // The eigenvectors computed in eval(), see op_state
+  A2D_FUNCTION Mat<T, N, N>& state() { return Q; }
+  A2D_FUNCTION const Mat<T, N, N>& state() const { return Q; }
+
  private:
   Stype& S;
   etype& eigs;
@@ -526,6 +703,7 @@ class SymEigsTest : public A2DTest<T, Vec<T, N>, SymMat<T, N>> {
 
 inline bool SymEigsTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   for (int i = 0; i < 10; i++) {
@@ -543,6 +721,20 @@ inline bool SymEigsTestAll(bool component = false, bool write_output = true) {
     passed = passed && Run(test1, component, write_output);
   }
 
+  // The same tests with exact hyper-dual references. The reference for N > 3
+  // differentiates the QL iterations of the general solver twice, which is
+  // only accurate to about 1e-8 for close eigenvalues, so it is left to the
+  // complex step.
+  for (int i = 0; i < 10; i++) {
+    SymEigsTest<Td, 2> test1;
+    passed = passed && Run(test1, component, write_output);
+  }
+
+  for (int i = 0; i < 10; i++) {
+    SymEigsTest<Td, 3> test1;
+    passed = passed && Run(test1, component, write_output);
+  }
+
   return passed;
 }
 
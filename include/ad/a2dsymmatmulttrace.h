@@ -157,6 +157,7 @@ class SymMatMultTraceTest : public A2DTest<T, T, SymMat<T, N>, SymMat<T, N>> {
 inline bool SymMatMultTraceTestAll(bool component = false,
                                    bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   SymMatMultTraceTest<Tc, 2> test1;
@@ -166,6 +167,14 @@ inline bool SymMatMultTraceTestAll(bool component = false,
   SymMatMultTraceTest<Tc, 4> test3;
   passed = passed && Run(test3, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  SymMatMultTraceTest<Td, 2> test4;
+  passed = passed && Run(test4, component, write_output);
+  SymMatMultTraceTest<Td, 3> test5;
+  passed = passed && Run(test5, component, write_output);
+  SymMatMultTraceTest<Td, 4> test6;
+  passed = passed && Run(test6, component, write_output);
+
   return passed;
 }
 
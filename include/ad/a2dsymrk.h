@@ -314,6 +314,7 @@ bool SymMatRKTestHelper(bool component = false, bool write_output = true) {
   const MatOp NORMAL = MatOp::NORMAL;
   const MatOp TRANSPOSE = MatOp::TRANSPOSE;
   using Tc = A2D_complex_t<T>;
+  using Td = HyperDual<T>;
 
   bool passed = true;
   SymMatRKTest<NORMAL, Tc, N, K, N> test1;
@@ -326,6 +327,17 @@ bool SymMatRKTestHelper(bool component = false, bool write_output = true) {
   SymMatRKScaleTest<TRANSPOSE, Tc, N, K, K> test4;
   passed = passed && Run(test4, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  SymMatRKTest<NORMAL, Td, N, K, N> test5;
+  passed = passed && Run(test5, component, write_output);
+  SymMatRKTest<TRANSPOSE, Td, N, K, K> test6;
+  passed = passed && Run(test6, component, write_output);
+
+  SymMatRKScaleTest<NORMAL, Td, N, K, N> test7;
+  passed = passed && Run(test7, component, write_output);
+  SymMatRKScaleTest<TRANSPOSE, Td, N, K, K> test8;
+  passed = passed && Run(test8, component, write_output);
+
   return passed;
 }
 
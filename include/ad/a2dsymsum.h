@@ -12,62 +12,41 @@ namespace A2D {
 
 template <typename T, int N, bool additive = false>
 A2D_FUNCTION void SymMatSumCore(const T A[], T S[]) {
-  if constexpr (additive) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        S[0] += (A[N * i + j] + A[N * j + i]);
-        S++;
-      }
+  UnrollLower<N>([&](auto i, auto j) {
+    if constexpr (additive) {
+      S[SymMatIndex<N>(i, j)] += (A[N * i + j] + A[N * j + i]);
+    } else {
+      S[SymMatIndex<N>(i, j)] = (A[N * i + j] + A[N * j + i]);
     }
-  } else {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        S[0] = (A[N * i + j] + A[N * j + i]);
-        S++;
-      }
-    }
-  }
+  });
 }
 
 template <typename T, int N, bool additive = false>
 A2D_FUNCTION void SymMatSumCore(const T alpha, const T A[], T S[]) {
-  if constexpr (additive) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        S[0] += alpha * (A[N * i + j] + A[N * j + i]);
-        S++;
-      }
-    }
-  } else {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        S[0] = alpha * (A[N * i + j] + A[N * j + i]);
-        S++;
-      }
+  UnrollLower<N>([&](auto i, auto j) {
+    if constexpr (additive) {
+      S[SymMatIndex<N>(i, j)] += alpha * (A[N * i + j] + A[N * j + i]);
+    } else {
+      S[SymMatIndex<N>(i, j)] = alpha * (A[N * i + j] + A[N * j + i]);
     }
-  }
+  });
 }
 
 template <typename T, int N>
 A2D_FUNCTION void SymMatSumCoreReverse(const T alpha, const T Sb[], T Ab[]) {
-  for (int i = 0; i < N; i++) {
-    for (int j = 0; j <= i; j++) {
-      Ab[N * i + j] += alpha * Sb[0];
-      Ab[N * j + i] += alpha * Sb[0];
-      Sb++;
-    }
-  }
+  UnrollLower<N>([&](auto i, auto j) {
+    const T sb = Sb[SymMatIndex<N>(i, j)];
+    Ab[N * i + j] += alpha * sb;
+    Ab[N * j + i] += alpha * sb;
+  });
 }
 
 template <typename T, int N>
 A2D_FUNCTION T SymMatSumCoreReverse(const T A[], const T Sb[]) {
   T val = 0.0;
-  for (int i = 0; i < N; i++) {
-    for (int j = 0; j <= i; j++) {
-      val += Sb[0] * (A[N * i + j] + A[N * j + i]);
-      Sb++;
-    }
-  }
+  UnrollLower<N>([&](auto i, auto j) {
+    val += Sb[SymMatIndex<N>(i, j)] * (A[N * i + j] + A[N * j + i]);
+  });
   return val;
 }
 
@@ -323,6 +302,7 @@ class SymMatSumScaleTest : public A2DTest<T, SymMat<T, N>, T, Mat<T, N, N>> {
 
 inline bool SymMatSumTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   SymMatSumTest<Tc, 4> test1;
@@ -331,6 +311,13 @@ inline bool SymMatSumTestAll(bool component = false, bool write_output = true) {
   SymMatSumScaleTest<Tc, 3> test2;
   passed = passed && Run(test2, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  SymMatSumTest<Td, 4> test3;
+  passed = passed && Run(test3, component, write_output);
+
+  SymMatSumScaleTest<Td, 3> test4;
+  passed = passed && Run(test4, component, write_output);
+
   return passed;
 }
 
@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <iostream>
 
+#include "a2dhyperdual.h"
 #include "a2dobj.h"
 #include "a2dstack.h"
 #include "a2dvartuple.h"
@@ -148,7 +149,7 @@ class A2DTest {
    *
    * @param out Where to write the result
    * @param test_value The test value (computed using AD)
-   * @param ref_value The reference value (usually complex-step)
+   * @param ref_value The reference value (complex-step or hyper-dual)
    */
   void write_result(std::string str, std::ostream& out, const T test_value,
                     const T ref_value) {
@@ -161,7 +162,8 @@ class A2DTest {
 
     out << std::scientific << std::setprecision(9) << str
         << " AD: " << std::setw(17) << RealPart(test_value)
-        << " CS: " << std::setw(17) << RealPart(ref_value)
+        << (is_hyperdual_v<T> ? " HD: " : " CS: ") << std::setw(17)
+        << RealPart(ref_value)
         << " Rel Err: " << std::setw(17) << RealPart(rel_err)
         << " Abs Err: " << std::setw(17) << RealPart(abs_err);
     if (passed) {
@@ -346,6 +348,120 @@ bool Run(A2DTest<A2D_complex_t<T>, Output, Inputs...>& test,
   return passed;
 }
 
+/**
+ * Run the AD test with exact hyper-dual reference derivatives
+ *
+ * For each direction p (random, or each unit vector for a component test),
+ * the output f is evaluated at x + E1 * p + E2 * q. This gives the first
+ * directional derivative and the projection onto q of the Hessian-vector
+ * product h from hprod(), which includes the second-order seed hvalue:
+ *
+ * p^{T} g = seed^{T} f_{E1}
+ * q^{T} h = seed^{T} f_{E1E2} + hvalue^{T} f_{E2}
+ *
+ * q is random for a projection test. A component test evaluates f once for
+ * each unit vector q = e_i, which checks every entry of h.
+ *
+ * No step size is involved, so both checks hold to rounding.
+ */
+template <typename T, class Output, class... Inputs>
+bool Run(A2DTest<HyperDual<T>, Output, Inputs...>& test,
+         bool component = false, bool write_output = true) {
+  using Td = HyperDual<T>;
+
+  // Declare all of the variables needed
+  VarTuple<Td, Inputs...> x, g, x1, p, q, h;
+  VarTuple<Td, Output> seed, hvalue;
+
+  TestType test_type = test.get_test_type();
+  if (test_type == TestType::FIRST_ORDER_INTEGRATION ||
+      test_type == TestType::SECOND_ORDER_INTEGRATION) {
+    // Set a random seed input
+    seed.set_rand();
+    hvalue.set_rand();
+  } else {
+    for (int i = 0; i < seed.get_num_components(); i++) {
+      seed[i] = T(1.0);
+      hvalue[i] = T(0.0);
+    }
+  }
+  bool second_order = (test_type == TestType::SECOND_ORDER ||
+                       test_type == TestType::SECOND_ORDER_INTEGRATION);
+
+  // Get the starting point and the gradient
+  test.get_point(x);
+  test.deriv(seed, x, g);
+
+  bool passed = true;
+  int ndirs = component ? p.get_num_components() : 1;
+  int nproj = (component && second_order) ? q.get_num_components() : 1;
+  for (int k = 0; k < ndirs; k++) {
+    if (component) {
+      p.zero();
+      p[k] = T(1.0);
+    } else {
+      p.set_rand();
+    }
+
+    if (second_order) {
+      test.hprod(seed, hvalue, x, p, h);
+    }
+
+    for (int j = 0; j < nproj; j++) {
+      if (component) {
+        q.zero();
+        q[j] = T(1.0);
+      } else {
+        q.set_rand();
+      }
+
+      // Set x1 = x + E1 * p + E2 * q
+      for (index_t i = 0; i < x.get_num_components(); i++) {
+        x1[i] = Td(x[i].re, p[i].re, q[i].re, T(0.0));
+      }
+      VarTuple<Td, Output> value = test.eval(x1);
+
+      // Compare p^{T} g, which does not depend on q
+      T ref = 0.0, ans = 0.0;
+      if (j == 0) {
+        for (index_t i = 0; i < value.get_num_components(); i++) {
+          ref += value[i].e1 * seed[i].re;
+        }
+        for (index_t i = 0; i < x.get_num_components(); i++) {
+          ans += g[i].re * p[i].re;
+        }
+
+        passed = passed && test.is_close(ans, ref);
+
+        if (write_output) {
+          test.write_result(test.name() + " first-order", std::cout, ans,
+                            ref);
+        }
+      }
+
+      // Compare q^{T} h
+      if (second_order) {
+        ref = 0.0, ans = 0.0;
+        for (index_t i = 0; i < value.get_num_components(); i++) {
+          ref += value[i].e12 * seed[i].re + value[i].e2 * hvalue[i].re;
+        }
+        for (index_t i = 0; i < x.get_num_components(); i++) {
+          ans += h[i].re * q[i].re;
+        }
+
+        passed = passed && test.is_close(ans, ref);
+
+        if (write_output) {
+          test.write_result(test.name() + " second-order", std::cout, ans,
+                            ref);
+        }
+      }
+    }
+  }
+
+  return passed;
+}
+
 }  // namespace Test
 
 }  // namespace A2D
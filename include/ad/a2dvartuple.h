@@ -7,6 +7,7 @@
 #include "../a2ddefs.h"
 #include "../a2dtuple.h"
 #include "../adscalar.h"
+#include "a2dhyperdual.h"
 #include "a2dobj.h"
 
 namespace A2D {
@@ -26,7 +27,8 @@ struct __is_adscalar<ADScalar<T, 1>> : public std::true_type {};
 template <typename T>
 struct __is_scalar_type {
   static const bool value = std::is_arithmetic<T>::value ||
-                            __is_complex<T>::value || __is_adscalar<T>::value;
+                            __is_complex<T>::value || __is_adscalar<T>::value ||
+                            is_hyperdual<T>::value;
 };
 
 struct __basic_arithmetic_type {
@@ -13,32 +13,22 @@ class Vec {
   static const index_t ncomp = N;
 
   A2D_FUNCTION Vec() {
-    for (int i = 0; i < N; i++) {
-      V[i] = 0.0;
-    }
+    Unroll<N>([&](auto i) { V[i] = 0.0; });
   }
   template <typename T2>
   A2D_FUNCTION Vec(const T2* vals) {
-    for (int i = 0; i < N; i++) {
-      V[i] = vals[i];
-    }
+    Unroll<N>([&](auto i) { V[i] = vals[i]; });
   }
   template <typename T2>
   A2D_FUNCTION Vec(const Vec<T2, N>& src) {
-    for (int i = 0; i < N; i++) {
-      V[i] = src(i);
-    }
+    Unroll<N>([&](auto i) { V[i] = src(i); });
   }
   A2D_FUNCTION void zero() {
-    for (int i = 0; i < N; i++) {
-      V[i] = 0.0;
-    }
+    Unroll<N>([&](auto i) { V[i] = 0.0; });
   }
   template <typename T2>
   A2D_FUNCTION void copy(const Vec<T2, N>& vec) {
-    for (int i = 0; i < N; i++) {
-      V[i] = vec(i);
-    }
+    Unroll<N>([&](auto i) { V[i] = vec(i); });
   }
   template <class IdxType>
   A2D_FUNCTION T& operator()(const IdxType i) {
@@ -65,12 +55,52 @@ class Vec {
   T V[N];
 };
 
+/*
+  View of a vector stored in external (caller-owned) memory, see MatView
+*/
+template <typename T, int N>
+class VecView {
+ public:
+  typedef T type;
+  static const ADObjType obj_type = ADObjType::VECTOR;
+  static const index_t ncomp = N;
+
+  A2D_FUNCTION VecView() : V(nullptr) {}
+  A2D_FUNCTION explicit VecView(T* V) : V(V) {}
+  A2D_FUNCTION VecView(Vec<T, N>& vec) : V(vec.get_data()) {}
+
+  A2D_FUNCTION void zero() {
+    Unroll<N>([&](auto i) { V[i] = 0.0; });
+  }
+  template <class VecType>
+  A2D_FUNCTION void copy(const VecType& vec) {
+    Unroll<N>([&](auto i) { V[i] = vec(i); });
+  }
+  template <class IdxType>
+  A2D_FUNCTION T& operator()(const IdxType i) const {
+    return V[i];
+  }
+
+  A2D_FUNCTION T* get_data() const { return V; }
+
+  template <typename I>
+  A2D_FUNCTION T& operator[](const I i) const {
+    return V[i];
+  }
+
+ private:
+  T* V;
+};
+
 template <typename T>
 struct is_a2d_vector : std::false_type {};
 
 template <typename U, int N>
 struct is_a2d_vector<Vec<U, N>> : std::true_type {};
 
+template <typename U, int N>
+struct is_a2d_vector<VecView<U, N>> : std::true_type {};
+
 }  // namespace A2D
 
 #endif  // A2D_VEC_H
@@ -426,6 +426,7 @@ class VecCross2DTest : public A2DTest<T, Vec<T, 2>, Vec<T, 2>, T> {
 
 inline bool VecCrossTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   VecCross3DTest<Tc> test1;
@@ -434,6 +435,13 @@ inline bool VecCrossTestAll(bool component = false, bool write_output = true) {
   VecCross2DTest<Tc> test2;
   passed = passed && Run(test2, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  VecCross3DTest<Td> test3;
+  passed = passed && Run(test3, component, write_output);
+
+  VecCross2DTest<Td> test4;
+  passed = passed && Run(test4, component, write_output);
+
   return passed;
 }
 
@@ -464,6 +464,7 @@ class VecNormTest : public A2DTest<T, T, Vec<T, N>> {
 
 inline bool VecNormTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   VecNormTest<Tc, 3> test1;
@@ -471,6 +472,12 @@ inline bool VecNormTestAll(bool component = false, bool write_output = true) {
   VecNormTest<Tc, 6> test2;
   passed = passed && Run(test2, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  VecNormTest<Td, 3> test3;
+  passed = passed && Run(test3, component, write_output);
+  VecNormTest<Td, 6> test4;
+  passed = passed && Run(test4, component, write_output);
+
   return passed;
 }
 
@@ -520,6 +527,7 @@ class VecScaleTest : public A2DTest<T, Vec<T, N>, T, Vec<T, N>> {
 
 inline bool VecScaleTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   VecScaleTest<Tc, 3> test1;
@@ -527,6 +535,12 @@ inline bool VecScaleTestAll(bool component = false, bool write_output = true) {
   VecScaleTest<Tc, 6> test2;
   passed = passed && Run(test2, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  VecScaleTest<Td, 3> test3;
+  passed = passed && Run(test3, component, write_output);
+  VecScaleTest<Td, 6> test4;
+  passed = passed && Run(test4, component, write_output);
+
   return passed;
 }
 
@@ -574,6 +588,7 @@ class VecNormalizeTest : public A2DTest<T, Vec<T, N>, Vec<T, N>> {
 inline bool VecNormalizeTestAll(bool component = false,
                                 bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   VecNormalizeTest<Tc, 3> test1;
@@ -581,6 +596,12 @@ inline bool VecNormalizeTestAll(bool component = false,
   VecNormalizeTest<Tc, 6> test2;
   passed = passed && Run(test2, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  VecNormalizeTest<Td, 3> test3;
+  passed = passed && Run(test3, component, write_output);
+  VecNormalizeTest<Td, 6> test4;
+  passed = passed && Run(test4, component, write_output);
+
   return passed;
 }
 
@@ -630,6 +651,7 @@ class VecDotTest : public A2DTest<T, T, Vec<T, N>, Vec<T, N>> {
 
 inline bool VecDotTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   VecDotTest<Tc, 3> test1;
@@ -637,6 +659,12 @@ inline bool VecDotTestAll(bool component = false, bool write_output = true) {
   VecDotTest<Tc, 6> test2;
   passed = passed && Run(test2, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  VecDotTest<Td, 3> test3;
+  passed = passed && Run(test3, component, write_output);
+  VecDotTest<Td, 6> test4;
+  passed = passed && Run(test4, component, write_output);
+
   return passed;
 }
 
@@ -217,6 +217,7 @@ class VecOuterTest : public A2DTest<T, Mat<T, N, M>, Vec<T, N>, Vec<T, M>> {
 
 inline bool VecOuterTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   VecOuterTest<Tc, 3, 5> test1;
@@ -224,6 +225,12 @@ inline bool VecOuterTestAll(bool component = false, bool write_output = true) {
   VecOuterTest<Tc, 6, 4> test2;
   passed = passed && Run(test2, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  VecOuterTest<Td, 3, 5> test3;
+  passed = passed && Run(test3, component, write_output);
+  VecOuterTest<Td, 6, 4> test4;
+  passed = passed && Run(test4, component, write_output);
+
   return passed;
 }
 
@@ -417,6 +417,7 @@ class VecSumScaleTest
 
 inline bool VecSumTestAll(bool component = false, bool write_output = true) {
   using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
 
   bool passed = true;
   VecSumTest<Tc, 3> test1;
@@ -427,6 +428,15 @@ inline bool VecSumTestAll(bool component = false, bool write_output = true) {
   VecSumScaleTest<Tc, 4> test3;
   passed = passed && Run(test3, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  VecSumTest<Td, 3> test4;
+  passed = passed && Run(test4, component, write_output);
+  VecSumTest<Td, 5> test5;
+  passed = passed && Run(test5, component, write_output);
+
+  VecSumScaleTest<Td, 4> test6;
+  passed = passed && Run(test6, component, write_output);
+
   return passed;
 }
 
@@ -4,6 +4,8 @@
 #include <stdexcept>
 
 #include "../../a2ddefs.h"
+#include "a2dgemmsimdcore.h"
+#include "generated/a2dgemmgen.h"
 
 namespace A2D {
 
@@ -20,188 +22,6 @@ struct int_conditional<false, i, j> {
   static constexpr int value = j;
 };
 
-template <typename T, MatOp opA = MatOp::NORMAL, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void MatMatMultCore3x3(const T A[], const T B[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL and opB == MatOp::NORMAL) {
-    C[0] = A[0] * B[0] + A[1] * B[3] + A[2] * B[6];
-    C[1] = A[0] * B[1] + A[1] * B[4] + A[2] * B[7];
-    C[2] = A[0] * B[2] + A[1] * B[5] + A[2] * B[8];
-    C[3] = A[3] * B[0] + A[4] * B[3] + A[5] * B[6];
-    C[4] = A[3] * B[1] + A[4] * B[4] + A[5] * B[7];
-    C[5] = A[3] * B[2] + A[4] * B[5] + A[5] * B[8];
-    C[6] = A[6] * B[0] + A[7] * B[3] + A[8] * B[6];
-    C[7] = A[6] * B[1] + A[7] * B[4] + A[8] * B[7];
-    C[8] = A[6] * B[2] + A[7] * B[5] + A[8] * B[8];
-  } else if constexpr (opA == MatOp::TRANSPOSE and opB == MatOp::NORMAL) {
-    C[0] = A[0] * B[0] + A[3] * B[3] + A[6] * B[6];
-    C[1] = A[0] * B[1] + A[3] * B[4] + A[6] * B[7];
-    C[2] = A[0] * B[2] + A[3] * B[5] + A[6] * B[8];
-    C[3] = A[1] * B[0] + A[4] * B[3] + A[7] * B[6];
-    C[4] = A[1] * B[1] + A[4] * B[4] + A[7] * B[7];
-    C[5] = A[1] * B[2] + A[4] * B[5] + A[7] * B[8];
-    C[6] = A[2] * B[0] + A[5] * B[3] + A[8] * B[6];
-    C[7] = A[2] * B[1] + A[5] * B[4] + A[8] * B[7];
-    C[8] = A[2] * B[2] + A[5] * B[5] + A[8] * B[8];
-  } else if constexpr (opA == MatOp::NORMAL and opB == MatOp::TRANSPOSE) {
-    C[0] = A[0] * B[0] + A[1] * B[1] + A[2] * B[2];
-    C[1] = A[0] * B[3] + A[1] * B[4] + A[2] * B[5];
-    C[2] = A[0] * B[6] + A[1] * B[7] + A[2] * B[8];
-    C[3] = A[3] * B[0] + A[4] * B[1] + A[5] * B[2];
-    C[4] = A[3] * B[3] + A[4] * B[4] + A[5] * B[5];
-    C[5] = A[3] * B[6] + A[4] * B[7] + A[5] * B[8];
-    C[6] = A[6] * B[0] + A[7] * B[1] + A[8] * B[2];
-    C[7] = A[6] * B[3] + A[7] * B[4] + A[8] * B[5];
-    C[8] = A[6] * B[6] + A[7] * B[7] + A[8] * B[8];
-  } else if constexpr (opA == MatOp::TRANSPOSE and opB == MatOp::TRANSPOSE) {
-    C[0] = A[0] * B[0] + A[3] * B[1] + A[6] * B[2];
-    C[1] = A[0] * B[3] + A[3] * B[4] + A[6] * B[5];
-    C[2] = A[0] * B[6] + A[3] * B[7] + A[6] * B[8];
-    C[3] = A[1] * B[0] + A[4] * B[1] + A[7] * B[2];
-    C[4] = A[1] * B[3] + A[4] * B[4] + A[7] * B[5];
-    C[5] = A[1] * B[6] + A[4] * B[7] + A[7] * B[8];
-    C[6] = A[2] * B[0] + A[5] * B[1] + A[8] * B[2];
-    C[7] = A[2] * B[3] + A[5] * B[4] + A[8] * B[5];
-    C[8] = A[2] * B[6] + A[5] * B[7] + A[8] * B[8];
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void MatMatMultCore3x3Scale(T scalar, const T A[], const T B[],
-                                         T C[]) {
-  if constexpr (opA == MatOp::NORMAL and opB == MatOp::NORMAL) {
-    C[0] = scalar * (A[0] * B[0] + A[1] * B[3] + A[2] * B[6]);
-    C[1] = scalar * (A[0] * B[1] + A[1] * B[4] + A[2] * B[7]);
-    C[2] = scalar * (A[0] * B[2] + A[1] * B[5] + A[2] * B[8]);
-    C[3] = scalar * (A[3] * B[0] + A[4] * B[3] + A[5] * B[6]);
-    C[4] = scalar * (A[3] * B[1] + A[4] * B[4] + A[5] * B[7]);
-    C[5] = scalar * (A[3] * B[2] + A[4] * B[5] + A[5] * B[8]);
-    C[6] = scalar * (A[6] * B[0] + A[7] * B[3] + A[8] * B[6]);
-    C[7] = scalar * (A[6] * B[1] + A[7] * B[4] + A[8] * B[7]);
-    C[8] = scalar * (A[6] * B[2] + A[7] * B[5] + A[8] * B[8]);
-  } else if constexpr (opA == MatOp::TRANSPOSE and opB == MatOp::NORMAL) {
-    C[0] = scalar * (A[0] * B[0] + A[3] * B[3] + A[6] * B[6]);
-    C[1] = scalar * (A[0] * B[1] + A[3] * B[4] + A[6] * B[7]);
-    C[2] = scalar * (A[0] * B[2] + A[3] * B[5] + A[6] * B[8]);
-    C[3] = scalar * (A[1] * B[0] + A[4] * B[3] + A[7] * B[6]);
-    C[4] = scalar * (A[1] * B[1] + A[4] * B[4] + A[7] * B[7]);
-    C[5] = scalar * (A[1] * B[2] + A[4] * B[5] + A[7] * B[8]);
-    C[6] = scalar * (A[2] * B[0] + A[5] * B[3] + A[8] * B[6]);
-    C[7] = scalar * (A[2] * B[1] + A[5] * B[4] + A[8] * B[7]);
-    C[8] = scalar * (A[2] * B[2] + A[5] * B[5] + A[8] * B[8]);
-  } else if constexpr (opA == MatOp::NORMAL and opB == MatOp::TRANSPOSE) {
-    C[0] = scalar * (A[0] * B[0] + A[1] * B[1] + A[2] * B[2]);
-    C[1] = scalar * (A[0] * B[3] + A[1] * B[4] + A[2] * B[5]);
-    C[2] = scalar * (A[0] * B[6] + A[1] * B[7] + A[2] * B[8]);
-    C[3] = scalar * (A[3] * B[0] + A[4] * B[1] + A[5] * B[2]);
-    C[4] = scalar * (A[3] * B[3] + A[4] * B[4] + A[5] * B[5]);
-    C[5] = scalar * (A[3] * B[6] + A[4] * B[7] + A[5] * B[8]);
-    C[6] = scalar * (A[6] * B[0] + A[7] * B[1] + A[8] * B[2]);
-    C[7] = scalar * (A[6] * B[3] + A[7] * B[4] + A[8] * B[5]);
-    C[8] = scalar * (A[6] * B[6] + A[7] * B[7] + A[8] * B[8]);
-  } else if constexpr (opA == MatOp::TRANSPOSE and opB == MatOp::TRANSPOSE) {
-    C[0] = scalar * (A[0] * B[0] + A[3] * B[1] + A[6] * B[2]);
-    C[1] = scalar * (A[0] * B[3] + A[3] * B[4] + A[6] * B[5]);
-    C[2] = scalar * (A[0] * B[6] + A[3] * B[7] + A[6] * B[8]);
-    C[3] = scalar * (A[1] * B[0] + A[4] * B[1] + A[7] * B[2]);
-    C[4] = scalar * (A[1] * B[3] + A[4] * B[4] + A[7] * B[5]);
-    C[5] = scalar * (A[1] * B[6] + A[4] * B[7] + A[7] * B[8]);
-    C[6] = scalar * (A[2] * B[0] + A[5] * B[1] + A[8] * B[2]);
-    C[7] = scalar * (A[2] * B[3] + A[5] * B[4] + A[8] * B[5]);
-    C[8] = scalar * (A[2] * B[6] + A[5] * B[7] + A[8] * B[8]);
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void MatMatMultCore3x3Add(const T A[], const T B[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL and opB == MatOp::NORMAL) {
-    C[0] += A[0] * B[0] + A[1] * B[3] + A[2] * B[6];
-    C[1] += A[0] * B[1] + A[1] * B[4] + A[2] * B[7];
-    C[2] += A[0] * B[2] + A[1] * B[5] + A[2] * B[8];
-    C[3] += A[3] * B[0] + A[4] * B[3] + A[5] * B[6];
-    C[4] += A[3] * B[1] + A[4] * B[4] + A[5] * B[7];
-    C[5] += A[3] * B[2] + A[4] * B[5] + A[5] * B[8];
-    C[6] += A[6] * B[0] + A[7] * B[3] + A[8] * B[6];
-    C[7] += A[6] * B[1] + A[7] * B[4] + A[8] * B[7];
-    C[8] += A[6] * B[2] + A[7] * B[5] + A[8] * B[8];
-  } else if constexpr (opA == MatOp::TRANSPOSE and opB == MatOp::NORMAL) {
-    C[0] += A[0] * B[0] + A[3] * B[3] + A[6] * B[6];
-    C[1] += A[0] * B[1] + A[3] * B[4] + A[6] * B[7];
-    C[2] += A[0] * B[2] + A[3] * B[5] + A[6] * B[8];
-    C[3] += A[1] * B[0] + A[4] * B[3] + A[7] * B[6];
-    C[4] += A[1] * B[1] + A[4] * B[4] + A[7] * B[7];
-    C[5] += A[1] * B[2] + A[4] * B[5] + A[7] * B[8];
-    C[6] += A[2] * B[0] + A[5] * B[3] + A[8] * B[6];
-    C[7] += A[2] * B[1] + A[5] * B[4] + A[8] * B[7];
-    C[8] += A[2] * B[2] + A[5] * B[5] + A[8] * B[8];
-  } else if constexpr (opA == MatOp::NORMAL and opB == MatOp::TRANSPOSE) {
-    C[0] += A[0] * B[0] + A[1] * B[1] + A[2] * B[2];
-    C[1] += A[0] * B[3] + A[1] * B[4] + A[2] * B[5];
-    C[2] += A[0] * B[6] + A[1] * B[7] + A[2] * B[8];
-    C[3] += A[3] * B[0] + A[4] * B[1] + A[5] * B[2];
-    C[4] += A[3] * B[3] + A[4] * B[4] + A[5] * B[5];
-    C[5] += A[3] * B[6] + A[4] * B[7] + A[5] * B[8];
-    C[6] += A[6] * B[0] + A[7] * B[1] + A[8] * B[2];
-    C[7] += A[6] * B[3] + A[7] * B[4] + A[8] * B[5];
-    C[8] += A[6] * B[6] + A[7] * B[7] + A[8] * B[8];
-  } else if constexpr (opA == MatOp::TRANSPOSE and opB == MatOp::TRANSPOSE) {
-    C[0] += A[0] * B[0] + A[3] * B[1] + A[6] * B[2];
-    C[1] += A[0] * B[3] + A[3] * B[4] + A[6] * B[5];
-    C[2] += A[0] * B[6] + A[3] * B[7] + A[6] * B[8];
-    C[3] += A[1] * B[0] + A[4] * B[1] + A[7] * B[2];
-    C[4] += A[1] * B[3] + A[4] * B[4] + A[7] * B[5];
-    C[5] += A[1] * B[6] + A[4] * B[7] + A[7] * B[8];
-    C[6] += A[2] * B[0] + A[5] * B[1] + A[8] * B[2];
-    C[7] += A[2] * B[3] + A[5] * B[4] + A[8] * B[5];
-    C[8] += A[2] * B[6] + A[5] * B[7] + A[8] * B[8];
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void MatMatMultCore3x3ScaleAdd(T scalar, const T A[], const T B[],
-                                            T C[]) {
-  if constexpr (opA == MatOp::NORMAL and opB == MatOp::NORMAL) {
-    C[0] += scalar * (A[0] * B[0] + A[1] * B[3] + A[2] * B[6]);
-    C[1] += scalar * (A[0] * B[1] + A[1] * B[4] + A[2] * B[7]);
-    C[2] += scalar * (A[0] * B[2] + A[1] * B[5] + A[2] * B[8]);
-    C[3] += scalar * (A[3] * B[0] + A[4] * B[3] + A[5] * B[6]);
-    C[4] += scalar * (A[3] * B[1] + A[4] * B[4] + A[5] * B[7]);
-    C[5] += scalar * (A[3] * B[2] + A[4] * B[5] + A[5] * B[8]);
-    C[6] += scalar * (A[6] * B[0] + A[7] * B[3] + A[8] * B[6]);
-    C[7] += scalar * (A[6] * B[1] + A[7] * B[4] + A[8] * B[7]);
-    C[8] += scalar * (A[6] * B[2] + A[7] * B[5] + A[8] * B[8]);
-  } else if constexpr (opA == MatOp::TRANSPOSE and opB == MatOp::NORMAL) {
-    C[0] += scalar * (A[0] * B[0] + A[3] * B[3] + A[6] * B[6]);
-    C[1] += scalar * (A[0] * B[1] + A[3] * B[4] + A[6] * B[7]);
-    C[2] += scalar * (A[0] * B[2] + A[3] * B[5] + A[6] * B[8]);
-    C[3] += scalar * (A[1] * B[0] + A[4] * B[3] + A[7] * B[6]);
-    C[4] += scalar * (A[1] * B[1] + A[4] * B[4] + A[7] * B[7]);
-    C[5] += scalar * (A[1] * B[2] + A[4] * B[5] + A[7] * B[8]);
-    C[6] += scalar * (A[2] * B[0] + A[5] * B[3] + A[8] * B[6]);
-    C[7] += scalar * (A[2] * B[1] + A[5] * B[4] + A[8] * B[7]);
-    C[8] += scalar * (A[2] * B[2] + A[5] * B[5] + A[8] * B[8]);
-  } else if constexpr (opA == MatOp::NORMAL and opB == MatOp::TRANSPOSE) {
-    C[0] += scalar * (A[0] * B[0] + A[1] * B[1] + A[2] * B[2]);
-    C[1] += scalar * (A[0] * B[3] + A[1] * B[4] + A[2] * B[5]);
-    C[2] += scalar * (A[0] * B[6] + A[1] * B[7] + A[2] * B[8]);
-    C[3] += scalar * (A[3] * B[0] + A[4] * B[1] + A[5] * B[2]);
-    C[4] += scalar * (A[3] * B[3] + A[4] * B[4] + A[5] * B[5]);
-    C[5] += scalar * (A[3] * B[6] + A[4] * B[7] + A[5] * B[8]);
-    C[6] += scalar * (A[6] * B[0] + A[7] * B[1] + A[8] * B[2]);
-    C[7] += scalar * (A[6] * B[3] + A[7] * B[4] + A[8] * B[5]);
-    C[8] += scalar * (A[6] * B[6] + A[7] * B[7] + A[8] * B[8]);
-  } else if constexpr (opA == MatOp::TRANSPOSE and opB == MatOp::TRANSPOSE) {
-    C[0] += scalar * (A[0] * B[0] + A[3] * B[1] + A[6] * B[2]);
-    C[1] += scalar * (A[0] * B[3] + A[3] * B[4] + A[6] * B[5]);
-    C[2] += scalar * (A[0] * B[6] + A[3] * B[7] + A[6] * B[8]);
-    C[3] += scalar * (A[1] * B[0] + A[4] * B[1] + A[7] * B[2]);
-    C[4] += scalar * (A[1] * B[3] + A[4] * B[4] + A[7] * B[5]);
-    C[5] += scalar * (A[1] * B[6] + A[4] * B[7] + A[7] * B[8]);
-    C[6] += scalar * (A[2] * B[0] + A[5] * B[1] + A[8] * B[2]);
-    C[7] += scalar * (A[2] * B[3] + A[5] * B[4] + A[8] * B[5]);
-    C[8] += scalar * (A[2] * B[6] + A[5] * B[7] + A[8] * B[8]);
-  }
-}
-
 /**
  * @brief mat-mat multiplication C = alpha * Op(A) * Op(B), where op is normal
  * or transpose
@@ -232,90 +52,23 @@ A2D_FUNCTION void MatMatMultCoreGeneral(const T A[], const T B[], T C[]) {
   // Op(A) is M-by-P, Op(B) is P-by-N, C is M-by-N
   constexpr int M = Cnrows;
   constexpr int N = Cncols;
-  // constexpr int P =
-  //    int_conditional<opA == MatOp::NORMAL, Ancols, Anrows>::value;
-
-  if constexpr (opA == MatOp::NORMAL) {
-    if (opB == MatOp::NORMAL) {
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[Ancols * i];
-          const T *aend = a + Ancols;
-          const T *b = &B[j];
-
-          T value = T(0.0);
-          for (; a < aend; a++, b += Bncols) {
-            value += a[0] * b[0];
-          }
-
-          if constexpr (additive) {
-            C[0] += value;
-          } else {
-            C[0] = value;
-          }
-        }
-      }
-    } else {  // opB == MatOp::TRANSPOSE
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[Ancols * i];
-          const T *aend = a + Ancols;
-          const T *b = &B[Bncols * j];
-
-          T value = T(0.0);
-          for (; a < aend; a++, b++) {
-            value += a[0] * b[0];
-          }
-
-          if constexpr (additive) {
-            C[0] += value;
-          } else {
-            C[0] = value;
-          }
-        }
-      }
-    }
-  } else {  // opA == MatOp::TRANSPOSE
-    if (opB == MatOp::NORMAL) {
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[i];
-          const T *b = &B[j];
-          const T *bend = b + Bnrows * Bncols;
-
-          T value = T(0.0);
-          for (; b < bend; a += Ancols, b += Bncols) {
-            value += a[0] * b[0];
-          }
-
-          if constexpr (additive) {
-            C[0] += value;
-          } else {
-            C[0] = value;
-          }
-        }
-      }
-    } else {  // opB == MatOp::TRANSPOSE
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[i];
-          const T *b = &B[Bncols * j];
-          const T *bend = b + Bncols;
-
-          T value = T(0.0);
-          for (; b < bend; a += Ancols, b++) {
-            value += a[0] * b[0];
-          }
-
-          if constexpr (additive) {
-            C[0] += value;
-          } else {
-            C[0] = value;
-          }
-        }
-      }
+  constexpr int P = opA == MatOp::NORMAL ? Ancols : Anrows;
+
+  Unroll<M, N>([&](auto i, auto j) {
+    accum_t<T> value = 0.0;
+    Unroll<P>([&](auto k) {
+      const T a =
+          opA == MatOp::NORMAL ? A[Ancols * i + k] : A[Ancols * k + i];
+      const T b =
+          opB == MatOp::NORMAL ? B[Bncols * k + j] : B[Bncols * j + k];
+      value += accum(a) * b;
+    });
+    if constexpr (additive) {
+      C[N * i + j] += value;
+    } else {
+      C[N * i + j] = value;
     }
-  }
+  });
 }
 
 /**
@@ -350,89 +103,212 @@ A2D_FUNCTION void MatMatMultScaleCoreGeneral(const T alpha, const T A[],
   // Op(A) is M-by-P, Op(B) is P-by-N, C is M-by-N
   constexpr int M = Cnrows;
   constexpr int N = Cncols;
-  // constexpr int P =
-  //    int_conditional<opA == MatOp::NORMAL, Ancols, Anrows>::value;
+  constexpr int P = opA == MatOp::NORMAL ? Ancols : Anrows;
+
+  Unroll<M, N>([&](auto i, auto j) {
+    accum_t<T> value = 0.0;
+    Unroll<P>([&](auto k) {
+      const T a =
+          opA == MatOp::NORMAL ? A[Ancols * i + k] : A[Ancols * k + i];
+      const T b =
+          opB == MatOp::NORMAL ? B[Bncols * k + j] : B[Bncols * j + k];
+      value += accum(a) * b;
+    });
+    if constexpr (additive) {
+      C[N * i + j] += alpha * value;
+    } else {
+      C[N * i + j] = alpha * value;
+    }
+  });
+}
+
+/*
+  Register-blocked GEMM for medium sizes
+
+  The blocked kernel computes C = alpha * op(A) * op(B) one MR x NR block of
+  C at a time. The block is held in local accumulators over the whole inner
+  dimension: each step loads MR entries of a column of op(A) and NR entries
+  of a row of op(B) and performs MR * NR multiply-adds, so that the number
+  of loads per flop is reduced by the block size compared to the general
+  kernel.
+
+  The operands are packed so that the entries used by each step are
+  contiguous, whatever the transpose of A and B: the P x NR panel of op(B)
+  for a column of blocks is packed once and reused from cache by all the
+  row blocks, and the MR x P panel of op(A) is packed for each block. This
+  also keeps the compiler from vectorizing along the inner dimension instead
+  of across the block.
+
+  The inner dimension is split into tiles of at most KC entries, so that the
+  packed panels stay in the L1 cache (16 KB for op(B) and 8 KB for op(A) in
+  double) and their size on the stack is bounded. The tiles are applied one
+  after the other to the whole of C, the first one with the assignment or
+  increment requested and the following ones as increments. In mixed
+  precision, the inner dimension is not tiled so that the sums are kept in
+  the accumulation type.
+
+  The sizes of the blocks are compile-time constants, as are the sizes of
+  the blocks at the bottom and right edges of C and of the last tile. The
+  block holds at most 32 accumulators, larger blocks are spilled from
+  registers.
+*/
+template <typename T>
+struct gemm_block_size {
+  static constexpr int MR = std::is_arithmetic<T>::value ? 4 : 2;
+  static constexpr int NR = std::is_arithmetic<T>::value ? 8 : 4;
+  static constexpr int KC = 256;
+};
 
-  if constexpr (opA == MatOp::NORMAL) {
-    if (opB == MatOp::NORMAL) {
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[Ancols * i];
-          const T *aend = a + Ancols;
-          const T *b = &B[j];
+/*
+  Whether the GEMM dispatchers use the register-blocked kernel. Small
+  products are fully unrolled by the general kernel. For larger products,
+  the compiler vectorizes the general kernel across the columns of C when
+  the rows of op(B) are contiguous and the inner dimension of length P is
+  unrolled, which is as fast as the blocked kernel.
+*/
+template <int Cnrows, int Cncols, int P, MatOp opB>
+struct use_blocked_gemm {
+  static constexpr bool value =
+      Cnrows * Cncols > A2D_MAX_UNROLL &&
+      (opB == MatOp::TRANSPOSE || P > A2D_MAX_UNROLL);
+};
 
-          T value = T(0.0);
-          for (; a < aend; a++, b += Bncols) {
-            value += a[0] * b[0];
-          }
+/**
+ * @brief Compute the mr-by-nr block of C starting at entry (i0, j0) over the
+ * kc entries of the inner dimension starting at k0
+ *
+ * @param Bp: the packed columns j0, ..., j0 + nr - 1 of rows k0, ...,
+ * k0 + kc - 1 of op(B), Bp[nr * k + j]
+ */
+template <typename T, int Ancols, int Cncols, int kc, int mr, int nr,
+          MatOp opA, bool scale, bool additive>
+A2D_FUNCTION void MatMatMultBlockKernel(const T alpha, const T A[],
+                                        const T Bp[], T C[], const int i0,
+                                        const int j0, const int k0) {
+  // Pack the rows i0, ..., i0 + mr - 1 of the tile of op(A)
+  T Ap[mr * kc];
+  for (int k = 0; k < kc; k++) {
+    for (int i = 0; i < mr; i++) {
+      Ap[mr * k + i] = (opA == MatOp::NORMAL ? A[Ancols * (i0 + i) + k0 + k]
+                                             : A[Ancols * (k0 + k) + i0 + i]);
+    }
+  }
 
-          if constexpr (additive) {
-            C[0] += alpha * value;
-          } else {
-            C[0] = alpha * value;
-          }
-        }
-      }
-    } else {  // opB == MatOp::TRANSPOSE
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[Ancols * i];
-          const T *aend = a + Ancols;
-          const T *b = &B[Bncols * j];
+  // The loops over the block have constant bounds and are unrolled by the
+  // compiler so that the block stays in registers
+  accum_t<T> c[mr][nr];
+  for (int i = 0; i < mr; i++) {
+    for (int j = 0; j < nr; j++) {
+      c[i][j] = 0.0;
+    }
+  }
 
-          T value = T(0.0);
-          for (; a < aend; a++, b++) {
-            value += a[0] * b[0];
-          }
+  for (int k = 0; k < kc; k++) {
+    for (int i = 0; i < mr; i++) {
+      const accum_t<T> a = accum(Ap[mr * k + i]);
+      for (int j = 0; j < nr; j++) {
+        c[i][j] += a * Bp[nr * k + j];
+      }
+    }
+  }
 
-          if constexpr (additive) {
-            C[0] += alpha * value;
-          } else {
-            C[0] = alpha * value;
-          }
-        }
+  for (int i = 0; i < mr; i++) {
+    for (int j = 0; j < nr; j++) {
+      T &cij = C[Cncols * (i0 + i) + j0 + j];
+      if constexpr (scale && additive) {
+        cij += alpha * c[i][j];
+      } else if constexpr (scale) {
+        cij = alpha * c[i][j];
+      } else if constexpr (additive) {
+        cij += c[i][j];
+      } else {
+        cij = c[i][j];
       }
     }
-  } else {  // opA == MatOp::TRANSPOSE
-    if (opB == MatOp::NORMAL) {
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[i];
-          const T *b = &B[j];
-          const T *bend = b + Bnrows * Bncols;
+  }
+}
 
-          T value = T(0.0);
-          for (; b < bend; a += Ancols, b += Bncols) {
-            value += a[0] * b[0];
-          }
+/**
+ * @brief Compute the nr columns of C starting at column j0 over the kc
+ * entries of the inner dimension starting at k0
+ */
+template <typename T, int Ancols, int Bncols, int Cnrows, int Cncols, int kc,
+          int nr, MatOp opA, MatOp opB, bool scale, bool additive>
+A2D_FUNCTION void MatMatMultBlockColumn(const T alpha, const T A[],
+                                        const T B[], T C[], const int j0,
+                                        const int k0) {
+  constexpr int MR = gemm_block_size<T>::MR;
+  constexpr int M0 = (Cnrows / MR) * MR;
+
+  // Pack the columns j0, ..., j0 + nr - 1 of the tile of op(B)
+  T Bp[nr * kc];
+  for (int k = 0; k < kc; k++) {
+    for (int j = 0; j < nr; j++) {
+      Bp[nr * k + j] = (opB == MatOp::NORMAL ? B[Bncols * (k0 + k) + j0 + j]
+                                             : B[Bncols * (j0 + j) + k0 + k]);
+    }
+  }
 
-          if constexpr (additive) {
-            C[0] += alpha * value;
-          } else {
-            C[0] = alpha * value;
-          }
-        }
-      }
-    } else {  // opB == MatOp::TRANSPOSE
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[i];
-          const T *b = &B[Bncols * j];
-          const T *bend = b + Bncols;
+  for (int i0 = 0; i0 < M0; i0 += MR) {
+    MatMatMultBlockKernel<T, Ancols, Cncols, kc, MR, nr, opA, scale,
+                          additive>(alpha, A, Bp, C, i0, j0, k0);
+  }
+  if constexpr (M0 < Cnrows) {
+    MatMatMultBlockKernel<T, Ancols, Cncols, kc, Cnrows - M0, nr, opA, scale,
+                          additive>(alpha, A, Bp, C, M0, j0, k0);
+  }
+}
 
-          T value = T(0.0);
-          for (; b < bend; a += Ancols, b++) {
-            value += a[0] * b[0];
-          }
+/**
+ * @brief Apply the tile of the inner dimension of length kc starting at k0
+ * to all the columns of C
+ */
+template <typename T, int Ancols, int Bncols, int Cnrows, int Cncols, int kc,
+          MatOp opA, MatOp opB, bool scale, bool additive>
+A2D_FUNCTION void MatMatMultBlockTile(const T alpha, const T A[], const T B[],
+                                      T C[], const int k0) {
+  constexpr int NR = gemm_block_size<T>::NR;
+  constexpr int N0 = (Cncols / NR) * NR;
 
-          if constexpr (additive) {
-            C[0] += alpha * value;
-          } else {
-            C[0] = alpha * value;
-          }
-        }
-      }
-    }
+  for (int j0 = 0; j0 < N0; j0 += NR) {
+    MatMatMultBlockColumn<T, Ancols, Bncols, Cnrows, Cncols, kc, NR, opA, opB,
+                          scale, additive>(alpha, A, B, C, j0, k0);
+  }
+  if constexpr (N0 < Cncols) {
+    MatMatMultBlockColumn<T, Ancols, Bncols, Cnrows, Cncols, kc, Cncols - N0,
+                          opA, opB, scale, additive>(alpha, A, B, C, N0, k0);
+  }
+}
+
+/**
+ * @brief Register-blocked mat-mat multiplication C = alpha * Op(A) * Op(B)
+ *
+ * The arguments are the same as for MatMatMultScaleCoreGeneral, alpha is
+ * only referenced when scale is true.
+ */
+template <typename T, int Anrows, int Ancols, int Bnrows, int Bncols,
+          int Cnrows, int Cncols, MatOp opA = MatOp::NORMAL,
+          MatOp opB = MatOp::NORMAL, bool scale = false, bool additive = false>
+A2D_FUNCTION void MatMatMultCoreBlocked(const T alpha, const T A[],
+                                        const T B[], T C[]) {
+  // Op(A) is Cnrows-by-P, Op(B) is P-by-Cncols
+  constexpr int P = opA == MatOp::NORMAL ? Ancols : Anrows;
+  constexpr int KC =
+      (is_mixed_precision<T>::value || P <= gemm_block_size<T>::KC)
+          ? P
+          : gemm_block_size<T>::KC;
+  constexpr int P0 = (P / KC) * KC;
+
+  // The first tile assigns or increments C, the others increment it
+  MatMatMultBlockTile<T, Ancols, Bncols, Cnrows, Cncols, KC, opA, opB, scale,
+                      additive>(alpha, A, B, C, 0);
+  for (int k0 = KC; k0 < P0; k0 += KC) {
+    MatMatMultBlockTile<T, Ancols, Bncols, Cnrows, Cncols, KC, opA, opB,
+                        scale, true>(alpha, A, B, C, k0);
+  }
+  if constexpr (P0 < P) {
+    MatMatMultBlockTile<T, Ancols, Bncols, Cnrows, Cncols, P - P0, opA, opB,
+                        scale, true>(alpha, A, B, C, P0);
   }
 }
 
@@ -482,12 +358,27 @@ A2D_FUNCTION void MatMatMultCore(const T A[], const T B[], T C[]) {
                   "Matrix dimensions must agree.");
   }
 
-  if constexpr (Anrows == 3 && Ancols == 3 && Bnrows == 3 && Bncols == 3) {
-    if constexpr (additive) {
-      MatMatMultCore3x3Add<T, opA, opB>(A, B, C);
-    } else {
-      MatMatMultCore3x3<T, opA, opB>(A, B, C);
-    }
+  constexpr bool is3x3 =
+      (Anrows == 3 && Ancols == 3 && Bnrows == 3 && Bncols == 3);
+  constexpr bool is2x2 =
+      (Anrows == 2 && Ancols == 2 && Bnrows == 2 && Bncols == 2);
+  constexpr bool generated = (Anrows == Ancols && Bnrows == Bncols &&
+                              Anrows == Bnrows && Anrows <= A2D_MAX_GEN_SIZE);
+  constexpr int P = opA == MatOp::NORMAL ? Ancols : Anrows;
+
+  if constexpr (use_blocked_gemm<Cnrows, Cncols, P, opB>::value) {
+    MatMatMultCoreBlocked<T, Anrows, Ancols, Bnrows, Bncols, Cnrows, Cncols,
+                          opA, opB, false, additive>(T(1.0), A, B, C);
+  } else if constexpr (is_mixed_precision<T>::value) {
+    // The general kernel accumulates in accum_t<T>
+    MatMatMultCoreGeneral<T, Anrows, Ancols, Bnrows, Bncols, Cnrows, Cncols,
+                          opA, opB, additive>(A, B, C);
+  } else if constexpr (has_simd_gemm<T>::value && is3x3) {
+    MatMatMultCore3x3Simd<T, opA, opB, false, additive>(T(1.0), A, B, C);
+  } else if constexpr (has_simd_gemm2x2<T>::value && is2x2) {
+    MatMatMultCore2x2Simd<T, opA, opB, false, additive>(T(1.0), A, B, C);
+  } else if constexpr (generated) {
+    MatMatMultCoreGen<T, Anrows, opA, opB, false, additive>(T(1.0), A, B, C);
   } else {  // The general fallback implmentation
     MatMatMultCoreGeneral<T, Anrows, Ancols, Bnrows, Bncols, Cnrows, Cncols,
                           opA, opB, additive>(A, B, C);
@@ -513,141 +404,120 @@ inline void MatMatMultScaleCore(T alpha, const T A[], const T B[], T C[]) {
                   "Matrix dimensions must agree.");
   }
 
-  if constexpr (Anrows == 3 && Ancols == 3 && Bnrows == 3 && Bncols == 3) {
-    if constexpr (additive) {
-      MatMatMultCore3x3ScaleAdd<T, opA, opB>(alpha, A, B, C);
-    } else {
-      MatMatMultCore3x3Scale<T, opA, opB>(alpha, A, B, C);
-    }
+  constexpr bool is3x3 =
+      (Anrows == 3 && Ancols == 3 && Bnrows == 3 && Bncols == 3);
+  constexpr bool is2x2 =
+      (Anrows == 2 && Ancols == 2 && Bnrows == 2 && Bncols == 2);
+  constexpr bool generated = (Anrows == Ancols && Bnrows == Bncols &&
+                              Anrows == Bnrows && Anrows <= A2D_MAX_GEN_SIZE);
+  constexpr int P = opA == MatOp::NORMAL ? Ancols : Anrows;
+
+  if constexpr (use_blocked_gemm<Cnrows, Cncols, P, opB>::value) {
+    MatMatMultCoreBlocked<T, Anrows, Ancols, Bnrows, Bncols, Cnrows, Cncols,
+                          opA, opB, true, additive>(alpha, A, B, C);
+  } else if constexpr (is_mixed_precision<T>::value) {
+    MatMatMultScaleCoreGeneral<T, Anrows, Ancols, Bnrows, Bncols, Cnrows,
+                               Cncols, opA, opB, additive>(alpha, A, B, C);
+  } else if constexpr (has_simd_gemm<T>::value && is3x3) {
+    MatMatMultCore3x3Simd<T, opA, opB, true, additive>(alpha, A, B, C);
+  } else if constexpr (has_simd_gemm2x2<T>::value && is2x2) {
+    MatMatMultCore2x2Simd<T, opA, opB, true, additive>(alpha, A, B, C);
+  } else if constexpr (generated) {
+    MatMatMultCoreGen<T, Anrows, opA, opB, true, additive>(alpha, A, B, C);
   } else {  // The general fallback implmentation
     MatMatMultScaleCoreGeneral<T, Anrows, Ancols, Bnrows, Bncols, Cnrows,
                                Cncols, opA, opB, additive>(alpha, A, B, C);
   }
 }
 
-template <typename T>
-A2D_FUNCTION void SMatSMatMultCore2x2(const T SA[], const T SB[], T C[]) {
-  C[0] = SA[0] * SB[0] + SA[1] * SB[1];
-  C[1] = SA[0] * SB[1] + SA[1] * SB[2];
-  C[2] = SA[1] * SB[0] + SA[2] * SB[1];
-  C[3] = SA[1] * SB[1] + SA[2] * SB[2];
-}
+/*
+  Product rule in a single pass over the operands:
 
-template <typename T>
-A2D_FUNCTION void SMatSMatMultCore2x2Add(const T SA[], const T SB[], T C[]) {
-  C[0] += SA[0] * SB[0] + SA[1] * SB[1];
-  C[1] += SA[0] * SB[1] + SA[1] * SB[2];
-  C[2] += SA[1] * SB[0] + SA[2] * SB[1];
-  C[3] += SA[1] * SB[1] + SA[2] * SB[2];
-}
-
-template <typename T>
-A2D_FUNCTION void SMatSMatMultCore2x2Scale(const T scalar, const T SA[],
-                                           const T SB[], T C[]) {
-  C[0] = scalar * (SA[0] * SB[0] + SA[1] * SB[1]);
-  C[1] = scalar * (SA[0] * SB[1] + SA[1] * SB[2]);
-  C[2] = scalar * (SA[1] * SB[0] + SA[2] * SB[1]);
-  C[3] = scalar * (SA[1] * SB[1] + SA[2] * SB[2]);
-}
-
-template <typename T>
-A2D_FUNCTION void SMatSMatMultCore3x3(const T SA[], const T SB[], T C[]) {
-  C[0] = SA[0] * SB[0] + SA[1] * SB[1] + SA[3] * SB[3];
-  C[1] = SA[0] * SB[1] + SA[1] * SB[2] + SA[3] * SB[4];
-  C[2] = SA[0] * SB[3] + SA[1] * SB[4] + SA[3] * SB[5];
-  C[3] = SA[1] * SB[0] + SA[2] * SB[1] + SA[4] * SB[3];
-  C[4] = SA[1] * SB[1] + SA[2] * SB[2] + SA[4] * SB[4];
-  C[5] = SA[1] * SB[3] + SA[2] * SB[4] + SA[4] * SB[5];
-  C[6] = SA[3] * SB[0] + SA[4] * SB[1] + SA[5] * SB[3];
-  C[7] = SA[3] * SB[1] + SA[4] * SB[2] + SA[5] * SB[4];
-  C[8] = SA[3] * SB[3] + SA[4] * SB[4] + SA[5] * SB[5];
-}
-
-template <typename T>
-A2D_FUNCTION void SMatSMatMultCore3x3Add(const T SA[], const T SB[], T C[]) {
-  C[0] += SA[0] * SB[0] + SA[1] * SB[1] + SA[3] * SB[3];
-  C[1] += SA[0] * SB[1] + SA[1] * SB[2] + SA[3] * SB[4];
-  C[2] += SA[0] * SB[3] + SA[1] * SB[4] + SA[3] * SB[5];
-  C[3] += SA[1] * SB[0] + SA[2] * SB[1] + SA[4] * SB[3];
-  C[4] += SA[1] * SB[1] + SA[2] * SB[2] + SA[4] * SB[4];
-  C[5] += SA[1] * SB[3] + SA[2] * SB[4] + SA[4] * SB[5];
-  C[6] += SA[3] * SB[0] + SA[4] * SB[1] + SA[5] * SB[3];
-  C[7] += SA[3] * SB[1] + SA[4] * SB[2] + SA[5] * SB[4];
-  C[8] += SA[3] * SB[3] + SA[4] * SB[4] + SA[5] * SB[5];
-}
+  C += opA(A) * opB(B)
+  Cd += opA(Ad) * opB(B) + opA(A) * opB(Bd)
 
-template <typename T>
-A2D_FUNCTION void SMatSMatMultCore3x3Scale(const T scalar, const T SA[],
-                                           const T SB[], T C[]) {
-  C[0] = scalar * (SA[0] * SB[0] + SA[1] * SB[1] + SA[3] * SB[3]);
-  C[1] = scalar * (SA[0] * SB[1] + SA[1] * SB[2] + SA[3] * SB[4]);
-  C[2] = scalar * (SA[0] * SB[3] + SA[1] * SB[4] + SA[3] * SB[5]);
-  C[3] = scalar * (SA[1] * SB[0] + SA[2] * SB[1] + SA[4] * SB[3]);
-  C[4] = scalar * (SA[1] * SB[1] + SA[2] * SB[2] + SA[4] * SB[4]);
-  C[5] = scalar * (SA[1] * SB[3] + SA[2] * SB[4] + SA[4] * SB[5]);
-  C[6] = scalar * (SA[3] * SB[0] + SA[4] * SB[1] + SA[5] * SB[3]);
-  C[7] = scalar * (SA[3] * SB[1] + SA[4] * SB[2] + SA[5] * SB[4]);
-  C[8] = scalar * (SA[3] * SB[3] + SA[4] * SB[4] + SA[5] * SB[5]);
-}
-
-template <typename T>
-A2D_FUNCTION void SMatSMatMultCore2x2ScaleAdd(const T scalar, const T SA[],
-                                              const T SB[], T C[]) {
-  C[0] += scalar * (SA[0] * SB[0] + SA[1] * SB[1]);
-  C[1] += scalar * (SA[0] * SB[1] + SA[1] * SB[2]);
-  C[2] += scalar * (SA[1] * SB[0] + SA[2] * SB[1]);
-  C[3] += scalar * (SA[1] * SB[1] + SA[2] * SB[2]);
-}
+  The first term of Cd is included when dA is true and the second when dB is
+  true, the pointers to the unused derivatives are not referenced. This is
+  used to fuse the reverse and second-order reverse products of an
+  expression, which share the operands A and B.
+*/
+template <typename T, int Anrows, int Ancols, int Bnrows, int Bncols,
+          int Cnrows, int Cncols, MatOp opA = MatOp::NORMAL,
+          MatOp opB = MatOp::NORMAL, bool dA = true, bool dB = true>
+A2D_FUNCTION void MatMatMultDualAddCore(const T A[], const T Ad[],
+                                        const T B[], const T Bd[], T C[],
+                                        T Cd[]) {
+  constexpr int P = (opA == MatOp::NORMAL ? Ancols : Anrows);
+  static_assert(P == (opB == MatOp::NORMAL ? Bnrows : Bncols),
+                "Matrix dimensions must agree.");
 
-template <typename T>
-A2D_FUNCTION void SMatSMatMultCore3x3ScaleAdd(const T scalar, const T SA[],
-                                              const T SB[], T C[]) {
-  C[0] += scalar * (SA[0] * SB[0] + SA[1] * SB[1] + SA[3] * SB[3]);
-  C[1] += scalar * (SA[0] * SB[1] + SA[1] * SB[2] + SA[3] * SB[4]);
-  C[2] += scalar * (SA[0] * SB[3] + SA[1] * SB[4] + SA[3] * SB[5]);
-  C[3] += scalar * (SA[1] * SB[0] + SA[2] * SB[1] + SA[4] * SB[3]);
-  C[4] += scalar * (SA[1] * SB[1] + SA[2] * SB[2] + SA[4] * SB[4]);
-  C[5] += scalar * (SA[1] * SB[3] + SA[2] * SB[4] + SA[4] * SB[5]);
-  C[6] += scalar * (SA[3] * SB[0] + SA[4] * SB[1] + SA[5] * SB[3]);
-  C[7] += scalar * (SA[3] * SB[1] + SA[4] * SB[2] + SA[5] * SB[4]);
-  C[8] += scalar * (SA[3] * SB[3] + SA[4] * SB[4] + SA[5] * SB[5]);
+  if constexpr (use_blocked_gemm<Cnrows, Cncols, P, opB>::value) {
+    // The products are computed separately by the blocked kernel, which
+    // reuses the operands from registers instead of across the products
+    MatMatMultCoreBlocked<T, Anrows, Ancols, Bnrows, Bncols, Cnrows, Cncols,
+                          opA, opB, false, true>(T(1.0), A, B, C);
+    if constexpr (dA) {
+      MatMatMultCoreBlocked<T, Anrows, Ancols, Bnrows, Bncols, Cnrows, Cncols,
+                            opA, opB, false, true>(T(1.0), Ad, B, Cd);
+    }
+    if constexpr (dB) {
+      MatMatMultCoreBlocked<T, Anrows, Ancols, Bnrows, Bncols, Cnrows, Cncols,
+                            opA, opB, false, true>(T(1.0), A, Bd, Cd);
+    }
+    return;
+  }
+
+  for (int i = 0; i < Cnrows; i++) {
+    for (int j = 0; j < Cncols; j++, C++, Cd++) {
+      accum_t<T> value = 0.0, dvalue = 0.0;
+      for (int k = 0; k < P; k++) {
+        const int ia = (opA == MatOp::NORMAL ? Ancols * i + k : Ancols * k + i);
+        const int ib = (opB == MatOp::NORMAL ? Bncols * k + j : Bncols * j + k);
+        value += accum(A[ia]) * B[ib];
+        if constexpr (dA) {
+          dvalue += accum(Ad[ia]) * B[ib];
+        }
+        if constexpr (dB) {
+          dvalue += accum(A[ia]) * Bd[ib];
+        }
+      }
+      C[0] += value;
+      Cd[0] += dvalue;
+    }
+  }
 }
 
 template <typename T, int Anrows, bool additive = false>
 A2D_FUNCTION void SMatSMatMultCoreGeneral(const T SA[], const T SB[], T C[]) {
-  for (int i = 0; i < Anrows; i++) {
-    for (int k = 0; k < Anrows; k++) {
-      T value = T(0.0);
-      for (int j = 0; j < Anrows; j++) {
-        value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                 SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
-      }
-      if (additive) {
-        C[i * Anrows + k] += value;
-      } else {
-        C[i * Anrows + k] = value;
-      }
+  constexpr int N = Anrows;
+  Unroll<N, N>([&](auto i, auto k) {
+    accum_t<T> value = 0.0;
+    Unroll<N>([&](auto j) {
+      value += accum(SA[SymMatIndex<N>(i, j)]) * SB[SymMatIndex<N>(j, k)];
+    });
+    if constexpr (additive) {
+      C[N * i + k] += value;
+    } else {
+      C[N * i + k] = value;
     }
-  }
+  });
 }
 
 template <typename T, int Anrows, bool additive = false>
 A2D_FUNCTION void SMatSMatMultScaleCoreGeneral(const T scalar, const T SA[],
                                                const T SB[], T C[]) {
-  for (int i = 0; i < Anrows; i++) {
-    for (int k = 0; k < Anrows; k++) {
-      T value = T(0.0);
-      for (int j = 0; j < Anrows; j++) {
-        value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                 SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
-      }
-      if (additive) {
-        C[i * Anrows + k] += scalar * value;
-      } else {
-        C[i * Anrows + k] = scalar * value;
-      }
+  constexpr int N = Anrows;
+  Unroll<N, N>([&](auto i, auto k) {
+    accum_t<T> value = 0.0;
+    Unroll<N>([&](auto j) {
+      value += accum(SA[SymMatIndex<N>(i, j)]) * SB[SymMatIndex<N>(j, k)];
+    });
+    if constexpr (additive) {
+      C[N * i + k] += scalar * value;
+    } else {
+      C[N * i + k] = scalar * value;
     }
-  }
+  });
 }
 
 template <typename T, int Anrows, int Bnrows, int Cnrows, int Cncols,
@@ -657,18 +527,12 @@ A2D_FUNCTION void SMatSMatMultCore(const T SA[], const T SB[], T C[]) {
   static_assert((Anrows == Bnrows and Bnrows == Cnrows and Cnrows == Cncols),
                 "Matrix dimensions must agree.");
 
-  if constexpr (Anrows == 2) {
-    if constexpr (additive) {
-      SMatSMatMultCore2x2Add(SA, SB, C);
-    } else {
-      SMatSMatMultCore2x2(SA, SB, C);
-    }
-  } else if constexpr (Anrows == 3) {
-    if constexpr (additive) {
-      SMatSMatMultCore3x3Add(SA, SB, C);
-    } else {
-      SMatSMatMultCore3x3(SA, SB, C);
-    }
+  if constexpr (is_mixed_precision<T>::value) {
+    SMatSMatMultCoreGeneral<T, Anrows, additive>(SA, SB, C);
+  } else if constexpr (has_simd_gemm<T>::value && Anrows == 3) {
+    SMatSMatMultCore3x3Simd<T, false, additive>(T(1.0), SA, SB, C);
+  } else if constexpr (Anrows <= A2D_MAX_GEN_SIZE) {
+    SMatSMatMultCoreGen<T, Anrows, false, additive>(T(1.0), SA, SB, C);
   } else {
     SMatSMatMultCoreGeneral<T, Anrows, additive>(SA, SB, C);
   }
@@ -682,266 +546,56 @@ A2D_FUNCTION void SMatSMatMultScaleCore(const T alpha, const T SA[],
   static_assert((Anrows == Bnrows and Bnrows == Cnrows and Cnrows == Cncols),
                 "Matrix dimensions must agree.");
 
-  if constexpr (Anrows == 2) {
-    if constexpr (additive) {
-      SMatSMatMultCore2x2ScaleAdd(alpha, SA, SB, C);
-    } else {
-      SMatSMatMultCore2x2Scale(alpha, SA, SB, C);
-    }
-  } else if constexpr (Anrows == 3) {
-    if constexpr (additive) {
-      SMatSMatMultCore3x3ScaleAdd(alpha, SA, SB, C);
-    } else {
-      SMatSMatMultCore3x3Scale(alpha, SA, SB, C);
-    }
+  if constexpr (is_mixed_precision<T>::value) {
+    SMatSMatMultScaleCoreGeneral<T, Anrows, additive>(alpha, SA, SB, C);
+  } else if constexpr (has_simd_gemm<T>::value && Anrows == 3) {
+    SMatSMatMultCore3x3Simd<T, true, additive>(alpha, SA, SB, C);
+  } else if constexpr (Anrows <= A2D_MAX_GEN_SIZE) {
+    SMatSMatMultCoreGen<T, Anrows, true, additive>(alpha, SA, SB, C);
   } else {
     SMatSMatMultScaleCoreGeneral<T, Anrows, additive>(alpha, SA, SB, C);
   }
 }
 
-template <typename T, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void SMatMatMultCore2x2(const T S[], const T B[], T C[]) {
-  if constexpr (opB == MatOp::NORMAL) {
-    C[0] = S[0] * B[0] + S[1] * B[2];
-    C[1] = S[0] * B[1] + S[1] * B[3];
-    C[2] = S[1] * B[0] + S[2] * B[2];
-    C[3] = S[1] * B[1] + S[2] * B[3];
-  } else if constexpr (opB == MatOp::TRANSPOSE) {
-    C[0] = S[0] * B[0] + S[1] * B[1];
-    C[1] = S[0] * B[2] + S[1] * B[3];
-    C[2] = S[1] * B[0] + S[2] * B[1];
-    C[3] = S[1] * B[2] + S[2] * B[3];
-  }
-}
-
-template <typename T, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void SMatMatMultCore2x2Scale(const T scalar, const T S[],
-                                          const T B[], T C[]) {
-  if constexpr (opB == MatOp::NORMAL) {
-    C[0] = scalar * (S[0] * B[0] + S[1] * B[2]);
-    C[1] = scalar * (S[0] * B[1] + S[1] * B[3]);
-    C[2] = scalar * (S[1] * B[0] + S[2] * B[2]);
-    C[3] = scalar * (S[1] * B[1] + S[2] * B[3]);
-  } else if constexpr (opB == MatOp::TRANSPOSE) {
-    C[0] = scalar * (S[0] * B[0] + S[1] * B[1]);
-    C[1] = scalar * (S[0] * B[2] + S[1] * B[3]);
-    C[2] = scalar * (S[1] * B[0] + S[2] * B[1]);
-    C[3] = scalar * (S[1] * B[2] + S[2] * B[3]);
-  }
-}
-
-template <typename T, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void SMatMatMultCore2x2Add(const T S[], const T B[], T C[]) {
-  if constexpr (opB == MatOp::NORMAL) {
-    C[0] += S[0] * B[0] + S[1] * B[2];
-    C[1] += S[0] * B[1] + S[1] * B[3];
-    C[2] += S[1] * B[0] + S[2] * B[2];
-    C[3] += S[1] * B[1] + S[2] * B[3];
-  } else if constexpr (opB == MatOp::TRANSPOSE) {
-    C[0] += S[0] * B[0] + S[1] * B[1];
-    C[1] += S[0] * B[2] + S[1] * B[3];
-    C[2] += S[1] * B[0] + S[2] * B[1];
-    C[3] += S[1] * B[2] + S[2] * B[3];
-  }
-}
-
-template <typename T, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void SMatMatMultCore2x2ScaleAdd(const T scalar, const T S[],
-                                             const T B[], T C[]) {
-  if constexpr (opB == MatOp::NORMAL) {
-    C[0] += scalar * (S[0] * B[0] + S[1] * B[2]);
-    C[1] += scalar * (S[0] * B[1] + S[1] * B[3]);
-    C[2] += scalar * (S[1] * B[0] + S[2] * B[2]);
-    C[3] += scalar * (S[1] * B[1] + S[2] * B[3]);
-  } else if constexpr (opB == MatOp::TRANSPOSE) {
-    C[0] += scalar * (S[0] * B[0] + S[1] * B[1]);
-    C[1] += scalar * (S[0] * B[2] + S[1] * B[3]);
-    C[2] += scalar * (S[1] * B[0] + S[2] * B[1]);
-    C[3] += scalar * (S[1] * B[2] + S[2] * B[3]);
-  }
-}
-
-template <typename T, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void SMatMatMultCore3x3(const T S[], const T B[], T C[]) {
-  if constexpr (opB == MatOp::NORMAL) {
-    C[0] = S[0] * B[0] + S[1] * B[3] + S[3] * B[6];
-    C[1] = S[0] * B[1] + S[1] * B[4] + S[3] * B[7];
-    C[2] = S[0] * B[2] + S[1] * B[5] + S[3] * B[8];
-    C[3] = S[1] * B[0] + S[2] * B[3] + S[4] * B[6];
-    C[4] = S[1] * B[1] + S[2] * B[4] + S[4] * B[7];
-    C[5] = S[1] * B[2] + S[2] * B[5] + S[4] * B[8];
-    C[6] = S[3] * B[0] + S[4] * B[3] + S[5] * B[6];
-    C[7] = S[3] * B[1] + S[4] * B[4] + S[5] * B[7];
-    C[8] = S[3] * B[2] + S[4] * B[5] + S[5] * B[8];
-  } else if constexpr (opB == MatOp::TRANSPOSE) {
-    C[0] = S[0] * B[0] + S[1] * B[1] + S[3] * B[2];
-    C[1] = S[0] * B[3] + S[1] * B[4] + S[3] * B[5];
-    C[2] = S[0] * B[6] + S[1] * B[7] + S[3] * B[8];
-    C[3] = S[1] * B[0] + S[2] * B[1] + S[4] * B[2];
-    C[4] = S[1] * B[3] + S[2] * B[4] + S[4] * B[5];
-    C[5] = S[1] * B[6] + S[2] * B[7] + S[4] * B[8];
-    C[6] = S[3] * B[0] + S[4] * B[1] + S[5] * B[2];
-    C[7] = S[3] * B[3] + S[4] * B[4] + S[5] * B[5];
-    C[8] = S[3] * B[6] + S[4] * B[7] + S[5] * B[8];
-  }
-}
-
-template <typename T, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void SMatMatMultCore3x3Scale(const T scalar, const T S[],
-                                          const T B[], T C[]) {
-  if constexpr (opB == MatOp::NORMAL) {
-    C[0] = scalar * (S[0] * B[0] + S[1] * B[3] + S[3] * B[6]);
-    C[1] = scalar * (S[0] * B[1] + S[1] * B[4] + S[3] * B[7]);
-    C[2] = scalar * (S[0] * B[2] + S[1] * B[5] + S[3] * B[8]);
-    C[3] = scalar * (S[1] * B[0] + S[2] * B[3] + S[4] * B[6]);
-    C[4] = scalar * (S[1] * B[1] + S[2] * B[4] + S[4] * B[7]);
-    C[5] = scalar * (S[1] * B[2] + S[2] * B[5] + S[4] * B[8]);
-    C[6] = scalar * (S[3] * B[0] + S[4] * B[3] + S[5] * B[6]);
-    C[7] = scalar * (S[3] * B[1] + S[4] * B[4] + S[5] * B[7]);
-    C[8] = scalar * (S[3] * B[2] + S[4] * B[5] + S[5] * B[8]);
-  } else if constexpr (opB == MatOp::TRANSPOSE) {
-    C[0] = scalar * (S[0] * B[0] + S[1] * B[1] + S[3] * B[2]);
-    C[1] = scalar * (S[0] * B[3] + S[1] * B[4] + S[3] * B[5]);
-    C[2] = scalar * (S[0] * B[6] + S[1] * B[7] + S[3] * B[8]);
-    C[3] = scalar * (S[1] * B[0] + S[2] * B[1] + S[4] * B[2]);
-    C[4] = scalar * (S[1] * B[3] + S[2] * B[4] + S[4] * B[5]);
-    C[5] = scalar * (S[1] * B[6] + S[2] * B[7] + S[4] * B[8]);
-    C[6] = scalar * (S[3] * B[0] + S[4] * B[1] + S[5] * B[2]);
-    C[7] = scalar * (S[3] * B[3] + S[4] * B[4] + S[5] * B[5]);
-    C[8] = scalar * (S[3] * B[6] + S[4] * B[7] + S[5] * B[8]);
-  }
-}
-
-template <typename T, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void SMatMatMultCore3x3Add(const T S[], const T B[], T C[]) {
-  if constexpr (opB == MatOp::NORMAL) {
-    C[0] += S[0] * B[0] + S[1] * B[3] + S[3] * B[6];
-    C[1] += S[0] * B[1] + S[1] * B[4] + S[3] * B[7];
-    C[2] += S[0] * B[2] + S[1] * B[5] + S[3] * B[8];
-    C[3] += S[1] * B[0] + S[2] * B[3] + S[4] * B[6];
-    C[4] += S[1] * B[1] + S[2] * B[4] + S[4] * B[7];
-    C[5] += S[1] * B[2] + S[2] * B[5] + S[4] * B[8];
-    C[6] += S[3] * B[0] + S[4] * B[3] + S[5] * B[6];
-    C[7] += S[3] * B[1] + S[4] * B[4] + S[5] * B[7];
-    C[8] += S[3] * B[2] + S[4] * B[5] + S[5] * B[8];
-  } else if constexpr (opB == MatOp::TRANSPOSE) {
-    C[0] += S[0] * B[0] + S[1] * B[1] + S[3] * B[2];
-    C[1] += S[0] * B[3] + S[1] * B[4] + S[3] * B[5];
-    C[2] += S[0] * B[6] + S[1] * B[7] + S[3] * B[8];
-    C[3] += S[1] * B[0] + S[2] * B[1] + S[4] * B[2];
-    C[4] += S[1] * B[3] + S[2] * B[4] + S[4] * B[5];
-    C[5] += S[1] * B[6] + S[2] * B[7] + S[4] * B[8];
-    C[6] += S[3] * B[0] + S[4] * B[1] + S[5] * B[2];
-    C[7] += S[3] * B[3] + S[4] * B[4] + S[5] * B[5];
-    C[8] += S[3] * B[6] + S[4] * B[7] + S[5] * B[8];
-  }
-}
-
-template <typename T, MatOp opB = MatOp::NORMAL>
-A2D_FUNCTION void SMatMatMultCore3x3ScaleAdd(const T scalar, const T S[],
-                                             const T B[], T C[]) {
-  if constexpr (opB == MatOp::NORMAL) {
-    C[0] += scalar * (S[0] * B[0] + S[1] * B[3] + S[3] * B[6]);
-    C[1] += scalar * (S[0] * B[1] + S[1] * B[4] + S[3] * B[7]);
-    C[2] += scalar * (S[0] * B[2] + S[1] * B[5] + S[3] * B[8]);
-    C[3] += scalar * (S[1] * B[0] + S[2] * B[3] + S[4] * B[6]);
-    C[4] += scalar * (S[1] * B[1] + S[2] * B[4] + S[4] * B[7]);
-    C[5] += scalar * (S[1] * B[2] + S[2] * B[5] + S[4] * B[8]);
-    C[6] += scalar * (S[3] * B[0] + S[4] * B[3] + S[5] * B[6]);
-    C[7] += scalar * (S[3] * B[1] + S[4] * B[4] + S[5] * B[7]);
-    C[8] += scalar * (S[3] * B[2] + S[4] * B[5] + S[5] * B[8]);
-  } else if constexpr (opB == MatOp::TRANSPOSE) {
-    C[0] += scalar * (S[0] * B[0] + S[1] * B[1] + S[3] * B[2]);
-    C[1] += scalar * (S[0] * B[3] + S[1] * B[4] + S[3] * B[5]);
-    C[2] += scalar * (S[0] * B[6] + S[1] * B[7] + S[3] * B[8]);
-    C[3] += scalar * (S[1] * B[0] + S[2] * B[1] + S[4] * B[2]);
-    C[4] += scalar * (S[1] * B[3] + S[2] * B[4] + S[4] * B[5]);
-    C[5] += scalar * (S[1] * B[6] + S[2] * B[7] + S[4] * B[8]);
-    C[6] += scalar * (S[3] * B[0] + S[4] * B[1] + S[5] * B[2]);
-    C[7] += scalar * (S[3] * B[3] + S[4] * B[4] + S[5] * B[5]);
-    C[8] += scalar * (S[3] * B[6] + S[4] * B[7] + S[5] * B[8]);
-  }
-}
-
 template <typename T, int Anrows, int Bnrows, int Bncols,
           MatOp opB = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void SMatMatMultCoreGeneral(const T SA[], const T B[], T C[]) {
-  int idim = Anrows;
-  int jdim = Anrows;
-  int kdim = opB == MatOp::NORMAL ? Bncols : Bnrows;
-
-  if constexpr (opB == MatOp::NORMAL) {
-    for (int i = 0; i < idim; i++) {
-      for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
-        for (int j = 0; j < jdim; j++) {
-          value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                   B[j * Bncols + k];
-        }
-        if (additive) {
-          C[i * Bncols + k] += value;  // C: Anrows-by-Bncols
-        } else {
-          C[i * Bncols + k] = value;  // C: Anrows-by-Bncols
-        }
-      }
-    }
-  } else {
-    for (int i = 0; i < idim; i++) {
-      for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
-        for (int j = 0; j < jdim; j++) {
-          value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                   B[k * Bncols + j];
-        }
-        if (additive) {
-          C[i * Bnrows + k] += value;  // C: Anrows-by-Bnrows
-        } else {
-          C[i * Bnrows + k] = value;  // C: Anrows-by-Bnrows
-        }
-      }
+  // C = S * op(B) is Anrows-by-K
+  constexpr int K = opB == MatOp::NORMAL ? Bncols : Bnrows;
+  Unroll<Anrows, K>([&](auto i, auto k) {
+    accum_t<T> value = 0.0;
+    Unroll<Anrows>([&](auto j) {
+      const T b =
+          opB == MatOp::NORMAL ? B[Bncols * j + k] : B[Bncols * k + j];
+      value += accum(SA[SymMatIndex<Anrows>(i, j)]) * b;
+    });
+    if constexpr (additive) {
+      C[K * i + k] += value;
+    } else {
+      C[K * i + k] = value;
     }
-  }
+  });
 }
 
 template <typename T, int Anrows, int Bnrows, int Bncols,
           MatOp opB = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void SMatMatMultScaleCoreGeneral(const T alpha, const T SA[],
                                               const T B[], T C[]) {
-  int idim = Anrows;
-  int jdim = Anrows;
-  int kdim = opB == MatOp::NORMAL ? Bncols : Bnrows;
-
-  if constexpr (opB == MatOp::NORMAL) {
-    for (int i = 0; i < idim; i++) {
-      for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
-        for (int j = 0; j < jdim; j++) {
-          value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                   B[j * Bncols + k];
-        }
-        if (additive) {
-          C[i * Bncols + k] += alpha * value;  // C: Anrows-by-Bncols
-        } else {
-          C[i * Bncols + k] = alpha * value;  // C: Anrows-by-Bncols
-        }
-      }
-    }
-  } else {
-    for (int i = 0; i < idim; i++) {
-      for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
-        for (int j = 0; j < jdim; j++) {
-          value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                   B[k * Bncols + j];
-        }
-        if (additive) {
-          C[i * Bnrows + k] += alpha * value;  // C: Anrows-by-Bnrows
-        } else {
-          C[i * Bnrows + k] = alpha * value;  // C: Anrows-by-Bnrows
-        }
-      }
+  // C = S * op(B) is Anrows-by-K
+  constexpr int K = opB == MatOp::NORMAL ? Bncols : Bnrows;
+  Unroll<Anrows, K>([&](auto i, auto k) {
+    accum_t<T> value = 0.0;
+    Unroll<Anrows>([&](auto j) {
+      const T b =
+          opB == MatOp::NORMAL ? B[Bncols * j + k] : B[Bncols * k + j];
+      value += accum(SA[SymMatIndex<Anrows>(i, j)]) * b;
+    });
+    if constexpr (additive) {
+      C[K * i + k] += alpha * value;
+    } else {
+      C[K * i + k] = alpha * value;
     }
-  }
+  });
 }
 
 template <typename T, int Anrows, int Bnrows, int Bncols, int Cnrows,
@@ -956,19 +610,13 @@ A2D_FUNCTION void SMatMatMultCore(const T S[], const T B[], T C[]) {
                   "Matrix dimensions must agree.");
   }
 
-  if constexpr (Anrows == 2 && Bnrows == 2 && Bncols == 2) {
-    if constexpr (additive) {
-      SMatMatMultCore2x2Add<T, opB>(S, B, C);
-    } else {
-      SMatMatMultCore2x2<T, opB>(S, B, C);
-    }
-
-  } else if constexpr (Anrows == 3 && Bnrows == 3 && Bncols == 3) {
-    if constexpr (additive) {
-      SMatMatMultCore3x3Add<T, opB>(S, B, C);
-    } else {
-      SMatMatMultCore3x3<T, opB>(S, B, C);
-    }
+  if constexpr (is_mixed_precision<T>::value) {
+    SMatMatMultCoreGeneral<T, Anrows, Bnrows, Bncols, opB, additive>(S, B, C);
+  } else if constexpr (has_simd_gemm<T>::value && Anrows == 3 &&
+                       Bnrows == 3 && Bncols == 3) {
+    SMatMatMultCore3x3Simd<T, opB, false, additive>(T(1.0), S, B, C);
+  } else if constexpr (Bnrows == Bncols && Anrows <= A2D_MAX_GEN_SIZE) {
+    SMatMatMultCoreGen<T, Anrows, opB, false, additive>(T(1.0), S, B, C);
   } else {  // The general fallback implmentation
     SMatMatMultCoreGeneral<T, Anrows, Bnrows, Bncols, opB, additive>(S, B, C);
   }
@@ -987,267 +635,59 @@ A2D_FUNCTION void SMatMatMultScaleCore(const T alpha, const T S[], const T B[],
                   "Matrix dimensions must agree.");
   }
 
-  if constexpr (Anrows == 2 && Bnrows == 2 && Bncols == 2) {
-    if constexpr (additive) {
-      SMatMatMultCore2x2ScaleAdd<T, opB>(alpha, S, B, C);
-    } else {
-      SMatMatMultCore2x2Scale<T, opB>(alpha, S, B, C);
-    }
-  } else if constexpr (Anrows == 3 && Bnrows == 3 && Bncols == 3) {
-    if constexpr (additive) {
-      SMatMatMultCore3x3ScaleAdd<T, opB>(alpha, S, B, C);
-    } else {
-      SMatMatMultCore3x3Scale<T, opB>(alpha, S, B, C);
-    }
+  if constexpr (is_mixed_precision<T>::value) {
+    SMatMatMultScaleCoreGeneral<T, Anrows, Bnrows, Bncols, opB, additive>(
+        alpha, S, B, C);
+  } else if constexpr (has_simd_gemm<T>::value && Anrows == 3 &&
+                       Bnrows == 3 && Bncols == 3) {
+    SMatMatMultCore3x3Simd<T, opB, true, additive>(alpha, S, B, C);
+  } else if constexpr (Bnrows == Bncols && Anrows <= A2D_MAX_GEN_SIZE) {
+    SMatMatMultCoreGen<T, Anrows, opB, true, additive>(alpha, S, B, C);
   } else {  // The general fallback implmentation
     SMatMatMultScaleCoreGeneral<T, Anrows, Bnrows, Bncols, opB, additive>(
         alpha, S, B, C);
   }
 }
 
-template <typename T, MatOp opA = MatOp::NORMAL>
-A2D_FUNCTION void MatSMatMultCore2x2(const T A[], const T S[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL) {
-    C[0] = A[0] * S[0] + A[1] * S[1];
-    C[1] = A[0] * S[1] + A[1] * S[2];
-    C[2] = A[2] * S[0] + A[3] * S[1];
-    C[3] = A[2] * S[1] + A[3] * S[2];
-  } else if constexpr (opA == MatOp::TRANSPOSE) {
-    C[0] = A[0] * S[0] + A[2] * S[1];
-    C[1] = A[0] * S[1] + A[2] * S[2];
-    C[2] = A[1] * S[0] + A[3] * S[1];
-    C[3] = A[1] * S[1] + A[3] * S[2];
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL>
-A2D_FUNCTION void MatSMatMultCore2x2Scale(const T scalar, const T A[],
-                                          const T S[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL) {
-    C[0] = scalar * (A[0] * S[0] + A[1] * S[1]);
-    C[1] = scalar * (A[0] * S[1] + A[1] * S[2]);
-    C[2] = scalar * (A[2] * S[0] + A[3] * S[1]);
-    C[3] = scalar * (A[2] * S[1] + A[3] * S[2]);
-  } else if constexpr (opA == MatOp::TRANSPOSE) {
-    C[0] = scalar * (A[0] * S[0] + A[2] * S[1]);
-    C[1] = scalar * (A[0] * S[1] + A[2] * S[2]);
-    C[2] = scalar * (A[1] * S[0] + A[3] * S[1]);
-    C[3] = scalar * (A[1] * S[1] + A[3] * S[2]);
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL>
-A2D_FUNCTION void MatSMatMultCore2x2Add(const T A[], const T S[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL) {
-    C[0] += A[0] * S[0] + A[1] * S[1];
-    C[1] += A[0] * S[1] + A[1] * S[2];
-    C[2] += A[2] * S[0] + A[3] * S[1];
-    C[3] += A[2] * S[1] + A[3] * S[2];
-  } else if constexpr (opA == MatOp::TRANSPOSE) {
-    C[0] += A[0] * S[0] + A[2] * S[1];
-    C[1] += A[0] * S[1] + A[2] * S[2];
-    C[2] += A[1] * S[0] + A[3] * S[1];
-    C[3] += A[1] * S[1] + A[3] * S[2];
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL>
-A2D_FUNCTION void MatSMatMultCore2x2ScaleAdd(const T scalar, const T A[],
-                                             const T S[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL) {
-    C[0] += scalar * (A[0] * S[0] + A[1] * S[1]);
-    C[1] += scalar * (A[0] * S[1] + A[1] * S[2]);
-    C[2] += scalar * (A[2] * S[0] + A[3] * S[1]);
-    C[3] += scalar * (A[2] * S[1] + A[3] * S[2]);
-  } else if constexpr (opA == MatOp::TRANSPOSE) {
-    C[0] += scalar * (A[0] * S[0] + A[2] * S[1]);
-    C[1] += scalar * (A[0] * S[1] + A[2] * S[2]);
-    C[2] += scalar * (A[1] * S[0] + A[3] * S[1]);
-    C[3] += scalar * (A[1] * S[1] + A[3] * S[2]);
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL>
-A2D_FUNCTION void MatSMatMultCore3x3(const T A[], const T S[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL) {
-    C[0] = A[0] * S[0] + A[1] * S[1] + A[2] * S[3];
-    C[1] = A[0] * S[1] + A[1] * S[2] + A[2] * S[4];
-    C[2] = A[0] * S[3] + A[1] * S[4] + A[2] * S[5];
-    C[3] = A[3] * S[0] + A[4] * S[1] + A[5] * S[3];
-    C[4] = A[3] * S[1] + A[4] * S[2] + A[5] * S[4];
-    C[5] = A[3] * S[3] + A[4] * S[4] + A[5] * S[5];
-    C[6] = A[6] * S[0] + A[7] * S[1] + A[8] * S[3];
-    C[7] = A[6] * S[1] + A[7] * S[2] + A[8] * S[4];
-    C[8] = A[6] * S[3] + A[7] * S[4] + A[8] * S[5];
-  } else if constexpr (opA == MatOp::TRANSPOSE) {
-    C[0] = A[0] * S[0] + A[3] * S[1] + A[6] * S[3];
-    C[1] = A[0] * S[1] + A[3] * S[2] + A[6] * S[4];
-    C[2] = A[0] * S[3] + A[3] * S[4] + A[6] * S[5];
-    C[3] = A[1] * S[0] + A[4] * S[1] + A[7] * S[3];
-    C[4] = A[1] * S[1] + A[4] * S[2] + A[7] * S[4];
-    C[5] = A[1] * S[3] + A[4] * S[4] + A[7] * S[5];
-    C[6] = A[2] * S[0] + A[5] * S[1] + A[8] * S[3];
-    C[7] = A[2] * S[1] + A[5] * S[2] + A[8] * S[4];
-    C[8] = A[2] * S[3] + A[5] * S[4] + A[8] * S[5];
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL>
-A2D_FUNCTION void MatSMatMultCore3x3Scale(const T scalar, const T A[],
-                                          const T S[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL) {
-    C[0] = scalar * (A[0] * S[0] + A[1] * S[1] + A[2] * S[3]);
-    C[1] = scalar * (A[0] * S[1] + A[1] * S[2] + A[2] * S[4]);
-    C[2] = scalar * (A[0] * S[3] + A[1] * S[4] + A[2] * S[5]);
-    C[3] = scalar * (A[3] * S[0] + A[4] * S[1] + A[5] * S[3]);
-    C[4] = scalar * (A[3] * S[1] + A[4] * S[2] + A[5] * S[4]);
-    C[5] = scalar * (A[3] * S[3] + A[4] * S[4] + A[5] * S[5]);
-    C[6] = scalar * (A[6] * S[0] + A[7] * S[1] + A[8] * S[3]);
-    C[7] = scalar * (A[6] * S[1] + A[7] * S[2] + A[8] * S[4]);
-    C[8] = scalar * (A[6] * S[3] + A[7] * S[4] + A[8] * S[5]);
-  } else if constexpr (opA == MatOp::TRANSPOSE) {
-    C[0] = scalar * (A[0] * S[0] + A[3] * S[1] + A[6] * S[3]);
-    C[1] = scalar * (A[0] * S[1] + A[3] * S[2] + A[6] * S[4]);
-    C[2] = scalar * (A[0] * S[3] + A[3] * S[4] + A[6] * S[5]);
-    C[3] = scalar * (A[1] * S[0] + A[4] * S[1] + A[7] * S[3]);
-    C[4] = scalar * (A[1] * S[1] + A[4] * S[2] + A[7] * S[4]);
-    C[5] = scalar * (A[1] * S[3] + A[4] * S[4] + A[7] * S[5]);
-    C[6] = scalar * (A[2] * S[0] + A[5] * S[1] + A[8] * S[3]);
-    C[7] = scalar * (A[2] * S[1] + A[5] * S[2] + A[8] * S[4]);
-    C[8] = scalar * (A[2] * S[3] + A[5] * S[4] + A[8] * S[5]);
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL>
-A2D_FUNCTION void MatSMatMultCore3x3Add(const T A[], const T S[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL) {
-    C[0] += A[0] * S[0] + A[1] * S[1] + A[2] * S[3];
-    C[1] += A[0] * S[1] + A[1] * S[2] + A[2] * S[4];
-    C[2] += A[0] * S[3] + A[1] * S[4] + A[2] * S[5];
-    C[3] += A[3] * S[0] + A[4] * S[1] + A[5] * S[3];
-    C[4] += A[3] * S[1] + A[4] * S[2] + A[5] * S[4];
-    C[5] += A[3] * S[3] + A[4] * S[4] + A[5] * S[5];
-    C[6] += A[6] * S[0] + A[7] * S[1] + A[8] * S[3];
-    C[7] += A[6] * S[1] + A[7] * S[2] + A[8] * S[4];
-    C[8] += A[6] * S[3] + A[7] * S[4] + A[8] * S[5];
-  } else if constexpr (opA == MatOp::TRANSPOSE) {
-    C[0] += A[0] * S[0] + A[3] * S[1] + A[6] * S[3];
-    C[1] += A[0] * S[1] + A[3] * S[2] + A[6] * S[4];
-    C[2] += A[0] * S[3] + A[3] * S[4] + A[6] * S[5];
-    C[3] += A[1] * S[0] + A[4] * S[1] + A[7] * S[3];
-    C[4] += A[1] * S[1] + A[4] * S[2] + A[7] * S[4];
-    C[5] += A[1] * S[3] + A[4] * S[4] + A[7] * S[5];
-    C[6] += A[2] * S[0] + A[5] * S[1] + A[8] * S[3];
-    C[7] += A[2] * S[1] + A[5] * S[2] + A[8] * S[4];
-    C[8] += A[2] * S[3] + A[5] * S[4] + A[8] * S[5];
-  }
-}
-
-template <typename T, MatOp opA = MatOp::NORMAL>
-A2D_FUNCTION void MatSMatMultCore3x3ScaleAdd(const T scalar, const T A[],
-                                             const T S[], T C[]) {
-  if constexpr (opA == MatOp::NORMAL) {
-    C[0] += scalar * (A[0] * S[0] + A[1] * S[1] + A[2] * S[3]);
-    C[1] += scalar * (A[0] * S[1] + A[1] * S[2] + A[2] * S[4]);
-    C[2] += scalar * (A[0] * S[3] + A[1] * S[4] + A[2] * S[5]);
-    C[3] += scalar * (A[3] * S[0] + A[4] * S[1] + A[5] * S[3]);
-    C[4] += scalar * (A[3] * S[1] + A[4] * S[2] + A[5] * S[4]);
-    C[5] += scalar * (A[3] * S[3] + A[4] * S[4] + A[5] * S[5]);
-    C[6] += scalar * (A[6] * S[0] + A[7] * S[1] + A[8] * S[3]);
-    C[7] += scalar * (A[6] * S[1] + A[7] * S[2] + A[8] * S[4]);
-    C[8] += scalar * (A[6] * S[3] + A[7] * S[4] + A[8] * S[5]);
-  } else if constexpr (opA == MatOp::TRANSPOSE) {
-    C[0] += scalar * (A[0] * S[0] + A[3] * S[1] + A[6] * S[3]);
-    C[1] += scalar * (A[0] * S[1] + A[3] * S[2] + A[6] * S[4]);
-    C[2] += scalar * (A[0] * S[3] + A[3] * S[4] + A[6] * S[5]);
-    C[3] += scalar * (A[1] * S[0] + A[4] * S[1] + A[7] * S[3]);
-    C[4] += scalar * (A[1] * S[1] + A[4] * S[2] + A[7] * S[4]);
-    C[5] += scalar * (A[1] * S[3] + A[4] * S[4] + A[7] * S[5]);
-    C[6] += scalar * (A[2] * S[0] + A[5] * S[1] + A[8] * S[3]);
-    C[7] += scalar * (A[2] * S[1] + A[5] * S[2] + A[8] * S[4]);
-    C[8] += scalar * (A[2] * S[3] + A[5] * S[4] + A[8] * S[5]);
-  }
-}
-
 template <typename T, int Anrows, int Ancols, int Bncols,
           MatOp opA = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void MatSMatMultCoreGeneral(const T A[], const T SB[], T C[]) {
-  int idim = opA == MatOp::NORMAL ? Anrows : Ancols;
-  int jdim = opA == MatOp::NORMAL ? Ancols : Anrows;
-  int kdim = Bncols;
-
-  if constexpr (opA == MatOp::NORMAL) {
-    for (int i = 0; i < idim; i++) {
-      for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
-        for (int j = 0; j < jdim; j++) {
-          value += A[i * Ancols + j] *
-                   SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
-        }
-        if (additive) {
-          C[i * Bncols + k] += value;  // C: Anrows-by-Bncols
-        } else {
-          C[i * Bncols + k] = value;  // C: Anrows-by-Bncols
-        }
-      }
-    }
-  } else {
-    for (int i = 0; i < idim; i++) {
-      for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
-        for (int j = 0; j < jdim; j++) {
-          value += A[j * Ancols + i] *
-                   SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
-        }
-        if (additive) {
-          C[i * Bncols + k] += value;  // C: Ancols-by-Bncols
-        } else {
-          C[i * Bncols + k] = value;  // C: Ancols-by-Bncols
-        }
-      }
+  // C = op(A) * S is I-by-Bncols
+  constexpr int I = opA == MatOp::NORMAL ? Anrows : Ancols;
+  Unroll<I, Bncols>([&](auto i, auto k) {
+    accum_t<T> value = 0.0;
+    Unroll<Bncols>([&](auto j) {
+      const T a =
+          opA == MatOp::NORMAL ? A[Ancols * i + j] : A[Ancols * j + i];
+      value += accum(a) * SB[SymMatIndex<Bncols>(j, k)];
+    });
+    if constexpr (additive) {
+      C[Bncols * i + k] += value;
+    } else {
+      C[Bncols * i + k] = value;
     }
-  }
+  });
 }
 
 template <typename T, int Anrows, int Ancols, int Bncols,
           MatOp opA = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void MatSMatMultScaleCoreGeneral(const T alpha, const T A[],
                                               const T SB[], T C[]) {
-  int idim = opA == MatOp::NORMAL ? Anrows : Ancols;
-  int jdim = opA == MatOp::NORMAL ? Ancols : Anrows;
-  int kdim = Bncols;
-
-  if constexpr (opA == MatOp::NORMAL) {
-    for (int i = 0; i < idim; i++) {
-      for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
-        for (int j = 0; j < jdim; j++) {
-          value += A[i * Ancols + j] *
-                   SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
-        }
-        if (additive) {
-          C[i * Bncols + k] += alpha * value;  // C: Anrows-by-Bncols
-        } else {
-          C[i * Bncols + k] = alpha * value;  // C: Anrows-by-Bncols
-        }
-      }
-    }
-  } else {
-    for (int i = 0; i < idim; i++) {
-      for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
-        for (int j = 0; j < jdim; j++) {
-          value += A[j * Ancols + i] *
-                   SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
-        }
-        if (additive) {
-          C[i * Bncols + k] += alpha * value;  // C: Ancols-by-Bncols
-        } else {
-          C[i * Bncols + k] = alpha * value;  // C: Ancols-by-Bncols
-        }
-      }
+  // C = op(A) * S is I-by-Bncols
+  constexpr int I = opA == MatOp::NORMAL ? Anrows : Ancols;
+  Unroll<I, Bncols>([&](auto i, auto k) {
+    accum_t<T> value = 0.0;
+    Unroll<Bncols>([&](auto j) {
+      const T a =
+          opA == MatOp::NORMAL ? A[Ancols * i + j] : A[Ancols * j + i];
+      value += accum(a) * SB[SymMatIndex<Bncols>(j, k)];
+    });
+    if constexpr (additive) {
+      C[Bncols * i + k] += alpha * value;
+    } else {
+      C[Bncols * i + k] = alpha * value;
     }
-  }
+  });
 }
 
 template <typename T, int Anrows, int Ancols, int Bnrows, int Cnrows,
@@ -1262,19 +702,13 @@ A2D_FUNCTION void MatSMatMultCore(const T A[], const T S[], T C[]) {
                   "Matrix dimensions must agree.");
   }
 
-  if constexpr (Anrows == 2 && Ancols == 2 && Bnrows == 2) {
-    if constexpr (additive) {
-      MatSMatMultCore2x2Add<T, opA>(A, S, C);
-    } else {
-      MatSMatMultCore2x2<T, opA>(A, S, C);
-    }
-
-  } else if constexpr (Anrows == 3 && Ancols == 3 && Bnrows == 3) {
-    if constexpr (additive) {
-      MatSMatMultCore3x3Add<T, opA>(A, S, C);
-    } else {
-      MatSMatMultCore3x3<T, opA>(A, S, C);
-    }
+  if constexpr (is_mixed_precision<T>::value) {
+    MatSMatMultCoreGeneral<T, Anrows, Ancols, Bnrows, opA, additive>(A, S, C);
+  } else if constexpr (has_simd_gemm<T>::value && Anrows == 3 &&
+                       Ancols == 3 && Bnrows == 3) {
+    MatSMatMultCore3x3Simd<T, opA, false, additive>(T(1.0), A, S, C);
+  } else if constexpr (Anrows == Ancols && Bnrows <= A2D_MAX_GEN_SIZE) {
+    MatSMatMultCoreGen<T, Bnrows, opA, false, additive>(T(1.0), A, S, C);
   } else {  // The general fallback implmentation
     MatSMatMultCoreGeneral<T, Anrows, Ancols, Bnrows, opA, additive>(A, S, C);
   }
@@ -1293,19 +727,14 @@ A2D_FUNCTION void MatSMatMultScaleCore(const T alpha, const T A[], const T S[],
                   "Matrix dimensions must agree.");
   }
 
-  if constexpr (Anrows == 2 && Ancols == 2 && Bnrows == 2) {
-    if constexpr (additive) {
-      MatSMatMultCore2x2ScaleAdd<T, opA>(alpha, A, S, C);
-    } else {
-      MatSMatMultCore2x2Scale<T, opA>(alpha, A, S, C);
-    }
-
-  } else if constexpr (Anrows == 3 && Ancols == 3 && Bnrows == 3) {
-    if constexpr (additive) {
-      MatSMatMultCore3x3ScaleAdd<T, opA>(alpha, A, S, C);
-    } else {
-      MatSMatMultCore3x3Scale<T, opA>(alpha, A, S, C);
-    }
+  if constexpr (is_mixed_precision<T>::value) {
+    MatSMatMultScaleCoreGeneral<T, Anrows, Ancols, Bnrows, opA, additive>(
+        alpha, A, S, C);
+  } else if constexpr (has_simd_gemm<T>::value && Anrows == 3 &&
+                       Ancols == 3 && Bnrows == 3) {
+    MatSMatMultCore3x3Simd<T, opA, true, additive>(alpha, A, S, C);
+  } else if constexpr (Anrows == Ancols && Bnrows <= A2D_MAX_GEN_SIZE) {
+    MatSMatMultCoreGen<T, Bnrows, opA, true, additive>(alpha, A, S, C);
   } else {  // The general fallback implmentation
     MatSMatMultScaleCoreGeneral<T, Anrows, Ancols, Bnrows, opA, additive>(
         alpha, A, S, C);
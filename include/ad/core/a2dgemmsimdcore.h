@@ -0,0 +1,307 @@
+#ifndef A2D_GEMM_SIMD_CORE_H
+#define A2D_GEMM_SIMD_CORE_H
+
+#include <type_traits>
+
+#include "../../a2ddefs.h"
+
+/*
+  Hand-vectorized 3x3 and 2x2 matrix-matrix products for float and double.
+
+  These kernels are used by the GEMM dispatchers in a2dgemmcore.h in place of
+  the scalar 3x3 kernels (and the general 2x2 loops for double) when
+  A2D_ENABLE_SIMD is defined and the target supports AVX2. Otherwise, or for
+  other numeric types such as complex or Batch, the scalar implementations
+  are used.
+
+  The 3x3 kernels hold one row of the matrices in a four-lane register: each
+  row of C is the sum of the rows of op(B) scaled by the broadcast entries of
+  op(A). The 2x2 kernels hold the whole matrix in one register.
+*/
+#if defined(A2D_ENABLE_SIMD) && defined(__AVX2__) && !defined(__CUDACC__)
+#define A2D_SIMD_GEMM 1
+#include <immintrin.h>
+#endif
+
+namespace A2D {
+
+// Whether the hand-vectorized GEMM kernels are used for the numeric type T
+template <typename T>
+struct has_simd_gemm {
+#ifdef A2D_SIMD_GEMM
+  static constexpr bool value =
+      std::is_same<T, double>::value || std::is_same<T, float>::value;
+#else
+  static constexpr bool value = false;
+#endif
+};
+
+// The 2x2 float products are vectorized well by the compiler, so only the
+// double precision 2x2 kernels are used
+template <typename T>
+struct has_simd_gemm2x2 {
+  static constexpr bool value =
+      has_simd_gemm<T>::value && std::is_same<T, double>::value;
+};
+
+#ifdef A2D_SIMD_GEMM
+
+namespace detail {
+
+// Four-lane registers for float and double
+template <typename T>
+struct SimdGemmReg;
+
+template <>
+struct SimdGemmReg<double> {
+  using reg = __m256d;
+
+  static inline reg load4(const double* x) { return _mm256_loadu_pd(x); }
+  static inline reg load3(const double* x) {
+    return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(x)),
+                                _mm_load_sd(x + 2), 1);
+  }
+  static inline void store4(double* x, reg v) { _mm256_storeu_pd(x, v); }
+  static inline void store3(double* x, reg v) {
+    _mm_storeu_pd(x, _mm256_castpd256_pd128(v));
+    _mm_store_sd(x + 2, _mm256_extractf128_pd(v, 1));
+  }
+  static inline reg set3(double a, double b, double c) {
+    return _mm256_set_pd(0.0, c, b, a);
+  }
+  static inline reg set1(double a) { return _mm256_set1_pd(a); }
+  static inline reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+  static inline reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+  static inline reg fmadd(reg a, reg b, reg c) {
+#ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+  }
+  template <int i0, int i1, int i2, int i3>
+  static inline reg permute(reg v) {
+    return _mm256_permute4x64_pd(v, i0 | (i1 << 2) | (i2 << 4) | (i3 << 6));
+  }
+};
+
+template <>
+struct SimdGemmReg<float> {
+  using reg = __m128;
+
+  static inline reg load4(const float* x) { return _mm_loadu_ps(x); }
+  static inline reg load3(const float* x) {
+    return _mm_movelh_ps(
+        _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(x))),
+        _mm_load_ss(x + 2));
+  }
+  static inline void store4(float* x, reg v) { _mm_storeu_ps(x, v); }
+  static inline void store3(float* x, reg v) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(x), v);
+    _mm_store_ss(x + 2, _mm_movehl_ps(v, v));
+  }
+  static inline reg set3(float a, float b, float c) {
+    return _mm_set_ps(0.0f, c, b, a);
+  }
+  static inline reg set1(float a) { return _mm_set1_ps(a); }
+  static inline reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+  static inline reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+  static inline reg fmadd(reg a, reg b, reg c) {
+#ifdef __FMA__
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+  }
+  template <int i0, int i1, int i2, int i3>
+  static inline reg permute(reg v) {
+    return _mm_permute_ps(v, i0 | (i1 << 2) | (i2 << 4) | (i3 << 6));
+  }
+};
+
+// Load the rows of op(B) for a 3x3 matrix B
+template <typename T, MatOp opB>
+inline void SimdGemmLoadRows3x3(const T B[],
+                                typename SimdGemmReg<T>::reg b[]) {
+  using V = SimdGemmReg<T>;
+  if constexpr (opB == MatOp::NORMAL) {
+    b[0] = V::load4(&B[0]);
+    b[1] = V::load4(&B[3]);
+    b[2] = V::load3(&B[6]);
+  } else {
+    b[0] = V::set3(B[0], B[3], B[6]);
+    b[1] = V::set3(B[1], B[4], B[7]);
+    b[2] = V::set3(B[2], B[5], B[8]);
+  }
+}
+
+// Load the rows of a packed 3x3 symmetric matrix S
+template <typename T>
+inline void SimdGemmLoadSymRows3x3(const T S[],
+                                   typename SimdGemmReg<T>::reg b[]) {
+  using V = SimdGemmReg<T>;
+  b[0] = V::set3(S[0], S[1], S[3]);
+  b[1] = V::set3(S[1], S[2], S[4]);
+  b[2] = V::load3(&S[3]);
+}
+
+// C (+)= alpha * a * b, where a is a row-major 3x3 array and b are the rows
+// of the second matrix. The last lane of each row of C may hold any value,
+// so the rows are stored in order and only the last row is masked.
+template <typename T, bool scale, bool additive>
+inline void SimdGemmRows3x3(const T alpha, const T a[],
+                            const typename SimdGemmReg<T>::reg b[], T C[]) {
+  using V = SimdGemmReg<T>;
+  typename V::reg c[3];
+  for (int i = 0; i < 3; i++) {
+    c[i] = V::mul(V::set1(a[3 * i]), b[0]);
+    c[i] = V::fmadd(V::set1(a[3 * i + 1]), b[1], c[i]);
+    c[i] = V::fmadd(V::set1(a[3 * i + 2]), b[2], c[i]);
+    if constexpr (scale) {
+      c[i] = V::mul(V::set1(alpha), c[i]);
+    }
+  }
+  if constexpr (additive) {
+    // Rows of C are loaded without the extra lane so that the loads do not
+    // straddle the overlapping stores of a previous call
+    c[0] = V::add(V::load3(&C[0]), c[0]);
+    c[1] = V::add(V::load3(&C[3]), c[1]);
+    c[2] = V::add(V::load3(&C[6]), c[2]);
+  }
+  V::store4(&C[0], c[0]);
+  V::store4(&C[3], c[1]);
+  V::store3(&C[6], c[2]);
+}
+
+// Entries of op(A) for a 3x3 matrix in row-major order
+template <typename T, MatOp opA>
+inline void SimdGemmOpA3x3(const T A[], T a[]) {
+  for (int i = 0; i < 3; i++) {
+    for (int k = 0; k < 3; k++) {
+      a[3 * i + k] = (opA == MatOp::NORMAL ? A[3 * i + k] : A[3 * k + i]);
+    }
+  }
+}
+
+// Entries of a packed 3x3 symmetric matrix in row-major order
+template <typename T>
+inline void SimdGemmSym3x3(const T S[], T a[]) {
+  a[0] = S[0], a[1] = S[1], a[2] = S[3];
+  a[3] = S[1], a[4] = S[2], a[5] = S[4];
+  a[6] = S[3], a[7] = S[4], a[8] = S[5];
+}
+
+}  // namespace detail
+
+/**
+ * @brief C (+)= alpha * op(A) * op(B) for 3x3 matrices
+ */
+template <typename T, MatOp opA, MatOp opB, bool scale, bool additive>
+inline void MatMatMultCore3x3Simd(const T alpha, const T A[], const T B[],
+                                  T C[]) {
+  typename detail::SimdGemmReg<T>::reg b[3];
+  detail::SimdGemmLoadRows3x3<T, opB>(B, b);
+  T a[9];
+  detail::SimdGemmOpA3x3<T, opA>(A, a);
+  detail::SimdGemmRows3x3<T, scale, additive>(alpha, a, b, C);
+}
+
+/**
+ * @brief C (+)= alpha * S * op(B) for a 3x3 symmetric matrix S
+ */
+template <typename T, MatOp opB, bool scale, bool additive>
+inline void SMatMatMultCore3x3Simd(const T alpha, const T S[], const T B[],
+                                   T C[]) {
+  typename detail::SimdGemmReg<T>::reg b[3];
+  detail::SimdGemmLoadRows3x3<T, opB>(B, b);
+  T a[9];
+  detail::SimdGemmSym3x3<T>(S, a);
+  detail::SimdGemmRows3x3<T, scale, additive>(alpha, a, b, C);
+}
+
+/**
+ * @brief C (+)= alpha * op(A) * S for a 3x3 symmetric matrix S
+ */
+template <typename T, MatOp opA, bool scale, bool additive>
+inline void MatSMatMultCore3x3Simd(const T alpha, const T A[], const T S[],
+                                   T C[]) {
+  typename detail::SimdGemmReg<T>::reg b[3];
+  detail::SimdGemmLoadSymRows3x3<T>(S, b);
+  T a[9];
+  detail::SimdGemmOpA3x3<T, opA>(A, a);
+  detail::SimdGemmRows3x3<T, scale, additive>(alpha, a, b, C);
+}
+
+/**
+ * @brief C (+)= alpha * SA * SB for 3x3 symmetric matrices SA and SB
+ */
+template <typename T, bool scale, bool additive>
+inline void SMatSMatMultCore3x3Simd(const T alpha, const T SA[], const T SB[],
+                                    T C[]) {
+  typename detail::SimdGemmReg<T>::reg b[3];
+  detail::SimdGemmLoadSymRows3x3<T>(SB, b);
+  T a[9];
+  detail::SimdGemmSym3x3<T>(SA, a);
+  detail::SimdGemmRows3x3<T, scale, additive>(alpha, a, b, C);
+}
+
+/**
+ * @brief C (+)= alpha * op(A) * op(B) for 2x2 matrices
+ *
+ * With a = op(A) and b = op(B), C = (a0, a0, a2, a2) * (b0, b1, b0, b1) +
+ * (a1, a1, a3, a3) * (b2, b3, b2, b3), where each operand is a permutation of
+ * the entries of A or B.
+ */
+template <typename T, MatOp opA, MatOp opB, bool scale, bool additive>
+inline void MatMatMultCore2x2Simd(const T alpha, const T A[], const T B[],
+                                  T C[]) {
+  using V = detail::SimdGemmReg<T>;
+  typename V::reg va = V::load4(A), vb = V::load4(B), a0, a1, b0, b1;
+  if constexpr (opA == MatOp::NORMAL) {
+    a0 = V::template permute<0, 0, 2, 2>(va);
+    a1 = V::template permute<1, 1, 3, 3>(va);
+  } else {
+    a0 = V::template permute<0, 0, 1, 1>(va);
+    a1 = V::template permute<2, 2, 3, 3>(va);
+  }
+  if constexpr (opB == MatOp::NORMAL) {
+    b0 = V::template permute<0, 1, 0, 1>(vb);
+    b1 = V::template permute<2, 3, 2, 3>(vb);
+  } else {
+    b0 = V::template permute<0, 2, 0, 2>(vb);
+    b1 = V::template permute<1, 3, 1, 3>(vb);
+  }
+  typename V::reg c = V::fmadd(a1, b1, V::mul(a0, b0));
+  if constexpr (scale) {
+    c = V::mul(V::set1(alpha), c);
+  }
+  if constexpr (additive) {
+    c = V::add(V::load4(C), c);
+  }
+  V::store4(C, c);
+}
+
+#else  // A2D_SIMD_GEMM
+
+// Declarations only: these are never called when has_simd_gemm is false
+template <typename T, MatOp opA, MatOp opB, bool scale, bool additive>
+void MatMatMultCore3x3Simd(const T alpha, const T A[], const T B[], T C[]);
+
+template <typename T, MatOp opB, bool scale, bool additive>
+void SMatMatMultCore3x3Simd(const T alpha, const T S[], const T B[], T C[]);
+
+template <typename T, MatOp opA, bool scale, bool additive>
+void MatSMatMultCore3x3Simd(const T alpha, const T A[], const T S[], T C[]);
+
+template <typename T, bool scale, bool additive>
+void SMatSMatMultCore3x3Simd(const T alpha, const T SA[], const T SB[],
+                             T C[]);
+
+template <typename T, MatOp opA, MatOp opB, bool scale, bool additive>
+void MatMatMultCore2x2Simd(const T alpha, const T A[], const T B[], T C[]);
+
+#endif  // A2D_SIMD_GEMM
+
+}  // namespace A2D
+
+#endif  // A2D_GEMM_SIMD_CORE_H
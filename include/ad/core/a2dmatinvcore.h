@@ -2,70 +2,214 @@
 #define A2D_MAT_INV_CORE_H
 
 #include "../../a2ddefs.h"
+#include "generated/a2dmatinvgen.h"
 
 namespace A2D {
 
+/*
+  LU factorization with partial pivoting for general N
+
+  P * A = L * U
+
+  The factors overwrite LU (L with a unit diagonal below, U on and above the
+  diagonal). At step k, row k is swapped with row piv[k] >= k. The pivot is
+  selected using the real part so that the factorization is unchanged under
+  a complex step. All loops have compile-time bounds so that they are fully
+  unrolled for the small sizes used here. The factors may be stored in a
+  wider type R than the matrix, see accum_t.
+
+  The row swaps depend on the values, so a Batch, whose lanes would need
+  different pivots, cannot be factored.
+*/
+template <typename T, int N, typename R = T>
+A2D_FUNCTION void MatLUFactorCore(const T A[], R LU[], index_t piv[]) {
+  static_assert(!is_batch_v<T> && !is_batch_v<R>,
+                "The LU factorization pivots on the values and is not "
+                "batchable: MatInv and SymMatInv for N > "
+                "A2D_MAX_GEN_INV_SIZE and MatSolve do not accept Batch");
+  for (int i = 0; i < N * N; i++) {
+    LU[i] = A[i];
+  }
+
+  for (int k = 0; k < N; k++) {
+    // Find the pivot row
+    index_t p = k;
+    double pmax = absfunc(LU[k * N + k]);
+    for (int i = k + 1; i < N; i++) {
+      double val = absfunc(LU[i * N + k]);
+      if (val > pmax) {
+        p = i;
+        pmax = val;
+      }
+    }
+    piv[k] = p;
+
+    if (p != k) {
+      for (int j = 0; j < N; j++) {
+        R t = LU[k * N + j];
+        LU[k * N + j] = LU[p * N + j];
+        LU[p * N + j] = t;
+      }
+    }
+
+    // Eliminate below the diagonal
+    R dinv = 1.0 / LU[k * N + k];
+    for (int i = k + 1; i < N; i++) {
+      R lik = LU[i * N + k] * dinv;
+      LU[i * N + k] = lik;
+      for (int j = k + 1; j < N; j++) {
+        LU[i * N + j] -= lik * LU[k * N + j];
+      }
+    }
+  }
+}
+
+/*
+  Solve op(A) * x = b using the factors from MatLUFactorCore
+
+  The right-hand side b and the solution x may be the same array. Factors of a
+  wider type R are applied in R.
+*/
+template <typename T, int N, MatOp op = MatOp::NORMAL, typename R = T>
+A2D_FUNCTION void MatLUSolveCore(const R LU[], const index_t piv[],
+                                 const T b[], T x[]) {
+  if constexpr (!std::is_same<R, T>::value) {
+    R y[N];
+    ConvertCopyCore<N>(b, y);
+    MatLUSolveCore<R, N, op>(LU, piv, y, y);
+    ConvertCopyCore<N>(y, x);
+    return;
+  }
+
+  if (x != b) {
+    for (int i = 0; i < N; i++) {
+      x[i] = b[i];
+    }
+  }
+
+  if constexpr (op == MatOp::NORMAL) {
+    // x = L^{-1} * P * b
+    for (int k = 0; k < N; k++) {
+      if (piv[k] != k) {
+        T t = x[k];
+        x[k] = x[piv[k]];
+        x[piv[k]] = t;
+      }
+    }
+    for (int i = 1; i < N; i++) {
+      for (int j = 0; j < i; j++) {
+        x[i] -= LU[i * N + j] * x[j];
+      }
+    }
+
+    // x = U^{-1} * x
+    for (int i = N - 1; i >= 0; i--) {
+      for (int j = i + 1; j < N; j++) {
+        x[i] -= LU[i * N + j] * x[j];
+      }
+      x[i] = x[i] / LU[i * N + i];
+    }
+  } else {
+    // x = U^{-T} * b
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j < i; j++) {
+        x[i] -= LU[j * N + i] * x[j];
+      }
+      x[i] = x[i] / LU[i * N + i];
+    }
+
+    // x = P^{T} * L^{-T} * x
+    for (int i = N - 2; i >= 0; i--) {
+      for (int j = i + 1; j < N; j++) {
+        x[i] -= LU[j * N + i] * x[j];
+      }
+    }
+    for (int k = N - 1; k >= 0; k--) {
+      if (piv[k] != k) {
+        T t = x[k];
+        x[k] = x[piv[k]];
+        x[piv[k]] = t;
+      }
+    }
+  }
+}
+
+/*
+  Compute Ainv = A^{-1} from the factors of MatLUFactorCore
+*/
+template <typename T, int N>
+A2D_FUNCTION void MatLUInvCore(const T LU[], const index_t piv[], T Ainv[]) {
+  T col[N];
+  for (int j = 0; j < N; j++) {
+    for (int i = 0; i < N; i++) {
+      col[i] = T(0.0);
+    }
+    col[j] = T(1.0);
+    MatLUSolveCore<T, N>(LU, piv, col, col);
+    for (int i = 0; i < N; i++) {
+      Ainv[i * N + j] = col[i];
+    }
+  }
+}
+
+/*
+  Compute the inverse of a matrix: the generated cofactor expressions for
+  N <= A2D_MAX_GEN_INV_SIZE and the LU factorization with partial pivoting
+  otherwise
+*/
 template <typename T, int N>
 A2D_FUNCTION void MatInvCore(const T A[], T Ainv[]) {
-  static_assert((N >= 1 && N <= 3), "MatInvCore not implemented for N >= 4");
-
-  if constexpr (N == 1) {
-    Ainv[0] = 1.0 / A[0];
-  } else if constexpr (N == 2) {
-    T det = A[0] * A[3] - A[1] * A[2];
-    T detinv = 1.0 / det;
-
-    Ainv[0] = A[3] * detinv;
-    Ainv[1] = -A[1] * detinv;
-    Ainv[2] = -A[2] * detinv;
-    Ainv[3] = A[0] * detinv;
-  } else {  // N == 3
-    T det = (A[8] * (A[0] * A[4] - A[3] * A[1]) -
-             A[7] * (A[0] * A[5] - A[3] * A[2]) +
-             A[6] * (A[1] * A[5] - A[2] * A[4]));
-    T detinv = 1.0 / det;
-
-    Ainv[0] = (A[4] * A[8] - A[5] * A[7]) * detinv;
-    Ainv[1] = -1.0 * (A[1] * A[8] - A[2] * A[7]) * detinv;
-    Ainv[2] = (A[1] * A[5] - A[2] * A[4]) * detinv;
-
-    Ainv[3] = -1.0 * (A[3] * A[8] - A[5] * A[6]) * detinv;
-    Ainv[4] = (A[0] * A[8] - A[2] * A[6]) * detinv;
-    Ainv[5] = -1.0 * (A[0] * A[5] - A[2] * A[3]) * detinv;
-
-    Ainv[6] = (A[3] * A[7] - A[4] * A[6]) * detinv;
-    Ainv[7] = -1.0 * (A[0] * A[7] - A[1] * A[6]) * detinv;
-    Ainv[8] = (A[0] * A[4] - A[1] * A[3]) * detinv;
+  static_assert(N >= 1, "MatInvCore requires N >= 1");
+
+  if constexpr (is_mixed_precision<T>::value) {
+    accum_t<T> a[N * N], ainv[N * N];
+    ConvertCopyCore<N * N>(A, a);
+    MatInvCore<accum_t<T>, N>(a, ainv);
+    ConvertCopyCore<N * N>(ainv, Ainv);
+  } else if constexpr (N <= A2D_MAX_GEN_INV_SIZE) {
+    MatInvCoreGen<T, N>(A, Ainv);
+  } else {
+    T LU[N * N];
+    index_t piv[N];
+    MatLUFactorCore<T, N>(A, LU, piv);
+    MatLUInvCore<T, N>(LU, piv, Ainv);
   }
 }
 
 template <typename T, int N>
 A2D_FUNCTION void SymMatInvCore(const T S[], T Sinv[]) {
-  static_assert((N >= 1 && N <= 3), "MatInvCore not implemented for N >= 4");
-
-  if constexpr (N == 1) {
-    Sinv[0] = 1.0 / S[0];
-  } else if constexpr (N == 2) {
-    T det = S[0] * S[2] - S[1] * S[1];
-    T detinv = 1.0 / det;
-
-    Sinv[0] = S[2] * detinv;
-    Sinv[1] = -S[1] * detinv;
-    Sinv[2] = S[0] * detinv;
-  } else {  // N == 3
-    T det = (S[5] * (S[0] * S[2] - S[1] * S[1]) -
-             S[4] * (S[0] * S[4] - S[1] * S[3]) +
-             S[3] * (S[1] * S[4] - S[3] * S[2]));
-    T detinv = 1.0 / det;
-
-    Sinv[0] = (S[2] * S[5] - S[4] * S[4]) * detinv;
-    Sinv[1] = -(S[1] * S[5] - S[3] * S[4]) * detinv;
-    Sinv[3] = (S[1] * S[4] - S[3] * S[2]) * detinv;
-
-    Sinv[2] = (S[0] * S[5] - S[3] * S[3]) * detinv;
-    Sinv[4] = -(S[0] * S[4] - S[3] * S[1]) * detinv;
-
-    Sinv[5] = (S[0] * S[2] - S[1] * S[1]) * detinv;
+  static_assert(N >= 1, "SymMatInvCore requires N >= 1");
+
+  if constexpr (is_mixed_precision<T>::value) {
+    accum_t<T> s[N * (N + 1) / 2], sinv[N * (N + 1) / 2];
+    ConvertCopyCore<N * (N + 1) / 2>(S, s);
+    SymMatInvCore<accum_t<T>, N>(s, sinv);
+    ConvertCopyCore<N * (N + 1) / 2>(sinv, Sinv);
+  } else if constexpr (N <= A2D_MAX_GEN_INV_SIZE) {
+    SymMatInvCoreGen<T, N>(S, Sinv);
+  } else {
+    // Pivoting does not preserve symmetry, so factor the full matrix and
+    // store the lower triangle of the inverse
+    T A[N * N], LU[N * N];
+    index_t piv[N];
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j <= i; j++) {
+        A[i * N + j] = A[j * N + i] = S[j + i * (i + 1) / 2];
+      }
+    }
+    MatLUFactorCore<T, N>(A, LU, piv);
+
+    T col[N];
+    for (int j = 0; j < N; j++) {
+      for (int i = 0; i < N; i++) {
+        col[i] = T(0.0);
+      }
+      col[j] = T(1.0);
+      MatLUSolveCore<T, N>(LU, piv, col, col);
+      for (int i = j; i < N; i++) {
+        Sinv[j + i * (i + 1) / 2] = col[i];
+      }
+    }
   }
 }
 
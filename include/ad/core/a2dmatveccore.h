@@ -4,6 +4,132 @@
 #include "../../a2ddefs.h"
 
 namespace A2D {
+
+/*
+  Register-blocked matrix-vector products for medium sizes
+
+  The blocked kernels process MR rows of A at a time. For y = A * x, the MR
+  dot products are accumulated together, each in L partial sums over the
+  entries j = l mod L, so that each entry of x is loaded once per block and
+  the MR * L sums form independent chains of multiply-adds instead of a
+  single chain of length N. The partial sums vectorize along the rows of A,
+  and they change the order of the sums compared to the unblocked loops. For
+  y = A^{T} * x, each pass over y applies MR rows of A, so that y is loaded
+  and stored once per block instead of once per row. The entries of y are
+  then summed in the same order as by the unblocked loops.
+
+  Types that are not arithmetic (complex, Batch) use a single partial sum.
+*/
+template <typename T>
+struct gemv_block_size {
+  static constexpr int MR = std::is_arithmetic<T>::value ? 8 : 2;
+  static constexpr int L = std::is_arithmetic<T>::value ? 4 : 1;
+};
+
+// Whether MatVecCore and MatVecCoreScale use the register-blocked kernel
+template <int M, int N>
+struct use_blocked_gemv {
+  static constexpr bool value = M * N > A2D_MAX_UNROLL;
+};
+
+/**
+ * @brief Compute the entries i0, ..., i0 + mr - 1 of y = alpha * A * x
+ */
+template <typename T, int N, int mr, bool scale, bool additive>
+A2D_FUNCTION void MatVecBlockKernel(const T alpha, const T A[], const T x[],
+                                    T y[], const int i0) {
+  constexpr int L = gemv_block_size<T>::L;
+  constexpr int N0 = (N / L) * L;
+
+  accum_t<T> c[mr][L];
+  for (int i = 0; i < mr; i++) {
+    for (int l = 0; l < L; l++) {
+      c[i][l] = 0.0;
+    }
+  }
+  for (int j0 = 0; j0 < N0; j0 += L) {
+    for (int i = 0; i < mr; i++) {
+      for (int l = 0; l < L; l++) {
+        c[i][l] += accum(A[N * (i0 + i) + j0 + l]) * x[j0 + l];
+      }
+    }
+  }
+  for (int j = N0; j < N; j++) {
+    for (int i = 0; i < mr; i++) {
+      c[i][0] += accum(A[N * (i0 + i) + j]) * x[j];
+    }
+  }
+
+  for (int i = 0; i < mr; i++) {
+    accum_t<T> value = c[i][0];
+    for (int l = 1; l < L; l++) {
+      value += c[i][l];
+    }
+    if constexpr (scale && additive) {
+      y[i0 + i] += alpha * value;
+    } else if constexpr (scale) {
+      y[i0 + i] = alpha * value;
+    } else if constexpr (additive) {
+      y[i0 + i] += value;
+    } else {
+      y[i0 + i] = value;
+    }
+  }
+}
+
+/**
+ * @brief Add the rows i0, ..., i0 + mr - 1 of A^{T} * (alpha * x) to y
+ */
+template <typename T, int N, int mr, bool scale>
+A2D_FUNCTION void MatTransVecBlockKernel(const T alpha, const T A[],
+                                         const T x[], T y[], const int i0) {
+  T xs[mr];
+  for (int i = 0; i < mr; i++) {
+    xs[i] = scale ? alpha * x[i0 + i] : x[i0 + i];
+  }
+  for (int j = 0; j < N; j++) {
+    T value = y[j];
+    for (int i = 0; i < mr; i++) {
+      value += A[N * (i0 + i) + j] * xs[i];
+    }
+    y[j] = value;
+  }
+}
+
+/**
+ * @brief Register-blocked matrix-vector product y = alpha * op(A) * x
+ *
+ * A is M x N, alpha is only referenced when scale is true.
+ */
+template <typename T, int M, int N, MatOp opA = MatOp::NORMAL,
+          bool scale = false, bool additive = false>
+A2D_FUNCTION void MatVecCoreBlocked(const T alpha, const T A[], const T x[],
+                                    T y[]) {
+  constexpr int MR = gemv_block_size<T>::MR;
+  constexpr int M0 = (M / MR) * MR;
+
+  if constexpr (opA == MatOp::NORMAL) {
+    for (int i0 = 0; i0 < M0; i0 += MR) {
+      MatVecBlockKernel<T, N, MR, scale, additive>(alpha, A, x, y, i0);
+    }
+    if constexpr (M0 < M) {
+      MatVecBlockKernel<T, N, M - M0, scale, additive>(alpha, A, x, y, M0);
+    }
+  } else {
+    if constexpr (!additive) {
+      for (int j = 0; j < N; j++) {
+        y[j] = T(0.0);
+      }
+    }
+    for (int i0 = 0; i0 < M0; i0 += MR) {
+      MatTransVecBlockKernel<T, N, MR, scale>(alpha, A, x, y, i0);
+    }
+    if constexpr (M0 < M) {
+      MatTransVecBlockKernel<T, N, M - M0, scale>(alpha, A, x, y, M0);
+    }
+  }
+}
+
 /*
   Compute the matrix-vector products
 
@@ -16,12 +142,32 @@ namespace A2D {
 template <typename T, int M, int N, MatOp opA = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void MatVecCore(const T A[], const T x[], T y[]) noexcept {
-  if constexpr (additive) {
+  if constexpr (opA == MatOp::TRANSPOSE && is_mixed_precision<T>::value) {
+    // Sum the rows of A in the accumulation type
+    accum_t<T> value[N];
+    for (int j = 0; j < N; j++) {
+      value[j] = 0.0;
+    }
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++, A++) {
+        value[j] += accum(A[0]) * x[i];
+      }
+    }
+    for (int j = 0; j < N; j++) {
+      if constexpr (additive) {
+        y[j] += value[j];
+      } else {
+        y[j] = value[j];
+      }
+    }
+  } else if constexpr (use_blocked_gemv<M, N>::value) {
+    MatVecCoreBlocked<T, M, N, opA, false, additive>(T(1.0), A, x, y);
+  } else if constexpr (additive) {
     if constexpr (opA == MatOp::NORMAL) {
       for (int i = 0; i < M; i++) {
-        T value = 0.0;
+        accum_t<T> value = 0.0;
         for (int j = 0; j < N; j++, A++) {
-          value += A[0] * x[j];
+          value += accum(A[0]) * x[j];
         }
         y[i] += value;
       }
@@ -36,9 +182,9 @@ A2D_FUNCTION void MatVecCore(const T A[], const T x[], T y[]) noexcept {
   } else {
     if constexpr (opA == MatOp::NORMAL) {
       for (int i = 0; i < M; i++) {
-        T value = 0.0;
+        accum_t<T> value = 0.0;
         for (int j = 0; j < N; j++, A++) {
-          value += A[0] * x[j];
+          value += accum(A[0]) * x[j];
         }
         y[i] = value;
       }
@@ -62,12 +208,31 @@ template <typename T, int M, int N, MatOp opA = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void MatVecCoreScale(const T alpha, const T A[], const T x[],
                                   T y[]) noexcept {
-  if constexpr (additive) {
+  if constexpr (opA == MatOp::TRANSPOSE && is_mixed_precision<T>::value) {
+    accum_t<T> value[N];
+    for (int j = 0; j < N; j++) {
+      value[j] = 0.0;
+    }
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++, A++) {
+        value[j] += accum(A[0]) * x[i];
+      }
+    }
+    for (int j = 0; j < N; j++) {
+      if constexpr (additive) {
+        y[j] += alpha * value[j];
+      } else {
+        y[j] = alpha * value[j];
+      }
+    }
+  } else if constexpr (use_blocked_gemv<M, N>::value) {
+    MatVecCoreBlocked<T, M, N, opA, true, additive>(alpha, A, x, y);
+  } else if constexpr (additive) {
     if constexpr (opA == MatOp::NORMAL) {
       for (int i = 0; i < M; i++) {
-        T value = 0.0;
+        accum_t<T> value = 0.0;
         for (int j = 0; j < N; j++, A++) {
-          value += A[0] * x[j];
+          value += accum(A[0]) * x[j];
         }
 
         y[i] += alpha * value;
@@ -83,9 +248,9 @@ A2D_FUNCTION void MatVecCoreScale(const T alpha, const T A[], const T x[],
   } else {
     if constexpr (opA == MatOp::NORMAL) {
       for (int i = 0; i < M; i++) {
-        T value = 0.0;
+        accum_t<T> value = 0.0;
         for (int j = 0; j < N; j++, A++) {
-          value += A[0] * x[j];
+          value += accum(A[0]) * x[j];
         }
 
         y[i] = alpha * value;
@@ -108,10 +273,10 @@ A2D_FUNCTION void MatVecCoreScale(const T alpha, const T A[], const T x[],
 
 template <typename T, int M, int N>
 A2D_FUNCTION T MatInnerCore(const T A[], const T x[], const T y[]) noexcept {
-  T value = 0.0;
+  accum_t<T> value = 0.0;
   for (int i = 0; i < M; i++) {
     for (int j = 0; j < N; j++) {
-      value += x[i] * A[0] * y[j];
+      value += accum(x[i]) * A[0] * y[j];
     }
   }
 
@@ -2,25 +2,24 @@
 #define A2D_SYM_TRACE_CORE_H
 
 #include "../../a2ddefs.h"
+#include "generated/a2dsymmatmulttracegen.h"
 
 namespace A2D {
 
 template <typename T, int N>
 A2D_FUNCTION T SymMatMultTraceCore(const T S[], const T E[]) {
-  if constexpr (N == 1) {
-    return S[0] * E[0];
-  } else if constexpr (N == 2) {
-    return S[0] * E[0] + S[2] * E[2] + 2.0 * S[1] * E[1];
-  } else if constexpr (N == 3) {
-    return S[0] * E[0] + S[2] * E[2] + S[5] * E[5] +
-           2.0 * (S[1] * E[1] + S[3] * E[3] + S[4] * E[4]);
+  // The loop accumulates in accum_t<T> with mixed precision
+  constexpr bool closed_form = !is_mixed_precision<T>::value;
+
+  if constexpr (N <= A2D_MAX_GEN_SIZE && closed_form) {
+    return SymMatMultTraceCoreGen<T, N>(S, E);
   } else {
-    T trace = 0.0;
+    accum_t<T> trace = 0.0;
     for (int i = 0; i < N; i++) {
       for (int j = 0; j < i; j++, S++, E++) {
-        trace += 2.0 * S[0] * E[0];
+        trace += 2.0 * accum(S[0]) * E[0];
       }
-      trace += S[0] * E[0];
+      trace += accum(S[0]) * E[0];
       S++, E++;
     }
     return trace;
@@ -30,19 +29,8 @@ A2D_FUNCTION T SymMatMultTraceCore(const T S[], const T E[]) {
 template <typename T, int N>
 A2D_FUNCTION void SymMatMultTraceReverseCore(const T scale, const T S[],
                                              T E[]) {
-  if constexpr (N == 1) {
-    E[0] += scale * S[0];
-  } else if constexpr (N == 2) {
-    E[0] += scale * S[0];
-    E[1] += 2.0 * scale * S[1];
-    E[2] += scale * S[2];
-  } else if constexpr (N == 3) {
-    E[0] += scale * S[0];
-    E[1] += 2.0 * scale * S[1];
-    E[2] += scale * S[2];
-    E[3] += 2.0 * scale * S[3];
-    E[4] += 2.0 * scale * S[4];
-    E[5] += scale * S[5];
+  if constexpr (N <= A2D_MAX_GEN_SIZE) {
+    SymMatMultTraceReverseCoreGen<T, N>(scale, S, E);
   } else {
     for (int i = 0; i < N; i++) {
       for (int j = 0; j < i; j++, S++, E++) {
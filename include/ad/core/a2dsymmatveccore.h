@@ -47,25 +47,17 @@ A2D_FUNCTION void SymMatVecCoreScale3x3(const T &scale, const T A[],
 */
 template <typename T, int M, bool additive = false>
 A2D_FUNCTION void SymMatVecCore(const T S[], const T x[], T y[]) noexcept {
-  if constexpr (additive) {
-    for (int i = 0; i < M; i++) {
-      T value = 0.0;
-      for (int j = 0; j < M; j++) {
-        int index = i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2;
-        value += S[index] * x[j];  // value += S[i, j] * y[j]
-      }
+  Unroll<M>([&](auto i) {
+    accum_t<T> value = 0.0;
+    Unroll<M>([&](auto j) {
+      value += accum(S[SymMatIndex<M>(i, j)]) * x[j];  // S[i, j] * x[j]
+    });
+    if constexpr (additive) {
       y[i] += value;
-    }
-  } else {
-    for (int i = 0; i < M; i++) {
-      T value = 0.0;
-      for (int j = 0; j < M; j++) {
-        int index = i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2;
-        value += S[index] * x[j];  // value += S[i, j] * y[j]
-      }
+    } else {
       y[i] = value;
     }
-  }
+  });
 }
 
 }  // namespace A2D
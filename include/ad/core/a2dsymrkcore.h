@@ -14,45 +14,24 @@ namespace A2D {
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void SymMatRKCore(const T A[], T S[]) {
-  if constexpr (op == MatOp::NORMAL) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        const T* a = &A[K * i];
-        const T* b = &A[K * j];
-
-        T val = 0.0;
-        for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
-          a++, b++;
-        }
-        if constexpr (additive) {
-          S[0] += val;
-        } else {
-          S[0] = val;
-        }
-        S++;
-      }
-    }
-  } else {
-    for (int i = 0; i < K; i++) {
-      for (int j = 0; j <= i; j++) {
-        const T* a = &A[i];
-        const T* b = &A[j];
-
-        T val = 0.0;
-        for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
-          a += K, b += K;
-        }
-        if constexpr (additive) {
-          S[0] += val;
-        } else {
-          S[0] = val;
-        }
-        S++;
+  // S is D-by-D and the products have P terms
+  constexpr int D = op == MatOp::NORMAL ? N : K;
+  constexpr int P = op == MatOp::NORMAL ? K : N;
+  UnrollLower<D>([&](auto i, auto j) {
+    accum_t<T> val = 0.0;
+    Unroll<P>([&](auto k) {
+      if constexpr (op == MatOp::NORMAL) {
+        val += accum(A[K * i + k]) * A[K * j + k];
+      } else {
+        val += accum(A[K * k + i]) * A[K * k + j];
       }
+    });
+    if constexpr (additive) {
+      S[SymMatIndex<D>(i, j)] += val;
+    } else {
+      S[SymMatIndex<D>(i, j)] = val;
     }
-  }
+  });
 }
 
 /*
@@ -64,45 +43,24 @@ A2D_FUNCTION void SymMatRKCore(const T A[], T S[]) {
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void SymMatRKCoreScale(const T alpha, const T A[], T S[]) {
-  if constexpr (op == MatOp::NORMAL) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        const T* a = &A[K * i];
-        const T* b = &A[K * j];
-
-        T val = 0.0;
-        for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
-          a++, b++;
-        }
-        if constexpr (additive) {
-          S[0] += alpha * val;
-        } else {
-          S[0] = alpha * val;
-        }
-        S++;
+  // S is D-by-D and the products have P terms
+  constexpr int D = op == MatOp::NORMAL ? N : K;
+  constexpr int P = op == MatOp::NORMAL ? K : N;
+  UnrollLower<D>([&](auto i, auto j) {
+    accum_t<T> val = 0.0;
+    Unroll<P>([&](auto k) {
+      if constexpr (op == MatOp::NORMAL) {
+        val += accum(A[K * i + k]) * A[K * j + k];
+      } else {
+        val += accum(A[K * k + i]) * A[K * k + j];
       }
+    });
+    if constexpr (additive) {
+      S[SymMatIndex<D>(i, j)] += alpha * val;
+    } else {
+      S[SymMatIndex<D>(i, j)] = alpha * val;
     }
-  } else {
-    for (int i = 0; i < K; i++) {
-      for (int j = 0; j <= i; j++) {
-        const T* a = &A[i];
-        const T* b = &A[j];
-
-        T val = 0.0;
-        for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
-          a += K, b += K;
-        }
-        if constexpr (additive) {
-          S[0] += alpha * val;
-        } else {
-          S[0] = alpha * val;
-        }
-        S++;
-      }
-    }
-  }
+  });
 }
 
 /*
@@ -114,61 +72,31 @@ A2D_FUNCTION void SymMatRKCoreScale(const T alpha, const T A[], T S[]) {
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void SymMatR2KCore(const T A[], const T B[], T S[]) {
-  if constexpr (op == MatOp::NORMAL) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        T val = 0.0;
-
-        const T* a = &A[K * i];
-        const T* b = &B[K * j];
-        for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
-          a++, b++;
-        }
-
-        a = &A[K * j];
-        b = &B[K * i];
-        for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
-          a++, b++;
-        }
-
-        if constexpr (additive) {
-          S[0] += val;
-        } else {
-          S[0] = val;
-        }
-        S++;
+  // S is D-by-D and the products have P terms
+  constexpr int D = op == MatOp::NORMAL ? N : K;
+  constexpr int P = op == MatOp::NORMAL ? K : N;
+  UnrollLower<D>([&](auto i, auto j) {
+    accum_t<T> val = 0.0;
+    Unroll<P>([&](auto k) {
+      if constexpr (op == MatOp::NORMAL) {
+        val += accum(A[K * i + k]) * B[K * j + k];
+      } else {
+        val += accum(A[K * k + i]) * B[K * k + j];
       }
-    }
-  } else {
-    for (int i = 0; i < K; i++) {
-      for (int j = 0; j <= i; j++) {
-        T val = 0.0;
-
-        const T* a = &A[i];
-        const T* b = &B[j];
-        for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
-          a += K, b += K;
-        }
-
-        a = &A[j];
-        b = &B[i];
-        for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
-          a += K, b += K;
-        }
-
-        if constexpr (additive) {
-          S[0] += val;
-        } else {
-          S[0] = val;
-        }
-        S++;
+    });
+    Unroll<P>([&](auto k) {
+      if constexpr (op == MatOp::NORMAL) {
+        val += accum(A[K * j + k]) * B[K * i + k];
+      } else {
+        val += accum(A[K * k + j]) * B[K * k + i];
       }
+    });
+    if constexpr (additive) {
+      S[SymMatIndex<D>(i, j)] += val;
+    } else {
+      S[SymMatIndex<D>(i, j)] = val;
     }
-  }
+  });
 }
 
 /*
@@ -181,170 +109,74 @@ template <typename T, int N, int K, MatOp op = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void SymMatR2KCoreScale(const T alpha, const T A[], const T B[],
                                      T S[]) {
-  if constexpr (op == MatOp::NORMAL) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        T val = 0.0;
-
-        const T* a = &A[K * i];
-        const T* b = &B[K * j];
-        for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
-          a++, b++;
-        }
-
-        a = &A[K * j];
-        b = &B[K * i];
-        for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
-          a++, b++;
-        }
-
-        if constexpr (additive) {
-          S[0] += alpha * val;
-        } else {
-          S[0] = alpha * val;
-        }
-        S++;
+  // S is D-by-D and the products have P terms
+  constexpr int D = op == MatOp::NORMAL ? N : K;
+  constexpr int P = op == MatOp::NORMAL ? K : N;
+  UnrollLower<D>([&](auto i, auto j) {
+    accum_t<T> val = 0.0;
+    Unroll<P>([&](auto k) {
+      if constexpr (op == MatOp::NORMAL) {
+        val += accum(A[K * i + k]) * B[K * j + k];
+      } else {
+        val += accum(A[K * k + i]) * B[K * k + j];
       }
-    }
-  } else {
-    for (int i = 0; i < K; i++) {
-      for (int j = 0; j <= i; j++) {
-        T val = 0.0;
-
-        const T* a = &A[i];
-        const T* b = &B[j];
-        for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
-          a += K, b += K;
-        }
-
-        a = &A[j];
-        b = &B[i];
-        for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
-          a += K, b += K;
-        }
-
-        if constexpr (additive) {
-          S[0] += alpha * val;
-        } else {
-          S[0] = alpha * val;
-        }
-        S++;
+    });
+    Unroll<P>([&](auto k) {
+      if constexpr (op == MatOp::NORMAL) {
+        val += accum(A[K * j + k]) * B[K * i + k];
+      } else {
+        val += accum(A[K * k + j]) * B[K * k + i];
       }
+    });
+    if constexpr (additive) {
+      S[SymMatIndex<D>(i, j)] += alpha * val;
+    } else {
+      S[SymMatIndex<D>(i, j)] = alpha * val;
     }
-  }
+  });
 }
 
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL>
 A2D_FUNCTION void SymMatRKCoreReverse(const T A[], const T Sb[], T Ab[]) {
-  if constexpr (op == MatOp::NORMAL) {
-    // Ab = Sb * A
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j < K; j++) {
-        int k = 0;
-        const T* s = &Sb[i * (i + 1) / 2];
-        const T* a = &A[j];
-
-        T val = 0.0;
-        for (; k < i; k++) {
-          val += s[0] * a[0];
-          a += K, s++;
-        }
-
-        for (; k < N; k++) {
-          val += s[0] * a[0];
-          a += K, s += k + 1;
-        }
-
-        val += A[K * i + j] * Sb[i + i * (i + 1) / 2];
-
-        Ab[0] += val;
-        Ab++;
-      }
-    }
-  } else {  // op == MatOp::TRANSPOSE
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j < K; j++) {
-        int k = 0;
-        const T* a = &A[K * i];
-        const T* s = &Sb[j * (j + 1) / 2];
-
-        T val = 0.0;
-        for (; k < j; k++) {
-          val += s[0] * a[0];
-          a++, s++;
-        }
-
-        for (; k < K; k++) {
-          val += s[0] * a[0];
-          a++, s += k + 1;
-        }
-
-        val += A[K * i + j] * Sb[j + j * (j + 1) / 2];
-
-        Ab[0] += val;
-        Ab++;
-      }
+  Unroll<N, K>([&](auto i, auto j) {
+    accum_t<T> val = 0.0;
+    if constexpr (op == MatOp::NORMAL) {
+      // Ab = Sb * A
+      Unroll<N>([&](auto k) {
+        val += accum(Sb[SymMatIndex<N>(i, k)]) * A[K * k + j];
+      });
+      val += accum(A[K * i + j]) * Sb[SymMatIndex<N>(i, i)];
+    } else {
+      // Ab = A * Sb
+      Unroll<K>([&](auto k) {
+        val += accum(Sb[SymMatIndex<K>(j, k)]) * A[K * i + k];
+      });
+      val += accum(A[K * i + j]) * Sb[SymMatIndex<K>(j, j)];
     }
-  }
+    Ab[K * i + j] += val;
+  });
 }
 
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL>
 A2D_FUNCTION void SymMatRKCoreReverseScale(const T alpha, const T A[],
                                            const T Sb[], T Ab[]) {
-  if constexpr (op == MatOp::NORMAL) {
-    // Ab = Sb * A
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j < K; j++) {
-        int k = 0;
-        const T* s = &Sb[i * (i + 1) / 2];
-        const T* a = &A[j];
-
-        T val = 0.0;
-        for (; k < i; k++) {
-          val += s[0] * a[0];
-          a += K, s++;
-        }
-
-        for (; k < N; k++) {
-          val += s[0] * a[0];
-          a += K, s += k + 1;
-        }
-
-        val += A[K * i + j] * Sb[i + i * (i + 1) / 2];
-
-        Ab[0] += alpha * val;
-        Ab++;
-      }
-    }
-  } else {  // op == MatOp::TRANSPOSE
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j < K; j++) {
-        int k = 0;
-        const T* a = &A[K * i];
-        const T* s = &Sb[j * (j + 1) / 2];
-
-        T val = 0.0;
-        for (; k < j; k++) {
-          val += s[0] * a[0];
-          a++, s++;
-        }
-
-        for (; k < K; k++) {
-          val += s[0] * a[0];
-          a++, s += k + 1;
-        }
-
-        val += A[K * i + j] * Sb[j + j * (j + 1) / 2];
-
-        Ab[0] += alpha * val;
-        Ab++;
-      }
+  Unroll<N, K>([&](auto i, auto j) {
+    accum_t<T> val = 0.0;
+    if constexpr (op == MatOp::NORMAL) {
+      // Ab = Sb * A
+      Unroll<N>([&](auto k) {
+        val += accum(Sb[SymMatIndex<N>(i, k)]) * A[K * k + j];
+      });
+      val += accum(A[K * i + j]) * Sb[SymMatIndex<N>(i, i)];
+    } else {
+      // Ab = A * Sb
+      Unroll<K>([&](auto k) {
+        val += accum(Sb[SymMatIndex<K>(j, k)]) * A[K * i + k];
+      });
+      val += accum(A[K * i + j]) * Sb[SymMatIndex<K>(j, j)];
     }
-  }
+    Ab[K * i + j] += alpha * val;
+  });
 }
 
 }  // namespace A2D
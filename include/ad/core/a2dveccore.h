@@ -21,120 +21,77 @@ A2D_FUNCTION void VecCrossCoreAdd(const T x[], const T y[], T v[]) {
 
 template <typename T, int size>
 A2D_FUNCTION void VecZeroCore(T A[]) {
-  for (int i = 0; i < size; i++) {
-    A[0] = T(0.0);
-    A++;
-  }
+  Unroll<size>([&](auto i) { A[i] = T(0.0); });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecCopyCore(const T A[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] = A[0];
-    C++, A++;
-  }
+  Unroll<size>([&](auto i) { C[i] = A[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecScaleCore(const T alpha, const T A[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] = alpha * A[0];
-    C++, A++;
-  }
+  Unroll<size>([&](auto i) { C[i] = alpha * A[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecAddCore(const T A[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] += A[0];
-    C++, A++;
-  }
+  Unroll<size>([&](auto i) { C[i] += A[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecAddCore(const T alpha, const T A[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] += alpha * A[0];
-    C++, A++;
-  }
+  Unroll<size>([&](auto i) { C[i] += alpha * A[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION T VecDotCore(const T A[], const T B[]) {
-  T dot = 0.0;
-  for (int i = 0; i < size; i++) {
-    dot += A[0] * B[0];
-    A++, B++;
-  }
+  accum_t<T> dot = 0.0;
+  Unroll<size>([&](auto i) { dot += accum(A[i]) * B[i]; });
   return dot;
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecSumCore(const T A[], const T B[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] = A[0] + B[0];
-    C++, A++, B++;
-  }
+  Unroll<size>([&](auto i) { C[i] = A[i] + B[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecSumCore(const T alpha, const T A[], const T beta,
                              const T B[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] = alpha * A[0] + beta * B[0];
-    C++, A++, B++;
-  }
+  Unroll<size>([&](auto i) { C[i] = alpha * A[i] + beta * B[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecHadamardCore(const T A[], const T B[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] = A[0] * B[0];
-    C++, A++, B++;
-  }
+  Unroll<size>([&](auto i) { C[i] = A[i] * B[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecHadamardDoubleCore(const T A[], const T Aseed[],
                                         const T B[], const T Bseed[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    // C[0] = A[0] * B[0];
-    C[0] = Aseed[0] * B[0] + Bseed[0] * A[0];
-    C++, A++, B++, Aseed++, Bseed++;
-  }
+  Unroll<size>([&](auto i) { C[i] = Aseed[i] * B[i] + Bseed[i] * A[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecHadamardSingleCore(const T A[], const T Bseed[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] = A[0] * Bseed[0];
-    C++, A++, Bseed++;
-  }
+  Unroll<size>([&](auto i) { C[i] = A[i] * Bseed[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecHadamardAddCore(const T A[], const T Bseed[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] += A[0] * Bseed[0];
-    C++, A++, Bseed++;
-  }
+  Unroll<size>([&](auto i) { C[i] += A[i] * Bseed[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecSumCoreAdd(const T A[], const T B[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] += A[0] + B[0];
-    C++, A++, B++;
-  }
+  Unroll<size>([&](auto i) { C[i] += A[i] + B[i]; });
 }
 
 template <typename T, int size>
 A2D_FUNCTION void VecSumCoreAdd(const T alpha, const T A[], const T beta,
                                 const T B[], T C[]) {
-  for (int i = 0; i < size; i++) {
-    C[0] += alpha * A[0] + beta * B[0];
-    C++, A++, B++;
-  }
+  Unroll<size>([&](auto i) { C[i] += alpha * A[i] + beta * B[i]; });
 }
 
 /*
@@ -148,38 +105,13 @@ A2D_FUNCTION void VecSumCoreAdd(const T alpha, const T A[], const T beta,
 */
 template <typename T, int M, int N, bool additive = false>
 A2D_FUNCTION void VecOuterCore(const T x[], const T y[], T A[]) {
-  if constexpr (additive) {
-    for (int i = 0; i < M; i++) {
-      for (int j = 0; j < N; j++) {
-        A[N * i + j] += x[i] * y[j];
-      }
-    }
-
-  } else {
-    for (int i = 0; i < M; i++) {
-      for (int j = 0; j < N; j++) {
-        A[N * i + j] += x[i] * y[j];
-      }
-    }
-  }
+  Unroll<M, N>([&](auto i, auto j) { A[N * i + j] += x[i] * y[j]; });
 }
 
 template <typename T, int M, int N, bool additive = false>
 A2D_FUNCTION void VecOuterCore(const T alpha, const T x[], const T y[], T A[]) {
-  if constexpr (additive) {
-    for (int i = 0; i < M; i++) {
-      for (int j = 0; j < N; j++) {
-        A[N * i + j] += alpha * x[i] * y[j];
-      }
-    }
-
-  } else {
-    for (int i = 0; i < M; i++) {
-      for (int j = 0; j < N; j++) {
-        A[N * i + j] += alpha * x[i] * y[j];
-      }
-    }
-  }
+  Unroll<M, N>(
+      [&](auto i, auto j) { A[N * i + j] += alpha * x[i] * y[j]; });
 }
 
 /*
@@ -190,63 +122,41 @@ A2D_FUNCTION void VecOuterCore(const T alpha, const T x[], const T y[], T A[]) {
 template <typename T, int N, bool additive = false>
 A2D_FUNCTION void DiagonalPreservingVecSymOuterCore(const T x[], const T y[],
                                                     T S[]) {
-  if constexpr (additive) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j < i; j++) {
-        S[0] += x[i] * y[j] + x[j] * y[i];
-        S++;
-      }
-      S[0] += x[i] * y[i];
-      S++;
+  UnrollLower<N>([&](auto i, auto j) {
+    T value;
+    if (i == j) {
+      value = x[i] * y[i];
+    } else {
+      value = x[i] * y[j] + x[j] * y[i];
     }
-  } else {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j < i; j++) {
-        S[0] = x[i] * y[j] + x[j] * y[i];
-        S++;
-      }
-      S[0] = x[i] * y[i];
-      S++;
+    if constexpr (additive) {
+      S[SymMatIndex<N>(i, j)] += value;
+    } else {
+      S[SymMatIndex<N>(i, j)] = value;
     }
-  }
+  });
 }
 
 template <typename T, int N, bool additive = false>
 A2D_FUNCTION void VecSymOuterCore(const T x[], T S[]) {
-  if constexpr (additive) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        S[0] += x[i] * x[j];
-        S++;
-      }
+  UnrollLower<N>([&](auto i, auto j) {
+    if constexpr (additive) {
+      S[SymMatIndex<N>(i, j)] += x[i] * x[j];
+    } else {
+      S[SymMatIndex<N>(i, j)] = x[i] * x[j];
     }
-  } else {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        S[0] = x[i] * x[j];
-        S++;
-      }
-    }
-  }
+  });
 }
 
 template <typename T, int N, bool additive = false>
 A2D_FUNCTION void VecSymOuterCore(const T alpha, const T x[], T S[]) {
-  if constexpr (additive) {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        S[0] += alpha * x[i] * x[j];
-        S++;
-      }
-    }
-  } else {
-    for (int i = 0; i < N; i++) {
-      for (int j = 0; j <= i; j++) {
-        S[0] = alpha * x[i] * x[j];
-        S++;
-      }
+  UnrollLower<N>([&](auto i, auto j) {
+    if constexpr (additive) {
+      S[SymMatIndex<N>(i, j)] += alpha * x[i] * x[j];
+    } else {
+      S[SymMatIndex<N>(i, j)] = alpha * x[i] * x[j];
     }
-  }
+  });
 }
 
 }  // namespace A2D
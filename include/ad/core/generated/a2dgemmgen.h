@@ -0,0 +1,411 @@
+// Generated by python/a2dcodegen.py, do not edit
+#ifndef A2D_GEMM_GEN_H
+#define A2D_GEMM_GEN_H
+
+#include "../../../a2ddefs.h"
+
+namespace A2D {
+
+template <int size, bool scale, bool additive, typename T>
+A2D_FUNCTION void GenStoreCore(const T alpha, const T c[], T C[]) {
+  for (int i = 0; i < size; i++) {
+    if constexpr (scale && additive) {
+      C[i] += alpha * c[i];
+    } else if constexpr (scale) {
+      C[i] = alpha * c[i];
+    } else if constexpr (additive) {
+      C[i] += c[i];
+    } else {
+      C[i] = c[i];
+    }
+  }
+}
+
+/*
+  C = alpha * op(A) * op(B) for N-by-N matrices, alpha is only used when
+  scale is true and C is added to when additive is true
+*/
+template <typename T, int N, MatOp opA, MatOp opB, bool scale = false,
+          bool additive = false>
+A2D_FUNCTION void MatMatMultCoreGen(const T alpha, const T A[], const T B[],
+                                    T C[]) {
+  static_assert(N >= 1 && N <= 4, "MatMatMultCoreGen is generated for N <= 4");
+
+  T c[N * N];
+  if constexpr (N == 1 && opA == MatOp::NORMAL && opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0];
+  } else if constexpr (N == 1 && opA == MatOp::NORMAL &&
+                       opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0];
+  } else if constexpr (N == 1 && opA == MatOp::TRANSPOSE &&
+                       opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0];
+  } else if constexpr (N == 1 && opA == MatOp::TRANSPOSE &&
+                       opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0];
+  } else if constexpr (N == 2 && opA == MatOp::NORMAL && opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[1] * B[2];
+    c[1] = A[0] * B[1] + A[1] * B[3];
+    c[2] = A[2] * B[0] + A[3] * B[2];
+    c[3] = A[2] * B[1] + A[3] * B[3];
+  } else if constexpr (N == 2 && opA == MatOp::NORMAL &&
+                       opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[1] * B[1];
+    c[1] = A[0] * B[2] + A[1] * B[3];
+    c[2] = A[2] * B[0] + A[3] * B[1];
+    c[3] = A[2] * B[2] + A[3] * B[3];
+  } else if constexpr (N == 2 && opA == MatOp::TRANSPOSE &&
+                       opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[2] * B[2];
+    c[1] = A[0] * B[1] + A[2] * B[3];
+    c[2] = A[1] * B[0] + A[3] * B[2];
+    c[3] = A[1] * B[1] + A[3] * B[3];
+  } else if constexpr (N == 2 && opA == MatOp::TRANSPOSE &&
+                       opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[2] * B[1];
+    c[1] = A[0] * B[2] + A[2] * B[3];
+    c[2] = A[1] * B[0] + A[3] * B[1];
+    c[3] = A[1] * B[2] + A[3] * B[3];
+  } else if constexpr (N == 3 && opA == MatOp::NORMAL && opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[1] * B[3] + A[2] * B[6];
+    c[1] = A[0] * B[1] + A[1] * B[4] + A[2] * B[7];
+    c[2] = A[0] * B[2] + A[1] * B[5] + A[2] * B[8];
+    c[3] = A[3] * B[0] + A[4] * B[3] + A[5] * B[6];
+    c[4] = A[3] * B[1] + A[4] * B[4] + A[5] * B[7];
+    c[5] = A[3] * B[2] + A[4] * B[5] + A[5] * B[8];
+    c[6] = A[6] * B[0] + A[7] * B[3] + A[8] * B[6];
+    c[7] = A[6] * B[1] + A[7] * B[4] + A[8] * B[7];
+    c[8] = A[6] * B[2] + A[7] * B[5] + A[8] * B[8];
+  } else if constexpr (N == 3 && opA == MatOp::NORMAL &&
+                       opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[1] * B[1] + A[2] * B[2];
+    c[1] = A[0] * B[3] + A[1] * B[4] + A[2] * B[5];
+    c[2] = A[0] * B[6] + A[1] * B[7] + A[2] * B[8];
+    c[3] = A[3] * B[0] + A[4] * B[1] + A[5] * B[2];
+    c[4] = A[3] * B[3] + A[4] * B[4] + A[5] * B[5];
+    c[5] = A[3] * B[6] + A[4] * B[7] + A[5] * B[8];
+    c[6] = A[6] * B[0] + A[7] * B[1] + A[8] * B[2];
+    c[7] = A[6] * B[3] + A[7] * B[4] + A[8] * B[5];
+    c[8] = A[6] * B[6] + A[7] * B[7] + A[8] * B[8];
+  } else if constexpr (N == 3 && opA == MatOp::TRANSPOSE &&
+                       opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[3] * B[3] + A[6] * B[6];
+    c[1] = A[0] * B[1] + A[3] * B[4] + A[6] * B[7];
+    c[2] = A[0] * B[2] + A[3] * B[5] + A[6] * B[8];
+    c[3] = A[1] * B[0] + A[4] * B[3] + A[7] * B[6];
+    c[4] = A[1] * B[1] + A[4] * B[4] + A[7] * B[7];
+    c[5] = A[1] * B[2] + A[4] * B[5] + A[7] * B[8];
+    c[6] = A[2] * B[0] + A[5] * B[3] + A[8] * B[6];
+    c[7] = A[2] * B[1] + A[5] * B[4] + A[8] * B[7];
+    c[8] = A[2] * B[2] + A[5] * B[5] + A[8] * B[8];
+  } else if constexpr (N == 3 && opA == MatOp::TRANSPOSE &&
+                       opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[3] * B[1] + A[6] * B[2];
+    c[1] = A[0] * B[3] + A[3] * B[4] + A[6] * B[5];
+    c[2] = A[0] * B[6] + A[3] * B[7] + A[6] * B[8];
+    c[3] = A[1] * B[0] + A[4] * B[1] + A[7] * B[2];
+    c[4] = A[1] * B[3] + A[4] * B[4] + A[7] * B[5];
+    c[5] = A[1] * B[6] + A[4] * B[7] + A[7] * B[8];
+    c[6] = A[2] * B[0] + A[5] * B[1] + A[8] * B[2];
+    c[7] = A[2] * B[3] + A[5] * B[4] + A[8] * B[5];
+    c[8] = A[2] * B[6] + A[5] * B[7] + A[8] * B[8];
+  } else if constexpr (N == 4 && opA == MatOp::NORMAL && opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[1] * B[4] + A[2] * B[8] + A[3] * B[12];
+    c[1] = A[0] * B[1] + A[1] * B[5] + A[2] * B[9] + A[3] * B[13];
+    c[2] = A[0] * B[2] + A[1] * B[6] + A[2] * B[10] + A[3] * B[14];
+    c[3] = A[0] * B[3] + A[1] * B[7] + A[2] * B[11] + A[3] * B[15];
+    c[4] = A[4] * B[0] + A[5] * B[4] + A[6] * B[8] + A[7] * B[12];
+    c[5] = A[4] * B[1] + A[5] * B[5] + A[6] * B[9] + A[7] * B[13];
+    c[6] = A[4] * B[2] + A[5] * B[6] + A[6] * B[10] + A[7] * B[14];
+    c[7] = A[4] * B[3] + A[5] * B[7] + A[6] * B[11] + A[7] * B[15];
+    c[8] = A[8] * B[0] + A[9] * B[4] + A[10] * B[8] + A[11] * B[12];
+    c[9] = A[8] * B[1] + A[9] * B[5] + A[10] * B[9] + A[11] * B[13];
+    c[10] = A[8] * B[2] + A[9] * B[6] + A[10] * B[10] + A[11] * B[14];
+    c[11] = A[8] * B[3] + A[9] * B[7] + A[10] * B[11] + A[11] * B[15];
+    c[12] = A[12] * B[0] + A[13] * B[4] + A[14] * B[8] + A[15] * B[12];
+    c[13] = A[12] * B[1] + A[13] * B[5] + A[14] * B[9] + A[15] * B[13];
+    c[14] = A[12] * B[2] + A[13] * B[6] + A[14] * B[10] + A[15] * B[14];
+    c[15] = A[12] * B[3] + A[13] * B[7] + A[14] * B[11] + A[15] * B[15];
+  } else if constexpr (N == 4 && opA == MatOp::NORMAL &&
+                       opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[1] * B[1] + A[2] * B[2] + A[3] * B[3];
+    c[1] = A[0] * B[4] + A[1] * B[5] + A[2] * B[6] + A[3] * B[7];
+    c[2] = A[0] * B[8] + A[1] * B[9] + A[2] * B[10] + A[3] * B[11];
+    c[3] = A[0] * B[12] + A[1] * B[13] + A[2] * B[14] + A[3] * B[15];
+    c[4] = A[4] * B[0] + A[5] * B[1] + A[6] * B[2] + A[7] * B[3];
+    c[5] = A[4] * B[4] + A[5] * B[5] + A[6] * B[6] + A[7] * B[7];
+    c[6] = A[4] * B[8] + A[5] * B[9] + A[6] * B[10] + A[7] * B[11];
+    c[7] = A[4] * B[12] + A[5] * B[13] + A[6] * B[14] + A[7] * B[15];
+    c[8] = A[8] * B[0] + A[9] * B[1] + A[10] * B[2] + A[11] * B[3];
+    c[9] = A[8] * B[4] + A[9] * B[5] + A[10] * B[6] + A[11] * B[7];
+    c[10] = A[8] * B[8] + A[9] * B[9] + A[10] * B[10] + A[11] * B[11];
+    c[11] = A[8] * B[12] + A[9] * B[13] + A[10] * B[14] + A[11] * B[15];
+    c[12] = A[12] * B[0] + A[13] * B[1] + A[14] * B[2] + A[15] * B[3];
+    c[13] = A[12] * B[4] + A[13] * B[5] + A[14] * B[6] + A[15] * B[7];
+    c[14] = A[12] * B[8] + A[13] * B[9] + A[14] * B[10] + A[15] * B[11];
+    c[15] = A[12] * B[12] + A[13] * B[13] + A[14] * B[14] + A[15] * B[15];
+  } else if constexpr (N == 4 && opA == MatOp::TRANSPOSE &&
+                       opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[4] * B[4] + A[8] * B[8] + A[12] * B[12];
+    c[1] = A[0] * B[1] + A[4] * B[5] + A[8] * B[9] + A[12] * B[13];
+    c[2] = A[0] * B[2] + A[4] * B[6] + A[8] * B[10] + A[12] * B[14];
+    c[3] = A[0] * B[3] + A[4] * B[7] + A[8] * B[11] + A[12] * B[15];
+    c[4] = A[1] * B[0] + A[5] * B[4] + A[9] * B[8] + A[13] * B[12];
+    c[5] = A[1] * B[1] + A[5] * B[5] + A[9] * B[9] + A[13] * B[13];
+    c[6] = A[1] * B[2] + A[5] * B[6] + A[9] * B[10] + A[13] * B[14];
+    c[7] = A[1] * B[3] + A[5] * B[7] + A[9] * B[11] + A[13] * B[15];
+    c[8] = A[2] * B[0] + A[6] * B[4] + A[10] * B[8] + A[14] * B[12];
+    c[9] = A[2] * B[1] + A[6] * B[5] + A[10] * B[9] + A[14] * B[13];
+    c[10] = A[2] * B[2] + A[6] * B[6] + A[10] * B[10] + A[14] * B[14];
+    c[11] = A[2] * B[3] + A[6] * B[7] + A[10] * B[11] + A[14] * B[15];
+    c[12] = A[3] * B[0] + A[7] * B[4] + A[11] * B[8] + A[15] * B[12];
+    c[13] = A[3] * B[1] + A[7] * B[5] + A[11] * B[9] + A[15] * B[13];
+    c[14] = A[3] * B[2] + A[7] * B[6] + A[11] * B[10] + A[15] * B[14];
+    c[15] = A[3] * B[3] + A[7] * B[7] + A[11] * B[11] + A[15] * B[15];
+  } else if constexpr (N == 4 && opA == MatOp::TRANSPOSE &&
+                       opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[4] * B[1] + A[8] * B[2] + A[12] * B[3];
+    c[1] = A[0] * B[4] + A[4] * B[5] + A[8] * B[6] + A[12] * B[7];
+    c[2] = A[0] * B[8] + A[4] * B[9] + A[8] * B[10] + A[12] * B[11];
+    c[3] = A[0] * B[12] + A[4] * B[13] + A[8] * B[14] + A[12] * B[15];
+    c[4] = A[1] * B[0] + A[5] * B[1] + A[9] * B[2] + A[13] * B[3];
+    c[5] = A[1] * B[4] + A[5] * B[5] + A[9] * B[6] + A[13] * B[7];
+    c[6] = A[1] * B[8] + A[5] * B[9] + A[9] * B[10] + A[13] * B[11];
+    c[7] = A[1] * B[12] + A[5] * B[13] + A[9] * B[14] + A[13] * B[15];
+    c[8] = A[2] * B[0] + A[6] * B[1] + A[10] * B[2] + A[14] * B[3];
+    c[9] = A[2] * B[4] + A[6] * B[5] + A[10] * B[6] + A[14] * B[7];
+    c[10] = A[2] * B[8] + A[6] * B[9] + A[10] * B[10] + A[14] * B[11];
+    c[11] = A[2] * B[12] + A[6] * B[13] + A[10] * B[14] + A[14] * B[15];
+    c[12] = A[3] * B[0] + A[7] * B[1] + A[11] * B[2] + A[15] * B[3];
+    c[13] = A[3] * B[4] + A[7] * B[5] + A[11] * B[6] + A[15] * B[7];
+    c[14] = A[3] * B[8] + A[7] * B[9] + A[11] * B[10] + A[15] * B[11];
+    c[15] = A[3] * B[12] + A[7] * B[13] + A[11] * B[14] + A[15] * B[15];
+  }
+  GenStoreCore<N * N, scale, additive>(alpha, c, C);
+}
+
+/*
+  C = alpha * S * op(B) where S is symmetric
+*/
+template <typename T, int N, MatOp opB, bool scale = false,
+          bool additive = false>
+A2D_FUNCTION void SMatMatMultCoreGen(const T alpha, const T A[], const T B[],
+                                     T C[]) {
+  static_assert(N >= 1 && N <= 4, "SMatMatMultCoreGen is generated for N <= 4");
+
+  T c[N * N];
+  if constexpr (N == 1 && opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0];
+  } else if constexpr (N == 1 && opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0];
+  } else if constexpr (N == 2 && opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[1] * B[2];
+    c[1] = A[0] * B[1] + A[1] * B[3];
+    c[2] = A[1] * B[0] + A[2] * B[2];
+    c[3] = A[1] * B[1] + A[2] * B[3];
+  } else if constexpr (N == 2 && opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[1] * B[1];
+    c[1] = A[0] * B[2] + A[1] * B[3];
+    c[2] = A[1] * B[0] + A[2] * B[1];
+    c[3] = A[1] * B[2] + A[2] * B[3];
+  } else if constexpr (N == 3 && opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[1] * B[3] + A[3] * B[6];
+    c[1] = A[0] * B[1] + A[1] * B[4] + A[3] * B[7];
+    c[2] = A[0] * B[2] + A[1] * B[5] + A[3] * B[8];
+    c[3] = A[1] * B[0] + A[2] * B[3] + A[4] * B[6];
+    c[4] = A[1] * B[1] + A[2] * B[4] + A[4] * B[7];
+    c[5] = A[1] * B[2] + A[2] * B[5] + A[4] * B[8];
+    c[6] = A[3] * B[0] + A[4] * B[3] + A[5] * B[6];
+    c[7] = A[3] * B[1] + A[4] * B[4] + A[5] * B[7];
+    c[8] = A[3] * B[2] + A[4] * B[5] + A[5] * B[8];
+  } else if constexpr (N == 3 && opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[1] * B[1] + A[3] * B[2];
+    c[1] = A[0] * B[3] + A[1] * B[4] + A[3] * B[5];
+    c[2] = A[0] * B[6] + A[1] * B[7] + A[3] * B[8];
+    c[3] = A[1] * B[0] + A[2] * B[1] + A[4] * B[2];
+    c[4] = A[1] * B[3] + A[2] * B[4] + A[4] * B[5];
+    c[5] = A[1] * B[6] + A[2] * B[7] + A[4] * B[8];
+    c[6] = A[3] * B[0] + A[4] * B[1] + A[5] * B[2];
+    c[7] = A[3] * B[3] + A[4] * B[4] + A[5] * B[5];
+    c[8] = A[3] * B[6] + A[4] * B[7] + A[5] * B[8];
+  } else if constexpr (N == 4 && opB == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[1] * B[4] + A[3] * B[8] + A[6] * B[12];
+    c[1] = A[0] * B[1] + A[1] * B[5] + A[3] * B[9] + A[6] * B[13];
+    c[2] = A[0] * B[2] + A[1] * B[6] + A[3] * B[10] + A[6] * B[14];
+    c[3] = A[0] * B[3] + A[1] * B[7] + A[3] * B[11] + A[6] * B[15];
+    c[4] = A[1] * B[0] + A[2] * B[4] + A[4] * B[8] + A[7] * B[12];
+    c[5] = A[1] * B[1] + A[2] * B[5] + A[4] * B[9] + A[7] * B[13];
+    c[6] = A[1] * B[2] + A[2] * B[6] + A[4] * B[10] + A[7] * B[14];
+    c[7] = A[1] * B[3] + A[2] * B[7] + A[4] * B[11] + A[7] * B[15];
+    c[8] = A[3] * B[0] + A[4] * B[4] + A[5] * B[8] + A[8] * B[12];
+    c[9] = A[3] * B[1] + A[4] * B[5] + A[5] * B[9] + A[8] * B[13];
+    c[10] = A[3] * B[2] + A[4] * B[6] + A[5] * B[10] + A[8] * B[14];
+    c[11] = A[3] * B[3] + A[4] * B[7] + A[5] * B[11] + A[8] * B[15];
+    c[12] = A[6] * B[0] + A[7] * B[4] + A[8] * B[8] + A[9] * B[12];
+    c[13] = A[6] * B[1] + A[7] * B[5] + A[8] * B[9] + A[9] * B[13];
+    c[14] = A[6] * B[2] + A[7] * B[6] + A[8] * B[10] + A[9] * B[14];
+    c[15] = A[6] * B[3] + A[7] * B[7] + A[8] * B[11] + A[9] * B[15];
+  } else if constexpr (N == 4 && opB == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[1] * B[1] + A[3] * B[2] + A[6] * B[3];
+    c[1] = A[0] * B[4] + A[1] * B[5] + A[3] * B[6] + A[6] * B[7];
+    c[2] = A[0] * B[8] + A[1] * B[9] + A[3] * B[10] + A[6] * B[11];
+    c[3] = A[0] * B[12] + A[1] * B[13] + A[3] * B[14] + A[6] * B[15];
+    c[4] = A[1] * B[0] + A[2] * B[1] + A[4] * B[2] + A[7] * B[3];
+    c[5] = A[1] * B[4] + A[2] * B[5] + A[4] * B[6] + A[7] * B[7];
+    c[6] = A[1] * B[8] + A[2] * B[9] + A[4] * B[10] + A[7] * B[11];
+    c[7] = A[1] * B[12] + A[2] * B[13] + A[4] * B[14] + A[7] * B[15];
+    c[8] = A[3] * B[0] + A[4] * B[1] + A[5] * B[2] + A[8] * B[3];
+    c[9] = A[3] * B[4] + A[4] * B[5] + A[5] * B[6] + A[8] * B[7];
+    c[10] = A[3] * B[8] + A[4] * B[9] + A[5] * B[10] + A[8] * B[11];
+    c[11] = A[3] * B[12] + A[4] * B[13] + A[5] * B[14] + A[8] * B[15];
+    c[12] = A[6] * B[0] + A[7] * B[1] + A[8] * B[2] + A[9] * B[3];
+    c[13] = A[6] * B[4] + A[7] * B[5] + A[8] * B[6] + A[9] * B[7];
+    c[14] = A[6] * B[8] + A[7] * B[9] + A[8] * B[10] + A[9] * B[11];
+    c[15] = A[6] * B[12] + A[7] * B[13] + A[8] * B[14] + A[9] * B[15];
+  }
+  GenStoreCore<N * N, scale, additive>(alpha, c, C);
+}
+
+/*
+  C = alpha * op(A) * S where S is symmetric
+*/
+template <typename T, int N, MatOp opA, bool scale = false,
+          bool additive = false>
+A2D_FUNCTION void MatSMatMultCoreGen(const T alpha, const T A[], const T B[],
+                                     T C[]) {
+  static_assert(N >= 1 && N <= 4, "MatSMatMultCoreGen is generated for N <= 4");
+
+  T c[N * N];
+  if constexpr (N == 1 && opA == MatOp::NORMAL) {
+    c[0] = A[0] * B[0];
+  } else if constexpr (N == 1 && opA == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0];
+  } else if constexpr (N == 2 && opA == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[1] * B[1];
+    c[1] = A[0] * B[1] + A[1] * B[2];
+    c[2] = A[2] * B[0] + A[3] * B[1];
+    c[3] = A[2] * B[1] + A[3] * B[2];
+  } else if constexpr (N == 2 && opA == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[2] * B[1];
+    c[1] = A[0] * B[1] + A[2] * B[2];
+    c[2] = A[1] * B[0] + A[3] * B[1];
+    c[3] = A[1] * B[1] + A[3] * B[2];
+  } else if constexpr (N == 3 && opA == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[1] * B[1] + A[2] * B[3];
+    c[1] = A[0] * B[1] + A[1] * B[2] + A[2] * B[4];
+    c[2] = A[0] * B[3] + A[1] * B[4] + A[2] * B[5];
+    c[3] = A[3] * B[0] + A[4] * B[1] + A[5] * B[3];
+    c[4] = A[3] * B[1] + A[4] * B[2] + A[5] * B[4];
+    c[5] = A[3] * B[3] + A[4] * B[4] + A[5] * B[5];
+    c[6] = A[6] * B[0] + A[7] * B[1] + A[8] * B[3];
+    c[7] = A[6] * B[1] + A[7] * B[2] + A[8] * B[4];
+    c[8] = A[6] * B[3] + A[7] * B[4] + A[8] * B[5];
+  } else if constexpr (N == 3 && opA == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[3] * B[1] + A[6] * B[3];
+    c[1] = A[0] * B[1] + A[3] * B[2] + A[6] * B[4];
+    c[2] = A[0] * B[3] + A[3] * B[4] + A[6] * B[5];
+    c[3] = A[1] * B[0] + A[4] * B[1] + A[7] * B[3];
+    c[4] = A[1] * B[1] + A[4] * B[2] + A[7] * B[4];
+    c[5] = A[1] * B[3] + A[4] * B[4] + A[7] * B[5];
+    c[6] = A[2] * B[0] + A[5] * B[1] + A[8] * B[3];
+    c[7] = A[2] * B[1] + A[5] * B[2] + A[8] * B[4];
+    c[8] = A[2] * B[3] + A[5] * B[4] + A[8] * B[5];
+  } else if constexpr (N == 4 && opA == MatOp::NORMAL) {
+    c[0] = A[0] * B[0] + A[1] * B[1] + A[2] * B[3] + A[3] * B[6];
+    c[1] = A[0] * B[1] + A[1] * B[2] + A[2] * B[4] + A[3] * B[7];
+    c[2] = A[0] * B[3] + A[1] * B[4] + A[2] * B[5] + A[3] * B[8];
+    c[3] = A[0] * B[6] + A[1] * B[7] + A[2] * B[8] + A[3] * B[9];
+    c[4] = A[4] * B[0] + A[5] * B[1] + A[6] * B[3] + A[7] * B[6];
+    c[5] = A[4] * B[1] + A[5] * B[2] + A[6] * B[4] + A[7] * B[7];
+    c[6] = A[4] * B[3] + A[5] * B[4] + A[6] * B[5] + A[7] * B[8];
+    c[7] = A[4] * B[6] + A[5] * B[7] + A[6] * B[8] + A[7] * B[9];
+    c[8] = A[8] * B[0] + A[9] * B[1] + A[10] * B[3] + A[11] * B[6];
+    c[9] = A[8] * B[1] + A[9] * B[2] + A[10] * B[4] + A[11] * B[7];
+    c[10] = A[8] * B[3] + A[9] * B[4] + A[10] * B[5] + A[11] * B[8];
+    c[11] = A[8] * B[6] + A[9] * B[7] + A[10] * B[8] + A[11] * B[9];
+    c[12] = A[12] * B[0] + A[13] * B[1] + A[14] * B[3] + A[15] * B[6];
+    c[13] = A[12] * B[1] + A[13] * B[2] + A[14] * B[4] + A[15] * B[7];
+    c[14] = A[12] * B[3] + A[13] * B[4] + A[14] * B[5] + A[15] * B[8];
+    c[15] = A[12] * B[6] + A[13] * B[7] + A[14] * B[8] + A[15] * B[9];
+  } else if constexpr (N == 4 && opA == MatOp::TRANSPOSE) {
+    c[0] = A[0] * B[0] + A[4] * B[1] + A[8] * B[3] + A[12] * B[6];
+    c[1] = A[0] * B[1] + A[4] * B[2] + A[8] * B[4] + A[12] * B[7];
+    c[2] = A[0] * B[3] + A[4] * B[4] + A[8] * B[5] + A[12] * B[8];
+    c[3] = A[0] * B[6] + A[4] * B[7] + A[8] * B[8] + A[12] * B[9];
+    c[4] = A[1] * B[0] + A[5] * B[1] + A[9] * B[3] + A[13] * B[6];
+    c[5] = A[1] * B[1] + A[5] * B[2] + A[9] * B[4] + A[13] * B[7];
+    c[6] = A[1] * B[3] + A[5] * B[4] + A[9] * B[5] + A[13] * B[8];
+    c[7] = A[1] * B[6] + A[5] * B[7] + A[9] * B[8] + A[13] * B[9];
+    c[8] = A[2] * B[0] + A[6] * B[1] + A[10] * B[3] + A[14] * B[6];
+    c[9] = A[2] * B[1] + A[6] * B[2] + A[10] * B[4] + A[14] * B[7];
+    c[10] = A[2] * B[3] + A[6] * B[4] + A[10] * B[5] + A[14] * B[8];
+    c[11] = A[2] * B[6] + A[6] * B[7] + A[10] * B[8] + A[14] * B[9];
+    c[12] = A[3] * B[0] + A[7] * B[1] + A[11] * B[3] + A[15] * B[6];
+    c[13] = A[3] * B[1] + A[7] * B[2] + A[11] * B[4] + A[15] * B[7];
+    c[14] = A[3] * B[3] + A[7] * B[4] + A[11] * B[5] + A[15] * B[8];
+    c[15] = A[3] * B[6] + A[7] * B[7] + A[11] * B[8] + A[15] * B[9];
+  }
+  GenStoreCore<N * N, scale, additive>(alpha, c, C);
+}
+
+/*
+  C = alpha * SA * SB where SA and SB are symmetric
+*/
+template <typename T, int N, bool scale = false, bool additive = false>
+A2D_FUNCTION void SMatSMatMultCoreGen(const T alpha, const T A[], const T B[],
+                                      T C[]) {
+  static_assert(N >= 1 && N <= 4,
+                "SMatSMatMultCoreGen is generated for N <= 4");
+
+  T c[N * N];
+  if constexpr (N == 1) {
+    c[0] = A[0] * B[0];
+  } else if constexpr (N == 2) {
+    T t0 = A[1] * B[1];
+    c[0] = A[0] * B[0] + t0;
+    c[1] = A[0] * B[1] + A[1] * B[2];
+    c[2] = A[1] * B[0] + A[2] * B[1];
+    c[3] = t0 + A[2] * B[2];
+  } else if constexpr (N == 3) {
+    T t0 = A[1] * B[1];
+    T t1 = A[3] * B[3];
+    c[0] = A[0] * B[0] + t0 + t1;
+    c[1] = A[0] * B[1] + A[1] * B[2] + A[3] * B[4];
+    c[2] = A[0] * B[3] + A[1] * B[4] + A[3] * B[5];
+    c[3] = A[1] * B[0] + A[2] * B[1] + A[4] * B[3];
+    T t2 = A[4] * B[4];
+    c[4] = t0 + A[2] * B[2] + t2;
+    c[5] = A[1] * B[3] + A[2] * B[4] + A[4] * B[5];
+    c[6] = A[3] * B[0] + A[4] * B[1] + A[5] * B[3];
+    c[7] = A[3] * B[1] + A[4] * B[2] + A[5] * B[4];
+    c[8] = t1 + t2 + A[5] * B[5];
+  } else if constexpr (N == 4) {
+    T t0 = A[1] * B[1];
+    T t1 = A[3] * B[3];
+    T t2 = A[6] * B[6];
+    c[0] = A[0] * B[0] + t0 + t1 + t2;
+    c[1] = A[0] * B[1] + A[1] * B[2] + A[3] * B[4] + A[6] * B[7];
+    c[2] = A[0] * B[3] + A[1] * B[4] + A[3] * B[5] + A[6] * B[8];
+    c[3] = A[0] * B[6] + A[1] * B[7] + A[3] * B[8] + A[6] * B[9];
+    c[4] = A[1] * B[0] + A[2] * B[1] + A[4] * B[3] + A[7] * B[6];
+    T t3 = A[4] * B[4];
+    T t4 = A[7] * B[7];
+    c[5] = t0 + A[2] * B[2] + t3 + t4;
+    c[6] = A[1] * B[3] + A[2] * B[4] + A[4] * B[5] + A[7] * B[8];
+    c[7] = A[1] * B[6] + A[2] * B[7] + A[4] * B[8] + A[7] * B[9];
+    c[8] = A[3] * B[0] + A[4] * B[1] + A[5] * B[3] + A[8] * B[6];
+    c[9] = A[3] * B[1] + A[4] * B[2] + A[5] * B[4] + A[8] * B[7];
+    T t5 = A[8] * B[8];
+    c[10] = t1 + t3 + A[5] * B[5] + t5;
+    c[11] = A[3] * B[6] + A[4] * B[7] + A[5] * B[8] + A[8] * B[9];
+    c[12] = A[6] * B[0] + A[7] * B[1] + A[8] * B[3] + A[9] * B[6];
+    c[13] = A[6] * B[1] + A[7] * B[2] + A[8] * B[4] + A[9] * B[7];
+    c[14] = A[6] * B[3] + A[7] * B[4] + A[8] * B[5] + A[9] * B[8];
+    c[15] = t2 + t4 + t5 + A[9] * B[9];
+  }
+  GenStoreCore<N * N, scale, additive>(alpha, c, C);
+}
+
+}  // namespace A2D
+
+#endif  // A2D_GEMM_GEN_H
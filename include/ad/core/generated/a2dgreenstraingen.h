@@ -0,0 +1,433 @@
+// Generated by python/a2dcodegen.py, do not edit
+#ifndef A2D_GREEN_STRAIN_GEN_H
+#define A2D_GREEN_STRAIN_GEN_H
+
+#include "../../../a2ddefs.h"
+
+namespace A2D {
+
+template <typename T, int N>
+A2D_FUNCTION void LinearGreenStrainCoreGen(const T* A2D_RESTRICT Ux,
+                                           T* A2D_RESTRICT E) {
+  static_assert(N >= 1 && N <= 4,
+                "LinearGreenStrainCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    E[0] = Ux[0];
+  } else if constexpr (N == 2) {
+    E[0] = Ux[0];
+    E[1] = 0.5 * (Ux[2] + Ux[1]);
+    E[2] = Ux[3];
+  } else if constexpr (N == 3) {
+    E[0] = Ux[0];
+    E[1] = 0.5 * (Ux[3] + Ux[1]);
+    E[2] = Ux[4];
+    E[3] = 0.5 * (Ux[6] + Ux[2]);
+    E[4] = 0.5 * (Ux[7] + Ux[5]);
+    E[5] = Ux[8];
+  } else if constexpr (N == 4) {
+    E[0] = Ux[0];
+    E[1] = 0.5 * (Ux[4] + Ux[1]);
+    E[2] = Ux[5];
+    E[3] = 0.5 * (Ux[8] + Ux[2]);
+    E[4] = 0.5 * (Ux[9] + Ux[6]);
+    E[5] = Ux[10];
+    E[6] = 0.5 * (Ux[12] + Ux[3]);
+    E[7] = 0.5 * (Ux[13] + Ux[7]);
+    E[8] = 0.5 * (Ux[14] + Ux[11]);
+    E[9] = Ux[15];
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void LinearGreenStrainForwardCoreGen(const T* A2D_RESTRICT Ud,
+                                                  T* A2D_RESTRICT E) {
+  static_assert(N >= 1 && N <= 4,
+                "LinearGreenStrainForwardCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    E[0] = Ud[0];
+  } else if constexpr (N == 2) {
+    E[0] = Ud[0];
+    E[1] = 0.5 * (Ud[2] + Ud[1]);
+    E[2] = Ud[3];
+  } else if constexpr (N == 3) {
+    E[0] = Ud[0];
+    E[1] = 0.5 * (Ud[3] + Ud[1]);
+    E[2] = Ud[4];
+    E[3] = 0.5 * (Ud[6] + Ud[2]);
+    E[4] = 0.5 * (Ud[7] + Ud[5]);
+    E[5] = Ud[8];
+  } else if constexpr (N == 4) {
+    E[0] = Ud[0];
+    E[1] = 0.5 * (Ud[4] + Ud[1]);
+    E[2] = Ud[5];
+    E[3] = 0.5 * (Ud[8] + Ud[2]);
+    E[4] = 0.5 * (Ud[9] + Ud[6]);
+    E[5] = Ud[10];
+    E[6] = 0.5 * (Ud[12] + Ud[3]);
+    E[7] = 0.5 * (Ud[13] + Ud[7]);
+    E[8] = 0.5 * (Ud[14] + Ud[11]);
+    E[9] = Ud[15];
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void LinearGreenStrainReverseCoreGen(const T* A2D_RESTRICT Eb,
+                                                  T* A2D_RESTRICT Ub) {
+  static_assert(N >= 1 && N <= 4,
+                "LinearGreenStrainReverseCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    Ub[0] += Eb[0];
+  } else if constexpr (N == 2) {
+    Ub[0] += Eb[0];
+    Ub[1] += 0.5 * Eb[1];
+    Ub[2] += 0.5 * Eb[1];
+    Ub[3] += Eb[2];
+  } else if constexpr (N == 3) {
+    Ub[0] += Eb[0];
+    Ub[1] += 0.5 * Eb[1];
+    Ub[2] += 0.5 * Eb[3];
+    Ub[3] += 0.5 * Eb[1];
+    Ub[4] += Eb[2];
+    Ub[5] += 0.5 * Eb[4];
+    Ub[6] += 0.5 * Eb[3];
+    Ub[7] += 0.5 * Eb[4];
+    Ub[8] += Eb[5];
+  } else if constexpr (N == 4) {
+    Ub[0] += Eb[0];
+    Ub[1] += 0.5 * Eb[1];
+    Ub[2] += 0.5 * Eb[3];
+    Ub[3] += 0.5 * Eb[6];
+    Ub[4] += 0.5 * Eb[1];
+    Ub[5] += Eb[2];
+    Ub[6] += 0.5 * Eb[4];
+    Ub[7] += 0.5 * Eb[7];
+    Ub[8] += 0.5 * Eb[3];
+    Ub[9] += 0.5 * Eb[4];
+    Ub[10] += Eb[5];
+    Ub[11] += 0.5 * Eb[8];
+    Ub[12] += 0.5 * Eb[6];
+    Ub[13] += 0.5 * Eb[7];
+    Ub[14] += 0.5 * Eb[8];
+    Ub[15] += Eb[9];
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void LinearGreenStrainHReverseCoreGen(const T* A2D_RESTRICT Eh,
+                                                   T* A2D_RESTRICT Uh) {
+  static_assert(N >= 1 && N <= 4,
+                "LinearGreenStrainHReverseCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    Uh[0] += Eh[0];
+  } else if constexpr (N == 2) {
+    Uh[0] += Eh[0];
+    Uh[1] += 0.5 * Eh[1];
+    Uh[2] += 0.5 * Eh[1];
+    Uh[3] += Eh[2];
+  } else if constexpr (N == 3) {
+    Uh[0] += Eh[0];
+    Uh[1] += 0.5 * Eh[1];
+    Uh[2] += 0.5 * Eh[3];
+    Uh[3] += 0.5 * Eh[1];
+    Uh[4] += Eh[2];
+    Uh[5] += 0.5 * Eh[4];
+    Uh[6] += 0.5 * Eh[3];
+    Uh[7] += 0.5 * Eh[4];
+    Uh[8] += Eh[5];
+  } else if constexpr (N == 4) {
+    Uh[0] += Eh[0];
+    Uh[1] += 0.5 * Eh[1];
+    Uh[2] += 0.5 * Eh[3];
+    Uh[3] += 0.5 * Eh[6];
+    Uh[4] += 0.5 * Eh[1];
+    Uh[5] += Eh[2];
+    Uh[6] += 0.5 * Eh[4];
+    Uh[7] += 0.5 * Eh[7];
+    Uh[8] += 0.5 * Eh[3];
+    Uh[9] += 0.5 * Eh[4];
+    Uh[10] += Eh[5];
+    Uh[11] += 0.5 * Eh[8];
+    Uh[12] += 0.5 * Eh[6];
+    Uh[13] += 0.5 * Eh[7];
+    Uh[14] += 0.5 * Eh[8];
+    Uh[15] += Eh[9];
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void NonlinearGreenStrainCoreGen(const T* A2D_RESTRICT Ux,
+                                              T* A2D_RESTRICT E) {
+  static_assert(N >= 1 && N <= 4,
+                "NonlinearGreenStrainCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    E[0] = 0.5 * Ux[0] * (2.0 + Ux[0]);
+  } else if constexpr (N == 2) {
+    E[0] = 0.5 * (Ux[0] * (2.0 + Ux[0]) + Ux[2] * Ux[2]);
+    E[1] = 0.5 * (Ux[1] * (1.0 + Ux[0]) + Ux[2] * (1.0 + Ux[3]));
+    E[2] = 0.5 * (Ux[3] * (2.0 + Ux[3]) + Ux[1] * Ux[1]);
+  } else if constexpr (N == 3) {
+    E[0] = 0.5 * (Ux[0] * (2.0 + Ux[0]) + Ux[3] * Ux[3] + Ux[6] * Ux[6]);
+    T t0 = 1.0 + Ux[0];
+    T t1 = 1.0 + Ux[4];
+    E[1] = 0.5 * (Ux[1] * t0 + Ux[3] * t1 + Ux[6] * Ux[7]);
+    E[2] = 0.5 * (Ux[4] * (2.0 + Ux[4]) + Ux[1] * Ux[1] + Ux[7] * Ux[7]);
+    T t2 = 1.0 + Ux[8];
+    E[3] = 0.5 * (Ux[2] * t0 + Ux[6] * t2 + Ux[3] * Ux[5]);
+    E[4] = 0.5 * (Ux[5] * t1 + Ux[7] * t2 + Ux[1] * Ux[2]);
+    E[5] = 0.5 * (Ux[8] * (2.0 + Ux[8]) + Ux[2] * Ux[2] + Ux[5] * Ux[5]);
+  } else if constexpr (N == 4) {
+    E[0] = 0.5 * (Ux[0] * (2.0 + Ux[0]) + Ux[4] * Ux[4] + Ux[8] * Ux[8] +
+                  Ux[12] * Ux[12]);
+    T t0 = 1.0 + Ux[0];
+    T t1 = 1.0 + Ux[5];
+    E[1] = 0.5 * (Ux[1] * t0 + Ux[4] * t1 + Ux[8] * Ux[9] + Ux[12] * Ux[13]);
+    E[2] = 0.5 * (Ux[5] * (2.0 + Ux[5]) + Ux[1] * Ux[1] + Ux[9] * Ux[9] +
+                  Ux[13] * Ux[13]);
+    T t2 = 1.0 + Ux[10];
+    E[3] = 0.5 * (Ux[2] * t0 + Ux[8] * t2 + Ux[4] * Ux[6] + Ux[12] * Ux[14]);
+    E[4] = 0.5 * (Ux[6] * t1 + Ux[9] * t2 + Ux[1] * Ux[2] + Ux[13] * Ux[14]);
+    E[5] = 0.5 * (Ux[10] * (2.0 + Ux[10]) + Ux[2] * Ux[2] + Ux[6] * Ux[6] +
+                  Ux[14] * Ux[14]);
+    T t3 = 1.0 + Ux[15];
+    E[6] = 0.5 * (Ux[3] * t0 + Ux[12] * t3 + Ux[4] * Ux[7] + Ux[8] * Ux[11]);
+    E[7] = 0.5 * (Ux[7] * t1 + Ux[13] * t3 + Ux[1] * Ux[3] + Ux[9] * Ux[11]);
+    E[8] = 0.5 * (Ux[11] * t2 + Ux[14] * t3 + Ux[2] * Ux[3] + Ux[6] * Ux[7]);
+    E[9] = 0.5 * (Ux[15] * (2.0 + Ux[15]) + Ux[3] * Ux[3] + Ux[7] * Ux[7] +
+                  Ux[11] * Ux[11]);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void NonlinearGreenStrainForwardCoreGen(const T* A2D_RESTRICT Ux,
+                                                     const T* A2D_RESTRICT Ud,
+                                                     T* A2D_RESTRICT E) {
+  static_assert(N >= 1 && N <= 4,
+                "NonlinearGreenStrainForwardCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    E[0] = 0.5 * 2.0 * Ud[0] * (1.0 + Ux[0]);
+  } else if constexpr (N == 2) {
+    T t0 = 1.0 + Ux[0];
+    T t1 = 0.5 * 2.0;
+    E[0] = (Ud[0] * t0 + Ud[2] * Ux[2]) * t1;
+    T t2 = 1.0 + Ux[3];
+    E[1] = 0.5 * (Ud[1] * t0 + Ud[2] * t2 + Ud[0] * Ux[1] + Ud[3] * Ux[2]);
+    E[2] = (Ud[3] * t2 + Ud[1] * Ux[1]) * t1;
+  } else if constexpr (N == 3) {
+    T t0 = 0.5 * 2.0;
+    T t1 = 1.0 + Ux[0];
+    E[0] = t0 * (Ud[0] * t1 + Ud[3] * Ux[3] + Ud[6] * Ux[6]);
+    T t2 = 1.0 + Ux[4];
+    E[1] = 0.5 * (Ud[1] * t1 + Ud[3] * t2 + Ud[0] * Ux[1] + Ud[4] * Ux[3] +
+                  Ud[6] * Ux[7] + Ud[7] * Ux[6]);
+    E[2] = t0 * (Ud[4] * t2 + Ud[1] * Ux[1] + Ud[7] * Ux[7]);
+    T t3 = 1.0 + Ux[8];
+    E[3] = 0.5 * (Ud[2] * t1 + Ud[6] * t3 + Ud[0] * Ux[2] + Ud[3] * Ux[5] +
+                  Ud[5] * Ux[3] + Ud[8] * Ux[6]);
+    E[4] = 0.5 * (Ud[5] * t2 + Ud[7] * t3 + Ud[1] * Ux[2] + Ud[2] * Ux[1] +
+                  Ud[4] * Ux[5] + Ud[8] * Ux[7]);
+    E[5] = t0 * (Ud[8] * t3 + Ud[2] * Ux[2] + Ud[5] * Ux[5]);
+  } else if constexpr (N == 4) {
+    T t0 = 0.5 * 2.0;
+    T t1 = 1.0 + Ux[0];
+    E[0] = t0 * (Ud[0] * t1 + Ud[4] * Ux[4] + Ud[8] * Ux[8] + Ud[12] * Ux[12]);
+    T t2 = 1.0 + Ux[5];
+    E[1] = 0.5 * (Ud[1] * t1 + Ud[4] * t2 + Ud[0] * Ux[1] + Ud[5] * Ux[4] +
+                  Ud[8] * Ux[9] + Ud[9] * Ux[8] + Ud[12] * Ux[13] +
+                  Ud[13] * Ux[12]);
+    E[2] = t0 * (Ud[5] * t2 + Ud[1] * Ux[1] + Ud[9] * Ux[9] + Ud[13] * Ux[13]);
+    T t3 = 1.0 + Ux[10];
+    E[3] = 0.5 * (Ud[2] * t1 + Ud[8] * t3 + Ud[0] * Ux[2] + Ud[4] * Ux[6] +
+                  Ud[6] * Ux[4] + Ud[10] * Ux[8] + Ud[12] * Ux[14] +
+                  Ud[14] * Ux[12]);
+    E[4] = 0.5 * (Ud[6] * t2 + Ud[9] * t3 + Ud[1] * Ux[2] + Ud[2] * Ux[1] +
+                  Ud[5] * Ux[6] + Ud[10] * Ux[9] + Ud[13] * Ux[14] +
+                  Ud[14] * Ux[13]);
+    E[5] = t0 * (Ud[10] * t3 + Ud[2] * Ux[2] + Ud[6] * Ux[6] + Ud[14] * Ux[14]);
+    T t4 = 1.0 + Ux[15];
+    E[6] = 0.5 * (Ud[3] * t1 + Ud[12] * t4 + Ud[0] * Ux[3] + Ud[4] * Ux[7] +
+                  Ud[7] * Ux[4] + Ud[8] * Ux[11] + Ud[11] * Ux[8] +
+                  Ud[15] * Ux[12]);
+    E[7] = 0.5 * (Ud[7] * t2 + Ud[13] * t4 + Ud[1] * Ux[3] + Ud[3] * Ux[1] +
+                  Ud[5] * Ux[7] + Ud[9] * Ux[11] + Ud[11] * Ux[9] +
+                  Ud[15] * Ux[13]);
+    E[8] = 0.5 * (Ud[11] * t3 + Ud[14] * t4 + Ud[2] * Ux[3] + Ud[3] * Ux[2] +
+                  Ud[6] * Ux[7] + Ud[7] * Ux[6] + Ud[10] * Ux[11] +
+                  Ud[15] * Ux[14]);
+    E[9] = t0 * (Ud[15] * t4 + Ud[3] * Ux[3] + Ud[7] * Ux[7] + Ud[11] * Ux[11]);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void NonlinearGreenStrainReverseCoreGen(const T* A2D_RESTRICT Ux,
+                                                     const T* A2D_RESTRICT Eb,
+                                                     T* A2D_RESTRICT Ub) {
+  static_assert(N >= 1 && N <= 4,
+                "NonlinearGreenStrainReverseCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    Ub[0] += Eb[0] * (Ux[0] + 1.0);
+  } else if constexpr (N == 2) {
+    T t0 = 0.5 * Eb[1];
+    Ub[0] += Eb[0] * (Ux[0] + 1.0) + Ux[1] * t0;
+    Ub[1] += t0 * (1.0 + Ux[0]) + Eb[2] * Ux[1];
+    Ub[2] += t0 * (1.0 + Ux[3]) + Eb[0] * Ux[2];
+    Ub[3] += Eb[2] * (Ux[3] + 1.0) + Ux[2] * t0;
+  } else if constexpr (N == 3) {
+    Ub[0] += Eb[0] * (Ux[0] + 1.0) + 0.5 * (Eb[3] * Ux[2] + Eb[1] * Ux[1]);
+    T t0 = 0.5 * Eb[1];
+    T t1 = 1.0 + Ux[0];
+    T t2 = 0.5 * Eb[4];
+    Ub[1] += t0 * t1 + Ux[2] * t2 + Eb[2] * Ux[1];
+    T t3 = 0.5 * Eb[3];
+    Ub[2] += t3 * t1 + Eb[5] * Ux[2] + Ux[1] * t2;
+    T t4 = 1.0 + Ux[4];
+    Ub[3] += t0 * t4 + Ux[5] * t3 + Eb[0] * Ux[3];
+    Ub[4] += Eb[2] * (Ux[4] + 1.0) + 0.5 * (Eb[4] * Ux[5] + Eb[1] * Ux[3]);
+    Ub[5] += t2 * t4 + Eb[5] * Ux[5] + Ux[3] * t3;
+    T t5 = 1.0 + Ux[8];
+    Ub[6] += t3 * t5 + Ux[7] * t0 + Eb[0] * Ux[6];
+    Ub[7] += t2 * t5 + Eb[2] * Ux[7] + Ux[6] * t0;
+    Ub[8] += Eb[5] * (Ux[8] + 1.0) + 0.5 * (Eb[4] * Ux[7] + Eb[3] * Ux[6]);
+  } else if constexpr (N == 4) {
+    Ub[0] += Eb[0] * (Ux[0] + 1.0) +
+             0.5 * (Eb[6] * Ux[3] + Eb[3] * Ux[2] + Eb[1] * Ux[1]);
+    T t0 = 0.5 * Eb[1];
+    T t1 = 1.0 + Ux[0];
+    T t2 = 0.5 * Eb[7];
+    T t3 = 0.5 * Eb[4];
+    Ub[1] += t0 * t1 + Ux[3] * t2 + Ux[2] * t3 + Eb[2] * Ux[1];
+    T t4 = 0.5 * Eb[3];
+    T t5 = 0.5 * Eb[8];
+    Ub[2] += t4 * t1 + Ux[3] * t5 + Eb[5] * Ux[2] + Ux[1] * t3;
+    T t6 = 0.5 * Eb[6];
+    Ub[3] += t6 * t1 + Eb[9] * Ux[3] + Ux[2] * t5 + Ux[1] * t2;
+    T t7 = 1.0 + Ux[5];
+    Ub[4] += t0 * t7 + Ux[7] * t6 + Ux[6] * t4 + Eb[0] * Ux[4];
+    Ub[5] += Eb[2] * (Ux[5] + 1.0) +
+             0.5 * (Eb[7] * Ux[7] + Eb[4] * Ux[6] + Eb[1] * Ux[4]);
+    Ub[6] += t3 * t7 + Ux[7] * t5 + Eb[5] * Ux[6] + Ux[4] * t4;
+    Ub[7] += t2 * t7 + Eb[9] * Ux[7] + Ux[6] * t5 + Ux[4] * t6;
+    T t8 = 1.0 + Ux[10];
+    Ub[8] += t4 * t8 + Ux[11] * t6 + Ux[9] * t0 + Eb[0] * Ux[8];
+    Ub[9] += t3 * t8 + Ux[11] * t2 + Eb[2] * Ux[9] + Ux[8] * t0;
+    Ub[10] += Eb[5] * (Ux[10] + 1.0) +
+              0.5 * (Eb[8] * Ux[11] + Eb[4] * Ux[9] + Eb[3] * Ux[8]);
+    Ub[11] += t5 * t8 + Eb[9] * Ux[11] + Ux[9] * t2 + Ux[8] * t6;
+    T t9 = 1.0 + Ux[15];
+    Ub[12] += t6 * t9 + Ux[14] * t4 + Ux[13] * t0 + Eb[0] * Ux[12];
+    Ub[13] += t2 * t9 + Ux[14] * t3 + Eb[2] * Ux[13] + Ux[12] * t0;
+    Ub[14] += t5 * t9 + Eb[5] * Ux[14] + Ux[13] * t3 + Ux[12] * t4;
+    Ub[15] += Eb[9] * (Ux[15] + 1.0) +
+              0.5 * (Eb[8] * Ux[14] + Eb[7] * Ux[13] + Eb[6] * Ux[12]);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void NonlinearGreenStrainHReverseCoreGen(const T* A2D_RESTRICT Ux,
+                                                      const T* A2D_RESTRICT Up,
+                                                      const T* A2D_RESTRICT Eb,
+                                                      const T* A2D_RESTRICT Eh,
+                                                      T* A2D_RESTRICT Uh) {
+  static_assert(N >= 1 && N <= 4,
+                "NonlinearGreenStrainHReverseCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    Uh[0] += Eh[0] * (Ux[0] + 1.0) + Eb[0] * Up[0];
+  } else if constexpr (N == 2) {
+    T t0 = 0.5 * Eh[1];
+    T t1 = 0.5 * Eb[1];
+    Uh[0] += Eh[0] * (Ux[0] + 1.0) + Ux[1] * t0 + Up[1] * t1 + Eb[0] * Up[0];
+    Uh[1] += t0 * (1.0 + Ux[0]) + Eh[2] * Ux[1] + Eb[2] * Up[1] + Up[0] * t1;
+    Uh[2] += t0 * (1.0 + Ux[3]) + Up[3] * t1 + Eh[0] * Ux[2] + Eb[0] * Up[2];
+    Uh[3] += Eh[2] * (Ux[3] + 1.0) + Eb[2] * Up[3] + Ux[2] * t0 + Up[2] * t1;
+  } else if constexpr (N == 3) {
+    T t0 = 0.5 * Eh[3];
+    T t1 = 0.5 * Eb[3];
+    T t2 = 0.5 * Eh[1];
+    T t3 = 0.5 * Eb[1];
+    Uh[0] += Eh[0] * (Ux[0] + 1.0) + Ux[2] * t0 + Up[2] * t1 + Ux[1] * t2 +
+             Up[1] * t3 + Eb[0] * Up[0];
+    T t4 = 1.0 + Ux[0];
+    T t5 = 0.5 * Eh[4];
+    T t6 = 0.5 * Eb[4];
+    Uh[1] += t2 * t4 + Ux[2] * t5 + Up[2] * t6 + Eh[2] * Ux[1] + Eb[2] * Up[1] +
+             Up[0] * t3;
+    Uh[2] += t0 * t4 + Eh[5] * Ux[2] + Eb[5] * Up[2] + Ux[1] * t5 + Up[1] * t6 +
+             Up[0] * t1;
+    T t7 = 1.0 + Ux[4];
+    Uh[3] += t2 * t7 + Ux[5] * t0 + Up[5] * t1 + Up[4] * t3 + Eh[0] * Ux[3] +
+             Eb[0] * Up[3];
+    Uh[4] += Eh[2] * (Ux[4] + 1.0) + Ux[5] * t5 + Up[5] * t6 + Eb[2] * Up[4] +
+             Ux[3] * t2 + Up[3] * t3;
+    Uh[5] += t5 * t7 + Eh[5] * Ux[5] + Eb[5] * Up[5] + Up[4] * t6 + Ux[3] * t0 +
+             Up[3] * t1;
+    T t8 = 1.0 + Ux[8];
+    Uh[6] += t0 * t8 + Up[8] * t1 + Ux[7] * t2 + Up[7] * t3 + Eh[0] * Ux[6] +
+             Eb[0] * Up[6];
+    Uh[7] += t5 * t8 + Up[8] * t6 + Eh[2] * Ux[7] + Eb[2] * Up[7] + Ux[6] * t2 +
+             Up[6] * t3;
+    Uh[8] += Eh[5] * (Ux[8] + 1.0) + Eb[5] * Up[8] + Ux[7] * t5 + Up[7] * t6 +
+             Ux[6] * t0 + Up[6] * t1;
+  } else if constexpr (N == 4) {
+    T t0 = 0.5 * Eh[6];
+    T t1 = 0.5 * Eb[6];
+    T t2 = 0.5 * Eh[3];
+    T t3 = 0.5 * Eb[3];
+    T t4 = 0.5 * Eh[1];
+    T t5 = 0.5 * Eb[1];
+    Uh[0] += Eh[0] * (Ux[0] + 1.0) + Ux[3] * t0 + Up[3] * t1 + Ux[2] * t2 +
+             Up[2] * t3 + Ux[1] * t4 + Up[1] * t5 + Eb[0] * Up[0];
+    T t6 = 1.0 + Ux[0];
+    T t7 = 0.5 * Eh[7];
+    T t8 = 0.5 * Eb[7];
+    T t9 = 0.5 * Eh[4];
+    T t10 = 0.5 * Eb[4];
+    Uh[1] += t4 * t6 + Ux[3] * t7 + Up[3] * t8 + Ux[2] * t9 + Up[2] * t10 +
+             Eh[2] * Ux[1] + Eb[2] * Up[1] + Up[0] * t5;
+    T t11 = 0.5 * Eh[8];
+    T t12 = 0.5 * Eb[8];
+    Uh[2] += t2 * t6 + Ux[3] * t11 + Up[3] * t12 + Eh[5] * Ux[2] +
+             Eb[5] * Up[2] + Ux[1] * t9 + Up[1] * t10 + Up[0] * t3;
+    Uh[3] += t0 * t6 + Eh[9] * Ux[3] + Eb[9] * Up[3] + Ux[2] * t11 +
+             Up[2] * t12 + Ux[1] * t7 + Up[1] * t8 + Up[0] * t1;
+    T t13 = 1.0 + Ux[5];
+    Uh[4] += t4 * t13 + Ux[7] * t0 + Up[7] * t1 + Ux[6] * t2 + Up[6] * t3 +
+             Up[5] * t5 + Eh[0] * Ux[4] + Eb[0] * Up[4];
+    Uh[5] += Eh[2] * (Ux[5] + 1.0) + Ux[7] * t7 + Up[7] * t8 + Ux[6] * t9 +
+             Up[6] * t10 + Eb[2] * Up[5] + Ux[4] * t4 + Up[4] * t5;
+    Uh[6] += t9 * t13 + Ux[7] * t11 + Up[7] * t12 + Eh[5] * Ux[6] +
+             Eb[5] * Up[6] + Up[5] * t10 + Ux[4] * t2 + Up[4] * t3;
+    Uh[7] += t7 * t13 + Eh[9] * Ux[7] + Eb[9] * Up[7] + Ux[6] * t11 +
+             Up[6] * t12 + Up[5] * t8 + Ux[4] * t0 + Up[4] * t1;
+    T t14 = 1.0 + Ux[10];
+    Uh[8] += t2 * t14 + Ux[11] * t0 + Up[11] * t1 + Up[10] * t3 + Ux[9] * t4 +
+             Up[9] * t5 + Eh[0] * Ux[8] + Eb[0] * Up[8];
+    Uh[9] += t9 * t14 + Ux[11] * t7 + Up[11] * t8 + Up[10] * t10 +
+             Eh[2] * Ux[9] + Eb[2] * Up[9] + Ux[8] * t4 + Up[8] * t5;
+    Uh[10] += Eh[5] * (Ux[10] + 1.0) + Ux[11] * t11 + Up[11] * t12 +
+              Eb[5] * Up[10] + Ux[9] * t9 + Up[9] * t10 + Ux[8] * t2 +
+              Up[8] * t3;
+    Uh[11] += t11 * t14 + Eh[9] * Ux[11] + Eb[9] * Up[11] + Up[10] * t12 +
+              Ux[9] * t7 + Up[9] * t8 + Ux[8] * t0 + Up[8] * t1;
+    T t15 = 1.0 + Ux[15];
+    Uh[12] += t0 * t15 + Up[15] * t1 + Ux[14] * t2 + Up[14] * t3 + Ux[13] * t4 +
+              Up[13] * t5 + Eh[0] * Ux[12] + Eb[0] * Up[12];
+    Uh[13] += t7 * t15 + Up[15] * t8 + Ux[14] * t9 + Up[14] * t10 +
+              Eh[2] * Ux[13] + Eb[2] * Up[13] + Ux[12] * t4 + Up[12] * t5;
+    Uh[14] += t11 * t15 + Up[15] * t12 + Eh[5] * Ux[14] + Eb[5] * Up[14] +
+              Ux[13] * t9 + Up[13] * t10 + Ux[12] * t2 + Up[12] * t3;
+    Uh[15] += Eh[9] * (Ux[15] + 1.0) + Eb[9] * Up[15] + Ux[14] * t11 +
+              Up[14] * t12 + Ux[13] * t7 + Up[13] * t8 + Ux[12] * t0 +
+              Up[12] * t1;
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_GREEN_STRAIN_GEN_H
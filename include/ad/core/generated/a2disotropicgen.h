@@ -0,0 +1,107 @@
+// Generated by python/a2dcodegen.py, do not edit
+#ifndef A2D_ISOTROPIC_GEN_H
+#define A2D_ISOTROPIC_GEN_H
+
+#include "../../../a2ddefs.h"
+
+namespace A2D {
+
+/*
+  S = 2 * mu * E + lambda * tr(E) * I, S is added to when additive is true
+*/
+template <typename T, int N, bool additive = false>
+A2D_FUNCTION void SymIsotropicCoreGen(const T mu, const T lambda, const T E[],
+                                      T S[]) {
+  static_assert(N >= 1 && N <= 4,
+                "SymIsotropicCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1 && !additive) {
+    S[0] = E[0] * (2.0 * mu + lambda);
+  } else if constexpr (N == 1 && additive) {
+    S[0] += E[0] * (2.0 * mu + lambda);
+  } else if constexpr (N == 2 && !additive) {
+    T t0 = 2.0 * mu;
+    T t1 = lambda * (E[0] + E[2]);
+    S[0] = E[0] * t0 + t1;
+    S[1] = E[1] * t0;
+    S[2] = E[2] * t0 + t1;
+  } else if constexpr (N == 2 && additive) {
+    T t0 = 2.0 * mu;
+    T t1 = lambda * (E[0] + E[2]);
+    S[0] += E[0] * t0 + t1;
+    S[1] += E[1] * t0;
+    S[2] += E[2] * t0 + t1;
+  } else if constexpr (N == 3 && !additive) {
+    T t0 = 2.0 * mu;
+    T t1 = lambda * (E[0] + E[2] + E[5]);
+    S[0] = E[0] * t0 + t1;
+    S[1] = E[1] * t0;
+    S[2] = E[2] * t0 + t1;
+    S[3] = E[3] * t0;
+    S[4] = E[4] * t0;
+    S[5] = E[5] * t0 + t1;
+  } else if constexpr (N == 3 && additive) {
+    T t0 = 2.0 * mu;
+    T t1 = lambda * (E[0] + E[2] + E[5]);
+    S[0] += E[0] * t0 + t1;
+    S[1] += E[1] * t0;
+    S[2] += E[2] * t0 + t1;
+    S[3] += E[3] * t0;
+    S[4] += E[4] * t0;
+    S[5] += E[5] * t0 + t1;
+  } else if constexpr (N == 4 && !additive) {
+    T t0 = 2.0 * mu;
+    T t1 = lambda * (E[0] + E[2] + E[5] + E[9]);
+    S[0] = E[0] * t0 + t1;
+    S[1] = E[1] * t0;
+    S[2] = E[2] * t0 + t1;
+    S[3] = E[3] * t0;
+    S[4] = E[4] * t0;
+    S[5] = E[5] * t0 + t1;
+    S[6] = E[6] * t0;
+    S[7] = E[7] * t0;
+    S[8] = E[8] * t0;
+    S[9] = E[9] * t0 + t1;
+  } else if constexpr (N == 4 && additive) {
+    T t0 = 2.0 * mu;
+    T t1 = lambda * (E[0] + E[2] + E[5] + E[9]);
+    S[0] += E[0] * t0 + t1;
+    S[1] += E[1] * t0;
+    S[2] += E[2] * t0 + t1;
+    S[3] += E[3] * t0;
+    S[4] += E[4] * t0;
+    S[5] += E[5] * t0 + t1;
+    S[6] += E[6] * t0;
+    S[7] += E[7] * t0;
+    S[8] += E[8] * t0;
+    S[9] += E[9] * t0 + t1;
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void SymIsotropicReverseCoefCoreGen(const T E[], const T Sb[],
+                                                 T& mu, T& lambda) {
+  static_assert(N >= 1 && N <= 4,
+                "SymIsotropicReverseCoefCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    mu += 2.0 * E[0] * Sb[0];
+    lambda += E[0] * Sb[0];
+  } else if constexpr (N == 2) {
+    mu += 2.0 * (E[2] * Sb[2] + E[1] * Sb[1] + E[0] * Sb[0]);
+    lambda += (E[0] + E[2]) * (Sb[2] + Sb[0]);
+  } else if constexpr (N == 3) {
+    mu += 2.0 * (E[5] * Sb[5] + E[4] * Sb[4] + E[3] * Sb[3] + E[2] * Sb[2] +
+                 E[1] * Sb[1] + E[0] * Sb[0]);
+    lambda += (E[0] + E[2] + E[5]) * (Sb[5] + Sb[2] + Sb[0]);
+  } else if constexpr (N == 4) {
+    mu += 2.0 * (E[9] * Sb[9] + E[8] * Sb[8] + E[7] * Sb[7] + E[6] * Sb[6] +
+                 E[5] * Sb[5] + E[4] * Sb[4] + E[3] * Sb[3] + E[2] * Sb[2] +
+                 E[1] * Sb[1] + E[0] * Sb[0]);
+    lambda += (E[0] + E[2] + E[5] + E[9]) * (Sb[9] + Sb[5] + Sb[2] + Sb[0]);
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_ISOTROPIC_GEN_H
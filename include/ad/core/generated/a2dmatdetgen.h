@@ -0,0 +1,501 @@
+// Generated by python/a2dcodegen.py, do not edit
+#ifndef A2D_MAT_DET_GEN_H
+#define A2D_MAT_DET_GEN_H
+
+#include "../../../a2ddefs.h"
+
+namespace A2D {
+
+template <typename T, int N>
+A2D_FUNCTION T MatDetCoreGen(const T A[]) {
+  static_assert(N >= 1 && N <= 4, "MatDetCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    return A[0];
+  } else if constexpr (N == 2) {
+    return A[0] * A[3] - A[1] * A[2];
+  } else if constexpr (N == 3) {
+    return A[0] * (A[4] * A[8] - A[5] * A[7]) -
+           A[1] * (A[3] * A[8] - A[5] * A[6]) +
+           A[2] * (A[3] * A[7] - A[4] * A[6]);
+  } else if constexpr (N == 4) {
+    T t0 = A[10] * A[15] - A[11] * A[14];
+    T t1 = A[9] * A[15] - A[11] * A[13];
+    T t2 = A[9] * A[14] - A[10] * A[13];
+    T t3 = A[8] * A[15] - A[11] * A[12];
+    T t4 = A[8] * A[14] - A[10] * A[12];
+    T t5 = A[8] * A[13] - A[9] * A[12];
+    return A[0] * (A[5] * t0 - A[6] * t1 + A[7] * t2) -
+           A[1] * (A[4] * t0 - A[6] * t3 + A[7] * t4) +
+           A[2] * (A[4] * t1 - A[5] * t3 + A[7] * t5) -
+           A[3] * (A[4] * t2 - A[5] * t4 + A[6] * t5);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION T MatDetForwardCoreGen(const T A[], const T Ad[]) {
+  static_assert(N >= 1 && N <= 4,
+                "MatDetForwardCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    return Ad[0];
+  } else if constexpr (N == 2) {
+    return A[3] * Ad[0] + A[0] * Ad[3] - A[2] * Ad[1] - A[1] * Ad[2];
+  } else if constexpr (N == 3) {
+    return Ad[0] * (A[4] * A[8] - A[5] * A[7]) +
+           A[0] * (A[8] * Ad[4] + A[4] * Ad[8] - A[7] * Ad[5] - A[5] * Ad[7]) -
+           Ad[1] * (A[3] * A[8] - A[5] * A[6]) -
+           A[1] * (A[8] * Ad[3] + A[3] * Ad[8] - A[6] * Ad[5] - A[5] * Ad[6]) +
+           Ad[2] * (A[3] * A[7] - A[4] * A[6]) +
+           A[2] * (A[7] * Ad[3] + A[3] * Ad[7] - A[6] * Ad[4] - A[4] * Ad[6]);
+  } else if constexpr (N == 4) {
+    T t0 = A[10] * A[15] - A[11] * A[14];
+    T t1 = A[9] * A[15] - A[11] * A[13];
+    T t2 = A[9] * A[14] - A[10] * A[13];
+    T t3 = A[15] * Ad[10] + A[10] * Ad[15] - A[14] * Ad[11] - A[11] * Ad[14];
+    T t4 = A[15] * Ad[9] + A[9] * Ad[15] - A[13] * Ad[11] - A[11] * Ad[13];
+    T t5 = A[14] * Ad[9] + A[9] * Ad[14] - A[13] * Ad[10] - A[10] * Ad[13];
+    T t6 = A[8] * A[15] - A[11] * A[12];
+    T t7 = A[8] * A[14] - A[10] * A[12];
+    T t8 = A[15] * Ad[8] + A[8] * Ad[15] - A[12] * Ad[11] - A[11] * Ad[12];
+    T t9 = A[14] * Ad[8] + A[8] * Ad[14] - A[12] * Ad[10] - A[10] * Ad[12];
+    T t10 = A[8] * A[13] - A[9] * A[12];
+    T t11 = A[13] * Ad[8] + A[8] * Ad[13] - A[12] * Ad[9] - A[9] * Ad[12];
+    return Ad[0] * (A[5] * t0 - A[6] * t1 + A[7] * t2) +
+           A[0] * (Ad[5] * t0 + A[5] * t3 - Ad[6] * t1 - A[6] * t4 +
+                   Ad[7] * t2 + A[7] * t5) -
+           Ad[1] * (A[4] * t0 - A[6] * t6 + A[7] * t7) -
+           A[1] * (Ad[4] * t0 + A[4] * t3 - Ad[6] * t6 - A[6] * t8 +
+                   Ad[7] * t7 + A[7] * t9) +
+           Ad[2] * (A[4] * t1 - A[5] * t6 + A[7] * t10) +
+           A[2] * (Ad[4] * t1 + A[4] * t4 - Ad[5] * t6 - A[5] * t8 +
+                   Ad[7] * t10 + A[7] * t11) -
+           Ad[3] * (A[4] * t2 - A[5] * t7 + A[6] * t10) -
+           A[3] * (Ad[4] * t2 + A[4] * t5 - Ad[5] * t7 - A[5] * t9 +
+                   Ad[6] * t10 + A[6] * t11);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void MatDetReverseCoreGen(const T bdet, const T A[], T Ab[]) {
+  static_assert(N >= 1 && N <= 4,
+                "MatDetReverseCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    Ab[0] += bdet;
+  } else if constexpr (N == 2) {
+    Ab[0] += A[3] * bdet;
+    Ab[1] += -A[2] * bdet;
+    Ab[2] += -A[1] * bdet;
+    Ab[3] += A[0] * bdet;
+  } else if constexpr (N == 3) {
+    Ab[0] += bdet * (A[4] * A[8] - A[5] * A[7]);
+    Ab[1] += -bdet * (A[3] * A[8] - A[5] * A[6]);
+    Ab[2] += bdet * (A[3] * A[7] - A[4] * A[6]);
+    Ab[3] += bdet * (A[2] * A[7] - A[1] * A[8]);
+    Ab[4] += bdet * (A[0] * A[8] - A[2] * A[6]);
+    Ab[5] += bdet * (A[1] * A[6] - A[0] * A[7]);
+    Ab[6] += bdet * (A[1] * A[5] - A[2] * A[4]);
+    Ab[7] += bdet * (A[2] * A[3] - A[0] * A[5]);
+    Ab[8] += bdet * (A[0] * A[4] - A[1] * A[3]);
+  } else if constexpr (N == 4) {
+    T t0 = A[10] * A[15] - A[11] * A[14];
+    T t1 = A[9] * A[15] - A[11] * A[13];
+    T t2 = A[9] * A[14] - A[10] * A[13];
+    Ab[0] += bdet * (A[5] * t0 - A[6] * t1 + A[7] * t2);
+    T t3 = A[8] * A[15] - A[11] * A[12];
+    T t4 = A[8] * A[14] - A[10] * A[12];
+    Ab[1] += -bdet * (A[4] * t0 - A[6] * t3 + A[7] * t4);
+    T t5 = A[8] * A[13] - A[9] * A[12];
+    Ab[2] += bdet * (A[4] * t1 - A[5] * t3 + A[7] * t5);
+    Ab[3] += -bdet * (A[4] * t2 - A[5] * t4 + A[6] * t5);
+    Ab[4] += bdet * (A[2] * t1 - A[3] * t2 - A[1] * t0);
+    Ab[5] += bdet * (A[3] * t4 - A[2] * t3 + A[0] * t0);
+    Ab[6] += bdet * (A[1] * t3 - A[3] * t5 - A[0] * t1);
+    Ab[7] += bdet * (A[2] * t5 - A[1] * t4 + A[0] * t2);
+    T t6 = bdet * (A[2] * A[7] - A[3] * A[6]);
+    T t7 = bdet * (A[3] * A[5] - A[1] * A[7]);
+    T t8 = bdet * (A[1] * A[6] - A[2] * A[5]);
+    Ab[8] += A[13] * t6 + A[14] * t7 + A[15] * t8;
+    T t9 = bdet * (A[0] * A[7] - A[3] * A[4]);
+    T t10 = bdet * (A[2] * A[4] - A[0] * A[6]);
+    Ab[9] += A[14] * t9 - A[12] * t6 + A[15] * t10;
+    T t11 = bdet * (A[0] * A[5] - A[1] * A[4]);
+    Ab[10] += A[15] * t11 - A[12] * t7 - A[13] * t9;
+    Ab[11] += -(A[12] * t8 + A[13] * t10 + A[14] * t11);
+    Ab[12] += -(A[9] * t6 + A[10] * t7 + A[11] * t8);
+    Ab[13] += A[8] * t6 - A[10] * t9 - A[11] * t10;
+    Ab[14] += A[8] * t7 + A[9] * t9 - A[11] * t11;
+    Ab[15] += A[8] * t8 + A[9] * t10 + A[10] * t11;
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void MatDetHReverseCoreGen(const T bdet, const T hdet, const T A[],
+                                        const T Ap[], T Ah[]) {
+  static_assert(N >= 1 && N <= 4,
+                "MatDetHReverseCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    Ah[0] += hdet;
+  } else if constexpr (N == 2) {
+    Ah[0] += Ap[3] * bdet + A[3] * hdet;
+    Ah[1] += -(Ap[2] * bdet + A[2] * hdet);
+    Ah[2] += -(Ap[1] * bdet + A[1] * hdet);
+    Ah[3] += Ap[0] * bdet + A[0] * hdet;
+  } else if constexpr (N == 3) {
+    Ah[0] += hdet * (A[4] * A[8] - A[5] * A[7]) +
+             bdet * (A[8] * Ap[4] + A[4] * Ap[8] - A[7] * Ap[5] - A[5] * Ap[7]);
+    Ah[1] += -(hdet * (A[3] * A[8] - A[5] * A[6]) +
+               bdet * (A[8] * Ap[3] + A[3] * Ap[8] - A[6] * Ap[5] -
+                       A[5] * Ap[6]));
+    Ah[2] += hdet * (A[3] * A[7] - A[4] * A[6]) +
+             bdet * (A[7] * Ap[3] + A[3] * Ap[7] - A[6] * Ap[4] - A[4] * Ap[6]);
+    Ah[3] += bdet * (A[7] * Ap[2] + A[2] * Ap[7] - A[8] * Ap[1] -
+                     A[1] * Ap[8]) + hdet * (A[2] * A[7] - A[1] * A[8]);
+    Ah[4] += bdet * (A[8] * Ap[0] - A[6] * Ap[2] - A[2] * Ap[6] +
+                     A[0] * Ap[8]) + hdet * (A[0] * A[8] - A[2] * A[6]);
+    Ah[5] += bdet * (A[6] * Ap[1] + A[1] * Ap[6] - A[7] * Ap[0] -
+                     A[0] * Ap[7]) + hdet * (A[1] * A[6] - A[0] * A[7]);
+    Ah[6] += bdet * (A[5] * Ap[1] - A[4] * Ap[2] - A[2] * Ap[4] +
+                     A[1] * Ap[5]) + hdet * (A[1] * A[5] - A[2] * A[4]);
+    Ah[7] += bdet * (A[3] * Ap[2] + A[2] * Ap[3] - A[5] * Ap[0] -
+                     A[0] * Ap[5]) + hdet * (A[2] * A[3] - A[0] * A[5]);
+    Ah[8] += bdet * (A[4] * Ap[0] - A[3] * Ap[1] - A[1] * Ap[3] +
+                     A[0] * Ap[4]) + hdet * (A[0] * A[4] - A[1] * A[3]);
+  } else if constexpr (N == 4) {
+    T t0 = A[10] * A[15] - A[11] * A[14];
+    T t1 = A[9] * A[15] - A[11] * A[13];
+    T t2 = A[9] * A[14] - A[10] * A[13];
+    T t3 = A[15] * Ap[10] + A[10] * Ap[15] - A[14] * Ap[11] - A[11] * Ap[14];
+    T t4 = A[15] * Ap[9] + A[9] * Ap[15] - A[13] * Ap[11] - A[11] * Ap[13];
+    T t5 = A[14] * Ap[9] + A[9] * Ap[14] - A[13] * Ap[10] - A[10] * Ap[13];
+    Ah[0] += hdet * (A[5] * t0 - A[6] * t1 + A[7] * t2) +
+             bdet * (Ap[5] * t0 + A[5] * t3 - Ap[6] * t1 - A[6] * t4 +
+                     Ap[7] * t2 + A[7] * t5);
+    T t6 = A[8] * A[15] - A[11] * A[12];
+    T t7 = A[8] * A[14] - A[10] * A[12];
+    T t8 = A[15] * Ap[8] + A[8] * Ap[15] - A[12] * Ap[11] - A[11] * Ap[12];
+    T t9 = A[14] * Ap[8] + A[8] * Ap[14] - A[12] * Ap[10] - A[10] * Ap[12];
+    Ah[1] += -(hdet * (A[4] * t0 - A[6] * t6 + A[7] * t7) +
+               bdet * (Ap[4] * t0 + A[4] * t3 - Ap[6] * t6 - A[6] * t8 +
+                       Ap[7] * t7 + A[7] * t9));
+    T t10 = A[8] * A[13] - A[9] * A[12];
+    T t11 = A[13] * Ap[8] + A[8] * Ap[13] - A[12] * Ap[9] - A[9] * Ap[12];
+    Ah[2] += hdet * (A[4] * t1 - A[5] * t6 + A[7] * t10) +
+             bdet * (Ap[4] * t1 + A[4] * t4 - Ap[5] * t6 - A[5] * t8 +
+                     Ap[7] * t10 + A[7] * t11);
+    Ah[3] += -(hdet * (A[4] * t2 - A[5] * t7 + A[6] * t10) +
+               bdet * (Ap[4] * t2 + A[4] * t5 - Ap[5] * t7 - A[5] * t9 +
+                       Ap[6] * t10 + A[6] * t11));
+    Ah[4] += bdet * (Ap[2] * t1 - Ap[3] * t2 - A[3] * t5 + A[2] * t4 -
+                     Ap[1] * t0 - A[1] * t3) +
+             hdet * (A[2] * t1 - A[3] * t2 - A[1] * t0);
+    Ah[5] += bdet * (Ap[3] * t7 + A[3] * t9 - Ap[2] * t6 - A[2] * t8 +
+                     Ap[0] * t0 + A[0] * t3) +
+             hdet * (A[3] * t7 - A[2] * t6 + A[0] * t0);
+    Ah[6] += bdet * (Ap[1] * t6 - Ap[3] * t10 - A[3] * t11 + A[1] * t8 -
+                     Ap[0] * t1 - A[0] * t4) +
+             hdet * (A[1] * t6 - A[3] * t10 - A[0] * t1);
+    Ah[7] += bdet * (Ap[2] * t10 + A[2] * t11 - Ap[1] * t7 - A[1] * t9 +
+                     Ap[0] * t2 + A[0] * t5) +
+             hdet * (A[2] * t10 - A[1] * t7 + A[0] * t2);
+    T t12 = A[2] * A[7] - A[3] * A[6];
+    T t13 = bdet * t12;
+    T t14 = bdet * (A[7] * Ap[2] - A[6] * Ap[3] - A[3] * Ap[6] + A[2] * Ap[7]) +
+            hdet * t12;
+    T t15 = A[3] * A[5] - A[1] * A[7];
+    T t16 = bdet * t15;
+    T t17 = bdet * (A[5] * Ap[3] + A[3] * Ap[5] - A[7] * Ap[1] - A[1] * Ap[7]) +
+            hdet * t15;
+    T t18 = A[1] * A[6] - A[2] * A[5];
+    T t19 = bdet * t18;
+    T t20 = bdet * (A[6] * Ap[1] - A[5] * Ap[2] - A[2] * Ap[5] + A[1] * Ap[6]) +
+            hdet * t18;
+    Ah[8] += Ap[13] * t13 + A[13] * t14 + Ap[14] * t16 + A[14] * t17 +
+             Ap[15] * t19 + A[15] * t20;
+    T t21 = A[0] * A[7] - A[3] * A[4];
+    T t22 = bdet * t21;
+    T t23 = bdet * (A[7] * Ap[0] - A[4] * Ap[3] - A[3] * Ap[4] + A[0] * Ap[7]) +
+            hdet * t21;
+    T t24 = A[2] * A[4] - A[0] * A[6];
+    T t25 = bdet * t24;
+    T t26 = bdet * (A[4] * Ap[2] + A[2] * Ap[4] - A[6] * Ap[0] - A[0] * Ap[6]) +
+            hdet * t24;
+    Ah[9] += Ap[14] * t22 - Ap[12] * t13 - A[12] * t14 + A[14] * t23 +
+             Ap[15] * t25 + A[15] * t26;
+    T t27 = A[0] * A[5] - A[1] * A[4];
+    T t28 = bdet * t27;
+    T t29 = bdet * (A[5] * Ap[0] - A[4] * Ap[1] - A[1] * Ap[4] + A[0] * Ap[5]) +
+            hdet * t27;
+    Ah[10] += Ap[15] * t28 - Ap[12] * t16 - A[12] * t17 - Ap[13] * t22 -
+              A[13] * t23 + A[15] * t29;
+    Ah[11] += -(Ap[12] * t19 + A[12] * t20 + Ap[13] * t25 + A[13] * t26 +
+                Ap[14] * t28 + A[14] * t29);
+    Ah[12] += -(Ap[9] * t13 + A[9] * t14 + Ap[10] * t16 + A[10] * t17 +
+                Ap[11] * t19 + A[11] * t20);
+    Ah[13] += Ap[8] * t13 + A[8] * t14 - Ap[10] * t22 - A[10] * t23 -
+              Ap[11] * t25 - A[11] * t26;
+    Ah[14] += Ap[8] * t16 + A[8] * t17 + Ap[9] * t22 + A[9] * t23 -
+              Ap[11] * t28 - A[11] * t29;
+    Ah[15] += Ap[8] * t19 + A[8] * t20 + Ap[9] * t25 + A[9] * t26 +
+              Ap[10] * t28 + A[10] * t29;
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION T SymMatDetCoreGen(const T S[]) {
+  static_assert(N >= 1 && N <= 4, "SymMatDetCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    return S[0];
+  } else if constexpr (N == 2) {
+    return S[0] * S[2] - S[1] * S[1];
+  } else if constexpr (N == 3) {
+    return S[0] * (S[2] * S[5] - S[4] * S[4]) -
+           S[1] * (S[1] * S[5] - S[3] * S[4]) +
+           S[3] * (S[1] * S[4] - S[2] * S[3]);
+  } else if constexpr (N == 4) {
+    T t0 = S[5] * S[9] - S[8] * S[8];
+    T t1 = S[4] * S[9] - S[7] * S[8];
+    T t2 = S[4] * S[8] - S[5] * S[7];
+    T t3 = S[3] * S[9] - S[6] * S[8];
+    T t4 = S[3] * S[8] - S[5] * S[6];
+    T t5 = S[3] * S[7] - S[4] * S[6];
+    return S[0] * (S[2] * t0 - S[4] * t1 + S[7] * t2) -
+           S[1] * (S[1] * t0 - S[4] * t3 + S[7] * t4) +
+           S[3] * (S[1] * t1 - S[2] * t3 + S[7] * t5) -
+           S[6] * (S[1] * t2 - S[2] * t4 + S[4] * t5);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION T SymMatDetForwardCoreGen(const T S[], const T Sd[]) {
+  static_assert(N >= 1 && N <= 4,
+                "SymMatDetForwardCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    return Sd[0];
+  } else if constexpr (N == 2) {
+    return S[2] * Sd[0] + S[0] * Sd[2] - 2.0 * S[1] * Sd[1];
+  } else if constexpr (N == 3) {
+    return Sd[0] * (S[2] * S[5] - S[4] * S[4]) +
+           S[0] * (S[5] * Sd[2] + S[2] * Sd[5] - 2.0 * S[4] * Sd[4]) -
+           Sd[1] * (S[1] * S[5] - S[3] * S[4]) -
+           S[1] * (S[5] * Sd[1] + S[1] * Sd[5] - S[4] * Sd[3] - S[3] * Sd[4]) +
+           Sd[3] * (S[1] * S[4] - S[2] * S[3]) +
+           S[3] * (S[4] * Sd[1] + S[1] * Sd[4] - S[3] * Sd[2] - S[2] * Sd[3]);
+  } else if constexpr (N == 4) {
+    T t0 = S[5] * S[9] - S[8] * S[8];
+    T t1 = S[4] * S[9] - S[7] * S[8];
+    T t2 = S[4] * S[8] - S[5] * S[7];
+    T t3 = S[9] * Sd[5] + S[5] * Sd[9] - 2.0 * S[8] * Sd[8];
+    T t4 = S[9] * Sd[4] + S[4] * Sd[9] - S[8] * Sd[7] - S[7] * Sd[8];
+    T t5 = S[8] * Sd[4] + S[4] * Sd[8] - S[7] * Sd[5] - S[5] * Sd[7];
+    T t6 = S[3] * S[9] - S[6] * S[8];
+    T t7 = S[3] * S[8] - S[5] * S[6];
+    T t8 = S[9] * Sd[3] + S[3] * Sd[9] - S[8] * Sd[6] - S[6] * Sd[8];
+    T t9 = S[8] * Sd[3] + S[3] * Sd[8] - S[6] * Sd[5] - S[5] * Sd[6];
+    T t10 = S[3] * S[7] - S[4] * S[6];
+    T t11 = S[7] * Sd[3] + S[3] * Sd[7] - S[6] * Sd[4] - S[4] * Sd[6];
+    return Sd[0] * (S[2] * t0 - S[4] * t1 + S[7] * t2) +
+           S[0] * (Sd[2] * t0 + S[2] * t3 - Sd[4] * t1 - S[4] * t4 +
+                   Sd[7] * t2 + S[7] * t5) -
+           Sd[1] * (S[1] * t0 - S[4] * t6 + S[7] * t7) -
+           S[1] * (Sd[1] * t0 + S[1] * t3 - Sd[4] * t6 - S[4] * t8 +
+                   Sd[7] * t7 + S[7] * t9) +
+           Sd[3] * (S[1] * t1 - S[2] * t6 + S[7] * t10) +
+           S[3] * (Sd[1] * t1 + S[1] * t4 - Sd[2] * t6 - S[2] * t8 +
+                   Sd[7] * t10 + S[7] * t11) -
+           Sd[6] * (S[1] * t2 - S[2] * t7 + S[4] * t10) -
+           S[6] * (Sd[1] * t2 + S[1] * t5 - Sd[2] * t7 - S[2] * t9 +
+                   Sd[4] * t10 + S[4] * t11);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void SymMatDetReverseCoreGen(const T bdet, const T S[], T Sb[]) {
+  static_assert(N >= 1 && N <= 4,
+                "SymMatDetReverseCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    Sb[0] += bdet;
+  } else if constexpr (N == 2) {
+    Sb[0] += S[2] * bdet;
+    Sb[1] += -2.0 * S[1] * bdet;
+    Sb[2] += S[0] * bdet;
+  } else if constexpr (N == 3) {
+    Sb[0] += bdet * (S[2] * S[5] - S[4] * S[4]);
+    T t0 = S[3] * S[4];
+    T t1 = S[1] * S[5];
+    Sb[1] += bdet * (t0 - t1 + t0 - t1);
+    Sb[2] += bdet * (S[0] * S[5] - S[3] * S[3]);
+    T t2 = S[1] * S[4];
+    T t3 = S[2] * S[3];
+    Sb[3] += bdet * (t2 - t3 - t3 + t2);
+    Sb[4] += 2.0 * bdet * (S[1] * S[3] - S[0] * S[4]);
+    Sb[5] += bdet * (S[0] * S[2] - S[1] * S[1]);
+  } else if constexpr (N == 4) {
+    T t0 = S[5] * S[9] - S[8] * S[8];
+    T t1 = S[4] * S[9] - S[7] * S[8];
+    T t2 = S[4] * S[8] - S[5] * S[7];
+    Sb[0] += bdet * (S[2] * t0 - S[4] * t1 + S[7] * t2);
+    T t3 = S[1] * t0;
+    T t4 = S[3] * S[9] - S[6] * S[8];
+    T t5 = S[3] * S[8] - S[5] * S[6];
+    Sb[1] += bdet * (S[3] * t1 - S[6] * t2 - t3 + S[4] * t4 - S[7] * t5 - t3);
+    Sb[2] += bdet * (S[6] * t5 - S[3] * t4 + S[0] * t0);
+    T t6 = S[3] * S[7];
+    T t7 = S[4] * S[6];
+    T t8 = t6 - t7;
+    T t9 = bdet * (t6 - t7);
+    T t10 = S[2] * S[6] - S[1] * S[7];
+    T t11 = S[8] * bdet;
+    T t12 = S[1] * S[4] - S[2] * S[3];
+    T t13 = bdet * t12;
+    Sb[3] += bdet * (S[1] * t1 - S[2] * t4 + S[7] * t8) + S[7] * t9 +
+             t10 * t11 + S[9] * t13;
+    T t14 = S[0] * S[7] - S[1] * S[6];
+    T t15 = S[1] * S[3] - S[0] * S[4];
+    T t16 = bdet * t15;
+    Sb[4] += bdet * (S[1] * t4 - S[6] * t8 - S[0] * t1) - S[6] * t9 +
+             t14 * t11 + S[9] * t16;
+    T t17 = bdet * t10;
+    T t18 = bdet * t14;
+    T t19 = S[0] * S[2] - S[1] * S[1];
+    T t20 = bdet * t19;
+    Sb[5] += S[9] * t20 - S[6] * t17 - S[7] * t18;
+    Sb[6] += -(bdet * (S[1] * t2 - S[2] * t5 + S[4] * t8) + S[4] * t9 +
+               S[5] * t17 + t12 * t11);
+    Sb[7] += bdet * (S[3] * t8 - S[1] * t5 + S[0] * t2) + S[3] * t9 -
+             S[5] * t18 - t15 * t11;
+    Sb[8] += S[3] * t17 - S[6] * t13 + S[4] * t18 - S[7] * t16 -
+             2.0 * t19 * t11;
+    Sb[9] += S[3] * t13 + S[4] * t16 + S[5] * t20;
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void SymMatDetHReverseCoreGen(const T bdet, const T hdet,
+                                           const T S[], const T Sp[], T Sh[]) {
+  static_assert(N >= 1 && N <= 4,
+                "SymMatDetHReverseCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    Sh[0] += hdet;
+  } else if constexpr (N == 2) {
+    Sh[0] += Sp[2] * bdet + S[2] * hdet;
+    Sh[1] += -2.0 * (Sp[1] * bdet + S[1] * hdet);
+    Sh[2] += Sp[0] * bdet + S[0] * hdet;
+  } else if constexpr (N == 3) {
+    Sh[0] += hdet * (S[2] * S[5] - S[4] * S[4]) +
+             bdet * (S[5] * Sp[2] + S[2] * Sp[5] - 2.0 * S[4] * Sp[4]);
+    T t0 = S[4] * Sp[3];
+    T t1 = S[3] * Sp[4];
+    T t2 = S[5] * Sp[1];
+    T t3 = S[1] * Sp[5];
+    T t4 = S[3] * S[4];
+    T t5 = S[1] * S[5];
+    Sh[1] += bdet * (t0 + t1 - t2 - t3 + t0 + t1 - t2 - t3) +
+             hdet * (t4 - t5 + t4 - t5);
+    Sh[2] += bdet * (S[5] * Sp[0] - 2.0 * S[3] * Sp[3] + S[0] * Sp[5]) +
+             hdet * (S[0] * S[5] - S[3] * S[3]);
+    T t6 = S[4] * Sp[1];
+    T t7 = S[1] * Sp[4];
+    T t8 = S[3] * Sp[2];
+    T t9 = S[2] * Sp[3];
+    T t10 = S[1] * S[4];
+    T t11 = S[2] * S[3];
+    Sh[3] += bdet * (t6 + t7 - t8 - t9 - t8 - t9 + t6 + t7) +
+             hdet * (t10 - t11 - t11 + t10);
+    Sh[4] += 2.0 *
+             (bdet * (S[3] * Sp[1] + S[1] * Sp[3] - S[4] * Sp[0] -
+                      S[0] * Sp[4]) + hdet * (S[1] * S[3] - S[0] * S[4]));
+    Sh[5] += bdet * (S[2] * Sp[0] - 2.0 * S[1] * Sp[1] + S[0] * Sp[2]) +
+             hdet * (S[0] * S[2] - S[1] * S[1]);
+  } else if constexpr (N == 4) {
+    T t0 = S[5] * S[9] - S[8] * S[8];
+    T t1 = S[4] * S[9] - S[7] * S[8];
+    T t2 = S[4] * S[8] - S[5] * S[7];
+    T t3 = 2.0 * S[8];
+    T t4 = S[9] * Sp[5] + S[5] * Sp[9] - Sp[8] * t3;
+    T t5 = S[9] * Sp[4] + S[4] * Sp[9] - S[8] * Sp[7] - S[7] * Sp[8];
+    T t6 = S[8] * Sp[4] + S[4] * Sp[8] - S[7] * Sp[5] - S[5] * Sp[7];
+    Sh[0] += hdet * (S[2] * t0 - S[4] * t1 + S[7] * t2) +
+             bdet * (Sp[2] * t0 + S[2] * t4 - Sp[4] * t1 - S[4] * t5 +
+                     Sp[7] * t2 + S[7] * t6);
+    T t7 = Sp[1] * t0;
+    T t8 = S[1] * t4;
+    T t9 = S[3] * S[9] - S[6] * S[8];
+    T t10 = S[9] * Sp[3] + S[3] * Sp[9] - S[8] * Sp[6] - S[6] * Sp[8];
+    T t11 = S[3] * S[8] - S[5] * S[6];
+    T t12 = S[8] * Sp[3] + S[3] * Sp[8] - S[6] * Sp[5] - S[5] * Sp[6];
+    T t13 = S[1] * t0;
+    Sh[1] += bdet * (Sp[3] * t1 - Sp[6] * t2 - S[6] * t6 + S[3] * t5 - t7 - t8 +
+                     Sp[4] * t9 + S[4] * t10 - Sp[7] * t11 - S[7] * t12 - t7 -
+                     t8) +
+             hdet * (S[3] * t1 - S[6] * t2 - t13 + S[4] * t9 - S[7] * t11 -
+                     t13);
+    Sh[2] += bdet * (Sp[6] * t11 + S[6] * t12 - Sp[3] * t9 - S[3] * t10 +
+                     Sp[0] * t0 + S[0] * t4) +
+             hdet * (S[6] * t11 - S[3] * t9 + S[0] * t0);
+    T t14 = S[3] * S[7];
+    T t15 = S[4] * S[6];
+    T t16 = t14 - t15;
+    T t17 = S[7] * Sp[3];
+    T t18 = S[3] * Sp[7];
+    T t19 = S[6] * Sp[4];
+    T t20 = S[4] * Sp[6];
+    T t21 = t17 + t18 - t19 - t20;
+    T t22 = t14 - t15;
+    T t23 = bdet * t22;
+    T t24 = bdet * (t17 - t19 - t20 + t18) + hdet * t22;
+    T t25 = S[2] * S[6] - S[1] * S[7];
+    T t26 = Sp[8] * bdet;
+    T t27 = bdet * (S[6] * Sp[2] + S[2] * Sp[6] - S[7] * Sp[1] - S[1] * Sp[7]) +
+            hdet * t25;
+    T t28 = S[1] * S[4] - S[2] * S[3];
+    T t29 = bdet * t28;
+    T t30 = bdet * (S[4] * Sp[1] - S[3] * Sp[2] - S[2] * Sp[3] + S[1] * Sp[4]) +
+            hdet * t28;
+    Sh[3] += hdet * (S[1] * t1 - S[2] * t9 + S[7] * t16) +
+             bdet * (Sp[1] * t1 + S[1] * t5 - Sp[2] * t9 - S[2] * t10 +
+                     Sp[7] * t16 + S[7] * t21) + Sp[7] * t23 + S[7] * t24 +
+             t25 * t26 + S[8] * t27 + Sp[9] * t29 + S[9] * t30;
+    T t31 = S[0] * S[7] - S[1] * S[6];
+    T t32 = bdet * (S[7] * Sp[0] - S[6] * Sp[1] - S[1] * Sp[6] + S[0] * Sp[7]) +
+            hdet * t31;
+    T t33 = S[1] * S[3] - S[0] * S[4];
+    T t34 = bdet * t33;
+    T t35 = bdet * (S[3] * Sp[1] + S[1] * Sp[3] - S[4] * Sp[0] - S[0] * Sp[4]) +
+            hdet * t33;
+    Sh[4] += bdet * (Sp[1] * t9 - Sp[6] * t16 - S[6] * t21 + S[1] * t10 -
+                     Sp[0] * t1 - S[0] * t5) +
+             hdet * (S[1] * t9 - S[6] * t16 - S[0] * t1) - Sp[6] * t23 -
+             S[6] * t24 + t31 * t26 + S[8] * t32 + Sp[9] * t34 + S[9] * t35;
+    T t36 = bdet * t25;
+    T t37 = bdet * t31;
+    T t38 = S[0] * S[2] - S[1] * S[1];
+    T t39 = bdet * t38;
+    T t40 = bdet * (S[2] * Sp[0] - 2.0 * S[1] * Sp[1] + S[0] * Sp[2]) +
+            hdet * t38;
+    Sh[5] += Sp[9] * t39 - Sp[6] * t36 - S[6] * t27 - Sp[7] * t37 - S[7] * t32 +
+             S[9] * t40;
+    Sh[6] += -(hdet * (S[1] * t2 - S[2] * t11 + S[4] * t16) +
+               bdet * (Sp[1] * t2 + S[1] * t6 - Sp[2] * t11 - S[2] * t12 +
+                       Sp[4] * t16 + S[4] * t21) + Sp[4] * t23 + S[4] * t24 +
+               Sp[5] * t36 + S[5] * t27 + t28 * t26 + S[8] * t30);
+    Sh[7] += bdet * (Sp[3] * t16 + S[3] * t21 - Sp[1] * t11 - S[1] * t12 +
+                     Sp[0] * t2 + S[0] * t6) +
+             hdet * (S[3] * t16 - S[1] * t11 + S[0] * t2) + Sp[3] * t23 +
+             S[3] * t24 - Sp[5] * t37 - S[5] * t32 - t33 * t26 - S[8] * t35;
+    Sh[8] += Sp[3] * t36 + S[3] * t27 - Sp[6] * t29 - S[6] * t30 + Sp[4] * t37 +
+             S[4] * t32 - Sp[7] * t34 - S[7] * t35 - 2.0 * t38 * t26 - t40 * t3;
+    Sh[9] += Sp[3] * t29 + S[3] * t30 + Sp[4] * t34 + S[4] * t35 + Sp[5] * t39 +
+             S[5] * t40;
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_MAT_DET_GEN_H
@@ -0,0 +1,65 @@
+// Generated by python/a2dcodegen.py, do not edit
+#ifndef A2D_MAT_INV_GEN_H
+#define A2D_MAT_INV_GEN_H
+
+#include "../../../a2ddefs.h"
+
+namespace A2D {
+
+template <typename T, int N>
+A2D_FUNCTION void MatInvCoreGen(const T A[], T Ainv[]) {
+  static_assert(N >= 1 && N <= 3, "MatInvCoreGen is generated for N <= 3");
+
+  if constexpr (N == 1) {
+    Ainv[0] = 1.0 / A[0];
+  } else if constexpr (N == 2) {
+    T t0 = 1.0 / (A[0] * A[3] - A[1] * A[2]);
+    Ainv[0] = A[3] * t0;
+    Ainv[1] = -A[1] * t0;
+    Ainv[2] = -A[2] * t0;
+    Ainv[3] = A[0] * t0;
+  } else if constexpr (N == 3) {
+    T t0 = A[4] * A[8] - A[5] * A[7];
+    T t1 = A[3] * A[8] - A[5] * A[6];
+    T t2 = A[3] * A[7] - A[4] * A[6];
+    T t3 = 1.0 / (A[0] * t0 - A[1] * t1 + A[2] * t2);
+    Ainv[0] = t0 * t3;
+    Ainv[1] = -t3 * (A[1] * A[8] - A[2] * A[7]);
+    Ainv[2] = t3 * (A[1] * A[5] - A[2] * A[4]);
+    Ainv[3] = -t1 * t3;
+    Ainv[4] = t3 * (A[0] * A[8] - A[2] * A[6]);
+    Ainv[5] = -t3 * (A[0] * A[5] - A[2] * A[3]);
+    Ainv[6] = t2 * t3;
+    Ainv[7] = -t3 * (A[0] * A[7] - A[1] * A[6]);
+    Ainv[8] = t3 * (A[0] * A[4] - A[1] * A[3]);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void SymMatInvCoreGen(const T S[], T Sinv[]) {
+  static_assert(N >= 1 && N <= 3, "SymMatInvCoreGen is generated for N <= 3");
+
+  if constexpr (N == 1) {
+    Sinv[0] = 1.0 / S[0];
+  } else if constexpr (N == 2) {
+    T t0 = 1.0 / (S[0] * S[2] - S[1] * S[1]);
+    Sinv[0] = S[2] * t0;
+    Sinv[1] = -S[1] * t0;
+    Sinv[2] = S[0] * t0;
+  } else if constexpr (N == 3) {
+    T t0 = S[2] * S[5] - S[4] * S[4];
+    T t1 = S[1] * S[5] - S[3] * S[4];
+    T t2 = S[1] * S[4] - S[2] * S[3];
+    T t3 = 1.0 / (S[0] * t0 - S[1] * t1 + S[3] * t2);
+    Sinv[0] = t0 * t3;
+    Sinv[1] = -t1 * t3;
+    Sinv[2] = t3 * (S[0] * S[5] - S[3] * S[3]);
+    Sinv[3] = t2 * t3;
+    Sinv[4] = -t3 * (S[0] * S[4] - S[1] * S[3]);
+    Sinv[5] = (S[0] * S[2] - S[1] * S[1]) * t3;
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_MAT_INV_GEN_H
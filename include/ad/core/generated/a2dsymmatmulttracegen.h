@@ -0,0 +1,65 @@
+// Generated by python/a2dcodegen.py, do not edit
+#ifndef A2D_SYM_TRACE_GEN_H
+#define A2D_SYM_TRACE_GEN_H
+
+#include "../../../a2ddefs.h"
+
+namespace A2D {
+
+template <typename T, int N>
+A2D_FUNCTION T SymMatMultTraceCoreGen(const T S[], const T E[]) {
+  static_assert(N >= 1 && N <= 4,
+                "SymMatMultTraceCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    return E[0] * S[0];
+  } else if constexpr (N == 2) {
+    return E[0] * S[0] + 2.0 * E[1] * S[1] + E[2] * S[2];
+  } else if constexpr (N == 3) {
+    return E[0] * S[0] + 2.0 * E[1] * S[1] + 2.0 * E[3] * S[3] + E[2] * S[2] +
+           2.0 * E[4] * S[4] + E[5] * S[5];
+  } else if constexpr (N == 4) {
+    return E[0] * S[0] + 2.0 * E[1] * S[1] + 2.0 * E[3] * S[3] +
+           2.0 * E[6] * S[6] + E[2] * S[2] + 2.0 * E[4] * S[4] +
+           2.0 * E[7] * S[7] + E[5] * S[5] + 2.0 * E[8] * S[8] + E[9] * S[9];
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void SymMatMultTraceReverseCoreGen(const T scale, const T S[],
+                                                T E[]) {
+  static_assert(N >= 1 && N <= 4,
+                "SymMatMultTraceReverseCoreGen is generated for N <= 4");
+
+  if constexpr (N == 1) {
+    E[0] += S[0] * scale;
+  } else if constexpr (N == 2) {
+    E[0] += S[0] * scale;
+    E[1] += 2.0 * S[1] * scale;
+    E[2] += S[2] * scale;
+  } else if constexpr (N == 3) {
+    E[0] += S[0] * scale;
+    T t0 = 2.0 * scale;
+    E[1] += S[1] * t0;
+    E[2] += S[2] * scale;
+    E[3] += S[3] * t0;
+    E[4] += S[4] * t0;
+    E[5] += S[5] * scale;
+  } else if constexpr (N == 4) {
+    E[0] += S[0] * scale;
+    T t0 = 2.0 * scale;
+    E[1] += S[1] * t0;
+    E[2] += S[2] * scale;
+    E[3] += S[3] * t0;
+    E[4] += S[4] * t0;
+    E[5] += S[5] * scale;
+    E[6] += S[6] * t0;
+    E[7] += S[7] * t0;
+    E[8] += S[8] * t0;
+    E[9] += S[9] * scale;
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_SYM_TRACE_GEN_H
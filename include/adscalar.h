@@ -16,10 +16,198 @@ struct is_adscalar<ADScalar<U, M>> : std::true_type {};
 template <class X>
 inline constexpr bool is_adscalar_v = is_adscalar<X>::value;
 
+/*
+  Expression templates for ADScalar arithmetic.
+
+  The arithmetic operators and elementary functions of ADScalar do not return
+  an ADScalar but a lightweight expression node. Each node computes its value
+  and the partial derivatives with respect to its operands when it is
+  constructed (these are scalars), while the derivative components are only
+  evaluated when the expression is assigned to an ADScalar. The assignment
+  evaluates all N components in a single fused loop without materializing the
+  intermediate derivative arrays:
+
+    ADScalar<T, N> f = a * b + c / d - sqrt(e);  // one loop over N
+
+  Nodes refer to ADScalar lvalue operands and hold everything else
+  (sub-expressions and temporary ADScalars) by value. A node is only meant to
+  live until the end of the full expression that builds it: it cannot be
+  copied, and its derivatives can only be read from an rvalue. A node stored
+  with auto (auto z = x * y;) is therefore rejected as soon as it is used, in
+  place of silently tracking later changes of x and y. Declare the result as
+  an ADScalar instead.
+*/
+
+// Base of all ADScalar expression nodes
+struct ADScalarExprTag {};
+
+template <class X>
+struct is_adscalar_expr
+    : std::is_base_of<ADScalarExprTag, std::decay_t<X>> {};
+template <class X>
+inline constexpr bool is_adscalar_expr_v = is_adscalar_expr<X>::value;
+
+// An ADScalar expression that is not a named (lvalue) node
+template <class X>
+inline constexpr bool is_adscalar_temp_expr_v =
+    is_adscalar_expr_v<X> && !std::is_lvalue_reference<X>::value;
+
+// An ADScalar or a temporary ADScalar expression
+template <class X>
+inline constexpr bool is_adscalar_operand_v =
+    is_adscalar_v<std::decay_t<X>> || is_adscalar_temp_expr_v<X>;
+
+// Operands with the same value type and number of derivatives
+template <class L, class R, class = void>
+struct __adscalar_same_family : std::false_type {};
+template <class L, class R>
+struct __adscalar_same_family<
+    L, R,
+    std::enable_if_t<is_adscalar_operand_v<L> && is_adscalar_operand_v<R>>>
+    : std::integral_constant<
+          bool, std::is_same<typename std::decay_t<L>::type,
+                             typename std::decay_t<R>::type>::value &&
+                    std::decay_t<L>::nderivs == std::decay_t<R>::nderivs> {};
+
+// A passive value S combined with the operand E (for instance 2.0 * x)
+template <class S, class E, class = void>
+struct __adscalar_mixed : std::false_type {};
+template <class S, class E>
+struct __adscalar_mixed<S, E, std::enable_if_t<is_adscalar_operand_v<E>>> {
+  static constexpr bool value =
+      !__adscalar_same_family<S, E>::value &&
+      std::is_convertible<const std::decay_t<S>&,
+                          typename std::decay_t<E>::type>::value;
+};
+
+// ADScalar lvalues are referenced, everything else is stored by value
+template <class E>
+using __adscalar_storage_t =
+    std::conditional_t<std::is_lvalue_reference<E>::value &&
+                           is_adscalar_v<std::decay_t<E>>,
+                       const std::decay_t<E>&, std::decay_t<E>>;
+
+template <class X, int M>
+class ADScalarExpr : public ADScalarExprTag {
+ public:
+  using type = X;
+  static constexpr int nderivs = M;
+
+  A2D_FUNCTION ADScalarExpr(const X& value) : value(value) {}
+
+  // Nodes are moved into the nodes that use them, never copied
+  ADScalarExpr(const ADScalarExpr&) = delete;
+  ADScalarExpr(ADScalarExpr&&) = default;
+  ADScalarExpr& operator=(const ADScalarExpr&) = delete;
+  ADScalarExpr& operator=(ADScalarExpr&&) = delete;
+
+  // Comparison operators
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline bool operator<(const R& rhs) const&& {
+    return value < rhs;
+  }
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline bool operator<=(const R& rhs) const&& {
+    return value <= rhs;
+  }
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline bool operator>(const R& rhs) const&& {
+    return value > rhs;
+  }
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline bool operator>=(const R& rhs) const&& {
+    return value >= rhs;
+  }
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline bool operator!=(const R& rhs) const&& {
+    return value != rhs;
+  }
+
+  X value;
+};
+
+/**
+ * @brief Node with the derivatives a * arg.deriv
+ */
+template <class A>
+class ADScalarUnaryExpr
+    : public ADScalarExpr<typename std::decay_t<A>::type,
+                          std::decay_t<A>::nderivs> {
+ public:
+  using X = typename std::decay_t<A>::type;
+
+  A2D_FUNCTION ADScalarUnaryExpr(const X& value, const X& a, A&& arg)
+      : ADScalarExpr<X, std::decay_t<A>::nderivs>(value),
+        a(a),
+        arg(std::forward<A>(arg)) {}
+
+  A2D_FUNCTION auto get_deriv(int i) const&& {
+    return a * std::move(arg).get_deriv(i);
+  }
+
+ private:
+  X a;
+  __adscalar_storage_t<A> arg;
+};
+
+/**
+ * @brief Node with the derivatives a * l.deriv + b * r.deriv
+ */
+template <class L, class R>
+class ADScalarBinaryExpr
+    : public ADScalarExpr<typename std::decay_t<L>::type,
+                          std::decay_t<L>::nderivs> {
+ public:
+  using X = typename std::decay_t<L>::type;
+
+  A2D_FUNCTION ADScalarBinaryExpr(const X& value, const X& a, L&& l,
+                                  const X& b, R&& r)
+      : ADScalarExpr<X, std::decay_t<L>::nderivs>(value),
+        a(a),
+        b(b),
+        l(std::forward<L>(l)),
+        r(std::forward<R>(r)) {}
+
+  A2D_FUNCTION auto get_deriv(int i) const&& {
+    return a * std::move(l).get_deriv(i) + b * std::move(r).get_deriv(i);
+  }
+
+ private:
+  X a, b;
+  __adscalar_storage_t<L> l;
+  __adscalar_storage_t<R> r;
+};
+
+template <class E>
+A2D_FUNCTION inline auto __adscalar_unary(
+    const typename std::decay_t<E>::type& value,
+    const typename std::decay_t<E>::type& a, E&& arg) {
+  return ADScalarUnaryExpr<E>(value, a, std::forward<E>(arg));
+}
+
+template <class L, class R>
+A2D_FUNCTION inline auto __adscalar_binary(
+    const typename std::decay_t<L>::type& value,
+    const typename std::decay_t<L>::type& a, L&& l,
+    const typename std::decay_t<L>::type& b, R&& r) {
+  return ADScalarBinaryExpr<L, R>(value, a, std::forward<L>(l), b,
+                                  std::forward<R>(r));
+}
+
 template <class T, int N>
 class ADScalar {
+  // Temporary expressions that evaluate to this type
+  template <class E>
+  using enable_if_expr_t =
+      std::enable_if_t<is_adscalar_temp_expr_v<E> &&
+                           std::is_same<typename std::decay_t<E>::type,
+                                        T>::value &&
+                           std::decay_t<E>::nderivs == N,
+                       bool>;
+
  public:
   using type = T;
+  static constexpr int nderivs = N;
 
   A2D_FUNCTION ADScalar() {}
 
@@ -46,6 +234,14 @@ class ADScalar {
     }
   }
 
+  // Evaluate an expression (value and all derivatives in one loop)
+  template <class E, enable_if_expr_t<E> = true>
+  A2D_FUNCTION ADScalar(E &&e) : value(e.value) {
+    for (int i = 0; i < N; i++) {
+      deriv[i] = std::move(e).get_deriv(i);
+    }
+  }
+
   // Conversion constructor
   //  - disabled when R == T, which forces copy constructor for same type copies
   //  - enabled when conversion or lifting makes sense
@@ -80,6 +276,18 @@ class ADScalar {
     return *this;
   }
 
+  // Assignment of an expression. Each derivative of an expression only
+  // depends on the same derivative of its operands, so the expression may
+  // refer to this scalar.
+  template <class E, enable_if_expr_t<E> = true>
+  A2D_FUNCTION inline ADScalar<T, N> &operator=(E &&e) {
+    value = e.value;
+    for (int i = 0; i < N; i++) {
+      deriv[i] = std::move(e).get_deriv(i);
+    }
+    return *this;
+  }
+
   // Comparison operators
   template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
   A2D_FUNCTION inline bool operator<(const R &rhs) const {
@@ -118,6 +326,26 @@ class ADScalar {
   A2D_FUNCTION inline bool operator>=(const ADScalar<X, M> &rhs) const {
     return value >= rhs.value;
   }
+  template <class E,
+            std::enable_if_t<is_adscalar_temp_expr_v<E>, bool> = true>
+  A2D_FUNCTION inline bool operator<(E &&rhs) const {
+    return value < rhs.value;
+  }
+  template <class E,
+            std::enable_if_t<is_adscalar_temp_expr_v<E>, bool> = true>
+  A2D_FUNCTION inline bool operator<=(E &&rhs) const {
+    return value <= rhs.value;
+  }
+  template <class E,
+            std::enable_if_t<is_adscalar_temp_expr_v<E>, bool> = true>
+  A2D_FUNCTION inline bool operator>(E &&rhs) const {
+    return value > rhs.value;
+  }
+  template <class E,
+            std::enable_if_t<is_adscalar_temp_expr_v<E>, bool> = true>
+  A2D_FUNCTION inline bool operator>=(E &&rhs) const {
+    return value >= rhs.value;
+  }
 
   // Operator +=, -=, *=, /=
   A2D_FUNCTION inline ADScalar<T, N> &operator+=(const ADScalar<T, N> &r) {
@@ -179,138 +407,134 @@ class ADScalar {
     return *this;
   }
 
-  A2D_FUNCTION inline ADScalar<T, N> operator-() const {
-    T negderivs[N];
+  // Operator +=, -=, *=, /= for expressions
+  template <class E, enable_if_expr_t<E> = true>
+  A2D_FUNCTION inline ADScalar<T, N> &operator+=(E &&e) {
+    value += e.value;
     for (int i = 0; i < N; i++) {
-      negderivs[i] = -deriv[i];
+      deriv[i] += std::move(e).get_deriv(i);
     }
-    return ADScalar<T, N>(-value,
-                          negderivs);  // Return by value, not by reference
+    return *this;
+  }
+  template <class E, enable_if_expr_t<E> = true>
+  A2D_FUNCTION inline ADScalar<T, N> &operator-=(E &&e) {
+    value -= e.value;
+    for (int i = 0; i < N; i++) {
+      deriv[i] -= std::move(e).get_deriv(i);
+    }
+    return *this;
+  }
+  template <class E, enable_if_expr_t<E> = true>
+  A2D_FUNCTION inline ADScalar<T, N> &operator*=(E &&e) {
+    return *this = *this * std::forward<E>(e);
+  }
+  template <class E, enable_if_expr_t<E> = true>
+  A2D_FUNCTION inline ADScalar<T, N> &operator/=(E &&e) {
+    return *this = *this / std::forward<E>(e);
   }
 
+  // Derivative access shared with the expression nodes
+  A2D_FUNCTION const T &get_deriv(int i) const { return deriv[i]; }
+
   //  private:
   T value;
   T deriv[N];
 };
 
 // Addition
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> operator+(const ADScalar<X, M> &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l.value + r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = l.deriv[i] + r.deriv[i];
-  }
-  return out;
+template <class L, class R,
+          std::enable_if_t<__adscalar_same_family<L, R>::value, bool> = true>
+A2D_FUNCTION inline auto operator+(L &&l, R &&r) {
+  using X = typename std::decay_t<L>::type;
+  return __adscalar_binary(X(l.value + r.value), X(1.0), std::forward<L>(l),
+                           X(1.0), std::forward<R>(r));
 }
-template <class X, int M, class L,
-          typename = std::enable_if_t<is_scalar_type<L>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator+(const L &l,
-                                             const ADScalar<X, M> &r) {
-  return ADScalar<X, M>(r.value + l, r.deriv);
+template <class L, class R,
+          std::enable_if_t<__adscalar_mixed<L, R>::value, bool> = true>
+A2D_FUNCTION inline auto operator+(const L &l, R &&r) {
+  using X = typename std::decay_t<R>::type;
+  return __adscalar_unary(X(r.value + l), X(1.0), std::forward<R>(r));
 }
-template <class X, int M, class R,
-          typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator+(const ADScalar<X, M> &l,
-                                             const R &r) {
-  return ADScalar<X, M>(l.value + r, l.deriv);
+template <class L, class R,
+          std::enable_if_t<__adscalar_mixed<R, L>::value, bool> = true>
+A2D_FUNCTION inline auto operator+(L &&l, const R &r) {
+  using X = typename std::decay_t<L>::type;
+  return __adscalar_unary(X(l.value + r), X(1.0), std::forward<L>(l));
 }
 
 // Subtraction
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> operator-(const ADScalar<X, M> &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l.value - r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = l.deriv[i] - r.deriv[i];
-  }
-  return out;
+template <class L, class R,
+          std::enable_if_t<__adscalar_same_family<L, R>::value, bool> = true>
+A2D_FUNCTION inline auto operator-(L &&l, R &&r) {
+  using X = typename std::decay_t<L>::type;
+  return __adscalar_binary(X(l.value - r.value), X(1.0), std::forward<L>(l),
+                           X(-1.0), std::forward<R>(r));
 }
-template <class X, int M, class L,
-          typename = std::enable_if_t<is_scalar_type<L>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator-(const L &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l - r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = -r.deriv[i];
-  }
-  return out;
+template <class L, class R,
+          std::enable_if_t<__adscalar_mixed<L, R>::value, bool> = true>
+A2D_FUNCTION inline auto operator-(const L &l, R &&r) {
+  using X = typename std::decay_t<R>::type;
+  return __adscalar_unary(X(l - r.value), X(-1.0), std::forward<R>(r));
 }
-template <class X, int M, class R,
-          typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator-(const ADScalar<X, M> &l,
-                                             const R &r) {
-  return ADScalar<X, M>(l.value - r, l.deriv);
+template <class L, class R,
+          std::enable_if_t<__adscalar_mixed<R, L>::value, bool> = true>
+A2D_FUNCTION inline auto operator-(L &&l, const R &r) {
+  using X = typename std::decay_t<L>::type;
+  return __adscalar_unary(X(l.value - r), X(1.0), std::forward<L>(l));
+}
+
+// Negation
+template <class E, std::enable_if_t<is_adscalar_operand_v<E>, bool> = true>
+A2D_FUNCTION inline auto operator-(E &&r) {
+  using X = typename std::decay_t<E>::type;
+  return __adscalar_unary(X(-r.value), X(-1.0), std::forward<E>(r));
 }
 
 // Multiplication
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> operator*(const ADScalar<X, M> &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l.value * r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = r.value * l.deriv[i] + r.deriv[i] * l.value;
-  }
-  return out;
+template <class L, class R,
+          std::enable_if_t<__adscalar_same_family<L, R>::value, bool> = true>
+A2D_FUNCTION inline auto operator*(L &&l, R &&r) {
+  using X = typename std::decay_t<L>::type;
+  return __adscalar_binary(X(l.value * r.value), X(r.value),
+                           std::forward<L>(l), X(l.value), std::forward<R>(r));
 }
-template <class X, int M, class L,
-          typename = std::enable_if_t<is_scalar_type<L>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator*(const L &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l * r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = r.deriv[i] * l;
-  }
-  return out;
+template <class L, class R,
+          std::enable_if_t<__adscalar_mixed<L, R>::value, bool> = true>
+A2D_FUNCTION inline auto operator*(const L &l, R &&r) {
+  using X = typename std::decay_t<R>::type;
+  return __adscalar_unary(X(l * r.value), X(l), std::forward<R>(r));
 }
-template <class X, int M, class R,
-          typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator*(const ADScalar<X, M> &l,
-                                             const R &r) {
-  ADScalar<X, M> out(l.value * r);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = l.deriv[i] * r;
-  }
-  return out;
+template <class L, class R,
+          std::enable_if_t<__adscalar_mixed<R, L>::value, bool> = true>
+A2D_FUNCTION inline auto operator*(L &&l, const R &r) {
+  using X = typename std::decay_t<L>::type;
+  return __adscalar_unary(X(l.value * r), X(r), std::forward<L>(l));
 }
 
 // Division
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> operator/(const ADScalar<X, M> &l,
-                                             const ADScalar<X, M> &r) {
+template <class L, class R,
+          std::enable_if_t<__adscalar_same_family<L, R>::value, bool> = true>
+A2D_FUNCTION inline auto operator/(L &&l, R &&r) {
+  using X = typename std::decay_t<L>::type;
   X inv = 1.0 / r.value;
   X inv2 = l.value * inv * inv;
-  ADScalar<X, M> out(inv * l.value);
-
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = inv * l.deriv[i] - inv2 * r.deriv[i];
-  }
-  return out;
+  return __adscalar_binary(X(inv * l.value), inv, std::forward<L>(l),
+                           X(-inv2), std::forward<R>(r));
 }
-template <class X, int M, class L,
-          typename = std::enable_if_t<is_scalar_type<L>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator/(const L &l,
-                                             const ADScalar<X, M> &r) {
+template <class L, class R,
+          std::enable_if_t<__adscalar_mixed<L, R>::value, bool> = true>
+A2D_FUNCTION inline auto operator/(const L &l, R &&r) {
+  using X = typename std::decay_t<R>::type;
   X inv = 1.0 / r.value;
   X inv2 = l * inv * inv;
-  ADScalar<X, M> out(inv * l);
-
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = -inv2 * r.deriv[i];
-  }
-  return out;
+  return __adscalar_unary(X(inv * l), X(-inv2), std::forward<R>(r));
 }
-template <class X, int M, class R,
-          typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator/(const ADScalar<X, M> &l,
-                                             const R &r) {
+template <class L, class R,
+          std::enable_if_t<__adscalar_mixed<R, L>::value, bool> = true>
+A2D_FUNCTION inline auto operator/(L &&l, const R &r) {
+  using X = typename std::decay_t<L>::type;
   X inv = 1.0 / r;
-  ADScalar<X, M> out(inv * l.value);
-
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = inv * l.deriv[i];
-  }
-  return out;
+  return __adscalar_unary(X(inv * l.value), inv, std::forward<L>(l));
 }
 
 // sign function
@@ -328,126 +552,138 @@ A2D_FUNCTION inline ADScalar<X, M> operator/(const ADScalar<X, M> &l,
 //   return out;
 // }
 
+/*
+  The elementary functions are implemented once for any operand in
+  __adscalar_<name>. The unqualified calls on the values resolve to the
+  (device compatible) scalar functions in a2ddefs.h or, for nested scalars,
+  to the ADScalar functions. The overloads for ADScalar lvalues and rvalues
+  are more specialized than the generic scalar functions in a2ddefs.h, which
+  also accept ADScalar, and the expression overload covers the temporary
+  nodes.
+*/
+#define A2D_ADSCALAR_UNARY_FUNCTION(FUNCNAME)                              \
+  template <class X, int M>                                                \
+  A2D_FUNCTION inline auto FUNCNAME(const ADScalar<X, M> &r) {             \
+    return __adscalar_##FUNCNAME(r);                                       \
+  }                                                                        \
+  template <class X, int M>                                                \
+  A2D_FUNCTION inline auto FUNCNAME(ADScalar<X, M> &&r) {                  \
+    return __adscalar_##FUNCNAME(std::move(r));                            \
+  }                                                                        \
+  template <class E,                                                       \
+            std::enable_if_t<is_adscalar_temp_expr_v<E>, bool> = true>      \
+  A2D_FUNCTION inline auto FUNCNAME(E &&r) {                               \
+    return __adscalar_##FUNCNAME(std::forward<E>(r));                      \
+  }
+
 // fabs, sqrt
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> fabs(const ADScalar<X, M> &r) {
+template <class E>
+A2D_FUNCTION inline auto __adscalar_fabs(E &&r) {
+  using X = typename std::decay_t<E>::type;
   X scalar = 1.0;
   if (r.value < 0.0) {
     scalar = -1.0;
   }
-  // device compatible fabs
-  ADScalar<X, M> out(::fabs(r.value));
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = scalar * r.deriv[i];
-  }
-  return out;
+  return __adscalar_unary(X(fabs(r.value)), scalar, std::forward<E>(r));
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> sqrt(const ADScalar<X, M> &r) {
-  // device compatible sqrt
-  X value = ::sqrt(r.value);
-  ADScalar<X, M> out(value);
-  X inv = 0.5 / value;
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = inv * r.deriv[i];
-  }
-  return out;
+template <class E>
+A2D_FUNCTION inline auto __adscalar_sqrt(E &&r) {
+  using X = typename std::decay_t<E>::type;
+  X value = sqrt(r.value);
+  return __adscalar_unary(value, X(0.5 / value), std::forward<E>(r));
+}
+
+template <class E, class R>
+A2D_FUNCTION inline auto __adscalar_pow(E &&r, const R &exponent) {
+  using X = typename std::decay_t<E>::type;
+  X value = pow(r.value, exponent);
+  return __adscalar_unary(value, X(exponent * value / r.value),
+                          std::forward<E>(r));
 }
 
 template <class X, int M, class R,
           typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> pow(const ADScalar<X, M> &r,
-                                       const R &exponent) {
-  // device compatible pow
-  X value = ::pow(r.value, exponent);
-  ADScalar<X, M> out(value);
-  X inv = exponent * value / r.value;
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = inv * r.deriv[i];
-  }
-  return out;
+A2D_FUNCTION inline auto pow(const ADScalar<X, M> &r, const R &exponent) {
+  return __adscalar_pow(r, exponent);
+}
+template <class X, int M, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline auto pow(ADScalar<X, M> &&r, const R &exponent) {
+  return __adscalar_pow(std::move(r), exponent);
+}
+template <class E, class R,
+          std::enable_if_t<is_adscalar_temp_expr_v<E> &&
+                               is_scalar_type<R>::value,
+                           bool> = true>
+A2D_FUNCTION inline auto pow(E &&r, const R &exponent) {
+  return __adscalar_pow(std::forward<E>(r), exponent);
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> exp(const ADScalar<X, M> &r) {
-  // device compatible exp
-  X value = ::exp(r.value);
-  ADScalar<X, M> out(value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = value * r.deriv[i];
-  }
-  return out;
+template <class E>
+A2D_FUNCTION inline auto __adscalar_exp(E &&r) {
+  using X = typename std::decay_t<E>::type;
+  X value = exp(r.value);
+  return __adscalar_unary(value, value, std::forward<E>(r));
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> log(const ADScalar<X, M> &r) {
-  // device compatible log
-  ADScalar<X, M> out(::log(r.value));
-  X inv = 1.0 / r.value;
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = inv * r.deriv[i];
-  }
-  return out;
+template <class E>
+A2D_FUNCTION inline auto __adscalar_log(E &&r) {
+  using X = typename std::decay_t<E>::type;
+  return __adscalar_unary(X(log(r.value)), X(1.0 / r.value),
+                          std::forward<E>(r));
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> sin(const ADScalar<X, M> &r) {
-  // device compatible sin, cos
-  ADScalar<X, M> out(::sin(r.value));
-  X d = ::cos(r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = d * r.deriv[i];
-  }
-  return out;
+template <class E>
+A2D_FUNCTION inline auto __adscalar_sin(E &&r) {
+  using X = typename std::decay_t<E>::type;
+  return __adscalar_unary(X(sin(r.value)), X(cos(r.value)),
+                          std::forward<E>(r));
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> cos(const ADScalar<X, M> &r) {
-  // device compatible sin, cos
-  ADScalar<X, M> out(::cos(r.value));
-  X d = -::sin(r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = d * r.deriv[i];
-  }
-  return out;
+template <class E>
+A2D_FUNCTION inline auto __adscalar_cos(E &&r) {
+  using X = typename std::decay_t<E>::type;
+  return __adscalar_unary(X(cos(r.value)), X(-sin(r.value)),
+                          std::forward<E>(r));
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> atan(const ADScalar<X, M> &r) {
-  // device compatible sin, cos
-  ADScalar<X, M> out(::atan(r.value));
+template <class E>
+A2D_FUNCTION inline auto __adscalar_atan(E &&r) {
+  using X = typename std::decay_t<E>::type;
   X d = 1.0 / (1.0 + r.value * r.value);  // 1/(1+x^2)
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = d * r.deriv[i];
-  }
-  return out;
+  return __adscalar_unary(X(::atan(r.value)), d, std::forward<E>(r));
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> atan2(const ADScalar<X, M> &y,
-                                         const ADScalar<X, M> &x) {
+template <class E>
+A2D_FUNCTION inline auto __adscalar_tanh(E &&r) {
+  using X = typename std::decay_t<E>::type;
+  // for smooth sign function essentially
+  X d = 1.0 / ::cosh(r.value) / ::cosh(r.value);
+  return __adscalar_unary(X(::tanh(r.value)), d, std::forward<E>(r));
+}
+
+A2D_ADSCALAR_UNARY_FUNCTION(fabs)
+A2D_ADSCALAR_UNARY_FUNCTION(sqrt)
+A2D_ADSCALAR_UNARY_FUNCTION(exp)
+A2D_ADSCALAR_UNARY_FUNCTION(log)
+A2D_ADSCALAR_UNARY_FUNCTION(sin)
+A2D_ADSCALAR_UNARY_FUNCTION(cos)
+A2D_ADSCALAR_UNARY_FUNCTION(atan)
+A2D_ADSCALAR_UNARY_FUNCTION(tanh)
+
+#undef A2D_ADSCALAR_UNARY_FUNCTION
+
+template <class L, class R,
+          std::enable_if_t<__adscalar_same_family<L, R>::value, bool> = true>
+A2D_FUNCTION inline auto atan2(L &&y, R &&x) {
   /** atan2(y,x) => theta */
-  ADScalar<X, M> out(::atan2(y.value, x.value));
+  using X = typename std::decay_t<L>::type;
   X denom = x.value * x.value + y.value * y.value;
   X dx = -y.value / denom;
   X dy = x.value / denom;
-
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = dx * x.deriv[0] + dy * y.deriv[0];
-  }
-  return out;
-}
-
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> tanh(const ADScalar<X, M> &r) {
-  // for smooth sign function essentially
-  ADScalar<X, M> out(::tanh(r.value));
-  X d = 1.0 / ::cosh(r.value) / ::cosh(r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = d * r.deriv[i];
-  }
-  return out;
+  return __adscalar_binary(X(::atan2(y.value, x.value)), dy,
+                           std::forward<L>(y), dx, std::forward<R>(x));
 }
 
 // template <int N>
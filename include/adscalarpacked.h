@@ -0,0 +1,416 @@
+#ifndef A2D_ADSCALAR_PACKED_H
+#define A2D_ADSCALAR_PACKED_H
+
+#include <type_traits>
+
+#include "a2ddefs.h"
+#include "ad/a2dbatch.h"
+#include "adscalar.h"
+
+/*
+  Forward-mode AD scalar with a derivative block that is padded and aligned to
+  the vector register width.
+
+  PackedADScalar<T, N> has the same interface as ADScalar<T, N> (the members
+  value and deriv[i], the arithmetic operators and the elementary functions)
+  but stores the N derivatives as ceil(N / W) Batch<T, W> chunks, where W is
+  the number of lanes of T in a vector register (see A2D_SIMD_BYTES). Every
+  derivative update is then a fixed number of aligned vector operations
+  instead of a scalar loop over N. The padded lanes are kept at zero.
+
+  This pays off for the element-level forward-mode codes where N is roughly
+  8 to 24. For small N (or N much smaller than W) the plain ADScalar is
+  usually faster.
+*/
+
+namespace A2D {
+
+/**
+ * @brief Derivative storage of a PackedADScalar
+ *
+ * @tparam T the underlying numeric type
+ * @tparam N the number of derivatives
+ */
+template <class T, int N>
+struct PackedADScalarDeriv {
+  static constexpr int width = default_batch_width<T>::value;
+  static constexpr int nchunks = (N + width - 1) / width;
+  using chunk_t = Batch<T, width>;
+
+  template <typename I>
+  A2D_FUNCTION T& operator[](const I i) {
+    return chunk[i / width][i % width];
+  }
+  template <typename I>
+  A2D_FUNCTION const T& operator[](const I i) const {
+    return chunk[i / width][i % width];
+  }
+
+  A2D_FUNCTION void zero() {
+    for (int k = 0; k < nchunks; k++) {
+      chunk[k] = T(0.0);
+    }
+  }
+
+  chunk_t chunk[nchunks];
+};
+
+template <class T, int N>
+class PackedADScalar {
+ public:
+  using type = T;
+  using deriv_t = PackedADScalarDeriv<T, N>;
+  static constexpr int nchunks = deriv_t::nchunks;
+
+  A2D_FUNCTION PackedADScalar() {}
+
+  // Value constructor (sets a value, zeros derivatives)
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION PackedADScalar(const R value) : value(value) {
+    deriv.zero();
+  }
+
+  // Value and derivative constructor
+  A2D_FUNCTION PackedADScalar(const T& value, const T d[]) : value(value) {
+    deriv.zero();
+    for (int i = 0; i < N; i++) {
+      deriv[i] = d[i];
+    }
+  }
+
+  // Conversion from the unpacked ADScalar
+  A2D_FUNCTION explicit PackedADScalar(const ADScalar<T, N>& r)
+      : PackedADScalar(r.value, r.deriv) {}
+
+  // Assignment operator
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION inline PackedADScalar& operator=(const R& r) {
+    value = r;
+    deriv.zero();
+    return *this;
+  }
+
+  // Comparison operators
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION inline bool operator<(const R& rhs) const {
+    return value < rhs;
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION inline bool operator<=(const R& rhs) const {
+    return value <= rhs;
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION inline bool operator>(const R& rhs) const {
+    return value > rhs;
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION inline bool operator>=(const R& rhs) const {
+    return value >= rhs;
+  }
+  A2D_FUNCTION inline bool operator<(const PackedADScalar& rhs) const {
+    return value < rhs.value;
+  }
+  A2D_FUNCTION inline bool operator<=(const PackedADScalar& rhs) const {
+    return value <= rhs.value;
+  }
+  A2D_FUNCTION inline bool operator>(const PackedADScalar& rhs) const {
+    return value > rhs.value;
+  }
+  A2D_FUNCTION inline bool operator>=(const PackedADScalar& rhs) const {
+    return value >= rhs.value;
+  }
+
+  // Operator +=, -=, *=, /=
+  A2D_FUNCTION inline PackedADScalar& operator+=(const PackedADScalar& r) {
+    value += r.value;
+    for (int k = 0; k < nchunks; k++) {
+      deriv.chunk[k] += r.deriv.chunk[k];
+    }
+    return *this;
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION inline PackedADScalar& operator+=(const R& r) {
+    value += r;
+    return *this;
+  }
+  A2D_FUNCTION inline PackedADScalar& operator-=(const PackedADScalar& r) {
+    value -= r.value;
+    for (int k = 0; k < nchunks; k++) {
+      deriv.chunk[k] -= r.deriv.chunk[k];
+    }
+    return *this;
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION inline PackedADScalar& operator-=(const R& r) {
+    value -= r;
+    return *this;
+  }
+  A2D_FUNCTION inline PackedADScalar& operator*=(const PackedADScalar& r) {
+    for (int k = 0; k < nchunks; k++) {
+      deriv.chunk[k] = r.value * deriv.chunk[k] + value * r.deriv.chunk[k];
+    }
+    value *= r.value;
+    return *this;
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION inline PackedADScalar& operator*=(const R& r) {
+    value *= r;
+    for (int k = 0; k < nchunks; k++) {
+      deriv.chunk[k] *= T(r);
+    }
+    return *this;
+  }
+  A2D_FUNCTION inline PackedADScalar& operator/=(const PackedADScalar& r) {
+    T inv = 1.0 / r.value;
+    T inv2 = value * inv * inv;
+    value *= inv;
+    for (int k = 0; k < nchunks; k++) {
+      deriv.chunk[k] = inv * deriv.chunk[k] - inv2 * r.deriv.chunk[k];
+    }
+    return *this;
+  }
+  template <typename R,
+            std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+  A2D_FUNCTION inline PackedADScalar& operator/=(const R& r) {
+    T inv = 1.0 / r;
+    value *= inv;
+    for (int k = 0; k < nchunks; k++) {
+      deriv.chunk[k] *= inv;
+    }
+    return *this;
+  }
+
+  A2D_FUNCTION inline PackedADScalar operator-() const {
+    PackedADScalar out;
+    out.value = -value;
+    for (int k = 0; k < nchunks; k++) {
+      out.deriv.chunk[k] = -deriv.chunk[k];
+    }
+    return out;
+  }
+
+  T value;
+  deriv_t deriv;
+};
+
+// A packed scalar is a numeric type in the same way as ADScalar
+template <class T, int N>
+struct __is_numeric_type<PackedADScalar<T, N>> : std::is_floating_point<T> {};
+
+template <class T, int N>
+struct __get_object_numeric_type<PackedADScalar<T, N>> {
+  using type = PackedADScalar<T, N>;
+};
+
+template <class T, int N>
+struct __get_a2d_object_type<PackedADScalar<T, N>> {
+  static constexpr ADObjType value = ADObjType::SCALAR;
+};
+
+/*
+  Result with the given value and the derivatives a * l.deriv + b * r.deriv
+*/
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> PackedADScalarAxpby(
+    const X& value, const X& a, const PackedADScalar<X, M>& l, const X& b,
+    const PackedADScalar<X, M>& r) {
+  PackedADScalar<X, M> out;
+  out.value = value;
+  for (int k = 0; k < PackedADScalar<X, M>::nchunks; k++) {
+    out.deriv.chunk[k] = a * l.deriv.chunk[k] + b * r.deriv.chunk[k];
+  }
+  return out;
+}
+
+/*
+  Result with the given value and the derivatives a * r.deriv, which is the
+  chain rule for all elementary functions of one argument
+*/
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> PackedADScalarScale(
+    const X& value, const X& a, const PackedADScalar<X, M>& r) {
+  PackedADScalar<X, M> out;
+  out.value = value;
+  for (int k = 0; k < PackedADScalar<X, M>::nchunks; k++) {
+    out.deriv.chunk[k] = a * r.deriv.chunk[k];
+  }
+  return out;
+}
+
+// Addition
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> operator+(
+    const PackedADScalar<X, M>& l, const PackedADScalar<X, M>& r) {
+  PackedADScalar<X, M> out;
+  out.value = l.value + r.value;
+  for (int k = 0; k < PackedADScalar<X, M>::nchunks; k++) {
+    out.deriv.chunk[k] = l.deriv.chunk[k] + r.deriv.chunk[k];
+  }
+  return out;
+}
+template <class X, int M, class L,
+          std::enable_if_t<__is_batch_broadcast_type<L>::value, bool> = true>
+A2D_FUNCTION inline PackedADScalar<X, M> operator+(
+    const L& l, const PackedADScalar<X, M>& r) {
+  PackedADScalar<X, M> out(r);
+  out.value += l;
+  return out;
+}
+template <class X, int M, class R,
+          std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+A2D_FUNCTION inline PackedADScalar<X, M> operator+(
+    const PackedADScalar<X, M>& l, const R& r) {
+  PackedADScalar<X, M> out(l);
+  out.value += r;
+  return out;
+}
+
+// Subtraction
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> operator-(
+    const PackedADScalar<X, M>& l, const PackedADScalar<X, M>& r) {
+  PackedADScalar<X, M> out;
+  out.value = l.value - r.value;
+  for (int k = 0; k < PackedADScalar<X, M>::nchunks; k++) {
+    out.deriv.chunk[k] = l.deriv.chunk[k] - r.deriv.chunk[k];
+  }
+  return out;
+}
+template <class X, int M, class L,
+          std::enable_if_t<__is_batch_broadcast_type<L>::value, bool> = true>
+A2D_FUNCTION inline PackedADScalar<X, M> operator-(
+    const L& l, const PackedADScalar<X, M>& r) {
+  PackedADScalar<X, M> out(-r);
+  out.value += l;
+  return out;
+}
+template <class X, int M, class R,
+          std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+A2D_FUNCTION inline PackedADScalar<X, M> operator-(
+    const PackedADScalar<X, M>& l, const R& r) {
+  PackedADScalar<X, M> out(l);
+  out.value -= r;
+  return out;
+}
+
+// Multiplication
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> operator*(
+    const PackedADScalar<X, M>& l, const PackedADScalar<X, M>& r) {
+  return PackedADScalarAxpby(X(l.value * r.value), r.value, l, l.value, r);
+}
+template <class X, int M, class L,
+          std::enable_if_t<__is_batch_broadcast_type<L>::value, bool> = true>
+A2D_FUNCTION inline PackedADScalar<X, M> operator*(
+    const L& l, const PackedADScalar<X, M>& r) {
+  return PackedADScalarScale(X(l * r.value), X(l), r);
+}
+template <class X, int M, class R,
+          std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+A2D_FUNCTION inline PackedADScalar<X, M> operator*(
+    const PackedADScalar<X, M>& l, const R& r) {
+  return PackedADScalarScale(X(l.value * r), X(r), l);
+}
+
+// Division
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> operator/(
+    const PackedADScalar<X, M>& l, const PackedADScalar<X, M>& r) {
+  X inv = 1.0 / r.value;
+  X inv2 = l.value * inv * inv;
+  return PackedADScalarAxpby(X(inv * l.value), inv, l, X(-inv2), r);
+}
+template <class X, int M, class L,
+          std::enable_if_t<__is_batch_broadcast_type<L>::value, bool> = true>
+A2D_FUNCTION inline PackedADScalar<X, M> operator/(
+    const L& l, const PackedADScalar<X, M>& r) {
+  X inv = 1.0 / r.value;
+  X inv2 = l * inv * inv;
+  return PackedADScalarScale(X(inv * l), X(-inv2), r);
+}
+template <class X, int M, class R,
+          std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+A2D_FUNCTION inline PackedADScalar<X, M> operator/(
+    const PackedADScalar<X, M>& l, const R& r) {
+  X inv = 1.0 / r;
+  return PackedADScalarScale(X(inv * l.value), inv, l);
+}
+
+// Elementary functions
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> fabs(const PackedADScalar<X, M>& r) {
+  X scalar = 1.0;
+  if (r.value < 0.0) {
+    scalar = -1.0;
+  }
+  return PackedADScalarScale(X(::fabs(r.value)), scalar, r);
+}
+
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> sqrt(const PackedADScalar<X, M>& r) {
+  X value = ::sqrt(r.value);
+  return PackedADScalarScale(value, X(0.5 / value), r);
+}
+
+template <class X, int M, class R,
+          std::enable_if_t<__is_batch_broadcast_type<R>::value, bool> = true>
+A2D_FUNCTION inline PackedADScalar<X, M> pow(const PackedADScalar<X, M>& r,
+                                             const R& exponent) {
+  X value = ::pow(r.value, exponent);
+  return PackedADScalarScale(value, X(exponent * value / r.value), r);
+}
+
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> exp(const PackedADScalar<X, M>& r) {
+  X value = ::exp(r.value);
+  return PackedADScalarScale(value, value, r);
+}
+
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> log(const PackedADScalar<X, M>& r) {
+  return PackedADScalarScale(X(::log(r.value)), X(1.0 / r.value), r);
+}
+
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> sin(const PackedADScalar<X, M>& r) {
+  return PackedADScalarScale(X(::sin(r.value)), X(::cos(r.value)), r);
+}
+
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> cos(const PackedADScalar<X, M>& r) {
+  return PackedADScalarScale(X(::cos(r.value)), X(-::sin(r.value)), r);
+}
+
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> atan(const PackedADScalar<X, M>& r) {
+  X d = 1.0 / (1.0 + r.value * r.value);
+  return PackedADScalarScale(X(::atan(r.value)), d, r);
+}
+
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> atan2(const PackedADScalar<X, M>& y,
+                                               const PackedADScalar<X, M>& x) {
+  X denom = x.value * x.value + y.value * y.value;
+  X dx = -y.value / denom;
+  X dy = x.value / denom;
+  return PackedADScalarAxpby(X(::atan2(y.value, x.value)), dx, x, dy, y);
+}
+
+template <class X, int M>
+A2D_FUNCTION inline PackedADScalar<X, M> tanh(const PackedADScalar<X, M>& r) {
+  X d = 1.0 / ::cosh(r.value) / ::cosh(r.value);
+  return PackedADScalarScale(X(::tanh(r.value)), d, r);
+}
+
+}  // namespace A2D
+
+#endif  // A2D_ADSCALAR_PACKED_H
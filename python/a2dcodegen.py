@@ -0,0 +1,1164 @@
+#!/usr/bin/env python3
+"""
+Generate the unrolled kernels in include/ad/core/generated.
+
+Each kernel is written below as an expression graph of the scalar entries of
+its operands. The graph is hash-consed: building the same subexpression twice
+returns the same node, sums and products are kept in a canonical order and
+like terms are combined. The forward, reverse and second-order reverse
+(hreverse) kernels are derived from the graph of the evaluation:
+
+  forward:   yd = dy/dx * xd                 (tangent of the graph)
+  reverse:   xb += (dy/dx)^T * yb            (adjoint of the graph)
+  hreverse:  xh += tangent of the adjoint in the direction (xp, yh)
+
+The derivatives are taken with respect to the stored entries, so for a
+symmetric matrix the off-diagonal entries count twice, as in the rest of A2D.
+
+Before the code is written, common factors are pulled out of the sums, the
+products that share a pair of factors reuse it and every subexpression that is
+used more than once is assigned to a temporary.
+
+Usage:
+
+  python3 a2dcodegen.py [--output-dir DIR] [--check]
+
+The headers are written to include/ad/core/generated by default. With --check
+nothing is written and the script fails if the headers in the output directory
+differ from the generated ones.
+"""
+
+import argparse
+import itertools
+import os
+import re
+import sys
+from collections import Counter
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+LINE_WIDTH = 80
+
+
+def _max_size(name):
+    with open(os.path.join(ROOT, "include", "a2ddefs.h")) as f:
+        match = re.search(r"#define %s (\d+)" % name, f.read())
+    return int(match.group(1))
+
+
+MAX_SIZE = _max_size("A2D_MAX_GEN_SIZE")
+MAX_INV_SIZE = _max_size("A2D_MAX_GEN_INV_SIZE")
+
+# ---------------------------------------------------------------------------
+# Expression graph
+# ---------------------------------------------------------------------------
+
+_nodes = {}
+
+
+class Node:
+    """A hash-consed node of the expression graph
+
+    op is one of:
+      num:   data is the value
+      var:   data is (name, index), index is None for a scalar
+      add:   args are the terms
+      mul:   args are the factors, data is the numeric coefficient
+      recip: args[0] is the denominator
+
+    After optimize() the graph only contains num, var, recip and the raw
+    nodes sum (args are the terms, data the signs) and prod (args are the
+    factors, data the sign), which are not simplified any further.
+    """
+
+    __slots__ = ("id", "op", "args", "data")
+
+    def __init__(self, id, op, args, data):
+        self.id = id
+        self.op = op
+        self.args = args
+        self.data = data
+
+    def __add__(self, other):
+        return add(self, other)
+
+    def __radd__(self, other):
+        return add(other, self)
+
+    def __sub__(self, other):
+        return add(self, mul(-1.0, other))
+
+    def __rsub__(self, other):
+        return add(other, mul(-1.0, self))
+
+    def __mul__(self, other):
+        return mul(self, other)
+
+    def __rmul__(self, other):
+        return mul(other, self)
+
+    def __neg__(self):
+        return mul(-1.0, self)
+
+    def __truediv__(self, other):
+        return mul(self, recip(other))
+
+
+def _make(op, args=(), data=None):
+    # The terms of a sum are kept in the order they were first added
+    ids = tuple(a.id for a in args)
+    key = (op, tuple(sorted(ids)) if op == "add" else ids, data)
+    node = _nodes.get(key)
+    if node is None:
+        node = Node(len(_nodes), op, tuple(args), data)
+        _nodes[key] = node
+    return node
+
+
+def _sort_key(x):
+    # Numbers first, then the variables by name and index, then the rest in
+    # order of creation
+    if x.op == "num":
+        return (0, x.data, "", 0)
+    elif x.op == "var":
+        name, index = x.data
+        return (1, 0, name, -1 if index is None else index)
+    return (2, x.id, "", 0)
+
+
+def num(value):
+    # Adding 0.0 turns -0.0 into 0.0
+    return _make("num", data=float(value) + 0.0)
+
+
+def var(name, index=None):
+    return _make("var", data=(name, index))
+
+
+def _lift(x):
+    return x if isinstance(x, Node) else num(x)
+
+
+def _split(x):
+    """Split a term into its coefficient and its factors"""
+    if x.op == "mul":
+        return x.data, x.args
+    return 1.0, (x,)
+
+
+def _term(coef, factors):
+    if coef == 0.0:
+        return num(0.0)
+    elif len(factors) == 0:
+        return num(coef)
+    elif coef == 1.0 and len(factors) == 1:
+        return factors[0]
+    return _make("mul", factors, coef + 0.0)
+
+
+def add(*xs):
+    const = 0.0
+    coefs = {}
+    for x in xs:
+        x = _lift(x)
+        terms = x.args if x.op == "add" else (x,)
+        for t in terms:
+            if t.op == "num":
+                const += t.data
+            else:
+                coef, factors = _split(t)
+                coefs[factors] = coefs.get(factors, 0.0) + coef
+
+    terms = [_term(c, f) for f, c in coefs.items() if c != 0.0]
+    if const != 0.0:
+        terms.append(num(const))
+    if len(terms) == 0:
+        return num(0.0)
+    elif len(terms) == 1:
+        return terms[0]
+    return _make("add", terms)
+
+
+def mul(*xs):
+    coef = 1.0
+    factors = []
+    for x in xs:
+        x = _lift(x)
+        if x.op == "num":
+            coef *= x.data
+        elif x.op == "mul":
+            coef *= x.data
+            factors.extend(x.args)
+        else:
+            factors.append(x)
+
+    if coef == 0.0:
+        return num(0.0)
+    return _term(coef, tuple(sorted(factors, key=_sort_key)))
+
+
+def recip(x):
+    x = _lift(x)
+    if x.op == "num":
+        return num(1.0 / x.data)
+    return _make("recip", (x,))
+
+
+ZERO = num(0.0)
+
+
+def postorder(roots):
+    """The nodes reachable from the roots, each after its arguments"""
+    order = []
+    visited = set()
+    for root in roots:
+        stack = [(root, False)]
+        while stack:
+            x, expanded = stack.pop()
+            if expanded:
+                order.append(x)
+            elif x.id not in visited:
+                visited.add(x.id)
+                stack.append((x, True))
+                for a in reversed(x.args):
+                    if a.id not in visited:
+                        stack.append((a, False))
+    return order
+
+
+def tangent(roots, seeds):
+    """Directional derivatives of the roots, seeds maps variables to their
+    directions"""
+    d = {}
+    for x in postorder(roots):
+        if x.op == "num":
+            d[x.id] = ZERO
+        elif x.op == "var":
+            d[x.id] = seeds.get(x, ZERO)
+        elif x.op == "add":
+            d[x.id] = add(*[d[t.id] for t in x.args])
+        elif x.op == "mul":
+            terms = []
+            for i, f in enumerate(x.args):
+                if d[f.id] is not ZERO:
+                    others = x.args[:i] + x.args[i + 1 :]
+                    terms.append(mul(x.data, d[f.id], *others))
+            d[x.id] = add(*terms)
+        elif x.op == "recip":
+            d[x.id] = mul(-1.0, x, x, d[x.args[0].id])
+    return [d[r.id] for r in roots]
+
+
+def adjoint(roots, seeds, wrt):
+    """Derivatives of sum(seeds[k] * roots[k]) with respect to the variables
+    in wrt"""
+    bar = {}
+    for r, s in zip(roots, seeds):
+        bar.setdefault(r.id, []).append(s)
+
+    for x in reversed(postorder(roots)):
+        if x.id not in bar or x.op in ("num", "var"):
+            continue
+        xb = add(*bar[x.id])
+        if x.op == "add":
+            for t in x.args:
+                bar.setdefault(t.id, []).append(xb)
+        elif x.op == "mul":
+            for i, f in enumerate(x.args):
+                others = x.args[:i] + x.args[i + 1 :]
+                bar.setdefault(f.id, []).append(mul(x.data, xb, *others))
+        elif x.op == "recip":
+            a = x.args[0]
+            bar.setdefault(a.id, []).append(mul(-1.0, xb, x, x))
+
+    return [add(*bar[v.id]) if v.id in bar else ZERO for v in wrt]
+
+
+# ---------------------------------------------------------------------------
+# Optimization
+# ---------------------------------------------------------------------------
+
+
+def _sum(terms, signs):
+    """Raw sum, nested sums are flattened"""
+    args, sgns = [], []
+    for t, s in zip(terms, signs):
+        if t.op == "sum":
+            args.extend(t.args)
+            sgns.extend(s * u for u in t.data)
+        else:
+            args.append(t)
+            sgns.append(s)
+    if len(args) == 1 and sgns[0] == 1:
+        return args[0]
+    return _make("sum", args, tuple(sgns))
+
+
+def _prod(factors, sign=1):
+    """Raw product, nested products are flattened"""
+    args = []
+    for f in factors:
+        if f.op == "prod":
+            sign *= f.data
+            args.extend(f.args)
+        else:
+            args.append(f)
+    args = [a for a in args if not (a.op == "num" and a.data == 1.0)]
+    if len(args) == 0:
+        return num(sign)
+    elif len(args) == 1 and sign == 1:
+        return args[0]
+    return _make("prod", sorted(args, key=_sort_key), sign)
+
+
+class _Optimizer:
+    def __init__(self):
+        self.memo = {}
+
+    def node(self, x):
+        if x.id in self.memo:
+            return self.memo[x.id]
+
+        if x.op in ("num", "var"):
+            y = x
+        elif x.op == "recip":
+            y = _make("recip", (self.node(x.args[0]),))
+        elif x.op == "mul":
+            y = self.term(x.data, x.args)
+        elif x.op == "add":
+            y = self.factor([_split(t) for t in x.args])
+
+        self.memo[x.id] = y
+        return y
+
+    def term(self, coef, factors):
+        sign = -1 if coef < 0.0 else 1
+        args = [self.node(f) for f in factors]
+        if abs(coef) != 1.0:
+            args.insert(0, num(abs(coef)))
+        return _prod(args, sign)
+
+    def factor(self, terms):
+        """Sum of coef * prod(factors) with the common factors pulled out"""
+        if len(terms) == 1:
+            return self.term(*terms[0])
+
+        # Common coefficient and sign
+        c0 = abs(terms[0][0])
+        if c0 != 1.0 and all(abs(c) == c0 for c, f in terms):
+            inner = self.factor([(c / c0, f) for c, f in terms])
+            return _prod([num(c0), inner])
+        if all(c < 0.0 for c, f in terms):
+            inner = self.factor([(-c, f) for c, f in terms])
+            return _prod([inner], -1)
+
+        # Pull out the factor shared by the most terms
+        count = Counter()
+        for c, f in terms:
+            count.update(set(f))
+        if count:
+            best = min(count, key=lambda f: (-count[f], _sort_key(f)))
+            if count[best] >= 2:
+                inner, rest = [], []
+                for c, f in terms:
+                    if best in f:
+                        i = f.index(best)
+                        inner.append((c, f[:i] + f[i + 1 :]))
+                    else:
+                        rest.append((c, f))
+                y = _prod([self.node(best), self.factor(inner)])
+                if rest:
+                    y = _sum([y, self.factor(rest)], [1, 1])
+                return y
+
+        args, signs = [], []
+        for c, f in terms:
+            t = self.term(abs(c), f)
+            args.append(t)
+            signs.append(-1 if c < 0.0 else 1)
+        return _sum(args, signs)
+
+
+def _rebuild(roots, rule):
+    """Rebuild the graph bottom-up, rule(x, args) gives the new node"""
+    new = {}
+    for x in postorder(roots):
+        args = tuple(new[a.id] for a in x.args)
+        new[x.id] = rule(x, args)
+    return [new[r.id] for r in roots]
+
+
+def _copy(x, args):
+    return _make(x.op, args, x.data)
+
+
+def _share_pairs(roots):
+    """Assign the pairs of factors shared by several products to new nodes"""
+    while True:
+        count = Counter()
+        for x in postorder(roots):
+            if x.op == "prod":
+                pairs = set(itertools.combinations(x.args, 2))
+                count.update((a.id, b.id) for a, b in pairs)
+        if not count:
+            return roots
+        best = min(count, key=lambda p: (-count[p], p))
+        if count[best] < 2:
+            return roots
+
+        pair = {}
+
+        def rule(x, args):
+            if x.op != "prod":
+                return _copy(x, args)
+            ids = [a.id for a in args]
+            if best[0] not in ids or best[1] not in ids:
+                return _copy(x, args)
+            args = list(args)
+            a = args.pop(ids.index(best[0]))
+            ids = [t.id for t in args]
+            if best[1] not in ids:
+                return _copy(x, tuple(sorted(args + [a], key=_sort_key)))
+            b = args.pop(ids.index(best[1]))
+            if "node" not in pair:
+                pair["node"] = _make("prod", (a, b), 1)
+            if not args:
+                if x.data == 1:
+                    return pair["node"]
+                return _make("prod", (pair["node"],), -1)
+            args = sorted(args + [pair["node"]], key=_sort_key)
+            return _make("prod", tuple(args), x.data)
+
+        roots = _rebuild(roots, rule)
+
+
+def optimize(roots):
+    opt = _Optimizer()
+    return _share_pairs([opt.node(r) for r in roots])
+
+
+# ---------------------------------------------------------------------------
+# Code emission
+# ---------------------------------------------------------------------------
+
+
+def _format_num(value):
+    return repr(float(value))
+
+
+class Writer:
+    """Writes the statements of a kernel, the subexpressions that are used
+    more than once are assigned to temporaries"""
+
+    def __init__(self, statements, indent):
+        """statements is a list of (format, node) where format contains {}
+        in place of the expression, or None for a verbatim line"""
+        self.indent = indent
+        exprs = [e for fmt, e in statements if e is not None]
+        exprs = optimize(exprs)
+        it = iter(exprs)
+        self.statements = [
+            (fmt, next(it) if e is not None else None) for fmt, e in statements
+        ]
+
+        uses = Counter()
+        for x in postorder(exprs):
+            uses.update(a.id for a in x.args)
+        self.temps = {}
+        self.shared = set(
+            x.id
+            for x in postorder(exprs)
+            if uses[x.id] >= 2 and not self._is_leaf(x)
+        )
+
+    def _is_leaf(self, x):
+        if x.op in ("num", "var"):
+            return True
+        return x.op == "prod" and len(x.args) == 1 and x.args[0].op == "var"
+
+    def lines(self):
+        out = []
+        for fmt, e in self.statements:
+            if e is None:
+                out.append(self.indent + fmt if fmt else "")
+                continue
+            for x in postorder([e]):
+                if x.id in self.shared and x.id not in self.temps:
+                    text = self.expr(x, top=True)
+                    self.temps[x.id] = "t%d" % len(self.temps)
+                    out.extend(
+                        wrap("T %s = {};" % self.temps[x.id], text, self.indent)
+                    )
+            if e.op == "num":
+                text = "T(%s)" % _format_num(e.data)
+            else:
+                text = self.expr(e)
+            out.extend(wrap(fmt, text, self.indent))
+        return out
+
+    def expr(self, x, top=False):
+        if not top and x.id in self.temps:
+            return self.temps[x.id]
+        if x.op == "num":
+            return _format_num(x.data)
+        elif x.op == "var":
+            name, index = x.data
+            return name if index is None else "%s[%d]" % (name, index)
+        elif x.op == "recip":
+            return "1.0 / %s" % self.factor(x.args[0])
+        elif x.op == "sum":
+            terms = []
+            for t, s in zip(x.args, x.data):
+                term = self.expr(t)
+                if t.op == "prod" and t.data == -1 and t.id not in self.temps:
+                    s, term = -s, term[1:]
+                terms.append((term, s))
+            # Start with a positive term if there is one
+            first = next((k for k, (t, s) in enumerate(terms) if s > 0), 0)
+            terms.insert(0, terms.pop(first))
+            text = ""
+            for i, (term, s) in enumerate(terms):
+                if i == 0:
+                    text = term if s > 0 else "-" + term
+                else:
+                    text += (" + " if s > 0 else " - ") + term
+            return text
+        elif x.op == "prod":
+            text = " * ".join(self.factor(f) for f in x.args)
+            return text if x.data > 0 else "-" + text
+
+    def factor(self, x):
+        text = self.expr(x)
+        if x.id not in self.temps and x.op in ("sum", "recip"):
+            return "(%s)" % text
+        if x.id not in self.temps and x.op == "prod" and x.data < 0:
+            return "(%s)" % text
+        return text
+
+
+def wrap(fmt, text, indent):
+    """Break the statement fmt.format(text) into lines of at most LINE_WIDTH
+    characters, after the operators with the fewest enclosing parentheses"""
+    head, tail = fmt.split("{}")
+    if len(indent + head + text + tail) <= LINE_WIDTH:
+        return [indent + head + text + tail]
+
+    # Pieces of the expression that end with an operator and the priority of
+    # the break after them, the additive operators come first
+    pieces = []
+    depth, start = 0, 0
+    for i, ch in enumerate(text):
+        if ch == "(":
+            depth += 1
+        elif ch == ")":
+            depth -= 1
+        elif text[i : i + 3] in (" + ", " - ", " * ") and i > start:
+            priority = depth + (1.5 if text[i + 1] == "*" else 0.0)
+            pieces.append((text[start : i + 2], priority))
+            start = i + 3
+    pieces.append((text[start:] + tail, None))
+
+    align = len(indent + head)
+    if align > LINE_WIDTH // 2:
+        align = len(indent) + 4
+
+    # Continuation lines are aligned with the innermost open parenthesis
+    lines = []
+    current = indent + head
+    parens = []
+    while pieces:
+        width, fits = len(current), []
+        for k, (piece, priority) in enumerate(pieces):
+            width += len(piece) + (k > 0)
+            if width > LINE_WIDTH:
+                break
+            fits.append(k)
+
+        if len(fits) == len(pieces):
+            best = len(pieces) - 1
+        elif not fits:
+            best = 0
+        else:
+            best = min(fits, key=lambda k: (pieces[k][1], -k))
+        start = len(current)
+        current += " ".join(p for p, _ in pieces[: best + 1])
+        for col in range(start, len(current)):
+            if current[col] == "(":
+                parens.append(col)
+            elif current[col] == ")":
+                parens.pop()
+        lines.append(current)
+        pieces = pieces[best + 1 :]
+        current = " " * (parens[-1] + 1 if parens else align)
+    return lines
+
+
+# ---------------------------------------------------------------------------
+# Operands
+# ---------------------------------------------------------------------------
+
+
+def sym_index(i, j):
+    if i < j:
+        i, j = j, i
+    return i * (i + 1) // 2 + j
+
+
+def mat(name, n, m=None):
+    """Entries of an n-by-m matrix stored row by row"""
+    m = n if m is None else m
+    return [[var(name, m * i + j) for j in range(m)] for i in range(n)]
+
+
+def symmat(name, n):
+    """Entries of an n-by-n symmetric matrix stored as its lower triangle"""
+    return [[var(name, sym_index(i, j)) for j in range(n)] for i in range(n)]
+
+
+def transpose(A):
+    return [list(row) for row in zip(*A)]
+
+
+def flat(A):
+    return [x for row in A for x in row]
+
+
+def lower(A):
+    """Stored entries of a symmetric matrix"""
+    return [A[i][j] for i in range(len(A)) for j in range(i + 1)]
+
+
+def symvars(name, n):
+    return [var(name, k) for k in range(n * (n + 1) // 2)]
+
+
+def det(A):
+    """Determinant by cofactor expansion, the minors are shared through the
+    hash-consing"""
+    n = len(A)
+
+    def minor(rows, cols):
+        if len(rows) == 1:
+            return A[rows[0]][cols[0]]
+        r, rest = rows[0], rows[1:]
+        terms = []
+        for k, c in enumerate(cols):
+            sub = minor(rest, cols[:k] + cols[k + 1 :])
+            terms.append(mul(-1.0 if k % 2 else 1.0, A[r][c], sub))
+        return add(*terms)
+
+    return minor(tuple(range(n)), tuple(range(n)))
+
+
+def cofactor(A, i, j):
+    n = len(A)
+    rows = [r for r in range(n) if r != i]
+    cols = [c for c in range(n) if c != j]
+    sub = [[A[r][c] for c in cols] for r in rows]
+    d = det(sub) if sub else num(1.0)
+    return d if (i + j) % 2 == 0 else -d
+
+
+def inverse(A):
+    n = len(A)
+    C = [[cofactor(A, i, j) for j in range(n)] for i in range(n)]
+    # Expand the determinant along the first row to reuse the cofactors
+    d = add(*[A[0][j] * C[0][j] for j in range(n)])
+    r = recip(d)
+    return [[C[j][i] * r for j in range(n)] for i in range(n)]
+
+
+# ---------------------------------------------------------------------------
+# Kernels
+# ---------------------------------------------------------------------------
+
+SIZES = range(1, MAX_SIZE + 1)
+OPS = ("NORMAL", "TRANSPOSE")
+
+
+class Kernel:
+    """A function whose body is selected by if constexpr over its cases"""
+
+    def __init__(self, doc, signature, cases, prologue=(), epilogue=()):
+        self.doc = doc
+        self.signature = signature
+        self.cases = cases  # list of (condition, statements)
+        self.prologue = prologue
+        self.epilogue = epilogue
+
+    def lines(self):
+        out = []
+        if self.doc:
+            out.append("/*")
+            out.extend(("  " + l).rstrip() for l in self.doc.strip().split("\n"))
+            out.append("*/")
+        out.extend(self.signature)
+        out.extend(("  " + l).rstrip() for l in self.prologue)
+        for k, (cond, statements) in enumerate(self.cases):
+            key = "  if constexpr (" if k == 0 else "  } else if constexpr ("
+            terms = cond.split(" && ")
+            out.extend(wrap_list(key, terms, ") {", " " * len(key), " &&"))
+            out.extend(Writer(statements, "    ").lines())
+        out.append("  }")
+        out.extend("  " + l for l in self.epilogue)
+        out.append("}")
+        return out
+
+
+def signature(ret, name, tparams, params):
+    """Template and function declaration in the style of clang-format"""
+    out = ["template <%s>" % ", ".join(tparams)]
+    if len(out[0]) > LINE_WIDTH:
+        out = wrap_list("template <", tparams, ">", "          ")
+    head = "A2D_FUNCTION %s %s(" % (ret, name)
+    out.extend(wrap_list(head, params, ") {", " " * len(head)))
+    return out
+
+
+def wrap_list(head, items, tail, cont, sep=","):
+    lines = []
+    current = head
+    for k, item in enumerate(items):
+        tok = item + (sep if k < len(items) - 1 else tail)
+        space = "" if current in (head, cont) else " "
+        if len(current) + len(space) + len(tok) <= LINE_WIDTH:
+            current += space + tok
+        else:
+            lines.append(current)
+            current = cont + tok
+    lines.append(current)
+    return lines
+
+
+def size_check(name, max_size=MAX_SIZE):
+    cond = "N >= 1 && N <= %d" % max_size
+    msg = '"%s is generated for N <= %d"' % (name, max_size)
+    line = "static_assert(%s, %s);" % (cond, msg)
+    if len(line) + 2 <= 80:
+        return [line, ""]
+    return ["static_assert(%s," % cond, "              %s);" % msg, ""]
+
+
+def assign(targets, exprs, op="="):
+    return [("%s %s {};" % (t, op), e) for t, e in zip(targets, exprs)]
+
+
+def accumulate(targets, exprs):
+    return [("%s += {};" % t, e) for t, e in zip(targets, exprs) if e is not ZERO]
+
+
+def names(name, n):
+    return ["%s[%d]" % (name, k) for k in range(n)]
+
+
+def gemm_operand(kind, name, n):
+    if kind == "SYMMETRIC":
+        return symmat(name, n)
+    A = mat(name, n)
+    return transpose(A) if kind == "TRANSPOSE" else A
+
+
+def gemm_kernel(name, doc, kinds_a, kinds_b, tparams, params, opnames):
+    cases = []
+    for n in SIZES:
+        for ka in kinds_a:
+            for kb in kinds_b:
+                A = gemm_operand(ka, "A", n)
+                B = gemm_operand(kb, "B", n)
+                C = [
+                    add(*[A[i][k] * B[k][j] for k in range(n)])
+                    for i in range(n)
+                    for j in range(n)
+                ]
+                cond = ["N == %d" % n]
+                for op, kind in zip(opnames, (ka, kb)):
+                    if op is not None:
+                        cond.append("%s == MatOp::%s" % (op, kind))
+                cases.append((" && ".join(cond), assign(names("c", n * n), C)))
+
+    return Kernel(
+        doc,
+        signature("void", name, tparams, params),
+        cases,
+        prologue=size_check(name) + ["T c[N * N];"],
+        epilogue=["GenStoreCore<N * N, scale, additive>(alpha, c, C);"],
+    )
+
+
+def gemm_header():
+    store = """template <int size, bool scale, bool additive, typename T>
+A2D_FUNCTION void GenStoreCore(const T alpha, const T c[], T C[]) {
+  for (int i = 0; i < size; i++) {
+    if constexpr (scale && additive) {
+      C[i] += alpha * c[i];
+    } else if constexpr (scale) {
+      C[i] = alpha * c[i];
+    } else if constexpr (additive) {
+      C[i] += c[i];
+    } else {
+      C[i] = c[i];
+    }
+  }
+}"""
+    kernels = [store.split("\n")]
+    both = ("NORMAL", "TRANSPOSE")
+    sym = ("SYMMETRIC",)
+    common = ["bool scale = false", "bool additive = false"]
+    kernels.append(
+        gemm_kernel(
+            "MatMatMultCoreGen",
+            """
+C = alpha * op(A) * op(B) for N-by-N matrices, alpha is only used when
+scale is true and C is added to when additive is true
+""",
+            both,
+            both,
+            ["typename T", "int N", "MatOp opA", "MatOp opB"] + common,
+            ["const T alpha", "const T A[]", "const T B[]", "T C[]"],
+            ("opA", "opB"),
+        ).lines()
+    )
+    kernels.append(
+        gemm_kernel(
+            "SMatMatMultCoreGen",
+            "C = alpha * S * op(B) where S is symmetric",
+            sym,
+            both,
+            ["typename T", "int N", "MatOp opB"] + common,
+            ["const T alpha", "const T A[]", "const T B[]", "T C[]"],
+            (None, "opB"),
+        ).lines()
+    )
+    kernels.append(
+        gemm_kernel(
+            "MatSMatMultCoreGen",
+            "C = alpha * op(A) * S where S is symmetric",
+            both,
+            sym,
+            ["typename T", "int N", "MatOp opA"] + common,
+            ["const T alpha", "const T A[]", "const T B[]", "T C[]"],
+            ("opA", None),
+        ).lines()
+    )
+    kernels.append(
+        gemm_kernel(
+            "SMatSMatMultCoreGen",
+            "C = alpha * SA * SB where SA and SB are symmetric",
+            sym,
+            sym,
+            ["typename T", "int N"] + common,
+            ["const T alpha", "const T A[]", "const T B[]", "T C[]"],
+            (None, None),
+        ).lines()
+    )
+    return "A2D_GEMM_GEN_H", ["../../../a2ddefs.h"], kernels
+
+
+def det_header():
+    kernels = []
+    for sym in (False, True):
+        prefix = "SymMat" if sym else "Mat"
+        X = "S" if sym else "A"
+        size = "N * (N + 1) / 2" if sym else "N * N"
+        cases = {"eval": [], "forward": [], "reverse": [], "hreverse": []}
+        for n in SIZES:
+            A = symmat(X, n) if sym else mat(X, n)
+            x = symvars(X, n) if sym else flat(A)
+            xd = symvars(X + "d", n) if sym else flat(mat(X + "d", n))
+            xp = symvars(X + "p", n) if sym else flat(mat(X + "p", n))
+            bdet, hdet = var("bdet"), var("hdet")
+
+            d = det(A)
+            dd = tangent([d], dict(zip(x, xd)))[0]
+            xb = adjoint([d], [bdet], x)
+            seeds = dict(zip(x, xp))
+            seeds[bdet] = hdet
+            xh = tangent(xb, seeds)
+
+            cond = "N == %d" % n
+            cases["eval"].append((cond, [("return {};", d)]))
+            cases["forward"].append((cond, [("return {};", dd)]))
+            cases["reverse"].append((cond, accumulate(names(X + "b", len(x)), xb)))
+            cases["hreverse"].append(
+                (cond, accumulate(names(X + "h", len(x)), xh))
+            )
+
+        tparams = ["typename T", "int N"]
+        arr = lambda s: "const T %s[]" % s
+        defs = [
+            ("eval", "T", "DetCoreGen", [arr(X)]),
+            ("forward", "T", "DetForwardCoreGen", [arr(X), arr(X + "d")]),
+            (
+                "reverse",
+                "void",
+                "DetReverseCoreGen",
+                ["const T bdet", arr(X), "T %sb[]" % X],
+            ),
+            (
+                "hreverse",
+                "void",
+                "DetHReverseCoreGen",
+                ["const T bdet", "const T hdet", arr(X), arr(X + "p"), "T %sh[]" % X],
+            ),
+        ]
+        for key, ret, name, params in defs:
+            name = prefix + name
+            kernels.append(
+                Kernel(
+                    None,
+                    signature(ret, name, tparams, params),
+                    cases[key],
+                    prologue=size_check(name),
+                ).lines()
+            )
+    return "A2D_MAT_DET_GEN_H", ["../../../a2ddefs.h"], kernels
+
+
+def inv_header():
+    kernels = []
+    for sym in (False, True):
+        name = "SymMatInvCoreGen" if sym else "MatInvCoreGen"
+        X, Y = ("S", "Sinv") if sym else ("A", "Ainv")
+        cases = []
+        for n in range(1, MAX_INV_SIZE + 1):
+            A = symmat(X, n) if sym else mat(X, n)
+            Ainv = inverse(A)
+            out = lower(Ainv) if sym else flat(Ainv)
+            cases.append(("N == %d" % n, assign(names(Y, len(out)), out)))
+        params = ["const T %s[]" % X, "T %s[]" % Y]
+        kernels.append(
+            Kernel(
+                None,
+                signature("void", name, ["typename T", "int N"], params),
+                cases,
+                prologue=size_check(name, MAX_INV_SIZE),
+            ).lines()
+        )
+    return "A2D_MAT_INV_GEN_H", ["../../../a2ddefs.h"], kernels
+
+
+def green_strain(U, nonlinear):
+    n = len(U)
+    E = []
+    for i in range(n):
+        for j in range(i + 1):
+            e = U[i][j] + U[j][i]
+            if nonlinear:
+                e = e + add(*[U[k][i] * U[k][j] for k in range(n)])
+            E.append(0.5 * e)
+    return E
+
+
+def green_strain_header():
+    kernels = []
+    ptr = lambda s: "const T* A2D_RESTRICT %s" % s
+    out = lambda s: "T* A2D_RESTRICT %s" % s
+    for nonlinear in (False, True):
+        prefix = "Nonlinear" if nonlinear else "Linear"
+        cases = {"eval": [], "forward": [], "reverse": [], "hreverse": []}
+        for n in SIZES:
+            U = mat("Ux", n)
+            ux, ud, up = flat(U), flat(mat("Ud", n)), flat(mat("Up", n))
+            eb, eh = symvars("Eb", n), symvars("Eh", n)
+
+            E = green_strain(U, nonlinear)
+            Ed = tangent(E, dict(zip(ux, ud)))
+            ub = adjoint(E, eb, ux)
+            seeds = dict(zip(ux, up))
+            seeds.update(zip(eb, eh))
+            uh = tangent(ub, seeds)
+
+            cond = "N == %d" % n
+            cases["eval"].append((cond, assign(names("E", len(E)), E)))
+            cases["forward"].append((cond, assign(names("E", len(E)), Ed)))
+            cases["reverse"].append((cond, accumulate(names("Ub", n * n), ub)))
+            cases["hreverse"].append((cond, accumulate(names("Uh", n * n), uh)))
+
+        if nonlinear:
+            params = {
+                "eval": [ptr("Ux"), out("E")],
+                "forward": [ptr("Ux"), ptr("Ud"), out("E")],
+                "reverse": [ptr("Ux"), ptr("Eb"), out("Ub")],
+                "hreverse": [ptr("Ux"), ptr("Up"), ptr("Eb"), ptr("Eh"), out("Uh")],
+            }
+        else:
+            params = {
+                "eval": [ptr("Ux"), out("E")],
+                "forward": [ptr("Ud"), out("E")],
+                "reverse": [ptr("Eb"), out("Ub")],
+                "hreverse": [ptr("Eh"), out("Uh")],
+            }
+        suffix = {
+            "eval": "",
+            "forward": "Forward",
+            "reverse": "Reverse",
+            "hreverse": "HReverse",
+        }
+        for key in ("eval", "forward", "reverse", "hreverse"):
+            name = "%sGreenStrain%sCoreGen" % (prefix, suffix[key])
+            kernels.append(
+                Kernel(
+                    None,
+                    signature("void", name, ["typename T", "int N"], params[key]),
+                    cases[key],
+                    prologue=size_check(name),
+                ).lines()
+            )
+    return "A2D_GREEN_STRAIN_GEN_H", ["../../../a2ddefs.h"], kernels
+
+
+def isotropic_header():
+    eval_cases, coef_cases = [], []
+    mu, lam = var("mu"), var("lambda")
+    for n in SIZES:
+        E = symmat("E", n)
+        tr = add(*[E[i][i] for i in range(n)])
+        S = [
+            2.0 * mu * E[i][j] + (lam * tr if i == j else ZERO)
+            for i in range(n)
+            for j in range(i + 1)
+        ]
+        coefs = adjoint(S, symvars("Sb", n), [mu, lam])
+
+        cond = "N == %d" % n
+        eval_cases.append((cond, assign(names("S", len(S)), S, "{op}")))
+        coef_cases.append((cond, accumulate(["mu", "lambda"], coefs)))
+
+    # The statements are shared by the assignment and the addition
+    name = "SymIsotropicCoreGen"
+    tparams = ["typename T", "int N", "bool additive = false"]
+    params = ["const T mu", "const T lambda", "const T E[]", "T S[]"]
+    kernels = []
+    for additive, op in ((False, "="), (True, "+=")):
+        cases = [
+            (c, [(fmt.replace("{op}", op), e) for fmt, e in st])
+            for c, st in eval_cases
+        ]
+        cond = "additive" if additive else "!additive"
+        cases = [("%s && %s" % (c, cond), st) for c, st in cases]
+        kernels.append(cases)
+    cases = [x for pair in zip(*kernels) for x in pair]
+
+    doc = """
+S = 2 * mu * E + lambda * tr(E) * I, S is added to when additive is true
+"""
+    eval_kernel = Kernel(
+        doc,
+        signature("void", name, tparams, params),
+        cases,
+        prologue=size_check(name),
+    )
+
+    name = "SymIsotropicReverseCoefCoreGen"
+    params = ["const T E[]", "const T Sb[]", "T& mu", "T& lambda"]
+    coef_kernel = Kernel(
+        None,
+        signature("void", name, ["typename T", "int N"], params),
+        coef_cases,
+        prologue=size_check(name),
+    )
+    return (
+        "A2D_ISOTROPIC_GEN_H",
+        ["../../../a2ddefs.h"],
+        [eval_kernel.lines(), coef_kernel.lines()],
+    )
+
+
+def trace_header():
+    eval_cases, rev_cases = [], []
+    scale = var("scale")
+    for n in SIZES:
+        S, E = symmat("S", n), symmat("E", n)
+        e = symvars("E", n)
+        tr = add(*[S[i][j] * E[j][i] for i in range(n) for j in range(n)])
+        eb = adjoint([tr], [scale], e)
+
+        cond = "N == %d" % n
+        eval_cases.append((cond, [("return {};", tr)]))
+        rev_cases.append((cond, accumulate(names("E", len(e)), eb)))
+
+    name = "SymMatMultTraceCoreGen"
+    k1 = Kernel(
+        None,
+        signature("T", name, ["typename T", "int N"], ["const T S[]", "const T E[]"]),
+        eval_cases,
+        prologue=size_check(name),
+    )
+    name = "SymMatMultTraceReverseCoreGen"
+    params = ["const T scale", "const T S[]", "T E[]"]
+    k2 = Kernel(
+        None,
+        signature("void", name, ["typename T", "int N"], params),
+        rev_cases,
+        prologue=size_check(name),
+    )
+    return "A2D_SYM_TRACE_GEN_H", ["../../../a2ddefs.h"], [k1.lines(), k2.lines()]
+
+
+HEADERS = {
+    "a2dgemmgen.h": gemm_header,
+    "a2dmatdetgen.h": det_header,
+    "a2dmatinvgen.h": inv_header,
+    "a2dgreenstraingen.h": green_strain_header,
+    "a2disotropicgen.h": isotropic_header,
+    "a2dsymmatmulttracegen.h": trace_header,
+}
+
+
+def render(filename, guard, includes, kernels):
+    out = [
+        "// Generated by python/a2dcodegen.py, do not edit",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+    ]
+    out.extend('#include "%s"' % inc for inc in includes)
+    out.extend(["", "namespace A2D {", ""])
+    for k in kernels:
+        out.extend(k)
+        out.append("")
+    out.extend(["}  // namespace A2D", "", "#endif  // %s" % guard, ""])
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument(
+        "--output-dir",
+        default=os.path.join(ROOT, "include", "ad", "core", "generated"),
+        help="directory of the generated headers",
+    )
+    parser.add_argument(
+        "--check",
+        action="store_true",
+        help="fail if the headers in the output directory are out of date",
+    )
+    args = parser.parse_args()
+
+    stale = []
+    for filename, build in HEADERS.items():
+        text = render(filename, *build())
+        path = os.path.join(args.output_dir, filename)
+        current = None
+        if os.path.exists(path):
+            with open(path) as f:
+                current = f.read()
+        if current == text:
+            continue
+        if args.check:
+            stale.append(path)
+        else:
+            os.makedirs(args.output_dir, exist_ok=True)
+            with open(path, "w") as f:
+                f.write(text)
+            print("Wrote %s" % path)
+
+    if stale:
+        for path in stale:
+            print("%s is out of date" % path, file=sys.stderr)
+        print("Run python/a2dcodegen.py to regenerate it", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include "a2ddefs.h"
+#include "ad/a2dbatch.h"
+#include "ad/a2dgemm.h"
+#include "ad/a2dmat.h"
+#include "ad/a2dmatdet.h"
+#include "ad/a2dmatinv.h"
+#include "ad/a2dobj.h"
+#include "ad/a2dstack.h"
+#include "ad/core/a2dgemmcore.h"
+#include "ad/core/a2dmatdetcore.h"
+#include "ad/core/a2dmatinvcore.h"
+#include "ad/core/a2dsymrkcore.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+// Fill each lane of a batched object with random values
+template <class BatchType>
+void set_random(BatchType& obj) {
+  using B = typename BatchType::type;
+  for (int i = 0; i < BatchType::ncomp; i++) {
+    for (int k = 0; k < B::width; k++) {
+      obj[i][k] = -1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX;
+    }
+  }
+}
+
+// Make each lane of a batched square matrix diagonally dominant
+template <int N, class BatchType>
+void make_invertible(BatchType& obj) {
+  for (int i = 0; i < N; i++) {
+    obj(i, i) += 2.0 * N;
+  }
+}
+
+template <int W, MatOp opA, MatOp opB>
+void test_batch_gemm() {
+  using B = Batch<double, W>;
+  Mat<B, 3, 3> A, Bm, C;
+  set_random(A);
+  set_random(Bm);
+
+  MatMatMultCore<B, 3, 3, 3, 3, 3, 3, opA, opB>(get_data(A), get_data(Bm),
+                                                get_data(C));
+
+  for (int k = 0; k < W; k++) {
+    Mat<double, 3, 3> Ak, Bk, Ck;
+    BatchGetLane(k, A, Ak);
+    BatchGetLane(k, Bm, Bk);
+    MatMatMultCore<double, 3, 3, 3, 3, 3, 3, opA, opB>(
+        get_data(Ak), get_data(Bk), get_data(Ck));
+    for (int i = 0; i < 9; i++) {
+      EXPECT_DOUBLE_EQ(C[i][k], Ck[i]);
+    }
+  }
+}
+
+TEST(test_a2dbatchcore, MatMatMultCore) {
+  test_batch_gemm<4, MatOp::NORMAL, MatOp::NORMAL>();
+  test_batch_gemm<4, MatOp::TRANSPOSE, MatOp::NORMAL>();
+  test_batch_gemm<8, MatOp::NORMAL, MatOp::TRANSPOSE>();
+  test_batch_gemm<8, MatOp::TRANSPOSE, MatOp::TRANSPOSE>();
+
+  // Non power-of-two widths use the array fallback
+  test_batch_gemm<3, MatOp::NORMAL, MatOp::NORMAL>();
+}
+
+template <int W, int N, int K, MatOp op>
+void test_batch_symrk() {
+  using B = Batch<double, W>;
+  constexpr int S = (op == MatOp::NORMAL ? N : K);
+  Mat<B, N, K> A;
+  SymMat<B, S> Sm;
+  set_random(A);
+
+  SymMatRKCore<B, N, K, op>(get_data(A), get_data(Sm));
+
+  for (int k = 0; k < W; k++) {
+    Mat<double, N, K> Ak;
+    SymMat<double, S> Sk;
+    BatchGetLane(k, A, Ak);
+    SymMatRKCore<double, N, K, op>(get_data(Ak), get_data(Sk));
+    for (int i = 0; i < Sk.ncomp; i++) {
+      EXPECT_DOUBLE_EQ(Sm[i][k], Sk[i]);
+    }
+  }
+}
+
+TEST(test_a2dbatchcore, SymMatRKCore) {
+  test_batch_symrk<4, 3, 3, MatOp::NORMAL>();
+  test_batch_symrk<4, 3, 2, MatOp::TRANSPOSE>();
+  test_batch_symrk<8, 2, 3, MatOp::NORMAL>();
+}
+
+template <int W, int N>
+void test_batch_det_inv() {
+  using B = Batch<double, W>;
+  Mat<B, N, N> A, Ainv;
+  set_random(A);
+  make_invertible<N>(A);
+
+  B det = MatDetCore<B, N>(get_data(A));
+  MatInvCore<B, N>(get_data(A), get_data(Ainv));
+
+  for (int k = 0; k < W; k++) {
+    Mat<double, N, N> Ak, Ainvk;
+    BatchGetLane(k, A, Ak);
+    MatInvCore<double, N>(get_data(Ak), get_data(Ainvk));
+    double detk = MatDetCore<double, N>(get_data(Ak));
+    EXPECT_DOUBLE_EQ(det[k], detk);
+    for (int i = 0; i < N * N; i++) {
+      EXPECT_NEAR(Ainv[i][k], Ainvk[i], 1e-15);
+    }
+  }
+}
+
+TEST(test_a2dbatchcore, MatDetInvCore) {
+  test_batch_det_inv<4, 1>();
+  test_batch_det_inv<4, 2>();
+  test_batch_det_inv<4, 3>();
+  test_batch_det_inv<8, 3>();
+}
+
+TEST(test_a2dbatchcore, ComplexBatch) {
+  using C = A2D_complex_t<double>;
+  using B = Batch<C, 2>;
+  Mat<B, 3, 3> A, Ainv;
+  for (int i = 0; i < 9; i++) {
+    for (int k = 0; k < 2; k++) {
+      A[i][k] = C(static_cast<double>(rand()) / RAND_MAX, 1e-30);
+    }
+  }
+  make_invertible<3>(A);
+  MatInvCore<B, 3>(get_data(A), get_data(Ainv));
+
+  for (int k = 0; k < 2; k++) {
+    Mat<C, 3, 3> Ak, Ainvk;
+    BatchGetLane(k, A, Ak);
+    MatInvCore<C, 3>(get_data(Ak), get_data(Ainvk));
+    for (int i = 0; i < 9; i++) {
+      EXPECT_NEAR(Ainv[i][k].real(), Ainvk[i].real(), 1e-15);
+      EXPECT_NEAR(Ainv[i][k].imag(), Ainvk[i].imag(), 1e-45);
+    }
+  }
+}
+
+// The batched types work through the expressions and the stack
+TEST(test_a2dbatchcore, BatchStack) {
+  constexpr int W = 4;
+  using B = Batch<double, W>;
+  ADObj<Mat<B, 3, 3>> A, C;
+  ADObj<B> det;
+  set_random(A.value());
+  make_invertible<3>(A.value());
+
+  auto stack = MakeStack(MatInv(A, C), MatDet(C, det));
+  det.bvalue() = 1.0;
+  stack.reverse();
+
+  for (int k = 0; k < W; k++) {
+    ADObj<Mat<double, 3, 3>> Ak, Ck;
+    ADObj<double> detk;
+    BatchGetLane(k, A.value(), Ak.value());
+    auto stackk = MakeStack(MatInv(Ak, Ck), MatDet(Ck, detk));
+    detk.bvalue() = 1.0;
+    stackk.reverse();
+
+    EXPECT_NEAR(det.value()[k], detk.value(), 1e-15);
+    for (int i = 0; i < 9; i++) {
+      EXPECT_NEAR(A.bvalue()[i][k], Ak.bvalue()[i], 1e-14);
+    }
+  }
+}
@@ -252,3 +252,105 @@ TEST(test_a2dgemmcore, rectangular_matrices) {
   run_single_test<true, MatOp::NORMAL, MatOp::NORMAL>(case7());
   run_single_test<true, MatOp::TRANSPOSE, MatOp::NORMAL>(case8());
 }
+
+TEST(test_a2dgemmcore, medium_matrices) {
+  // Products with op(B) transposed or a long inner dimension use the
+  // register-blocked kernel, these include partial blocks at the edges
+  using case1 = a2d_tuple<Mat<T, 27, 27>, Mat<T, 27, 27>, Mat<T, 27, 27>>;
+  using case2 = a2d_tuple<Mat<T, 64, 24>, Mat<T, 24, 24>, Mat<T, 64, 24>>;
+  using case3 = a2d_tuple<Mat<T, 64, 24>, Mat<T, 64, 24>, Mat<T, 24, 24>>;
+  using case4 = a2d_tuple<Mat<T, 7, 5>, Mat<T, 9, 5>, Mat<T, 7, 9>>;
+  using case5 = a2d_tuple<Mat<T, 5, 7>, Mat<T, 9, 5>, Mat<T, 7, 9>>;
+
+  // Regular and Scale
+  run_single_test<false, MatOp::NORMAL, MatOp::NORMAL>(case1());
+  run_single_test<false, MatOp::TRANSPOSE, MatOp::TRANSPOSE>(case1());
+  run_single_test<false, MatOp::NORMAL, MatOp::TRANSPOSE>(case2());
+  run_single_test<false, MatOp::TRANSPOSE, MatOp::NORMAL>(case3());
+  run_single_test<false, MatOp::NORMAL, MatOp::TRANSPOSE>(case4());
+  run_single_test<false, MatOp::TRANSPOSE, MatOp::TRANSPOSE>(case5());
+
+  // Add and ScaleAdd
+  run_single_test<true, MatOp::NORMAL, MatOp::NORMAL>(case1());
+  run_single_test<true, MatOp::TRANSPOSE, MatOp::TRANSPOSE>(case1());
+  run_single_test<true, MatOp::NORMAL, MatOp::TRANSPOSE>(case2());
+  run_single_test<true, MatOp::TRANSPOSE, MatOp::NORMAL>(case3());
+  run_single_test<true, MatOp::NORMAL, MatOp::TRANSPOSE>(case4());
+  run_single_test<true, MatOp::TRANSPOSE, MatOp::TRANSPOSE>(case5());
+}
+
+// Inner dimensions longer than the tile length are split into tiles, which
+// changes the order of the sums compared to the general kernel
+template <int M, int P, int N, MatOp opA, MatOp opB, bool additive>
+void test_gemm_tiled() {
+  constexpr int Anrows = opA == MatOp::NORMAL ? M : P;
+  constexpr int Ancols = opA == MatOp::NORMAL ? P : M;
+  constexpr int Bnrows = opB == MatOp::NORMAL ? P : N;
+  constexpr int Bncols = opB == MatOp::NORMAL ? N : P;
+  static_assert(P > gemm_block_size<T>::KC, "The product must be tiled");
+
+  Mat<T, Anrows, Ancols> A;
+  Mat<T, Bnrows, Bncols> B;
+  Mat<T, M, N> C, C_expect;
+  const T alpha = 1.234;
+  for (int i = 0; i < A.ncomp; i++) {
+    A[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+  for (int i = 0; i < B.ncomp; i++) {
+    B[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+  for (int i = 0; i < C.ncomp; i++) {
+    C[i] = C_expect[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+
+  MatMatMultScaleCore<T, Anrows, Ancols, Bnrows, Bncols, M, N, opA, opB,
+                      additive>(alpha, get_data(A), get_data(B), get_data(C));
+  MatMatMultScaleCoreGeneral<T, Anrows, Ancols, Bnrows, Bncols, M, N, opA, opB,
+                             additive>(alpha, get_data(A), get_data(B),
+                                       get_data(C_expect));
+  for (int i = 0; i < C.ncomp; i++) {
+    EXPECT_NEAR(C_expect[i], C[i], 1e-12 * P);
+  }
+}
+
+TEST(test_a2dgemmcore, tiled_inner_dimension) {
+  constexpr MatOp NORMAL = MatOp::NORMAL, TRANSPOSE = MatOp::TRANSPOSE;
+
+  // One full tile and a partial one
+  test_gemm_tiled<6, 300, 9, NORMAL, TRANSPOSE, false>();
+  test_gemm_tiled<6, 300, 9, TRANSPOSE, NORMAL, true>();
+
+  // Two full tiles
+  test_gemm_tiled<7, 512, 6, NORMAL, NORMAL, false>();
+  test_gemm_tiled<7, 512, 6, TRANSPOSE, TRANSPOSE, true>();
+}
+
+TEST(test_a2dgemmcore, dual_add_medium_matrices) {
+  constexpr int N = 27;
+  Mat<T, N, N> A, Ad, B, Bd, C, Cd, C_expect, Cd_expect;
+  for (int i = 0; i < N * N; i++) {
+    A[i] = static_cast<T>(rand()) / RAND_MAX;
+    Ad[i] = static_cast<T>(rand()) / RAND_MAX;
+    B[i] = static_cast<T>(rand()) / RAND_MAX;
+    Bd[i] = static_cast<T>(rand()) / RAND_MAX;
+    C[i] = C_expect[i] = static_cast<T>(rand()) / RAND_MAX;
+    Cd[i] = Cd_expect[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+
+  constexpr MatOp NORMAL = MatOp::NORMAL, TRANSPOSE = MatOp::TRANSPOSE;
+  MatMatMultDualAddCore<T, N, N, N, N, N, N, NORMAL, TRANSPOSE>(
+      get_data(A), get_data(Ad), get_data(B), get_data(Bd), get_data(C),
+      get_data(Cd));
+
+  MatMatMultCoreGeneral<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, true>(
+      get_data(A), get_data(B), get_data(C_expect));
+  MatMatMultCoreGeneral<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, true>(
+      get_data(Ad), get_data(B), get_data(Cd_expect));
+  MatMatMultCoreGeneral<T, N, N, N, N, N, N, NORMAL, TRANSPOSE, true>(
+      get_data(A), get_data(Bd), get_data(Cd_expect));
+
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_DOUBLE_EQ(C_expect[i], C[i]);
+    EXPECT_DOUBLE_EQ(Cd_expect[i], Cd[i]);
+  }
+}
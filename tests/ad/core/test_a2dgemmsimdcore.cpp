@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "a2ddefs.h"
+#include "ad/a2dmat.h"
+#include "ad/core/a2dgemmcore.h"
+
+// This test is compiled with A2D_ENABLE_SIMD: the dispatchers use the
+// hand-vectorized kernels when the target supports them and are compared
+// against the scalar (generated) kernels, which are called directly.
+
+using namespace A2D;
+
+template <typename T, int N>
+void randomize(T (&x)[N]) {
+  for (int i = 0; i < N; i++) {
+    x[i] = -1.0 + 2.0 * static_cast<T>(rand()) / RAND_MAX;
+  }
+}
+
+template <typename T, int N>
+void expect_near(const T (&x)[N], const T (&y)[N]) {
+  const T tol = std::is_same<T, float>::value ? 1e-5 : 1e-14;
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(x[i], y[i], tol) << "entry " << i;
+  }
+}
+
+template <typename T, MatOp opA, MatOp opB>
+void test_mat_mat_3x3() {
+  T A[9], B[9], C0[9], C[9], Cref[9];
+  randomize(A);
+  randomize(B);
+  randomize(C0);
+  const T alpha = 1.234;
+
+  MatMatMultCoreGen<T, 3, opA, opB>(T(1.0), A, B, Cref);
+  MatMatMultCore<T, 3, 3, 3, 3, 3, 3, opA, opB>(A, B, C);
+  expect_near(C, Cref);
+
+  MatMatMultCoreGen<T, 3, opA, opB, true>(alpha, A, B, Cref);
+  MatMatMultScaleCore<T, 3, 3, 3, 3, 3, 3, opA, opB>(alpha, A, B, C);
+  expect_near(C, Cref);
+
+  std::copy(C0, C0 + 9, Cref);
+  std::copy(C0, C0 + 9, C);
+  MatMatMultCoreGen<T, 3, opA, opB, false, true>(T(1.0), A, B, Cref);
+  MatMatMultCore<T, 3, 3, 3, 3, 3, 3, opA, opB, true>(A, B, C);
+  expect_near(C, Cref);
+
+  std::copy(C0, C0 + 9, Cref);
+  std::copy(C0, C0 + 9, C);
+  MatMatMultCoreGen<T, 3, opA, opB, true, true>(alpha, A, B, Cref);
+  MatMatMultScaleCore<T, 3, 3, 3, 3, 3, 3, opA, opB, true>(alpha, A, B, C);
+  expect_near(C, Cref);
+}
+
+template <typename T, MatOp opA, MatOp opB>
+void test_mat_mat_2x2() {
+  T A[4], B[4], C0[4], C[4], Cref[4];
+  randomize(A);
+  randomize(B);
+  randomize(C0);
+  const T alpha = -0.75;
+
+  MatMatMultCoreGeneral<T, 2, 2, 2, 2, 2, 2, opA, opB>(A, B, Cref);
+  MatMatMultCore<T, 2, 2, 2, 2, 2, 2, opA, opB>(A, B, C);
+  expect_near(C, Cref);
+
+  std::copy(C0, C0 + 4, Cref);
+  std::copy(C0, C0 + 4, C);
+  MatMatMultScaleCoreGeneral<T, 2, 2, 2, 2, 2, 2, opA, opB, true>(alpha, A, B,
+                                                                  Cref);
+  MatMatMultScaleCore<T, 2, 2, 2, 2, 2, 2, opA, opB, true>(alpha, A, B, C);
+  expect_near(C, Cref);
+}
+
+template <typename T, MatOp op>
+void test_sym_mat_3x3() {
+  T S[6], SB[6], A[9], C0[9], C[9], Cref[9];
+  randomize(S);
+  randomize(SB);
+  randomize(A);
+  randomize(C0);
+  const T alpha = 0.4;
+
+  SMatMatMultCoreGen<T, 3, op>(T(1.0), S, A, Cref);
+  SMatMatMultCore<T, 3, 3, 3, 3, 3, op>(S, A, C);
+  expect_near(C, Cref);
+
+  std::copy(C0, C0 + 9, Cref);
+  std::copy(C0, C0 + 9, C);
+  SMatMatMultCoreGen<T, 3, op, true, true>(alpha, S, A, Cref);
+  SMatMatMultScaleCore<T, 3, 3, 3, 3, 3, op, true>(alpha, S, A, C);
+  expect_near(C, Cref);
+
+  MatSMatMultCoreGen<T, 3, op, true>(alpha, A, S, Cref);
+  MatSMatMultScaleCore<T, 3, 3, 3, 3, 3, op>(alpha, A, S, C);
+  expect_near(C, Cref);
+
+  std::copy(C0, C0 + 9, Cref);
+  std::copy(C0, C0 + 9, C);
+  MatSMatMultCoreGen<T, 3, op, false, true>(T(1.0), A, S, Cref);
+  MatSMatMultCore<T, 3, 3, 3, 3, 3, op, true>(A, S, C);
+  expect_near(C, Cref);
+
+  SMatSMatMultCoreGen<T, 3>(T(1.0), S, SB, Cref);
+  SMatSMatMultCore<T, 3, 3, 3, 3>(S, SB, C);
+  expect_near(C, Cref);
+
+  std::copy(C0, C0 + 9, Cref);
+  std::copy(C0, C0 + 9, C);
+  SMatSMatMultCoreGen<T, 3, true, true>(alpha, S, SB, Cref);
+  SMatSMatMultScaleCore<T, 3, 3, 3, 3, true>(alpha, S, SB, C);
+  expect_near(C, Cref);
+}
+
+template <typename T>
+void test_all() {
+  test_mat_mat_3x3<T, MatOp::NORMAL, MatOp::NORMAL>();
+  test_mat_mat_3x3<T, MatOp::NORMAL, MatOp::TRANSPOSE>();
+  test_mat_mat_3x3<T, MatOp::TRANSPOSE, MatOp::NORMAL>();
+  test_mat_mat_3x3<T, MatOp::TRANSPOSE, MatOp::TRANSPOSE>();
+  test_mat_mat_2x2<T, MatOp::NORMAL, MatOp::NORMAL>();
+  test_mat_mat_2x2<T, MatOp::NORMAL, MatOp::TRANSPOSE>();
+  test_mat_mat_2x2<T, MatOp::TRANSPOSE, MatOp::NORMAL>();
+  test_mat_mat_2x2<T, MatOp::TRANSPOSE, MatOp::TRANSPOSE>();
+  test_sym_mat_3x3<T, MatOp::NORMAL>();
+  test_sym_mat_3x3<T, MatOp::TRANSPOSE>();
+}
+
+TEST(test_a2dgemmsimdcore, Enabled) {
+#ifdef __AVX2__
+  EXPECT_TRUE(has_simd_gemm<double>::value);
+  EXPECT_TRUE(has_simd_gemm<float>::value);
+  EXPECT_TRUE(has_simd_gemm2x2<double>::value);
+#endif
+  EXPECT_FALSE(has_simd_gemm2x2<float>::value);
+  EXPECT_FALSE(has_simd_gemm<A2D_complex_t<double>>::value);
+}
+
+TEST(test_a2dgemmsimdcore, Double) { test_all<double>(); }
+
+TEST(test_a2dgemmsimdcore, Float) { test_all<float>(); }
@@ -0,0 +1,348 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "a2ddefs.h"
+#include "ad/a2disotropic.h"
+#include "ad/a2dmat.h"
+#include "ad/core/a2dgemmcore.h"
+#include "ad/core/a2dgreenstraincore.h"
+#include "ad/core/a2dmatdetcore.h"
+#include "ad/core/a2dmatinvcore.h"
+#include "ad/core/a2dsymmatmulttracecore.h"
+
+// The kernels generated by python/a2dcodegen.py are compared against plain
+// loops, and their derivatives against central differences, which are exact
+// up to round-off for the quadratic green strains.
+
+using namespace A2D;
+using T = double;
+
+template <int N>
+void randomize(T (&x)[N]) {
+  for (int i = 0; i < N; i++) {
+    x[i] = -1.0 + 2.0 * static_cast<T>(rand()) / RAND_MAX;
+  }
+}
+
+template <int N>
+void expect_near(const T (&x)[N], const T (&y)[N], T tol = 1e-13) {
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(x[i], y[i], tol) << "entry " << i;
+  }
+}
+
+template <int N>
+T sym_entry(const T S[], int i, int j) {
+  return i >= j ? S[i * (i + 1) / 2 + j] : S[j * (j + 1) / 2 + i];
+}
+
+template <int N, MatOp op>
+T op_entry(const T A[], int i, int j) {
+  return op == MatOp::NORMAL ? A[i * N + j] : A[j * N + i];
+}
+
+// C = alpha * op(A) * op(B) + beta * C0, symA and symB select packed storage
+template <int N, bool symA, bool symB, MatOp opA, MatOp opB>
+void gemm_ref(T alpha, const T A[], const T B[], T beta, const T C0[], T C[]) {
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      T value = 0.0;
+      for (int k = 0; k < N; k++) {
+        T a = symA ? sym_entry<N>(A, i, k) : op_entry<N, opA>(A, i, k);
+        T b = symB ? sym_entry<N>(B, k, j) : op_entry<N, opB>(B, k, j);
+        value += a * b;
+      }
+      C[i * N + j] = alpha * value + beta * C0[i * N + j];
+    }
+  }
+}
+
+template <int N, MatOp opA, MatOp opB, bool scale, bool additive>
+void test_gemm_gen() {
+  constexpr int M = N * N, S = (N * (N + 1)) / 2;
+  T A[M], B[M], SA[S], SB[S], C0[M], C[M], Cref[M];
+  randomize(A);
+  randomize(B);
+  randomize(SA);
+  randomize(SB);
+  randomize(C0);
+  const T alpha = scale ? -1.375 : 1.0, beta = additive ? 1.0 : 0.0;
+
+  std::copy(C0, C0 + M, C);
+  MatMatMultCoreGen<T, N, opA, opB, scale, additive>(alpha, A, B, C);
+  gemm_ref<N, false, false, opA, opB>(alpha, A, B, beta, C0, Cref);
+  expect_near(C, Cref);
+
+  std::copy(C0, C0 + M, C);
+  SMatMatMultCoreGen<T, N, opB, scale, additive>(alpha, SA, B, C);
+  gemm_ref<N, true, false, opA, opB>(alpha, SA, B, beta, C0, Cref);
+  expect_near(C, Cref);
+
+  std::copy(C0, C0 + M, C);
+  MatSMatMultCoreGen<T, N, opA, scale, additive>(alpha, A, SB, C);
+  gemm_ref<N, false, true, opA, opB>(alpha, A, SB, beta, C0, Cref);
+  expect_near(C, Cref);
+
+  std::copy(C0, C0 + M, C);
+  SMatSMatMultCoreGen<T, N, scale, additive>(alpha, SA, SB, C);
+  gemm_ref<N, true, true, opA, opB>(alpha, SA, SB, beta, C0, Cref);
+  expect_near(C, Cref);
+}
+
+template <int N, bool scale, bool additive>
+void test_gemm_gen_ops() {
+  test_gemm_gen<N, MatOp::NORMAL, MatOp::NORMAL, scale, additive>();
+  test_gemm_gen<N, MatOp::NORMAL, MatOp::TRANSPOSE, scale, additive>();
+  test_gemm_gen<N, MatOp::TRANSPOSE, MatOp::NORMAL, scale, additive>();
+  test_gemm_gen<N, MatOp::TRANSPOSE, MatOp::TRANSPOSE, scale, additive>();
+}
+
+template <int N>
+void test_gemm_gen_all() {
+  test_gemm_gen_ops<N, false, false>();
+  test_gemm_gen_ops<N, true, false>();
+  test_gemm_gen_ops<N, false, true>();
+  test_gemm_gen_ops<N, true, true>();
+}
+
+TEST(test_a2dgencore, gemm) {
+  test_gemm_gen_all<1>();
+  test_gemm_gen_all<2>();
+  test_gemm_gen_all<3>();
+  test_gemm_gen_all<4>();
+}
+
+// det(A) from the Leibniz formula
+template <int N>
+T det_ref(const T A[]) {
+  int p[N];
+  for (int i = 0; i < N; i++) {
+    p[i] = i;
+  }
+  T det = 0.0;
+  do {
+    int inversions = 0;
+    for (int i = 0; i < N; i++) {
+      for (int j = i + 1; j < N; j++) {
+        inversions += (p[i] > p[j]);
+      }
+    }
+    T term = (inversions % 2 ? -1.0 : 1.0);
+    for (int i = 0; i < N; i++) {
+      term *= A[i * N + p[i]];
+    }
+    det += term;
+  } while (std::next_permutation(p, p + N));
+  return det;
+}
+
+template <int N>
+void test_det_gen() {
+  constexpr int M = N * N;
+  const T h = 1e-6, bdet = 0.75, hdet = -1.25;
+  T A[M], Ad[M], A1[M], A2[M], Ab[M], Ab1[M], Ab2[M], Ah[M], Ahref[M];
+  randomize(A);
+  randomize(Ad);
+
+  EXPECT_NEAR((MatDetCore<T, N>(A)), det_ref<N>(A), 1e-14);
+
+  for (int i = 0; i < M; i++) {
+    A1[i] = A[i] + h * Ad[i];
+    A2[i] = A[i] - h * Ad[i];
+    Ab[i] = Ab1[i] = Ab2[i] = Ah[i] = 0.0;
+  }
+  T dref = (det_ref<N>(A1) - det_ref<N>(A2)) / (2.0 * h);
+  EXPECT_NEAR((MatDetForwardCore<T, N>(A, Ad)), dref, 1e-8);
+
+  // The reverse product with the seed Ad is the forward derivative
+  MatDetReverseCore<T, N>(bdet, A, Ab);
+  T dot = 0.0;
+  for (int i = 0; i < M; i++) {
+    dot += Ab[i] * Ad[i];
+  }
+  EXPECT_NEAR(dot, (bdet * MatDetForwardCore<T, N>(A, Ad)), 1e-13);
+
+  // Ah = hdet * d(det)/dA + bdet * d^2(det)/dA^2 * Ad
+  MatDetReverseCore<T, N>(bdet, A1, Ab1);
+  MatDetReverseCore<T, N>(bdet, A2, Ab2);
+  for (int i = 0; i < M; i++) {
+    Ahref[i] = (Ab1[i] - Ab2[i]) / (2.0 * h) + hdet * Ab[i] / bdet;
+  }
+  MatDetHReverseCore<T, N>(bdet, hdet, A, Ad, Ah);
+  expect_near(Ah, Ahref, 1e-8);
+}
+
+template <int N>
+void test_inv_gen() {
+  constexpr int M = N * N, S = (N * (N + 1)) / 2;
+  T A[M], Ainv[M], SA[S], Sinv[S];
+  randomize(A);
+  randomize(SA);
+  for (int i = 0; i < N; i++) {
+    A[i * N + i] += N;
+    SA[i * (i + 1) / 2 + i] += N;
+  }
+
+  MatInvCore<T, N>(A, Ainv);
+  SymMatInvCore<T, N>(SA, Sinv);
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      T I = 0.0, SI = 0.0;
+      for (int k = 0; k < N; k++) {
+        I += A[i * N + k] * Ainv[k * N + j];
+        SI += sym_entry<N>(SA, i, k) * sym_entry<N>(Sinv, k, j);
+      }
+      EXPECT_NEAR(I, i == j ? 1.0 : 0.0, 1e-14);
+      EXPECT_NEAR(SI, i == j ? 1.0 : 0.0, 1e-14);
+    }
+  }
+}
+
+TEST(test_a2dgencore, det_inv) {
+  test_det_gen<1>();
+  test_det_gen<2>();
+  test_det_gen<3>();
+  test_det_gen<4>();
+  test_inv_gen<1>();
+  test_inv_gen<2>();
+  test_inv_gen<3>();
+  test_inv_gen<4>();
+}
+
+// E = 0.5 * (Ux + Ux^{T}) (+ 0.5 * Ux^{T} * Ux)
+template <int N, bool nonlinear>
+void strain_ref(const T Ux[], T E[]) {
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      T value = 0.5 * (Ux[i * N + j] + Ux[j * N + i]);
+      for (int k = 0; nonlinear && k < N; k++) {
+        value += 0.5 * Ux[k * N + i] * Ux[k * N + j];
+      }
+      E[i * (i + 1) / 2 + j] = value;
+    }
+  }
+}
+
+template <int N, bool nonlinear>
+void test_strain_gen() {
+  constexpr int M = N * N, S = (N * (N + 1)) / 2;
+  const T h = 1e-4;
+  T Ux[M], Ud[M], U1[M], U2[M], Ub[M], Ub1[M], Ub2[M], Uh[M], Uhref[M];
+  T Eb[S], Eh[S], E[S], Eref[S], Ed[S], E1[S], E2[S], Edref[S];
+  randomize(Ux);
+  randomize(Ud);
+  randomize(Eb);
+  randomize(Eh);
+  for (int i = 0; i < M; i++) {
+    U1[i] = Ux[i] + h * Ud[i];
+    U2[i] = Ux[i] - h * Ud[i];
+    Ub[i] = Ub1[i] = Ub2[i] = Uh[i] = Uhref[i] = 0.0;
+  }
+
+  strain_ref<N, nonlinear>(Ux, Eref);
+  strain_ref<N, nonlinear>(U1, E1);
+  strain_ref<N, nonlinear>(U2, E2);
+  for (int i = 0; i < S; i++) {
+    Edref[i] = (E1[i] - E2[i]) / (2.0 * h);
+  }
+
+  T dot = 0.0, dref = 0.0;
+  if constexpr (nonlinear) {
+    NonlinearGreenStrainCore<T, N>(Ux, E);
+    NonlinearGreenStrainForwardCore<T, N>(Ux, Ud, Ed);
+    NonlinearGreenStrainReverseCore<T, N>(Ux, Eb, Ub);
+    NonlinearGreenStrainReverseCore<T, N>(U1, Eb, Ub1);
+    NonlinearGreenStrainReverseCore<T, N>(U2, Eb, Ub2);
+    NonlinearGreenStrainHReverseCore<T, N>(Ux, Ud, Eb, Eh, Uh);
+    NonlinearGreenStrainReverseCore<T, N>(Ux, Eh, Uhref);
+  } else {
+    LinearGreenStrainCore<T, N>(Ux, E);
+    LinearGreenStrainForwardCore<T, N>(Ud, Ed);
+    LinearGreenStrainReverseCore<T, N>(Eb, Ub);
+    LinearGreenStrainReverseCore<T, N>(Eb, Ub1);
+    LinearGreenStrainReverseCore<T, N>(Eb, Ub2);
+    LinearGreenStrainHReverseCore<T, N>(Eh, Uh);
+    LinearGreenStrainReverseCore<T, N>(Eh, Uhref);
+  }
+  expect_near(E, Eref);
+  expect_near(Ed, Edref, 1e-10);
+
+  for (int i = 0; i < M; i++) {
+    dot += Ub[i] * Ud[i];
+    Uhref[i] += (Ub1[i] - Ub2[i]) / (2.0 * h);
+  }
+  for (int i = 0; i < S; i++) {
+    dref += Eb[i] * Ed[i];
+  }
+  EXPECT_NEAR(dot, dref, 1e-13);
+  expect_near(Uh, Uhref, 1e-10);
+}
+
+TEST(test_a2dgencore, green_strain) {
+  test_strain_gen<1, false>();
+  test_strain_gen<2, false>();
+  test_strain_gen<3, false>();
+  test_strain_gen<4, false>();
+  test_strain_gen<1, true>();
+  test_strain_gen<2, true>();
+  test_strain_gen<3, true>();
+  test_strain_gen<4, true>();
+}
+
+template <int N>
+void test_isotropic_trace_gen() {
+  constexpr int S = (N * (N + 1)) / 2;
+  const T mu = 0.35, lambda = 0.51, scale = -0.5;
+  T E[S], Sb[S], Sx[S], S0[S], Sref[S], Eb[S], Ebref[S];
+  randomize(E);
+  randomize(Sb);
+  randomize(S0);
+
+  T trE = 0.0, trSb = 0.0, dot = 0.0, trace = 0.0;
+  for (int i = 0; i < N; i++) {
+    trE += E[i * (i + 1) / 2 + i];
+    trSb += Sb[i * (i + 1) / 2 + i];
+    for (int j = 0; j < N; j++) {
+      trace += sym_entry<N>(Sb, i, j) * sym_entry<N>(E, j, i);
+    }
+  }
+  for (int i = 0; i < S; i++) {
+    dot += Sb[i] * E[i];
+  }
+
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      int k = i * (i + 1) / 2 + j;
+      Sref[k] = 2.0 * mu * E[k] + (i == j ? lambda * trE : 0.0);
+      Ebref[k] = S0[k] + (i == j ? 1.0 : 2.0) * scale * Sb[k];
+    }
+  }
+  SymIsotropicCore<T, N>(mu, lambda, E, Sx);
+  expect_near(Sx, Sref);
+
+  std::copy(S0, S0 + S, Sx);
+  SymIsotropicAddCore<T, N>(mu, lambda, E, Sx);
+  for (int i = 0; i < S; i++) {
+    Sref[i] += S0[i];
+  }
+  expect_near(Sx, Sref);
+
+  T mub = 0.0, lambdab = 0.0;
+  SymIsotropicReverseCoefCore<T, N>(E, Sb, mub, lambdab);
+  EXPECT_NEAR(mub, 2.0 * dot, 1e-14);
+  EXPECT_NEAR(lambdab, trSb * trE, 1e-14);
+
+  EXPECT_NEAR((SymMatMultTraceCore<T, N>(Sb, E)), trace, 1e-14);
+  std::copy(S0, S0 + S, Eb);
+  SymMatMultTraceReverseCore<T, N>(scale, Sb, Eb);
+  expect_near(Eb, Ebref);
+}
+
+TEST(test_a2dgencore, isotropic_trace) {
+  test_isotropic_trace_gen<1>();
+  test_isotropic_trace_gen<2>();
+  test_isotropic_trace_gen<3>();
+  test_isotropic_trace_gen<4>();
+}
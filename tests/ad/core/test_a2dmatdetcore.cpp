@@ -77,11 +77,10 @@ void test_mat_det_reverse_core() {
 
   for (int i = 0; i < N; i++) {
     for (int j = 0; j < N; j++) {
-      if (i == j) {
-        EXPECT_DOUBLE_EQ(Ab(i, j), Sb(i, j));
-      } else {
-        EXPECT_DOUBLE_EQ(2.0 * Ab(i, j), Sb(i, j));
-      }
+      // The symmetric kernels combine the repeated entries first, so the
+      // results only agree up to round-off
+      T scale = (i == j ? 1.0 : 2.0);
+      EXPECT_NEAR(scale * Ab(i, j), Sb(i, j), 1e-14);
     }
   }
 }
@@ -113,11 +112,10 @@ void test_mat_det_hreverse_core() {
 
   for (int i = 0; i < N; i++) {
     for (int j = 0; j < N; j++) {
-      if (i == j) {
-        EXPECT_DOUBLE_EQ(Ah(i, j), Sh(i, j));
-      } else {
-        EXPECT_DOUBLE_EQ(2.0 * Ah(i, j), Sh(i, j));
-      }
+      // The symmetric kernels combine the repeated entries first, so the
+      // results only agree up to round-off
+      T scale = (i == j ? 1.0 : 2.0);
+      EXPECT_NEAR(scale * Ah(i, j), Sh(i, j), 1e-14);
     }
   }
 }
@@ -126,22 +124,26 @@ TEST(test_a2dmatdetcore, MatDetCore) {
   test_mat_det_core<1>();
   test_mat_det_core<2>();
   test_mat_det_core<3>();
+  test_mat_det_core<4>();
 }
 
 TEST(test_a2dmatdetcore, MatDetForwardCore) {
   test_mat_det_forward_core<1>();
   test_mat_det_forward_core<2>();
   test_mat_det_forward_core<3>();
+  test_mat_det_forward_core<4>();
 }
 
 TEST(test_a2dmatdetcore, MatDetReverseCore) {
   test_mat_det_reverse_core<1>();
   test_mat_det_reverse_core<2>();
   test_mat_det_reverse_core<3>();
+  test_mat_det_reverse_core<4>();
 }
 
 TEST(test_a2dmatdetcore, MatDetHReverseCore) {
   test_mat_det_hreverse_core<1>();
   test_mat_det_hreverse_core<2>();
   test_mat_det_hreverse_core<3>();
+  test_mat_det_hreverse_core<4>();
 }
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "ad/a2dmat.h"
+#include "ad/a2dobj.h"
+#include "ad/core/a2dmatveccore.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+template <int M, int N, MatOp opA, bool additive>
+void test_mat_vec_core(bool scale) {
+  constexpr int xdim = opA == MatOp::NORMAL ? N : M;
+  constexpr int ydim = opA == MatOp::NORMAL ? M : N;
+
+  Mat<T, M, N> A;
+  Vec<T, xdim> x;
+  Vec<T, ydim> y, y_expect;
+  T alpha = scale ? 1.234 : 1.0;
+
+  for (int i = 0; i < A.ncomp; i++) {
+    A[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+  for (int i = 0; i < xdim; i++) {
+    x[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+  for (int i = 0; i < ydim; i++) {
+    y[i] = y_expect[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+
+  for (int i = 0; i < ydim; i++) {
+    T value = 0.0;
+    for (int j = 0; j < xdim; j++) {
+      value += (opA == MatOp::NORMAL ? A(i, j) : A(j, i)) * x[j];
+    }
+    if constexpr (additive) {
+      y_expect[i] += alpha * value;
+    } else {
+      y_expect[i] = alpha * value;
+    }
+  }
+
+  if (scale) {
+    MatVecCoreScale<T, M, N, opA, additive>(alpha, get_data(A), get_data(x),
+                                            get_data(y));
+  } else {
+    MatVecCore<T, M, N, opA, additive>(get_data(A), get_data(x),
+                                       get_data(y));
+  }
+
+  for (int i = 0; i < ydim; i++) {
+    EXPECT_NEAR(y_expect[i], y[i], 1e-13) << "i: " + std::to_string(i);
+  }
+}
+
+template <int M, int N>
+void run_mat_vec_tests() {
+  for (auto scale : {true, false}) {
+    test_mat_vec_core<M, N, MatOp::NORMAL, false>(scale);
+    test_mat_vec_core<M, N, MatOp::TRANSPOSE, false>(scale);
+    test_mat_vec_core<M, N, MatOp::NORMAL, true>(scale);
+    test_mat_vec_core<M, N, MatOp::TRANSPOSE, true>(scale);
+  }
+}
+
+TEST(test_a2dmatveccore, small_matrices) {
+  run_mat_vec_tests<3, 3>();
+  run_mat_vec_tests<2, 4>();
+}
+
+TEST(test_a2dmatveccore, medium_matrices) {
+  // These use the register-blocked kernel, with partial blocks of rows
+  run_mat_vec_tests<27, 27>();
+  run_mat_vec_tests<64, 24>();
+  run_mat_vec_tests<24, 64>();
+  run_mat_vec_tests<7, 5>();
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "a2dcore.h"
+#include "ad/a2dbsrmat.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+class BSRMatTest : public ::testing::Test {
+ protected:
+  // Structured nx x ny mesh of 4-node quadrilaterals
+  static constexpr index_t nx = 7, ny = 5;
+  static constexpr index_t nnodes = (nx + 1) * (ny + 1);
+  static constexpr index_t nelems = nx * ny;
+  static constexpr index_t nodes_per_elem = 4;
+  static constexpr int M = 2;
+  static constexpr int size = M * nnodes;
+
+  using JacType = Mat<T, M * nodes_per_elem, M * nodes_per_elem>;
+
+  void SetUp() override {
+    conn.resize(nodes_per_elem * nelems);
+    for (index_t j = 0; j < ny; j++) {
+      for (index_t i = 0; i < nx; i++) {
+        index_t* nodes = &conn[nodes_per_elem * (i + nx * j)];
+        nodes[0] = i + (nx + 1) * j;
+        nodes[1] = nodes[0] + 1;
+        nodes[2] = nodes[1] + nx + 1;
+        nodes[3] = nodes[0] + nx + 1;
+      }
+    }
+
+    jac.resize(nelems);
+    for (index_t e = 0; e < nelems; e++) {
+      for (int i = 0; i < JacType::ncomp; i++) {
+        jac[e][i] = -1.0 + 2.0 * rand() / RAND_MAX;
+      }
+    }
+  }
+
+  // Dense serial assembly of the element matrices
+  std::vector<T> assemble_dense() {
+    std::vector<T> A(size * size, 0.0);
+    for (index_t e = 0; e < nelems; e++) {
+      const index_t* nodes = &conn[nodes_per_elem * e];
+      for (int i = 0; i < M * nodes_per_elem; i++) {
+        for (int j = 0; j < M * nodes_per_elem; j++) {
+          index_t row = M * nodes[i / M] + i % M;
+          index_t col = M * nodes[j / M] + j % M;
+          A[size * row + col] += jac[e](i, j);
+        }
+      }
+    }
+    return A;
+  }
+
+  std::vector<index_t> conn;
+  std::vector<JacType> jac;
+};
+
+TEST_F(BSRMatTest, Pattern) {
+  BSRMat<T, M> mat(nnodes, nelems, nodes_per_elem, conn.data());
+
+  // Each node is coupled to its (up to 3 x 3) neighbors on the grid
+  index_t nblocks = 0;
+  for (index_t j = 0; j <= ny; j++) {
+    for (index_t i = 0; i <= nx; i++) {
+      index_t n = i + (nx + 1) * j;
+      index_t ncols = (1 + (i > 0) + (i < nx)) * (1 + (j > 0) + (j < ny));
+      EXPECT_EQ(mat.rowp[n + 1] - mat.rowp[n], ncols);
+      nblocks += ncols;
+
+      for (index_t jp = mat.rowp[n] + 1; jp < mat.rowp[n + 1]; jp++) {
+        EXPECT_LT(mat.cols[jp - 1], mat.cols[jp]);
+      }
+      EXPECT_NE(mat.find_block(n, n), NO_INDEX);
+    }
+  }
+  EXPECT_EQ(mat.get_num_blocks(), nblocks);
+  EXPECT_EQ(mat.find_block(0, nx + 3), NO_INDEX);
+}
+
+TEST_F(BSRMatTest, Coloring) {
+  ElementColoring coloring(nnodes, nelems, nodes_per_elem, conn.data());
+
+  // A structured quadrilateral mesh needs four colors
+  EXPECT_EQ(coloring.get_num_colors(), 4);
+
+  // Every element appears once and no two elements of a color share a node
+  std::vector<int> count(nelems, 0);
+  for (index_t c = 0; c < coloring.get_num_colors(); c++) {
+    std::vector<int> used(nnodes, 0);
+    for (index_t k = coloring.color_ptr[c]; k < coloring.color_ptr[c + 1];
+         k++) {
+      index_t e = coloring.elems[k];
+      EXPECT_EQ(coloring.color[e], c);
+      count[e]++;
+      for (index_t i = 0; i < nodes_per_elem; i++) {
+        EXPECT_EQ(used[conn[nodes_per_elem * e + i]]++, 0);
+      }
+    }
+  }
+  for (index_t e = 0; e < nelems; e++) {
+    EXPECT_EQ(count[e], 1);
+  }
+}
+
+TEST_F(BSRMatTest, AssembleAndMult) {
+  std::vector<T> A = assemble_dense();
+  std::vector<T> x(size), y_ref(size, 0.0);
+  for (int i = 0; i < size; i++) {
+    x[i] = -1.0 + 2.0 * rand() / RAND_MAX;
+  }
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      y_ref[i] += A[size * i + j] * x[j];
+    }
+  }
+
+  ThreadPool pool(3);
+  ElementColoring coloring(nnodes, nelems, nodes_per_elem, conn.data());
+  BSRMat<T, M> mat(nnodes, nelems, nodes_per_elem, conn.data());
+
+  // Assembling twice after zeroing gives the same values
+  for (index_t chunk : {0, 1}) {
+    mat.zero();
+    EXPECT_TRUE(
+        mat.add_values(pool, coloring, conn.data(), jac.data(), chunk));
+
+    for (index_t i = 0; i < nnodes; i++) {
+      for (index_t jp = mat.rowp[i]; jp < mat.rowp[i + 1]; jp++) {
+        index_t j = mat.cols[jp];
+        for (int k = 0; k < M; k++) {
+          for (int l = 0; l < M; l++) {
+            EXPECT_NEAR(mat.vals[jp](k, l),
+                        A[size * (M * i + k) + M * j + l], 1e-14);
+          }
+        }
+      }
+    }
+
+    std::vector<T> y(size), y_serial(size);
+    mat.mult(pool, x.data(), y.data(), chunk);
+    mat.mult(x.data(), y_serial.data());
+    for (int i = 0; i < size; i++) {
+      EXPECT_NEAR(y[i], y_ref[i], 1e-13);
+      EXPECT_EQ(y[i], y_serial[i]);
+    }
+  }
+}
+
+TEST_F(BSRMatTest, AddElementOutsidePattern) {
+  BSRMat<T, M> mat(nnodes, nelems, nodes_per_elem, conn.data());
+
+  // Nodes 0 and nnodes - 1 share no element, and nnodes is not a node
+  const index_t nodes[] = {0, nnodes - 1, nnodes, 1};
+  EXPECT_FALSE(mat.add_element(nodes, jac[0]));
+
+  // The blocks that are in the pattern are still added
+  index_t jp = mat.find_block(0, 1);
+  ASSERT_NE(jp, NO_INDEX);
+  for (int k = 0; k < M; k++) {
+    for (int l = 0; l < M; l++) {
+      EXPECT_EQ(mat.vals[jp](k, l), jac[0](k, M * 3 + l));
+    }
+  }
+  EXPECT_EQ(mat.find_block(nnodes, 0), NO_INDEX);
+  EXPECT_EQ(mat.find_block(0, nnodes - 1), NO_INDEX);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "a2dcore.h"
+
+using namespace A2D;
+
+constexpr int N = 3;
+using T = double;
+using M = Mat<T, N, N>;
+
+TEST(test_a2dcost, MatMatMult) {
+  // 27 multiply-adds for each product of 3 x 3 matrices
+  using Active = MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, ADObj<M>,
+                                ADObj<M>, ADObj<M>>;
+  using Cost = OpCost<Active>;
+  static_assert(Cost::known);
+  static_assert(Cost::eval.flops == 54);
+  static_assert(Cost::eval.bytes == 27 * sizeof(T));
+  static_assert(Cost::forward.flops == 2 * 54);
+  static_assert(Cost::reverse.flops == 2 * 54);
+  static_assert(Cost::hreverse.flops == 4 * 54);
+
+  // Only the derivative of the active input is computed
+  using Passive = MatMatMultExpr<MatOp::NORMAL, MatOp::TRANSPOSE, const M,
+                                 A2DObj<M>, A2DObj<M>>;
+  static_assert(OpCost<Passive>::forward.flops == 54);
+  static_assert(OpCost<Passive>::hreverse.flops == 54);
+
+  // Rectangular products count the inner dimension of op(A)
+  using R = MatMatMultExpr<MatOp::TRANSPOSE, MatOp::NORMAL,
+                           ADObj<Mat<T, 4, 2>>, ADObj<Mat<T, 4, 3>>,
+                           ADObj<Mat<T, 2, 3>>>;
+  static_assert(OpCost<R>::eval.flops == 2 * 2 * 3 * 4);
+
+  // Operations on Mat<float> touch half as many bytes
+  using MF = ADObj<Mat<float, N, N>>;
+  using F = MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, MF, MF, MF>;
+  static_assert(2 * OpCost<F>::eval.bytes == Cost::eval.bytes);
+}
+
+TEST(test_a2dcost, MatInv) {
+  // Generated closed form for N = 3, LU with pivoting beyond
+  static_assert(OpCost<MatInvExpr<const M, M>>::eval.flops == 45);
+  using M4 = Mat<T, 4, 4>;
+  using Inv4 = OpCost<MatInvExpr<ADObj<M4>, ADObj<M4>>>;
+  static_assert(Inv4::eval.flops == 2 * 4 * 4 * 4);
+  static_assert(Inv4::forward.flops == 2 * 2 * 4 * 4 * 4);
+}
+
+TEST(test_a2dcost, Stack) {
+  M Jp, Jinv;
+  A2DObj<M> Uxi, Ux;
+  A2DObj<SymMat<T, N>> E, S;
+  A2DObj<T> output;
+
+  auto stack = MakeStack(MatInv(Jp, Jinv), MatMatMult(Uxi, Jinv, Ux),
+                         SymMatSum(T(0.5), Ux, E),
+                         SymIsotropic(T(0.35), T(0.51), E, S),
+                         SymMatMultTrace(E, S, output));
+  using Cost = OpCost<decltype(stack)>;
+  using Inv = OpCost<MatInvExpr<const M, M>>;
+  using Mult = OpCost<decltype(MatMatMult(Uxi, Jinv, Ux))>;
+  static_assert(Cost::known);
+
+  // The passive inverse only contributes to eval
+  static_assert(Cost::eval.flops > Inv::eval.flops + Mult::eval.flops);
+  static_assert(Cost::forward.flops > Mult::forward.flops);
+  static_assert(Cost::hproduct.flops ==
+                Cost::forward.flops + Cost::reverse.flops +
+                    Cost::hreverse.flops);
+  static_assert(Cost::hproduct.bytes ==
+                Cost::forward.bytes + Cost::reverse.bytes +
+                    Cost::hreverse.bytes);
+
+  auto active = MakeStack(MatMatMult(Uxi, Jinv, Ux), SymMatSum(T(0.5), Ux, E),
+                          SymIsotropic(T(0.35), T(0.51), E, S),
+                          SymMatMultTrace(E, S, output));
+  using ActiveCost = OpCost<decltype(active)>;
+  static_assert(ActiveCost::forward.flops == Cost::forward.flops);
+  static_assert(ActiveCost::eval.flops + Inv::eval.flops == Cost::eval.flops);
+
+  EXPECT_GT(Cost::hproduct.intensity(), 0.0);
+  EXPECT_LT(Cost::hproduct.intensity(), 1.0);
+
+  // A stack with an operation without a model is unknown
+  A2DObj<Vec<T, N>> eigs;
+  auto unknown = MakeStack(SymEigs(S, eigs), SymMatSum(T(0.5), Ux, E));
+  static_assert(!OpCost<decltype(unknown)>::known);
+}
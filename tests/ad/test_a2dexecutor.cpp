@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "a2dcore.h"
+#include "ad/a2dexecutor.h"
+#include "test_commons.h"
+#include "test_energies.h"
+
+using namespace A2D;
+
+using DataType = Vec<T, 1>;
+using GeoType = Mat<T, 3, 3>;
+using StateType = Mat<T, 3, 3>;
+
+class ExecutorTest : public ::testing::Test {
+ protected:
+  static constexpr index_t nelems = 103;
+
+  void SetUp() override {
+    data.resize(nelems);
+    geo.resize(nelems);
+    state.resize(nelems);
+    dir.resize(nelems);
+    for (index_t e = 0; e < nelems; e++) {
+      RandomStrainEnergyElement(data[e], geo[e], state[e], dir[e]);
+    }
+  }
+
+  std::vector<DataType> data;
+  std::vector<GeoType> geo;
+  std::vector<StateType> state;
+  std::vector<StateType> dir;
+};
+
+TEST_F(ExecutorTest, ThreadPoolCoversRange) {
+  ThreadPool pool(4);
+  for (index_t chunk : {0, 1, 5, 200}) {
+    std::vector<std::atomic<int>> count(nelems);
+    pool.parallel_for(nelems, chunk, [&](int tid, index_t start, index_t end) {
+      for (index_t i = start; i < end; i++) {
+        count[i]++;
+      }
+    });
+    for (index_t i = 0; i < nelems; i++) {
+      EXPECT_EQ(count[i], 1);
+    }
+  }
+}
+
+TEST_F(ExecutorTest, JacobianProduct) {
+  // Serial reference
+  std::vector<StateType> res_ref(nelems);
+  for (index_t e = 0; e < nelems; e++) {
+    A2DObj<DataType> d(data[e]);
+    A2DObj<GeoType> g(geo[e]);
+    A2DObj<StateType> s(state[e]);
+    auto build = MakeStrainEnergyBuilder<T>();
+    auto stack = build(d, g, s);
+    JacobianProduct<FEVarType::STATE, FEVarType::STATE>(stack, d, g, s,
+                                                        dir[e], res_ref[e]);
+  }
+
+  ThreadPool pool(4);
+  for (index_t chunk : {0, 1, 7}) {
+    std::vector<StateType> res(nelems);
+    JacobianProduct<FEVarType::STATE, FEVarType::STATE>(
+        pool, nelems, data.data(), geo.data(), state.data(), dir.data(),
+        res.data(), MakeStrainEnergyBuilder<T>(), chunk);
+
+    for (index_t e = 0; e < nelems; e++) {
+      for (int i = 0; i < 9; i++) {
+        EXPECT_NEAR(res[e][i], res_ref[e][i], 1e-14);
+      }
+    }
+  }
+}
+
+TEST_F(ExecutorTest, ExtractJacobian) {
+  using JacType = Mat<T, 9, 9>;
+
+  // Serial reference
+  std::vector<JacType> jac_ref(nelems);
+  for (index_t e = 0; e < nelems; e++) {
+    A2DObj<DataType> d(data[e]);
+    A2DObj<GeoType> g(geo[e]);
+    A2DObj<StateType> s(state[e]);
+    auto build = MakeStrainEnergyBuilder<T>();
+    auto stack = build(d, g, s);
+    ExtractJacobian<FEVarType::STATE, FEVarType::GEOMETRY>(stack, d, g, s,
+                                                           jac_ref[e]);
+  }
+
+  ThreadPool pool(3);
+  std::vector<JacType> jac(nelems);
+  ExtractJacobian<FEVarType::STATE, FEVarType::GEOMETRY>(
+      pool, nelems, data.data(), geo.data(), state.data(), jac.data(),
+      MakeStrainEnergyBuilder<T>(), 4);
+
+  for (index_t e = 0; e < nelems; e++) {
+    for (int i = 0; i < 81; i++) {
+      EXPECT_NEAR(jac[e][i], jac_ref[e][i], 1e-13);
+    }
+  }
+}
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "a2dcore.h"
+#include "ad/a2dexecutor.h"
+#include "ad/a2dgeocache.h"
+#include "test_commons.h"
+#include "test_energies.h"
+
+using namespace A2D;
+
+using DataType = Vec<T, 1>;
+using GeoType = Mat<T, 3, 3>;
+using StateType = Mat<T, 3, 3>;
+
+class GeometryCacheTest : public ::testing::Test {
+ protected:
+  static constexpr index_t nelems = 37;
+
+  GeometryCacheTest() : geo(nelems) {}
+
+  void SetUp() override {
+    data.resize(nelems);
+    state.resize(nelems);
+    dir.resize(nelems);
+    auto J = geo.modify();
+    for (index_t e = 0; e < nelems; e++) {
+      RandomStrainEnergyElement(data[e], J[e], state[e], dir[e]);
+    }
+  }
+
+  void check_factors(const GeometryFactorCache<T, 3>& cache) {
+    for (index_t e = 0; e < nelems; e++) {
+      Mat<T, 3, 3> Jinv;
+      T detJ;
+      MatInv(geo[e], Jinv);
+      MatDet(geo[e], detJ);
+      const GeometryFactors<T, 3>* f = cache.get_factors(e);
+      for (int i = 0; i < 9; i++) {
+        EXPECT_NEAR(f[0].Jinv[i], Jinv[i], 1e-14);
+      }
+      EXPECT_NEAR(f[0].detJ, detJ, 1e-14);
+    }
+  }
+
+  std::vector<DataType> data;
+  VersionedArray<GeoType> geo;
+  std::vector<StateType> state;
+  std::vector<GeoType> dir;
+};
+
+TEST_F(GeometryCacheTest, UpdatesWithGeometry) {
+  GeometryFactorCache<T, 3> cache(nelems);
+  EXPECT_FALSE(cache.is_current(geo));
+  EXPECT_TRUE(cache.update(geo));
+  EXPECT_FALSE(cache.update(geo));
+  check_factors(cache);
+
+  // A write to the geometry invalidates the factors
+  geo.modify()[5](0, 0) += 0.25;
+  EXPECT_FALSE(cache.is_current(geo));
+  ThreadPool pool(3);
+  EXPECT_TRUE(cache.update(pool, geo));
+  check_factors(cache);
+
+  GeoType J = geo[2];
+  J(1, 1) -= 0.125;
+  geo.set(2, J);
+  EXPECT_FALSE(cache.is_current(geo));
+  EXPECT_TRUE(cache.update(geo));
+  check_factors(cache);
+
+  // Writes made while the modifier is alive invalidate an update made in
+  // between once the modifier goes out of scope
+  {
+    auto mod = geo.modify();
+    mod[7](2, 0) = 0.03;
+    EXPECT_TRUE(cache.update(geo));
+    mod[7](0, 2) = -0.02;
+  }
+  EXPECT_FALSE(cache.is_current(geo));
+  EXPECT_TRUE(cache.update(geo));
+  check_factors(cache);
+
+  cache.invalidate();
+  EXPECT_TRUE(cache.update(geo));
+}
+
+TEST_F(GeometryCacheTest, SizeMismatch) {
+  // A geometry array shorter or longer than the cache is rejected
+  ThreadPool pool(2);
+  GeometryFactorCache<T, 3> larger(nelems + 1), smaller(nelems - 1);
+  EXPECT_THROW(larger.update(geo), std::invalid_argument);
+  EXPECT_THROW(larger.update(pool, geo), std::invalid_argument);
+  EXPECT_THROW(smaller.update(geo), std::invalid_argument);
+  EXPECT_FALSE(larger.is_current(geo));
+}
+
+TEST_F(GeometryCacheTest, CachedExprsMatchMatInvMatDet) {
+  GeometryFactorCache<T, 3> cache(nelems);
+  cache.update(geo);
+  const GeometryFactors<T, 3>* f = cache.get_factors(3);
+
+  A2DObj<GeoType> J(geo[3]), Jc(geo[3]);
+  A2DObj<Mat<T, 3, 3>> Jinv, Jinvc;
+  A2DObj<T> det, detc;
+  auto stack = MakeStack(MatInv(J, Jinv), MatDet(J, det));
+  auto cached = MakeStack(CachedMatInv(Jc, f[0].Jinv, Jinvc),
+                          CachedMatDet(Jc, f[0].detJ, detc));
+
+  // With a passive geometry, the cached inverse is only evaluated
+  static_assert(is_passive_op<decltype(CachedMatInv(
+                    geo[3], f[0].Jinv, Jinvc))>::value,
+                "Cached inverse of a passive matrix must be passive");
+
+  for (int i = 0; i < 9; i++) {
+    Jinv.bvalue()[i] = Jinvc.bvalue()[i] = -1.0 + 2.0 * rand() / RAND_MAX;
+    Jinv.hvalue()[i] = Jinvc.hvalue()[i] = -1.0 + 2.0 * rand() / RAND_MAX;
+    J.pvalue()[i] = Jc.pvalue()[i] = -1.0 + 2.0 * rand() / RAND_MAX;
+  }
+  det.bvalue() = detc.bvalue() = 0.7;
+  det.hvalue() = detc.hvalue() = -0.3;
+  stack.reverse();
+  stack.hforward();
+  stack.hreverse();
+  cached.reverse();
+  cached.hforward();
+  cached.hreverse();
+
+  EXPECT_NEAR(detc.value(), det.value(), 1e-14);
+  EXPECT_NEAR(detc.pvalue(), det.pvalue(), 1e-14);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_NEAR(Jinvc.value()[i], Jinv.value()[i], 1e-14);
+    EXPECT_NEAR(Jinvc.pvalue()[i], Jinv.pvalue()[i], 1e-14);
+    EXPECT_NEAR(Jc.bvalue()[i], J.bvalue()[i], 1e-14);
+    EXPECT_NEAR(Jc.hvalue()[i], J.hvalue()[i], 1e-13);
+  }
+}
+
+TEST_F(GeometryCacheTest, ExecutorMatchesUncached) {
+  ThreadPool pool(3);
+  GeometryFactorCache<T, 3> cache(nelems);
+
+  // State-only Jacobians, with the geometry passive in the stacks
+  using JacType = Mat<T, 9, 9>;
+  std::vector<JacType> jac(nelems), jac_ref(nelems);
+  ExtractJacobian<FEVarType::STATE, FEVarType::STATE>(
+      pool, nelems, data.data(), geo.data(), state.data(), jac_ref.data(),
+      MakeStrainEnergyBuilder<T>());
+  ExtractJacobian<FEVarType::STATE, FEVarType::STATE>(
+      pool, nelems, data.data(), geo, state.data(), jac.data(),
+      MakeCachedStrainEnergyBuilder<T>(), cache);
+  EXPECT_TRUE(cache.is_current(geo));
+  for (index_t e = 0; e < nelems; e++) {
+    for (int i = 0; i < JacType::ncomp; i++) {
+      EXPECT_NEAR(jac[e][i], jac_ref[e][i], 1e-13);
+    }
+  }
+
+  // Geometry derivatives, after the geometry has changed
+  geo.modify()[0](1, 2) = 0.05;
+  std::vector<StateType> res(nelems), res_ref(nelems);
+  JacobianProduct<FEVarType::STATE, FEVarType::GEOMETRY>(
+      pool, nelems, data.data(), geo.data(), state.data(), dir.data(),
+      res_ref.data(), MakeStrainEnergyBuilder<T>());
+  JacobianProduct<FEVarType::STATE, FEVarType::GEOMETRY>(
+      pool, nelems, data.data(), geo, state.data(), dir.data(), res.data(),
+      MakeCachedStrainEnergyBuilder<T>(), cache);
+  for (index_t e = 0; e < nelems; e++) {
+    for (int i = 0; i < StateType::ncomp; i++) {
+      EXPECT_NEAR(res[e][i], res_ref[e][i], 1e-13);
+    }
+  }
+
+  ExtractJacobian<FEVarType::GEOMETRY, FEVarType::GEOMETRY>(
+      pool, nelems, data.data(), geo.data(), state.data(), jac_ref.data(),
+      MakeStrainEnergyBuilder<T>());
+  ExtractJacobian<FEVarType::GEOMETRY, FEVarType::GEOMETRY>(
+      pool, nelems, data.data(), geo, state.data(), jac.data(),
+      MakeCachedStrainEnergyBuilder<T>(), cache);
+  for (index_t e = 0; e < nelems; e++) {
+    for (int i = 0; i < JacType::ncomp; i++) {
+      EXPECT_NEAR(jac[e][i], jac_ref[e][i], 1e-12);
+    }
+  }
+}
+
+TEST_F(GeometryCacheTest, QuadraturePoints) {
+  // The mapping Jacobian at point q is (q + 1) times the element geometry
+  auto jacobian = [](const GeoType& g, index_t q, Mat<T, 3, 3>& J) {
+    for (int i = 0; i < 9; i++) {
+      J[i] = (q + 1.0) * g[i];
+    }
+  };
+  GeometryFactorCache<T, 3, decltype(jacobian)> cache(nelems, 2, jacobian);
+  EXPECT_TRUE(cache.update(geo));
+  for (index_t e = 0; e < nelems; e++) {
+    Mat<T, 3, 3> Jinv;
+    T detJ;
+    MatInv(geo[e], Jinv);
+    MatDet(geo[e], detJ);
+    const GeometryFactors<T, 3>* f = cache.get_factors(e);
+    for (int q = 0; q < 2; q++) {
+      for (int i = 0; i < 9; i++) {
+        EXPECT_NEAR(f[q].Jinv[i], Jinv[i] / (q + 1.0), 1e-14);
+      }
+      EXPECT_NEAR(f[q].detJ, detJ * (q + 1.0) * (q + 1.0) * (q + 1.0),
+                  1e-13);
+    }
+  }
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "a2dcore.h"
+#include "ad/a2dbsrmat.h"
+#include "ad/a2dhessianop.h"
+#include "test_commons.h"
+#include "test_energies.h"
+
+using namespace A2D;
+
+constexpr index_t nodes_per_elem = 4;
+constexpr int M = 2;
+
+using DataType = Vec<T, 1>;
+using GeoType = Mat<T, nodes_per_elem, M>;
+using StateType = Mat<T, nodes_per_elem, M>;
+using JacType = Mat<T, M * nodes_per_elem, M * nodes_per_elem>;
+
+// Nonlinear strain energy of an element in terms of its nodal displacements
+auto make_builder() {
+  return MakeNodalStrainEnergyBuilder<T, nodes_per_elem, M,
+                                            GreenStrainType::NONLINEAR>();
+}
+
+// The same stack through a lambda, which has no hook for the cache
+auto make_lambda_builder() {
+  return [build = make_builder()](auto& data, auto& geo,
+                                  auto& state) mutable {
+    return build(data, geo, state);
+  };
+}
+
+class HessianOperatorTest : public ::testing::Test {
+ protected:
+  // Structured nx x ny mesh of 4-node quadrilaterals
+  static constexpr index_t nx = 6, ny = 5;
+  static constexpr index_t nnodes = (nx + 1) * (ny + 1);
+  static constexpr index_t nelems = nx * ny;
+  static constexpr index_t size = M * nnodes;
+
+  void SetUp() override {
+    conn.resize(nodes_per_elem * nelems);
+    for (index_t j = 0; j < ny; j++) {
+      for (index_t i = 0; i < nx; i++) {
+        index_t* nodes = &conn[nodes_per_elem * (i + nx * j)];
+        nodes[0] = i + (nx + 1) * j;
+        nodes[1] = nodes[0] + 1;
+        nodes[2] = nodes[1] + nx + 1;
+        nodes[3] = nodes[0] + nx + 1;
+      }
+    }
+
+    data.resize(nelems);
+    geo.resize(nelems);
+    for (index_t e = 0; e < nelems; e++) {
+      data[e](0) = 1.0;
+      for (int i = 0; i < GeoType::ncomp; i++) {
+        geo[e][i] = -1.0 + 2.0 * rand() / RAND_MAX;
+      }
+    }
+  }
+
+  std::vector<T> random_vector() {
+    std::vector<T> x(size);
+    for (index_t i = 0; i < size; i++) {
+      x[i] = -0.5 + 1.0 * rand() / RAND_MAX;
+    }
+    return x;
+  }
+
+  // Reference product with the assembled Hessian at x
+  template <class Builder>
+  std::vector<T> assembled_product(ThreadPool& pool, const std::vector<T>& x,
+                                   const std::vector<T>& p,
+                                   const Builder& build) {
+    std::vector<StateType> state(nelems);
+    for (index_t e = 0; e < nelems; e++) {
+      for (int i = 0; i < nodes_per_elem; i++) {
+        for (int k = 0; k < M; k++) {
+          state[e](i, k) = x[M * conn[nodes_per_elem * e + i] + k];
+        }
+      }
+    }
+    std::vector<JacType> jac(nelems);
+    ExtractJacobian<FEVarType::STATE, FEVarType::STATE>(
+        pool, nelems, data.data(), geo.data(), state.data(), jac.data(),
+        build);
+
+    ElementColoring coloring(nnodes, nelems, nodes_per_elem, conn.data());
+    BSRMat<T, M> mat(nnodes, nelems, nodes_per_elem, conn.data());
+    mat.add_values(pool, coloring, conn.data(), jac.data());
+
+    std::vector<T> y(size);
+    mat.mult(p.data(), y.data());
+    return y;
+  }
+
+  // Compare the products of the operator, with and without the cache, to
+  // those of the assembled Hessian
+  template <class Builder>
+  void check_products(const Builder& build) {
+    ThreadPool pool(3);
+    for (bool cache : {false, true}) {
+      SCOPED_TRACE(cache ? "cache" : "no cache");
+      auto hess = MakeHessianOperator<StateType>(
+          pool, nnodes, nelems, conn.data(), data.data(), geo.data(), build,
+          cache);
+      EXPECT_EQ(hess.get_size(), size);
+
+      // Successive products at the same point, then at a new point
+      for (int point = 0; point < 2; point++) {
+        std::vector<T> x = random_vector();
+        hess.linearize(x.data());
+
+        for (int dir = 0; dir < 3; dir++) {
+          std::vector<T> p = random_vector(), y(size);
+          hess.mult(p.data(), y.data());
+
+          std::vector<T> y_ref = assembled_product(pool, x, p, build);
+          for (index_t i = 0; i < size; i++) {
+            EXPECT_NEAR(y[i], y_ref[i], 1e-12);
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<index_t> conn;
+  std::vector<DataType> data;
+  std::vector<GeoType> geo;
+};
+
+TEST_F(HessianOperatorTest, MatchesAssembled) {
+  check_products(make_builder());
+}
+
+// SymEigs keeps its eigenvectors from eval(), which the cache must restore
+TEST_F(HessianOperatorTest, MatchesAssembledSymEigs) {
+  check_products(PrincipalStrainEnergyBuilder<T, nodes_per_elem, M>());
+}
+
+TEST_F(HessianOperatorTest, CacheRequiresHook) {
+  ThreadPool pool(1);
+  auto build = make_lambda_builder();
+  EXPECT_THROW(MakeHessianOperator<StateType>(pool, nnodes, nelems,
+                                              conn.data(), data.data(),
+                                              geo.data(), build, true),
+               std::invalid_argument);
+  EXPECT_NO_THROW(MakeHessianOperator<StateType>(
+      pool, nnodes, nelems, conn.data(), data.data(), geo.data(), build));
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include "a2dcore.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+// Random matrix close to the identity
+template <int N>
+Mat<double, N, N> random_mat() {
+  Mat<double, N, N> A;
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      A(i, j) = (i == j) + 0.25 * static_cast<double>(rand()) / RAND_MAX;
+    }
+  }
+  return A;
+}
+
+// Compute the Hessian of the strain energy with respect to Ux
+template <typename T, int N, class Jacobian>
+void strain_energy_hessian(const Mat<double, N, N>& Ux0, Jacobian& jac) {
+  const double mu(0.197), lambda(0.839);
+  A2DObj<Mat<T, N, N>> Ux;
+  A2DObj<SymMat<T, N>> E, S;
+  A2DObj<T> output;
+  Ux.value().copy(Ux0);
+
+  auto stack = MakeStack(MatGreenStrain<GreenStrainType::NONLINEAR>(Ux, E),
+                         SymIsotropic(mu, lambda, E, S),
+                         SymMatMultTrace(E, S, output));
+
+  output.bvalue() = 1.0;
+  stack.hextract(Ux.pvalue(), Ux.hvalue(), jac);
+}
+
+template <int N, int K>
+void test_vector_mode_hextract() {
+  constexpr int ncomp = N * N;
+  Mat<double, N, N> Ux0 = random_mat<N>();
+
+  Mat<double, ncomp, ncomp> jac, jac_batch;
+  strain_energy_hessian<double, N>(Ux0, jac);
+  strain_energy_hessian<Batch<double, K>, N>(Ux0, jac_batch);
+
+  for (int i = 0; i < ncomp; i++) {
+    for (int j = 0; j < ncomp; j++) {
+      EXPECT_NEAR(jac(i, j), jac_batch(i, j), 1e-14);
+    }
+  }
+}
+
+TEST(test_a2dhextract, VectorModeHExtract) {
+  test_vector_mode_hextract<2, 4>();
+  test_vector_mode_hextract<3, 2>();
+  test_vector_mode_hextract<3, 4>();
+  test_vector_mode_hextract<3, 8>();
+}
+
+// Mixed second derivative of the energy with respect to state and geometry
+template <typename T, class Jacobian>
+void mixed_hessian(const Mat<double, 3, 3>& J0, const Mat<double, 3, 3>& Ux0,
+                   Jacobian& jac) {
+  const double mu(0.197), lambda(0.839);
+  A2DObj<Vec<T, 1>> data;
+  A2DObj<Mat<T, 3, 3>> J, Ux, Jinv, F;
+  A2DObj<SymMat<T, 3>> E, S;
+  A2DObj<T> output;
+  J.value().copy(J0);
+  Ux.value().copy(Ux0);
+
+  auto stack = MakeStack(MatInv(J, Jinv), MatMatMult(Ux, Jinv, F),
+                         MatGreenStrain<GreenStrainType::NONLINEAR>(F, E),
+                         SymIsotropic(mu, lambda, E, S),
+                         SymMatMultTrace(E, S, output));
+
+  output.bvalue() = 1.0;
+  ExtractJacobian<FEVarType::STATE, FEVarType::GEOMETRY>(stack, data, J, Ux,
+                                                         jac);
+}
+
+TEST(test_a2dhextract, VectorModeExtractJacobian) {
+  Mat<double, 3, 3> J0 = random_mat<3>();
+  Mat<double, 3, 3> Ux0 = random_mat<3>();
+
+  Mat<double, 9, 9> jac, jac_batch;
+  mixed_hessian<double>(J0, Ux0, jac);
+  mixed_hessian<Batch<double, 4>>(J0, Ux0, jac_batch);
+
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 9; j++) {
+      EXPECT_NEAR(jac(i, j), jac_batch(i, j), 1e-13);
+    }
+  }
+}
+
+// Hessian of the linear strain energy, using the sparsity pattern if given
+template <typename T, int N, class Jacobian, class... Colouring>
+void linear_strain_energy_hessian(const Mat<double, N, N>& Ux0, Jacobian& jac,
+                                  const Colouring&... colouring) {
+  const double mu(0.197), lambda(0.839);
+  A2DObj<Vec<T, 1>> data;
+  A2DObj<Mat<T, N, N>> geo, Ux;
+  A2DObj<SymMat<T, N>> E, S;
+  A2DObj<T> output;
+  Ux.value().copy(Ux0);
+
+  auto stack = MakeStack(MatGreenStrain<GreenStrainType::LINEAR>(Ux, E),
+                         SymIsotropic(mu, lambda, E, S),
+                         SymMatMultTrace(E, S, output));
+
+  output.bvalue() = 1.0;
+  ExtractJacobian<FEVarType::STATE, FEVarType::STATE>(stack, data, geo, Ux,
+                                                      colouring..., jac);
+}
+
+template <int N>
+constexpr auto linear_strain_energy_pattern() {
+  return SparsityCongruence(
+      MatGreenStrainSparsity<GreenStrainType::LINEAR, N>(),
+      SymIsotropicSparsity<N>());
+}
+
+TEST(test_a2dhextract, SparsityColouring) {
+  // Off-diagonal pairs Ux(i, j), Ux(j, i) share the colours of the diagonal
+  constexpr JacobianColouring<4, 4> colouring2(
+      linear_strain_energy_pattern<2>());
+  constexpr JacobianColouring<9, 9> colouring3(
+      linear_strain_energy_pattern<3>());
+  static_assert(colouring2.ncolours == 2);
+  static_assert(colouring3.ncolours == 3);
+
+  // The nonlinear strain couples all the entries of Ux
+  constexpr auto J = MatGreenStrainSparsity<GreenStrainType::NONLINEAR, 3>();
+  constexpr auto H = SparsityUnion(
+      SparsityCongruence(J, SymIsotropicSparsity<3>()),
+      MatGreenStrainHessianSparsity<GreenStrainType::NONLINEAR, 3>());
+  static_assert(H.nnz() == 81);
+  static_assert(JacobianColouring<9, 9>(H).ncolours == 9);
+
+  constexpr auto x = MatColumnToVecSparsity<3, 2>(1);
+  static_assert(x.nnz() == 3 && x(0, 1) && x(1, 3) && x(2, 5));
+  constexpr auto y = SymMatColumnToVecSparsity<3>(1);
+  static_assert(y.nnz() == 3 && y(0, 1) && y(1, 2) && y(2, 4));
+  static_assert(MatSumSparsity<SymMat<double, 3>>().nnz() == 6);
+  static_assert(JacobianColouring<4, 4>(VecHadamardSparsity<4>()).ncolours ==
+                1);
+}
+
+template <int N, class Scalar>
+void test_coloured_extract_jacobian() {
+  constexpr int ncomp = N * N;
+  constexpr JacobianColouring<ncomp, ncomp> colouring(
+      linear_strain_energy_pattern<N>());
+  Mat<double, N, N> Ux0 = random_mat<N>();
+
+  Mat<double, ncomp, ncomp> jac, jac_sparse;
+  linear_strain_energy_hessian<double, N>(Ux0, jac);
+  linear_strain_energy_hessian<Scalar, N>(Ux0, jac_sparse, colouring);
+
+  for (int i = 0; i < ncomp; i++) {
+    for (int j = 0; j < ncomp; j++) {
+      EXPECT_NEAR(jac(i, j), jac_sparse(i, j), 1e-14);
+    }
+  }
+}
+
+TEST(test_a2dhextract, ColouredExtractJacobian) {
+  test_coloured_extract_jacobian<2, double>();
+  test_coloured_extract_jacobian<3, double>();
+  test_coloured_extract_jacobian<3, Batch<double, 2>>();
+  test_coloured_extract_jacobian<3, Batch<double, 4>>();
+}
+
+TEST(test_a2dhextract, ColouredHExtract) {
+  // The Hessian of (x o y) . (x o y) with respect to x is diagonal
+  A2DObj<Vec<double, 5>> x, y, z;
+  A2DObj<double> output;
+  for (int i = 0; i < 5; i++) {
+    x.value()(i) = 0.3 * i - 0.2;
+    y.value()(i) = 1.0 + 0.1 * i;
+  }
+
+  auto stack = MakeStack(VecHadamard(x, y, z), VecDot(z, z, output));
+  output.bvalue() = 1.0;
+
+  constexpr JacobianColouring<5, 5> colouring(
+      SparsityCongruence(VecHadamardSparsity<5>(), IdentitySparsity<5>()));
+  Mat<double, 5, 5> jac;
+  stack.hextract(colouring, x.pvalue(), x.hvalue(), jac);
+
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      double yi = y.value()(i);
+      EXPECT_NEAR(jac(i, j), (i == j ? 2.0 * yi * yi : 0.0), 1e-14);
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "a2dcore.h"
+
+using namespace A2D;
+
+using Td = HyperDual<double>;
+
+// Check f(x + E1 + E2) against the value and the first two derivatives
+void expect_derivs(const Td& f, double value, double d1, double d2) {
+  EXPECT_NEAR(f.re, value, 1e-14 * std::fabs(value));
+  EXPECT_NEAR(f.e1, d1, 1e-14 * std::fabs(d1));
+  EXPECT_NEAR(f.e2, d1, 1e-14 * std::fabs(d1));
+  EXPECT_NEAR(f.e12, d2, 1e-14 * std::fabs(d2));
+}
+
+TEST(test_a2dhyperdual, Arithmetic) {
+  const double a = 0.7;
+  Td x(a, 1.0, 1.0, 0.0);
+
+  // f = (2 x^2 - 1) / (x + 3)
+  Td f = (2.0 * x * x - 1.0) / (x + 3.0);
+  double u = 2.0 * a * a - 1.0, v = a + 3.0;
+  double d1 = (4.0 * a * v - u) / (v * v);
+  double d2 = 4.0 / v - 2.0 * (4.0 * a * v - u) / (v * v * v);
+  expect_derivs(f, u / v, d1, d2);
+
+  // The compound operators agree with the binary operators
+  Td g = x;
+  g *= x;
+  g -= 0.5;
+  g /= x;
+  expect_derivs(g, a - 0.5 / a, 1.0 + 0.5 / (a * a), -1.0 / (a * a * a));
+
+  // The ordering uses the real part only
+  EXPECT_TRUE(x < 1.0);
+  EXPECT_TRUE(Td(0.7) < x + 1e-3);
+  EXPECT_FALSE(x == Td(0.7));
+  EXPECT_EQ(RealPart(x), a);
+}
+
+TEST(test_a2dhyperdual, Functions) {
+  const double a = 0.3;
+  Td x(a, 1.0, 1.0, 0.0);
+
+  expect_derivs(sqrt(x), std::sqrt(a), 0.5 / std::sqrt(a),
+                -0.25 / (a * std::sqrt(a)));
+  expect_derivs(exp(x), std::exp(a), std::exp(a), std::exp(a));
+  expect_derivs(log(x), std::log(a), 1.0 / a, -1.0 / (a * a));
+  expect_derivs(sin(x), std::sin(a), std::cos(a), -std::sin(a));
+  expect_derivs(cos(x), std::cos(a), -std::sin(a), -std::cos(a));
+
+  double s = std::sqrt(1.0 - a * a);
+  expect_derivs(asin(x), std::asin(a), 1.0 / s, a / (s * s * s));
+  expect_derivs(acos(x), std::acos(a), -1.0 / s, -a / (s * s * s));
+  expect_derivs(pow(x, 2.5), std::pow(a, 2.5), 2.5 * std::pow(a, 1.5),
+                3.75 * std::sqrt(a));
+  expect_derivs(fabs(-x), a, 1.0, 0.0);
+}
+
+TEST(test_a2dhyperdual, Core) {
+  // The mixed second derivative of det(A) with respect to A(0, 0) and A(1, 1)
+  // for a 3 x 3 matrix is A(2, 2)
+  Td A[9], Ainv[9];
+  for (int i = 0; i < 9; i++) {
+    A[i] = Td(0.1 * (i + 1) + (i % 4 == 0 ? 1.0 : 0.0));
+  }
+  A[0].e1 = 1.0;
+  A[4].e2 = 1.0;
+  Td det = MatDetCore<Td, 3>(A);
+  EXPECT_NEAR(det.e12, A[8].re, 1e-14);
+
+  // d(A^{-1}) = -A^{-1} dA A^{-1}, so the E1 part of A * A^{-1} vanishes
+  MatInvCore<Td, 3>(A, Ainv);
+  Td I[9];
+  MatMatMultCore<Td, 3, 3, 3, 3, 3, 3>(A, Ainv, I);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_NEAR(I[i].re, (i % 4 == 0 ? 1.0 : 0.0), 1e-14);
+    EXPECT_NEAR(I[i].e1, 0.0, 1e-14);
+    EXPECT_NEAR(I[i].e12, 0.0, 1e-14);
+  }
+}
@@ -90,3 +90,45 @@ TEST(test_a2dmat, SymMat_const_operator) {
     }
   }
 }
+
+TEST(test_a2dmat, SymMatIndex) {
+  // Small sizes use the compile-time table, large sizes the runtime loops
+  auto check = [](auto size) {
+    constexpr int N = decltype(size)::value;
+    SymMat<double, N> S;
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j <= i; j++) {
+        EXPECT_EQ(SymMatIndex<N>(i, j), j + i * (i + 1) / 2);
+        EXPECT_EQ(SymMatIndex<N>(j, i), j + i * (i + 1) / 2);
+        S(i, j) = 1.0 + i * N + j;
+      }
+    }
+
+    int index = 0;
+    UnrollLower<N>([&](auto i, auto j) {
+      EXPECT_EQ(SymMatIndex<N>(i, j), index);
+      EXPECT_DOUBLE_EQ(S[index], 1.0 + i * N + j);
+      index++;
+    });
+    EXPECT_EQ(index, N * (N + 1) / 2);
+  };
+
+  check(std::integral_constant<int, 1>());
+  check(std::integral_constant<int, 3>());
+  check(std::integral_constant<int, 4>());
+  check(std::integral_constant<int, 9>());
+}
+
+TEST(test_a2dmat, Unroll) {
+  int count = 0, sum = 0;
+  Unroll<5>([&](auto i) { count++, sum += i; });
+  EXPECT_EQ(count, 5);
+  EXPECT_EQ(sum, 10);
+
+  count = 0, sum = 0;
+  Unroll<4, 12>([&](auto i, auto j) {
+    EXPECT_EQ(count, 12 * i + j);
+    count++;
+  });
+  EXPECT_EQ(count, 48);
+}
@@ -33,4 +33,5 @@ TEST(test_a2dmatinv, MatDet) {
   test_sym_mat_det<1>();
   test_sym_mat_det<2>();
   test_sym_mat_det<3>();
+  test_sym_mat_det<4>();
 }
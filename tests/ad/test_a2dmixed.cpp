@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "a2dcore.h"
+
+using namespace A2D;
+
+// Single precision values and seeds, double precision sums
+static_assert(std::is_same<accum_t<float>, double>::value);
+static_assert(std::is_same<accum_t<double>, double>::value);
+static_assert(std::is_same<accum_t<A2D_complex_t<float>>,
+                           A2D_complex_t<float>>::value);
+static_assert(is_mixed_precision<float>::value);
+static_assert(!is_mixed_precision<double>::value);
+
+constexpr double eps = std::numeric_limits<float>::epsilon();
+
+template <int size>
+void random_fill(float x[]) {
+  for (int i = 0; i < size; i++) {
+    x[i] = 2.0f * static_cast<float>(rand()) / RAND_MAX - 1.0f;
+  }
+}
+
+// Make a row-major or packed symmetric matrix diagonally dominant
+template <int N>
+void make_invertible(float A[], bool packed = false) {
+  for (int i = 0; i < N; i++) {
+    A[packed ? i + i * (i + 1) / 2 : i * (N + 1)] += 2.0f * N;
+  }
+}
+
+TEST(test_a2dmixed, Cancellation) {
+  // The sums are exact in double, but float loses the 1.0 entirely
+  float x[3] = {1e8f, 1.0f, -1e8f}, ones[3] = {1.0f, 1.0f, 1.0f};
+  float dot = VecDotCore<float, 3>(x, ones);
+  EXPECT_EQ(dot, 1.0f);
+
+  float A[9] = {1e8f, 1.0f, -1e8f, 1e8f, 1.0f, -1e8f, 1e8f, 1.0f, -1e8f};
+  float y[3], B[9];
+  MatVecCore<float, 3, 3>(A, ones, y);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(y[i], 1.0f);
+  }
+
+  // The transpose product accumulates down the columns
+  float At[9];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      At[3 * j + i] = A[3 * i + j];
+    }
+  }
+  MatVecCore<float, 3, 3, MatOp::TRANSPOSE>(At, ones, y);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(y[i], 1.0f);
+  }
+
+  float O[9] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+  MatMatMultCore<float, 3, 3, 3, 3, 3, 3>(A, O, B);
+  for (int i = 0; i < 9; i++) {
+    EXPECT_EQ(B[i], 1.0f);
+  }
+}
+
+TEST(test_a2dmixed, Reductions) {
+  // The sums of the products of float values are exact to rounding in double,
+  // so the results are the correctly rounded double results
+  constexpr int N = 4;
+  float A[N * N], B[N * N], C[N * N], S[N * (N + 1) / 2];
+  random_fill<N * N>(A);
+  random_fill<N * N>(B);
+
+  double Ad[N * N], Bd[N * N], Cd[N * N];
+  ConvertCopyCore<N * N>(A, Ad);
+  ConvertCopyCore<N * N>(B, Bd);
+
+  MatMatMultCore<float, N, N, N, N, N, N, MatOp::TRANSPOSE, MatOp::NORMAL>(
+      A, B, C);
+  MatMatMultCore<double, N, N, N, N, N, N, MatOp::TRANSPOSE, MatOp::NORMAL>(
+      Ad, Bd, Cd);
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_EQ(C[i], static_cast<float>(Cd[i]));
+  }
+
+  double Sd[N * (N + 1) / 2];
+  SymMatRKCore<float, N, N, MatOp::NORMAL>(A, S);
+  SymMatRKCore<double, N, N, MatOp::NORMAL>(Ad, Sd);
+  for (int i = 0; i < N * (N + 1) / 2; i++) {
+    EXPECT_EQ(S[i], static_cast<float>(Sd[i]));
+  }
+
+  // Trace of the rounded product
+  ConvertCopyCore<N * (N + 1) / 2>(S, Sd);
+  float trace = SymMatMultTraceCore<float, N>(S, S);
+  double traced = SymMatMultTraceCore<double, N>(Sd, Sd);
+  EXPECT_NEAR(trace, traced, 0.5 * eps * std::fabs(traced));
+}
+
+TEST(test_a2dmixed, Factorizations) {
+  constexpr int N = 4;
+  float A[N * N], Ainv[N * N], S[N * (N + 1) / 2], Sinv[N * (N + 1) / 2];
+  random_fill<N * N>(A);
+  random_fill<N * (N + 1) / 2>(S);
+  make_invertible<N>(A);
+  make_invertible<N>(S, true);
+
+  double Ad[N * N], Ainvd[N * N], Sd[N * (N + 1) / 2],
+      Sinvd[N * (N + 1) / 2];
+  ConvertCopyCore<N * N>(A, Ad);
+  ConvertCopyCore<N * (N + 1) / 2>(S, Sd);
+
+  // The LU factors are stored in double, so the inverse is rounded once
+  MatInvCore<float, N>(A, Ainv);
+  MatInvCore<double, N>(Ad, Ainvd);
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_NEAR(Ainv[i], Ainvd[i], 0.5 * eps * std::fabs(Ainvd[i]));
+  }
+
+  SymMatInvCore<float, N>(S, Sinv);
+  SymMatInvCore<double, N>(Sd, Sinvd);
+  for (int i = 0; i < N * (N + 1) / 2; i++) {
+    EXPECT_NEAR(Sinv[i], Sinvd[i], 0.5 * eps * std::fabs(Sinvd[i]));
+  }
+
+  // Determinants of the leading 3 x 3 block
+  float A3[9];
+  double A3d[9];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      A3[3 * i + j] = A[N * i + j];
+      A3d[3 * i + j] = Ad[N * i + j];
+    }
+  }
+  float det = MatDetCore<float, 3>(A3);
+  double detd = MatDetCore<double, 3>(A3d);
+  EXPECT_NEAR(det, detd, 0.5 * eps * std::fabs(detd));
+
+  // The eigenvalues from the tridiagonal reduction
+  float eigs[N], Q[N * N];
+  double eigsd[N], Qd[N * N];
+  SymEigsGeneral<float, N>(S, eigs, Q);
+  SymEigsGeneral<double, N>(Sd, eigsd, Qd);
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(eigs[i], eigsd[i], 0.5 * eps * std::fabs(eigsd[i]));
+  }
+}
+
+// Hessian-vector product of a strain energy through a stack
+template <typename T>
+void strain_energy_hproduct(const T Uxi[], const T p[], T g[], T h[]) {
+  constexpr int N = 3;
+  Mat<T, N, N> J;
+  A2DObj<Mat<T, N, N>> Ux, Uxi0;
+  A2DObj<SymMat<T, N>> E, S;
+  A2DObj<T> energy;
+  for (int i = 0; i < N; i++) {
+    J(i, i) = T(2.0);
+  }
+  J(0, 1) = T(0.25);
+  for (int i = 0; i < N * N; i++) {
+    Uxi0.value()[i] = Uxi[i];
+    Uxi0.pvalue()[i] = p[i];
+  }
+
+  auto stack = MakeStack(MatMatMult(Uxi0, J, Ux),
+                         MatGreenStrain<GreenStrainType::NONLINEAR>(Ux, E),
+                         SymIsotropic(T(0.35), T(0.51), E, S),
+                         SymMatMultTrace(E, S, energy));
+  energy.bvalue() = T(1.0);
+  stack.hproduct();
+  for (int i = 0; i < N * N; i++) {
+    g[i] = Uxi0.bvalue()[i];
+    h[i] = Uxi0.hvalue()[i];
+  }
+}
+
+TEST(test_a2dmixed, StackHProduct) {
+  // The closed forms of the strain and the constitutive relation stay in
+  // float, so the products agree to a few rounding errors of float
+  float Uxi[9], p[9], g[9], h[9];
+  random_fill<9>(Uxi);
+  random_fill<9>(p);
+
+  double Uxid[9], pd[9], gd[9], hd[9];
+  ConvertCopyCore<9>(Uxi, Uxid);
+  ConvertCopyCore<9>(p, pd);
+
+  strain_energy_hproduct(Uxi, p, g, h);
+  strain_energy_hproduct(Uxid, pd, gd, hd);
+
+  double gnorm = 0.0, hnorm = 0.0;
+  for (int i = 0; i < 9; i++) {
+    gnorm = std::max(gnorm, std::fabs(gd[i]));
+    hnorm = std::max(hnorm, std::fabs(hd[i]));
+  }
+  for (int i = 0; i < 9; i++) {
+    EXPECT_NEAR(g[i], gd[i], 16.0 * eps * gnorm);
+    EXPECT_NEAR(h[i], hd[i], 16.0 * eps * hnorm);
+  }
+}
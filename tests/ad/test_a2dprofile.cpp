@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "a2dcore.h"
+
+// This test is compiled with A2D_ENABLE_PROFILING
+
+using namespace A2D;
+
+constexpr int N = 3;
+using T = double;
+
+TEST(test_a2dprofile, Names) {
+  using M = ADObj<Mat<T, N, N>>;
+  EXPECT_EQ((Profile::op_name<MatInvExpr<M, M>>()), "MatInvExpr");
+  EXPECT_EQ((Profile::op_name<
+                MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, M, M, M>>()),
+            "MatMatMultExpr");
+}
+
+TEST(test_a2dprofile, Counts) {
+  Profile::reset();
+
+  A2DObj<Mat<T, N, N>> Uxi, J, Jinv, Ux;
+  A2DObj<SymMat<T, N>> E, S;
+  A2DObj<T> output;
+  for (int i = 0; i < N; i++) {
+    J.value()(i, i) = 1.0;
+  }
+
+  auto stack = MakeStack(MatInv(J, Jinv), MatMatMult(Uxi, Jinv, Ux),
+                         SymMatSum(T(0.5), Ux, E),
+                         SymIsotropic(T(0.35), T(0.51), E, S),
+                         SymMatMultTrace(E, S, output));
+  const int npoints = 5;
+  for (int q = 0; q < npoints; q++) {
+    stack.eval();
+    stack.reset();
+    output.bvalue() = 1.0;
+    stack.reverse();
+    stack.hproduct();
+  }
+
+  // Construction evaluates the stack once
+  const Profile::Counters* c = Profile::find("MatMatMultExpr");
+  ASSERT_NE(c, nullptr);
+  const int eval = static_cast<int>(Profile::Sweep::EVAL);
+  const int reverse = static_cast<int>(Profile::Sweep::REVERSE);
+  const int hforward = static_cast<int>(Profile::Sweep::HFORWARD);
+  const int fused = static_cast<int>(Profile::Sweep::HPRODUCT_REVERSE);
+  EXPECT_EQ(c->calls[eval], npoints + 1);
+  EXPECT_EQ(c->calls[reverse], npoints);
+  EXPECT_EQ(c->calls[hforward], npoints);
+  EXPECT_EQ(c->calls[fused], npoints);
+  EXPECT_GT(c->cycles[eval], 0u);
+
+  c = Profile::find("SymMatMultTraceExpr");
+  ASSERT_NE(c, nullptr);
+  EXPECT_EQ(c->calls[fused], npoints);
+
+  // The report lists each expression and sweep that was called
+  char buffer[8192] = {0};
+  std::FILE* fp = fmemopen(buffer, sizeof(buffer), "w");
+  Profile::report(fp);
+  std::fclose(fp);
+  EXPECT_NE(std::strstr(buffer, "SymIsotropicExpr"), nullptr);
+  EXPECT_NE(std::strstr(buffer, "hproduct_reverse"), nullptr);
+
+  Profile::reset();
+  EXPECT_EQ(Profile::find("MatMatMultExpr")->calls[eval], 0u);
+}
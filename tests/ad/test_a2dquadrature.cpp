@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "a2dcore.h"
+#include "ad/a2dquadrature.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+// A 4-node element in 2D with 4 quadrature points
+constexpr int nnodes = 4, dim = 2, NQ = 4;
+
+// Strain energy at the quadrature points: the state holds the nodal
+// displacements and the geometry the basis function gradients at the point
+template <typename Q>
+auto make_stack(A2DObj<Vec<Q, 1>>& data, A2DObj<Mat<Q, nnodes, dim>>& G,
+                A2DObj<Mat<Q, nnodes, dim>>& U, A2DObj<Mat<Q, dim, dim>>& Ux,
+                A2DObj<SymMat<Q, dim>>& E, A2DObj<SymMat<Q, dim>>& S,
+                A2DObj<Q>& out) {
+  return MakeStack(MatMatMult<MatOp::TRANSPOSE, MatOp::NORMAL>(U, G, Ux),
+                   MatGreenStrain<GreenStrainType::NONLINEAR>(Ux, E),
+                   SymIsotropic(T(0.35), T(0.51), E, S),
+                   SymMatMultTrace(E, S, out));
+}
+
+class QuadratureTest : public ::testing::Test {
+ protected:
+  using Q = Batch<T, NQ>;
+  using GeoType = Mat<T, nnodes, dim>;
+  using StateType = Mat<T, nnodes, dim>;
+  using JacType = Mat<T, nnodes * dim, nnodes * dim>;
+
+  void SetUp() override {
+    for (int q = 0; q < NQ; q++) {
+      weights[q] = 0.25 + 0.1 * q;
+      for (int i = 0; i < GeoType::ncomp; i++) {
+        geo[q][i] = -1.0 + 2.0 * rand() / RAND_MAX;
+      }
+    }
+    for (int i = 0; i < StateType::ncomp; i++) {
+      state[i] = -0.5 + 1.0 * rand() / RAND_MAX;
+      dir[i] = -1.0 + 2.0 * rand() / RAND_MAX;
+    }
+  }
+
+  // Reference: one stack per point and the weighted sums by hand
+  void point_loop(StateType& res, StateType& prod, JacType& jac,
+                  GeoType geo_res[]) {
+    res.zero();
+    prod.zero();
+    jac.zero();
+    for (int q = 0; q < NQ; q++) {
+      A2DObj<Vec<T, 1>> data;
+      A2DObj<GeoType> G(geo[q]);
+      A2DObj<StateType> U(state);
+      A2DObj<Mat<T, dim, dim>> Ux;
+      A2DObj<SymMat<T, dim>> E, S;
+      A2DObj<T> out;
+      auto stack = make_stack(data, G, U, Ux, E, S, out);
+      out.bvalue() = weights[q];
+
+      StateType p, Jp;
+      p.copy(dir);
+      JacobianProduct<FEVarType::STATE, FEVarType::STATE>(stack, data, G, U,
+                                                          p, Jp);
+      for (int i = 0; i < StateType::ncomp; i++) {
+        res[i] += U.bvalue()[i];
+        prod[i] += Jp[i];
+      }
+      for (int i = 0; i < GeoType::ncomp; i++) {
+        geo_res[q][i] = G.bvalue()[i];
+      }
+
+      JacType jac_q;
+      stack.bzero();
+      stack.hzero();
+      U.bvalue().zero();
+      out.bvalue() = weights[q];
+      ExtractJacobian<FEVarType::STATE, FEVarType::STATE>(stack, data, G, U,
+                                                          jac_q);
+      for (int i = 0; i < JacType::ncomp; i++) {
+        jac[i] += jac_q[i];
+      }
+    }
+  }
+
+  T weights[NQ];
+  GeoType geo[NQ];
+  StateType state, dir;
+};
+
+TEST_F(QuadratureTest, MatchesPointLoop) {
+  StateType res_ref, prod_ref;
+  JacType jac_ref;
+  GeoType geo_res_ref[NQ];
+  point_loop(res_ref, prod_ref, jac_ref, geo_res_ref);
+
+  // All the points in one stack: the state is broadcast to all the lanes
+  A2DObj<Vec<Q, 1>> data;
+  A2DObj<Mat<Q, nnodes, dim>> G, U;
+  A2DObj<Mat<Q, dim, dim>> Ux;
+  A2DObj<SymMat<Q, dim>> E, S;
+  A2DObj<Q> out;
+  for (int q = 0; q < NQ; q++) {
+    BatchSetLane(q, geo[q], G.value());
+  }
+  U.value().copy(state);
+  auto stack = make_stack(data, G, U, Ux, E, S, out);
+  out.bvalue() = Q(weights);
+
+  StateType res, prod;
+  JacType jac;
+  QuadratureExtractJacobian<FEVarType::STATE, FEVarType::STATE>(
+      stack, data, G, U, res, jac);
+  for (int i = 0; i < StateType::ncomp; i++) {
+    EXPECT_NEAR(res[i], res_ref[i], 1e-14);
+  }
+  for (int i = 0; i < JacType::ncomp; i++) {
+    EXPECT_NEAR(jac[i], jac_ref[i], 1e-13);
+  }
+
+  // The residual with respect to the geometry is a point-level quantity
+  Mat<Q, nnodes, dim> geo_res;
+  QuadratureSum(G.bvalue(), geo_res);
+  for (int q = 0; q < NQ; q++) {
+    for (int i = 0; i < GeoType::ncomp; i++) {
+      EXPECT_NEAR(geo_res[i][q], geo_res_ref[q][i], 1e-14);
+    }
+  }
+
+  stack.bzero();
+  stack.hzero();
+  U.bvalue().zero();
+  U.hvalue().zero();
+  G.bvalue().zero();
+  out.bvalue() = Q(weights);
+  QuadratureJacobianProduct<FEVarType::STATE, FEVarType::STATE>(
+      stack, data, G, U, dir, prod);
+  for (int i = 0; i < StateType::ncomp; i++) {
+    EXPECT_NEAR(prod[i], prod_ref[i], 1e-13);
+  }
+
+  stack.bzero();
+  U.bvalue().zero();
+  out.bvalue() = Q(weights);
+  QuadratureResidual<FEVarType::STATE>(stack, data, G, U, res);
+  for (int i = 0; i < StateType::ncomp; i++) {
+    EXPECT_NEAR(res[i], res_ref[i], 1e-14);
+  }
+}
@@ -0,0 +1,310 @@
+#include <gtest/gtest.h>
+
+#include "a2dcore.h"
+
+using namespace A2D;
+
+constexpr int N = 3;
+using T = double;
+
+TEST(test_a2dstack, PassiveOps) {
+  using M = Mat<T, N, N>;
+  static_assert(is_passive_op<MatInvExpr<const M, ADObj<M>>>::value);
+  static_assert(is_passive_op<MatInvExpr<const M, A2DObj<M>>>::value);
+  static_assert(!is_passive_op<MatInvExpr<ADObj<M>, ADObj<M>>>::value);
+  static_assert(is_passive_op<MatDetExpr<const M, ADObj<T>>>::value);
+  static_assert(!is_passive_op<MatDetExpr<A2DObj<M>, A2DObj<T>>>::value);
+
+  // The inverse and determinant of a passive matrix are passive
+  static_assert(is_constant_op<decltype(MatInv(
+                    std::declval<const M&>(), std::declval<M&>()))>::value);
+  static_assert(is_constant_op<decltype(MatDet(
+                    std::declval<const M&>(), std::declval<T&>()))>::value);
+  static_assert(!is_constant_op<MatInvExpr<const M, ADObj<M>>>::value);
+
+  // An active input with a passive output is active
+  static_assert(!is_passive_op<MatDetExpr<ADObj<M>, T>>::value);
+  static_assert(!is_passive_op<MatInvExpr<A2DObj<M>, M>>::value);
+  static_assert(!is_passive_op<MatTraceExpr<ADObj<M>, T>>::value);
+  static_assert(!is_constant_op<MatDetExpr<ADObj<M>, T>>::value);
+
+  // A product with one active input is active
+  static_assert(!is_passive_op<decltype(MatMatMult(
+                    std::declval<const M&>(), std::declval<ADObj<M>&>(),
+                    std::declval<ADObj<M>&>()))>::value);
+}
+
+// Random gradient and a Jacobian transformation near the identity
+void set_values(Mat<T, N, N>& Uxi, Mat<T, N, N>& J) {
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      Uxi(i, j) = static_cast<T>(rand()) / RAND_MAX;
+      J(i, j) = 0.1 * static_cast<T>(rand()) / RAND_MAX;
+    }
+    J(i, i) += 1.0;
+  }
+}
+
+TEST(test_a2dstack, FirstOrder) {
+  Mat<T, N, N> Jp, Jinv;
+  T detJ;
+  ADObj<Mat<T, N, N>> Uxi, J, Ux, Jinv0, Ux0;
+  ADObj<T> output, detJ0, output0;
+  ADObj<SymMat<T, N>> E, S, E0, S0;
+  set_values(Uxi.value(), Jp);
+  J.value() = Jp;
+
+  auto passive =
+      MakeStack(MatInv(Jp, Jinv), MatDet(Jp, detJ), MatMatMult(Uxi, Jinv, Ux),
+                SymMatSum(T(0.5), Ux, E), SymIsotropic(T(0.35), T(0.51), E, S),
+                SymMatMultTrace(E, S, output));
+  static_assert(decltype(passive)::num_ops == 6);
+  static_assert(decltype(passive)::num_active_ops == 4);
+  T det = MatDetCore<T, N>(get_data(Jp));
+  EXPECT_NEAR(detJ, det, 1e-15);
+
+  output.bvalue() = 1.0;
+  passive.reverse();
+  Mat<T, N, N> g = Uxi.bvalue();
+
+  Uxi.bvalue().zero();
+  auto active = MakeStack(
+      MatInv(J, Jinv0), MatDet(J, detJ0), MatMatMult(Uxi, Jinv0, Ux0),
+      SymMatSum(T(0.5), Ux0, E0), SymIsotropic(T(0.35), T(0.51), E0, S0),
+      SymMatMultTrace(E0, S0, output0));
+  static_assert(decltype(active)::num_active_ops == 6);
+  output0.bvalue() = 1.0;
+  active.reverse();
+
+  EXPECT_NEAR(output.value(), output0.value(), 1e-14);
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_NEAR(g[i], Uxi.bvalue()[i], 1e-14);
+  }
+}
+
+TEST(test_a2dstack, SecondOrder) {
+  Mat<T, N, N> Jp, Jinv;
+  T detJ;
+  A2DObj<Mat<T, N, N>> Uxi, J, Ux, Jinv0, Ux0;
+  A2DObj<T> output, detJ0, output0;
+  A2DObj<SymMat<T, N>> E, S, E0, S0;
+  set_values(Uxi.value(), Jp);
+  J.value() = Jp;
+  for (int i = 0; i < N * N; i++) {
+    Uxi.pvalue()[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+
+  auto passive =
+      MakeStack(MatInv(Jp, Jinv), MatDet(Jp, detJ), MatMatMult(Uxi, Jinv, Ux),
+                SymMatSum(T(0.5), Ux, E), SymIsotropic(T(0.35), T(0.51), E, S),
+                SymMatMultTrace(E, S, output));
+  static_assert(decltype(passive)::num_active_ops == 4);
+  output.bvalue() = 1.0;
+  passive.hproduct();
+  Mat<T, N, N> g = Uxi.bvalue(), h = Uxi.hvalue();
+
+  Uxi.bvalue().zero();
+  Uxi.hvalue().zero();
+  auto active = MakeStack(
+      MatInv(J, Jinv0), MatDet(J, detJ0), MatMatMult(Uxi, Jinv0, Ux0),
+      SymMatSum(T(0.5), Ux0, E0), SymIsotropic(T(0.35), T(0.51), E0, S0),
+      SymMatMultTrace(E0, S0, output0));
+  output0.bvalue() = 1.0;
+  active.hproduct();
+
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_NEAR(g[i], Uxi.bvalue()[i], 1e-14);
+    EXPECT_NEAR(h[i], Uxi.hvalue()[i], 1e-14);
+  }
+}
+
+// Passive outputs make the operations that use them passive
+TEST(test_a2dstack, PassiveChain) {
+  Mat<T, N, N> Jp, Jinv, Jinv2;
+  T detJinv;
+  A2DObj<Mat<T, N, N>> Uxi, Ux, Ux0, Jinv0;
+  A2DObj<SymMat<T, N>> E, S, E0, S0;
+  A2DObj<T> detJinv0, output, output0;
+  set_values(Uxi.value(), Jp);
+  for (int i = 0; i < N * N; i++) {
+    Uxi.pvalue()[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+
+  auto stack = MakeStack(
+      MatInv(Jp, Jinv), MatDet(Jinv, detJinv), MatInv(Jinv, Jinv2),
+      MatMatMult(Uxi, Jinv, Ux), SymMatSum(T(0.5), Ux, E),
+      SymIsotropic(T(0.35), T(0.51), E, S), SymMatMultTrace(E, S, output));
+  static_assert(decltype(stack)::num_ops == 7);
+  static_assert(decltype(stack)::num_active_ops == 4);
+  static_assert(!decltype(stack)::is_active<1>);
+  static_assert(!decltype(stack)::is_active<2>);
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_NEAR(Jinv2[i], Jp[i], 1e-14);
+  }
+
+  output.bvalue() = 1.0;
+  stack.hproduct();
+
+  // Reference with an active inverse
+  MatInv(Jp, Jinv0.value());
+  auto ref = MakeStack(
+      MatDet(Jinv0, detJinv0), MatMatMult(Uxi, Jinv0, Ux0),
+      SymMatSum(T(0.5), Ux0, E0), SymIsotropic(T(0.35), T(0.51), E0, S0),
+      SymMatMultTrace(E0, S0, output0));
+  EXPECT_NEAR(detJinv, detJinv0.value(), 1e-15);
+  Mat<T, N, N> g = Uxi.bvalue(), h = Uxi.hvalue();
+  Uxi.bzero();
+  Uxi.hzero();
+  output0.bvalue() = 1.0;
+  ref.hproduct();
+
+  EXPECT_NEAR(output.value(), output0.value(), 1e-14);
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_NEAR(g[i], Uxi.bvalue()[i], 1e-14);
+    EXPECT_NEAR(h[i], Uxi.hvalue()[i], 1e-14);
+  }
+}
+
+// The seeds of the active output of a passive operation are zeroed, since
+// the forward sweeps skip it
+TEST(test_a2dstack, PassiveOutputSeeds) {
+  using M = Mat<T, N, N>;
+  M Jp;
+  A2DObj<M> Uxi, Jinv, Ux;
+  A2DObj<SymMat<T, N>> E, S;
+  A2DObj<T> output;
+  set_values(Uxi.value(), Jp);
+  for (int i = 0; i < N * N; i++) {
+    Uxi.pvalue()[i] = static_cast<T>(rand()) / RAND_MAX;
+  }
+
+  auto stack = MakeStack(MatInvExpr<const M, A2DObj<M>>(Jp, Jinv),
+                         MatMatMult(Uxi, Jinv, Ux), SymMatSum(T(0.5), Ux, E),
+                         SymIsotropic(T(0.35), T(0.51), E, S),
+                         SymMatMultTrace(E, S, output));
+  static_assert(decltype(stack)::num_active_ops == 4);
+  output.bvalue() = 1.0;
+  stack.hproduct();
+  M g = Uxi.bvalue(), h = Uxi.hvalue();
+
+  // Stale seeds in the output of the passive inverse
+  for (int i = 0; i < N * N; i++) {
+    Jinv.bvalue()[i] = Jinv.pvalue()[i] = Jinv.hvalue()[i] = 1.0 + i;
+  }
+  Uxi.bzero();
+  Uxi.hzero();
+  stack.reset();
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_EQ(Jinv.bvalue()[i], 0.0);
+    EXPECT_EQ(Jinv.pvalue()[i], 0.0);
+    EXPECT_EQ(Jinv.hvalue()[i], 0.0);
+  }
+  output.bvalue() = 1.0;
+  stack.hproduct();
+
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_EQ(g[i], Uxi.bvalue()[i]);
+    EXPECT_EQ(h[i], Uxi.hvalue()[i]);
+  }
+}
+
+// The fused Hessian-vector product against the separate sweeps
+TEST(test_a2dstack, FusedHProduct) {
+  A2DObj<Mat<T, N, N>> Uxi, J, Jinv, Ux;
+  A2DObj<SymMat<T, N>> E1, E2, E, S;
+  A2DObj<T> output;
+  set_values(Uxi.value(), J.value());
+  for (int i = 0; i < N * N; i++) {
+    Uxi.pvalue()[i] = static_cast<T>(rand()) / RAND_MAX;
+    J.pvalue()[i] = 0.1 * static_cast<T>(rand()) / RAND_MAX;
+  }
+
+  constexpr MatOp NORMAL = MatOp::NORMAL, TRANSPOSE = MatOp::TRANSPOSE;
+  auto stack = MakeStack(
+      MatInv(J, Jinv), MatMatMult<NORMAL, TRANSPOSE>(Uxi, Jinv, Ux),
+      SymMatSum(T(0.5), Ux, E1), SymMatRK<TRANSPOSE>(Ux, E2),
+      MatSum(T(1.0), E1, T(0.5), E2, E), SymIsotropic(T(0.35), T(0.51), E, S),
+      SymMatMultTrace(E, S, output));
+
+  output.bvalue() = 1.0;
+  output.hvalue() = 0.3;
+  stack.reverse();
+  stack.hforward();
+  stack.hreverse();
+  Mat<T, N, N> gU = Uxi.bvalue(), gJ = J.bvalue();
+  Mat<T, N, N> hU = Uxi.hvalue(), hJ = J.hvalue();
+
+  Uxi.bzero();
+  J.bzero();
+  stack.bzero();
+  Uxi.hzero();
+  J.hzero();
+  stack.hzero();
+  output.bvalue() = 1.0;
+  output.hvalue() = 0.3;
+  stack.hproduct();
+
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_NEAR(gU[i], Uxi.bvalue()[i], 1e-13);
+    EXPECT_NEAR(gJ[i], J.bvalue()[i], 1e-13);
+    EXPECT_NEAR(hU[i], Uxi.hvalue()[i], 1e-13);
+    EXPECT_NEAR(hJ[i], J.hvalue()[i], 1e-13);
+  }
+}
+
+// A stack built once and re-run at several points
+TEST(test_a2dstack, Reuse) {
+  A2DObj<Mat<T, N, N>> Uxi, J, Jinv, Ux;
+  A2DObj<SymMat<T, N>> E, S;
+  A2DObj<T> output;
+
+  auto stack = MakeStack(MatInv(J, Jinv), MatMatMult(Uxi, Jinv, Ux),
+                         SymMatSum(T(0.5), Ux, E),
+                         SymIsotropic(T(0.35), T(0.51), E, S),
+                         SymMatMultTrace(E, S, output));
+  static_assert(decltype(stack)::order == ADorder::SECOND);
+
+  for (int point = 0; point < 4; point++) {
+    Mat<T, N, N> Uxi0, J0, P;
+    set_values(Uxi0, J0);
+    set_values(P, J0);
+
+    // Update the inputs and re-run the stack
+    Uxi.value() = Uxi0;
+    J.value() = J0;
+    Uxi.pvalue() = P;
+    Uxi.bzero();
+    Uxi.hzero();
+    J.bzero();
+    J.hzero();
+    stack.eval();
+    stack.reset();
+    output.bvalue() = 1.0;
+    stack.hproduct();
+
+    // A stack built for this point only
+    A2DObj<Mat<T, N, N>> Uxi1, J1, Jinv1, Ux1;
+    A2DObj<SymMat<T, N>> E1, S1;
+    A2DObj<T> output1;
+    Uxi1.value() = Uxi0;
+    J1.value() = J0;
+    Uxi1.pvalue() = P;
+    auto stack1 = MakeStack(MatInv(J1, Jinv1), MatMatMult(Uxi1, Jinv1, Ux1),
+                            SymMatSum(T(0.5), Ux1, E1),
+                            SymIsotropic(T(0.35), T(0.51), E1, S1),
+                            SymMatMultTrace(E1, S1, output1));
+    output1.bvalue() = 1.0;
+    stack1.hproduct();
+
+    EXPECT_EQ(output.value(), output1.value());
+    for (int i = 0; i < N * N; i++) {
+      EXPECT_EQ(Uxi.bvalue()[i], Uxi1.bvalue()[i]);
+      EXPECT_EQ(Uxi.hvalue()[i], Uxi1.hvalue()[i]);
+      EXPECT_EQ(J.hvalue()[i], J1.hvalue()[i]);
+    }
+  }
+
+  ADObj<Mat<T, N, N>> A, Ainv;
+  auto first = MakeStack(MatInv(A, Ainv));
+  static_assert(decltype(first)::order == ADorder::FIRST);
+}
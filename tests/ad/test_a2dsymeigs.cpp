@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "a2dcore.h"
+
+using namespace A2D;
+
+// Symmetric matrix Q * diag(d) * Q^T for a random rotation Q
+void make_sym(const double d[], double A[]) {
+  double V[3][3];
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      V[i][j] = -1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX;
+    }
+    for (int k = 0; k < i; k++) {
+      double dot = V[i][0] * V[k][0] + V[i][1] * V[k][1] + V[i][2] * V[k][2];
+      for (int j = 0; j < 3; j++) {
+        V[i][j] -= dot * V[k][j];
+      }
+    }
+    double norm = std::sqrt(V[i][0] * V[i][0] + V[i][1] * V[i][1] +
+                            V[i][2] * V[i][2]);
+    for (int j = 0; j < 3; j++) {
+      V[i][j] /= norm;
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j <= i; j++) {
+      double value = 0.0;
+      for (int k = 0; k < 3; k++) {
+        value += V[k][i] * d[k] * V[k][j];
+      }
+      A[j + i * (i + 1) / 2] = value;
+    }
+  }
+}
+
+// Check that the eigenvalues are sorted, that Q is orthonormal and that
+// A * Q = Q * diag(eigs)
+void check_eigs(const double A[], const double eigs[], const double Q[],
+                double tol) {
+  EXPECT_LE(eigs[0], eigs[1]);
+  EXPECT_LE(eigs[1], eigs[2]);
+
+  for (int i = 0; i < 3; i++) {
+    for (int k = 0; k < 3; k++) {
+      double r = -eigs[k] * Q[k + 3 * i];
+      for (int j = 0; j < 3; j++) {
+        int ij = (i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2);
+        r += A[ij] * Q[k + 3 * j];
+      }
+      EXPECT_NEAR(r, 0.0, tol);
+    }
+  }
+
+  for (int k = 0; k < 3; k++) {
+    for (int l = 0; l < 3; l++) {
+      double dot = Q[k] * Q[l] + Q[k + 3] * Q[l + 3] + Q[k + 6] * Q[l + 6];
+      EXPECT_NEAR(dot, k == l ? 1.0 : 0.0, tol);
+    }
+  }
+}
+
+// The tolerance of the closed form is tol * scale
+void test_3x3(const double A[], double tol, double scale = 1.0) {
+  tol *= scale;
+  double eigs[3], Q[9], e[3], ref[3], Qref[9];
+  SymEigs3x3(A, eigs, Q);
+  check_eigs(A, eigs, Q, tol);
+
+  // Eigenvalues alone
+  SymEigs3x3(A, e);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(e[k], eigs[k], tol);
+  }
+
+  // Compare against the general path, which does not sort
+  SymEigsGeneral<double, 3>(A, ref, Qref);
+  std::sort(ref, ref + 3);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(eigs[k], ref[k], tol);
+  }
+}
+
+TEST(test_a2dsymeigs, Random) {
+  for (int i = 0; i < 100; i++) {
+    double A[6];
+    for (int j = 0; j < 6; j++) {
+      A[j] = -1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX;
+    }
+    test_3x3(A, 1e-13);
+  }
+}
+
+// Close and repeated eigenvalues
+TEST(test_a2dsymeigs, Clustered) {
+  const double d[][3] = {{1.0, 1.0 + 1e-10, -3.0},
+                         {-2.0, 5.0, 5.0},
+                         {0.5, 0.5 + 1e-3, 0.5 + 2e-3},
+                         {1e4, 1e4 + 1.0, 1e4 + 3.0}};
+  for (int i = 0; i < 4; i++) {
+    double A[6];
+    make_sym(d[i], A);
+    test_3x3(A, 1e-13, std::fabs(d[i][2]));
+  }
+}
+
+TEST(test_a2dsymeigs, Diagonal) {
+  const double A[] = {3.0, 0.0, -1.0, 0.0, 0.0, 2.0};
+  test_3x3(A, 1e-15);
+
+  const double I[] = {2.0, 0.0, 2.0, 0.0, 0.0, 2.0};
+  double eigs[3], Q[9];
+  SymEigs3x3(I, eigs, Q);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(eigs[k], 2.0);
+  }
+  check_eigs(I, eigs, Q, 1e-15);
+}
+
+// The closed form has no branches, so each lane of a batch gives the result
+// of its own matrix
+TEST(test_a2dsymeigs, Batch) {
+  constexpr int W = 4;
+  const double d[][3] = {{-0.3, 0.8, 1.9}, {1.0, 1.0 + 1e-10, -3.0}};
+  double A[W][6];
+  for (int j = 0; j < 6; j++) {
+    A[0][j] = -1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX;
+  }
+  make_sym(d[0], A[1]);
+  make_sym(d[1], A[2]);
+  const double I[] = {2.0, 0.0, 2.0, 0.0, 0.0, 2.0};
+  std::copy(I, I + 6, A[3]);
+
+  Batch<double, W> Ab[6], eigs[3], Q[9];
+  for (int k = 0; k < W; k++) {
+    for (int j = 0; j < 6; j++) {
+      Ab[j][k] = A[k][j];
+    }
+  }
+  SymEigs3x3(Ab, eigs, Q);
+
+  for (int k = 0; k < W; k++) {
+    double e[3], Qk[9];
+    SymEigs3x3(A[k], e, Qk);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(eigs[i][k], e[i], 1e-14);
+    }
+    for (int i = 0; i < 9; i++) {
+      EXPECT_NEAR(Q[i][k], Qk[i], 1e-14);
+    }
+  }
+}
+
+// The first- and second-order sweeps are branch-free as well, including the
+// terms of repeated eigenvalues
+TEST(test_a2dsymeigs, BatchHProduct) {
+  constexpr int W = 4;
+  using B = Batch<double, W>;
+  double A[W][6], b[W][3], p[W][6];
+  for (int k = 0; k < W; k++) {
+    for (int j = 0; j < 6; j++) {
+      A[k][j] = -1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX;
+      p[k][j] = -1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX;
+    }
+    for (int j = 0; j < 3; j++) {
+      b[k][j] = -1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX;
+    }
+  }
+  const double d[] = {1.0, 1.0, -3.0};
+  make_sym(d, A[1]);
+  const double I[] = {2.0, 0.0, 2.0, 0.0, 0.0, 2.0};
+  std::copy(I, I + 6, A[3]);
+
+  A2DObj<SymMat<B, 3>> Sb;
+  A2DObj<Vec<B, 3>> eigsb;
+  for (int k = 0; k < W; k++) {
+    for (int j = 0; j < 6; j++) {
+      Sb.value()[j][k] = A[k][j];
+      Sb.pvalue()[j][k] = p[k][j];
+    }
+    for (int j = 0; j < 3; j++) {
+      eigsb.bvalue()[j][k] = b[k][j];
+    }
+  }
+  auto stackb = MakeStack(SymEigs(Sb, eigsb));
+  stackb.reverse();
+  stackb.hproduct();
+
+  for (int k = 0; k < W; k++) {
+    A2DObj<SymMat<double, 3>> S;
+    A2DObj<Vec<double, 3>> eigs;
+    for (int j = 0; j < 6; j++) {
+      S.value()[j] = A[k][j];
+      S.pvalue()[j] = p[k][j];
+    }
+    for (int j = 0; j < 3; j++) {
+      eigs.bvalue()[j] = b[k][j];
+    }
+    auto stack = MakeStack(SymEigs(S, eigs));
+    stack.reverse();
+    stack.hproduct();
+
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(eigsb.pvalue()[j][k], eigs.pvalue()[j], 1e-13);
+    }
+    for (int j = 0; j < 6; j++) {
+      EXPECT_NEAR(Sb.bvalue()[j][k], S.bvalue()[j], 1e-13);
+      EXPECT_NEAR(Sb.hvalue()[j][k], S.hvalue()[j], 1e-13);
+    }
+  }
+}
+
+// The forward sweep sets the eigenvalue seeds, so it can be repeated
+TEST(test_a2dsymeigs, RepeatedForward) {
+  ADObj<SymMat<double, 3>> S;
+  ADObj<Vec<double, 3>> eigs;
+  for (int j = 0; j < 6; j++) {
+    S.value()[j] = -1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX;
+    S.bvalue()[j] = -1.0 + 2.0 * static_cast<double>(rand()) / RAND_MAX;
+  }
+
+  auto stack = MakeStack(SymEigs(S, eigs));
+  stack.forward();
+  Vec<double, 3> d = eigs.bvalue();
+  stack.forward();
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(eigs.bvalue()[k], d[k]);
+  }
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "a2dcore.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+TEST(test_a2dview, ViewAccess) {
+  std::vector<T> data(12);
+  for (int i = 0; i < 12; i++) {
+    data[i] = i;
+  }
+
+  MatView<T, 2, 3> A(data.data());
+  SymMatView<T, 2> S(data.data() + 6);
+  VecView<T, 3> x(data.data() + 9);
+  EXPECT_EQ(A(1, 2), 5.0);
+  EXPECT_EQ(S(0, 1), 7.0);
+  EXPECT_EQ(S(1, 0), 7.0);
+  EXPECT_EQ(x(2), 11.0);
+
+  // Writes go to the external storage
+  A(0, 1) = -1.0;
+  x.zero();
+  EXPECT_EQ(data[1], -1.0);
+  EXPECT_EQ(data[9] + data[10] + data[11], 0.0);
+
+  // copy() copies the entries, while assignment rebinds the view
+  Mat<T, 2, 3> B;
+  B(1, 1) = 3.0;
+  A.copy(B);
+  EXPECT_EQ(data[4], 3.0);
+  EXPECT_EQ(data[1], 0.0);
+
+  MatView<T, 2, 3> Bview(B);
+  A = Bview;
+  A(0, 0) = 2.0;
+  EXPECT_EQ(B(0, 0), 2.0);
+  EXPECT_EQ(data[0], 0.0);
+}
+
+// Strain energy Hessian-vector products computed in place in global arrays
+TEST(test_a2dview, InPlaceJacobianProduct) {
+  constexpr index_t nelems = 17;
+  const T mu(0.197), lambda(0.839);
+
+  std::vector<T> u(9 * nelems), p(9 * nelems), res(9 * nelems, 0.0);
+  for (index_t i = 0; i < 9 * nelems; i++) {
+    u[i] = 0.2 * rand() / RAND_MAX;
+    p[i] = -1.0 + 2.0 * rand() / RAND_MAX;
+  }
+
+  for (index_t e = 0; e < nelems; e++) {
+    // Reference computed with copies of the element values
+    A2DObj<Mat<T, 3, 3>> Ux(Mat<T, 3, 3>(&u[9 * e]));
+    Mat<T, 3, 3> pe(&p[9 * e]), re;
+    {
+      A2DObj<SymMat<T, 3>> E, S;
+      A2DObj<T> out;
+      A2DObj<Vec<T, 1>> data;
+      A2DObj<Mat<T, 3, 3>> geo;
+      auto stack = MakeStack(MatGreenStrain<GreenStrainType::NONLINEAR>(Ux, E),
+                             SymIsotropic(mu, lambda, E, S),
+                             SymMatMultTrace(E, S, out));
+      out.bvalue() = 1.0;
+      JacobianProduct<FEVarType::STATE, FEVarType::STATE>(stack, data, geo, Ux,
+                                                          pe, re);
+    }
+
+    // Values, directions and results referenced directly in the arrays
+    Mat<T, 3, 3> ub;
+    A2DObj<MatView<T, 3, 3>> Uv(
+        MatView<T, 3, 3>(&u[9 * e]), MatView<T, 3, 3>(ub),
+        MatView<T, 3, 3>(&p[9 * e]), MatView<T, 3, 3>(&res[9 * e]));
+    A2DObj<SymMat<T, 3>> E, S;
+    A2DObj<T> out;
+    auto stack = MakeStack(MatGreenStrain<GreenStrainType::NONLINEAR>(Uv, E),
+                           SymIsotropic(mu, lambda, E, S),
+                           SymMatMultTrace(E, S, out));
+    out.bvalue() = 1.0;
+    stack.hproduct();
+
+    for (int i = 0; i < 9; i++) {
+      EXPECT_NEAR(res[9 * e + i], re[i], 1e-14);
+    }
+  }
+}
+
+TEST(test_a2dview, SymMatAndVecViews) {
+  const T mu(0.3), lambda(0.7);
+  std::vector<T> e(6), eb(6, 0.0), x(3), xb(3, 0.0);
+  for (int i = 0; i < 6; i++) {
+    e[i] = 0.1 * (i + 1);
+  }
+  for (int i = 0; i < 3; i++) {
+    x[i] = 1.0 - 0.5 * i;
+  }
+
+  // Reference computed with owned objects
+  ADObj<SymMat<T, 3>> Eref(SymMat<T, 3>(e.data())), Sref;
+  ADObj<T> energy_ref;
+  auto ref = MakeStack(SymIsotropic(mu, lambda, Eref, Sref),
+                       SymMatMultTrace(Eref, Sref, energy_ref));
+  energy_ref.bvalue() = 1.0;
+  ref.reverse();
+
+  ADObj<SymMatView<T, 3>> E(SymMatView<T, 3>(e.data()),
+                            SymMatView<T, 3>(eb.data()));
+  ADObj<VecView<T, 3>> xv(VecView<T, 3>(x.data()), VecView<T, 3>(xb.data()));
+  // Operands of SymMatMultTrace must have the same type
+  SymMat<T, 3> s, sb;
+  ADObj<SymMatView<T, 3>> S(s, sb);
+  ADObj<T> energy, norm;
+
+  auto stack = MakeStack(SymIsotropic(mu, lambda, E, S),
+                         SymMatMultTrace(E, S, energy), VecDot(xv, xv, norm));
+  energy.bvalue() = 1.0;
+  norm.bvalue() = 1.0;
+  stack.reverse();
+
+  EXPECT_NEAR(energy.value(), energy_ref.value(), 1e-14);
+  for (int i = 0; i < 6; i++) {
+    EXPECT_NEAR(eb[i], Eref.bvalue()[i], 1e-14);
+  }
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(xb[i], 2.0 * x[i], 1e-14);
+  }
+}
@@ -618,26 +618,48 @@ class DiamondGraphTest : public A2D::Test::A2DTest<T, T, Mat<T, N, N>> {
 };
 
 bool MatIntegrationTests(bool component, bool write_output) {
+  using Tc = A2D_complex_t<double>;
+  using Td = HyperDual<double>;
+
   bool passed = true;
 
-  StrainTest<A2D_complex_t<double>, 3> test1;
+  StrainTest<Tc, 3> test1;
   passed = passed && A2D::Test::Run(test1, component, write_output);
 
-  DefGradTest<A2D_complex_t<double>, 3> test2;
+  DefGradTest<Tc, 3> test2;
   passed = passed && A2D::Test::Run(test2, component, write_output);
 
-  MooneyRivlin<A2D_complex_t<double>> test3;
+  MooneyRivlin<Tc> test3;
   passed = passed && A2D::Test::Run(test3, component, write_output);
 
-  HExtractTest<A2D_complex_t<double>, 3> test4;
+  HExtractTest<Tc, 3> test4;
   passed = passed && A2D::Test::Run(test4, component, write_output);
 
-  VonMisesPenaltyTest<A2D_complex_t<double>> test5;
+  VonMisesPenaltyTest<Tc> test5;
   passed = passed && A2D::Test::Run(test5, component, write_output);
 
-  DiamondGraphTest<A2D_complex_t<double>, 3> test6;
+  DiamondGraphTest<Tc, 3> test6;
   passed = passed && A2D::Test::Run(test6, component, write_output);
 
+  // The same tests with exact hyper-dual references
+  StrainTest<Td, 3> test7;
+  passed = passed && A2D::Test::Run(test7, component, write_output);
+
+  DefGradTest<Td, 3> test8;
+  passed = passed && A2D::Test::Run(test8, component, write_output);
+
+  MooneyRivlin<Td> test9;
+  passed = passed && A2D::Test::Run(test9, component, write_output);
+
+  HExtractTest<Td, 3> test10;
+  passed = passed && A2D::Test::Run(test10, component, write_output);
+
+  VonMisesPenaltyTest<Td> test11;
+  passed = passed && A2D::Test::Run(test11, component, write_output);
+
+  DiamondGraphTest<Td, 3> test12;
+  passed = passed && A2D::Test::Run(test12, component, write_output);
+
   return passed;
 }
 
@@ -665,6 +687,7 @@ int main(int argc, char *argv[]) {
   tests.push_back(A2D::Test::SymMatVecMultTestAll);
   tests.push_back(A2D::Test::MatDetTestAll);
   tests.push_back(A2D::Test::MatInvTestAll);
+  tests.push_back(A2D::Test::MatSolveTestAll);
   tests.push_back(A2D::Test::MatTraceTestAll);
   tests.push_back(A2D::Test::MatGreenStrainTestAll);
   tests.push_back(A2D::Test::SymMatMultTraceTestAll);
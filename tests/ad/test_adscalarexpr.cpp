@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "a2dcore.h"
+
+using namespace A2D;
+
+constexpr int N = 5;
+using S = ADScalar<double, N>;
+
+// Scalar with value v and derivatives d0 * (1, 2, ..., N)
+S make_scalar(double v, double d0) {
+  S s(v);
+  for (int i = 0; i < N; i++) {
+    s.deriv[i] = d0 * (i + 1);
+  }
+  return s;
+}
+
+TEST(test_adscalarexpr, Traits) {
+  static_assert(is_adscalar_v<S>);
+  static_assert(!is_adscalar_expr_v<S>);
+
+  S a = make_scalar(1.0, 1.0), b = make_scalar(2.0, 1.0);
+  static_assert(is_adscalar_expr_v<decltype(a * b + a)>);
+  static_assert(!is_adscalar_v<decltype(a * b + a)>);
+  static_assert(std::is_same<decltype(a * b)::type, double>::value);
+  static_assert(decltype(a * b)::nderivs == N);
+
+  // Scalars other than ADScalar are not expressions
+  static_assert(!is_adscalar_expr_v<double>);
+  static_assert(!is_adscalar_expr_v<Batch<double, 2>>);
+}
+
+// a*b + c/d - sqrt(e) against the hand-derived chain rule
+TEST(test_adscalarexpr, FusedChain) {
+  S a = make_scalar(1.5, 0.1), b = make_scalar(-0.7, 0.2),
+    c = make_scalar(0.3, -0.3), d = make_scalar(2.2, 0.4),
+    e = make_scalar(1.1, 0.5);
+
+  S f = a * b + c / d - sqrt(e);
+
+  EXPECT_NEAR(f.value,
+              a.value * b.value + c.value / d.value - std::sqrt(e.value),
+              1e-15);
+  for (int i = 0; i < N; i++) {
+    double df = a.deriv[i] * b.value + a.value * b.deriv[i] +
+                c.deriv[i] / d.value -
+                c.value * d.deriv[i] / (d.value * d.value) -
+                0.5 * e.deriv[i] / std::sqrt(e.value);
+    EXPECT_NEAR(f.deriv[i], df, 1e-14);
+  }
+}
+
+TEST(test_adscalarexpr, MixedScalarsAndFunctions) {
+  S x = make_scalar(0.8, 0.25);
+  S f = 2.0 * exp(x) - 3.0 / x + x / 4.0 + 1.0 - log(x) * sin(x);
+  S g = -pow(x, 3) + cos(x) - atan(x) + tanh(x) + fabs(-x);
+
+  double v = x.value;
+  double df = 2.0 * std::exp(v) + 3.0 / (v * v) + 0.25 - 1.0 / v * std::sin(v) -
+              std::log(v) * std::cos(v);
+  double dg = -3.0 * v * v - std::sin(v) - 1.0 / (1.0 + v * v) +
+              1.0 / (std::cosh(v) * std::cosh(v)) + 1.0;
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(f.deriv[i], df * x.deriv[i], 1e-13);
+    EXPECT_NEAR(g.deriv[i], dg * x.deriv[i], 1e-13);
+  }
+
+  S y = make_scalar(-0.4, 0.5);
+  S h = atan2(y, x);
+  double denom = x.value * x.value + y.value * y.value;
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(h.deriv[i],
+                (x.value * y.deriv[i] - y.value * x.deriv[i]) / denom, 1e-14);
+  }
+}
+
+// Assignments where the expression refers to the target
+TEST(test_adscalarexpr, Aliasing) {
+  S x = make_scalar(1.3, 0.2), y = make_scalar(-0.6, 0.7);
+  S xref = x;
+
+  x = x * y + x;
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(x.deriv[i],
+                xref.deriv[i] * (y.value + 1.0) + xref.value * y.deriv[i],
+                1e-14);
+  }
+
+  x = xref;
+  x *= x + y;
+  S z = xref * (xref + y);
+  EXPECT_NEAR(x.value, z.value, 1e-15);
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(x.deriv[i], z.deriv[i], 1e-14);
+  }
+
+  x = xref;
+  x /= y * y;
+  x += y * xref;
+  x -= 2.0 * y;
+  z = xref / (y * y) + y * xref - 2.0 * y;
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(x.deriv[i], z.deriv[i], 1e-14);
+  }
+}
+
+// Detect whether an expression can be combined with an ADScalar
+template <class A, class B, class = void>
+struct can_multiply : std::false_type {};
+template <class A, class B>
+struct can_multiply<
+    A, B, std::void_t<decltype(std::declval<A>() * std::declval<B>())>>
+    : std::true_type {};
+
+template <class A, class = void>
+struct can_sqrt : std::false_type {};
+template <class A>
+struct can_sqrt<A, std::void_t<decltype(sqrt(std::declval<A>()))>>
+    : std::true_type {};
+
+// A named expression (auto e = x * y;) cannot be used
+TEST(test_adscalarexpr, NamedExpressionRejected) {
+  using E = decltype(std::declval<S&>() * std::declval<S&>());
+  static_assert(!std::is_copy_constructible<E>::value);
+  static_assert(!std::is_constructible<S, E&>::value);
+  static_assert(!std::is_constructible<S, const E&>::value);
+  static_assert(!std::is_assignable<S&, E&>::value);
+  static_assert(!can_multiply<E&, S&>::value);
+  static_assert(!can_multiply<double, E&>::value);
+  static_assert(!can_sqrt<E&>::value);
+
+  // Temporaries are accepted
+  static_assert(std::is_constructible<S, E>::value);
+  static_assert(std::is_assignable<S&, E>::value);
+  static_assert(can_multiply<E, S&>::value);
+  static_assert(can_multiply<double, E>::value);
+  static_assert(can_sqrt<E>::value);
+}
+
+// Temporary ADScalars are stored by value in an expression
+TEST(test_adscalarexpr, TemporaryOperands) {
+  S x = make_scalar(0.5, 1.0);
+  S f = make_scalar(2.0, 1.0) * x + S(1.0);
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(f.deriv[i], (i + 1) * x.value + 2.0 * x.deriv[i], 1e-15);
+  }
+  EXPECT_TRUE(make_scalar(2.0, 1.0) * x + S(1.0) > 1.0);
+  EXPECT_TRUE(x < make_scalar(2.0, 1.0) * x + S(1.0));
+}
+
+// Second derivatives with a nested scalar
+TEST(test_adscalarexpr, Nested) {
+  using T1 = ADScalar<double, 1>;
+  using T2 = ADScalar<T1, 1>;
+
+  // f(x) = x^2 sin(x), seed both directions with 1
+  T1 x1(0.9);
+  x1.deriv[0] = 1.0;
+  T2 x(x1);
+  x.deriv[0] = T1(1.0);
+
+  T2 f = x * x * sin(x);
+  double v = 0.9;
+  double df = 2.0 * v * std::sin(v) + v * v * std::cos(v);
+  double d2f = 2.0 * std::sin(v) + 4.0 * v * std::cos(v) - v * v * std::sin(v);
+  EXPECT_NEAR(f.value.value, v * v * std::sin(v), 1e-15);
+  EXPECT_NEAR(f.value.deriv[0], df, 1e-14);
+  EXPECT_NEAR(f.deriv[0].value, df, 1e-14);
+  EXPECT_NEAR(f.deriv[0].deriv[0], d2f, 1e-14);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "a2dcore.h"
+#include "adscalarpacked.h"
+
+using namespace A2D;
+
+// Random scalar with random derivatives, in both representations
+template <typename T, int N>
+void random_scalar(T value, ADScalar<T, N>& a, PackedADScalar<T, N>& p) {
+  T d[N];
+  for (int i = 0; i < N; i++) {
+    d[i] = -1.0 + 2.0 * static_cast<T>(rand()) / RAND_MAX;
+  }
+  a = ADScalar<T, N>(value, d);
+  p = PackedADScalar<T, N>(value, d);
+}
+
+// The ADScalar argument is not deduced so that expressions are converted
+template <typename T, int N>
+void expect_same(const PackedADScalar<T, N>& p,
+                 const typename std::common_type<ADScalar<T, N>>::type& a) {
+  const T tol = std::is_same<T, float>::value ? 1e-5 : 1e-14;
+  EXPECT_NEAR(p.value, a.value, tol);
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(p.deriv[i], a.deriv[i], tol) << "derivative " << i;
+  }
+  // The padding must stay zero
+  for (int i = N; i < PackedADScalar<T, N>::nchunks *
+                          PackedADScalarDeriv<T, N>::width;
+       i++) {
+    EXPECT_EQ(p.deriv[i], T(0.0));
+  }
+}
+
+template <typename T, int N>
+void test_packed() {
+  ADScalar<T, N> x, y;
+  PackedADScalar<T, N> px, py;
+  random_scalar<T, N>(0.7, x, px);
+  random_scalar<T, N>(-1.3, y, py);
+  const T s = 2.5;
+
+  expect_same(px + py, x + y);
+  expect_same(s + px, s + x);
+  expect_same(px - py, x - y);
+  expect_same(s - px, s - x);
+  expect_same(px * py, x * y);
+  expect_same(s * px, s * x);
+  expect_same(px / py, x / y);
+  expect_same(s / py, s / y);
+  expect_same(px / s, x / s);
+  expect_same(-px, -x);
+
+  expect_same(fabs(py), fabs(y));
+  expect_same(sqrt(px), sqrt(x));
+  expect_same(pow(px, 2.5), pow(x, 2.5));
+  expect_same(exp(px), exp(x));
+  expect_same(log(px), log(x));
+  expect_same(sin(px), sin(x));
+  expect_same(cos(px), cos(x));
+  expect_same(atan(px), atan(x));
+  expect_same(atan2(py, px), atan2(y, x));
+  expect_same(tanh(px), tanh(x));
+
+  // Compound assignment
+  ADScalar<T, N> z(x);
+  PackedADScalar<T, N> pz(px);
+  z *= y;
+  pz *= py;
+  z /= x;
+  pz /= px;
+  z -= y;
+  pz -= py;
+  z += x;
+  pz += px;
+  z *= s;
+  pz *= s;
+  expect_same(pz, z);
+
+  // Conversion from the unpacked scalar
+  expect_same(PackedADScalar<T, N>(x), x);
+}
+
+TEST(test_adscalarpacked, Layout) {
+  using Packed = PackedADScalar<double, 13>;
+  constexpr int width = PackedADScalarDeriv<double, 13>::width;
+  EXPECT_EQ(Packed::nchunks, (13 + width - 1) / width);
+  EXPECT_EQ(alignof(Packed) % alignof(Batch<double, width>), 0u);
+}
+
+TEST(test_adscalarpacked, Double) {
+  test_packed<double, 1>();
+  test_packed<double, 3>();
+  test_packed<double, 8>();
+  test_packed<double, 13>();
+  test_packed<double, 24>();
+}
+
+TEST(test_adscalarpacked, Float) {
+  test_packed<float, 5>();
+  test_packed<float, 16>();
+}
+
+// Jacobian of a small map computed with both scalar types
+TEST(test_adscalarpacked, Jacobian) {
+  constexpr int N = 9;
+  ADScalar<double, N> x[N];
+  PackedADScalar<double, N> px[N];
+  for (int i = 0; i < N; i++) {
+    x[i] = 0.1 * (i + 1);
+    x[i].deriv[i] = 1.0;
+    px[i] = 0.1 * (i + 1);
+    px[i].deriv[i] = 1.0;
+  }
+
+  for (int i = 0; i < N; i++) {
+    int j = (i + 1) % N;
+    ADScalar<double, N> f =
+        x[i] * exp(x[j]) / (1.0 + x[i] * x[i]) - sqrt(x[j]);
+    auto pf = px[i] * exp(px[j]) / (1.0 + px[i] * px[i]) - sqrt(px[j]);
+    expect_same(pf, f);
+  }
+}
@@ -0,0 +1,141 @@
+#ifndef TEST_ENERGIES_H
+#define TEST_ENERGIES_H
+
+#include <cstdlib>
+
+#include "a2dcore.h"
+#include "ad/a2dgeocache.h"
+#include "ad/a2dhessianop.h"
+
+using namespace A2D;
+
+/*
+  Element strain energies shared by the executor tests and benchmarks. This
+  header does not depend on gtest so that the benchmarks can include it.
+*/
+
+/**
+ * @brief Stack builder for the strain energy in terms of the mapping
+ * Jacobian J and the displacement gradient Ux
+ */
+template <typename T>
+auto MakeStrainEnergyBuilder() {
+  return [Jinv = A2DObj<Mat<T, 3, 3>>(), F = A2DObj<Mat<T, 3, 3>>(),
+          E = A2DObj<SymMat<T, 3>>(), S = A2DObj<SymMat<T, 3>>(),
+          out = A2DObj<T>()](A2DObj<Vec<T, 1>>& data, A2DObj<Mat<T, 3, 3>>& J,
+                             A2DObj<Mat<T, 3, 3>>& Ux) mutable {
+    out.bvalue() = 1.0;
+    return MakeStack(MatInv(J, Jinv), MatMatMult(Ux, Jinv, F),
+                     MatGreenStrain<GreenStrainType::NONLINEAR>(F, E),
+                     SymIsotropic(T(0.35), T(0.51), E, S),
+                     SymMatMultTrace(E, S, out));
+  };
+}
+
+/**
+ * @brief The same energy with the inverse of J taken from a
+ * GeometryFactorCache
+ */
+template <typename T>
+auto MakeCachedStrainEnergyBuilder() {
+  return [Jinv = A2DObj<Mat<T, 3, 3>>(), F = A2DObj<Mat<T, 3, 3>>(),
+          E = A2DObj<SymMat<T, 3>>(), S = A2DObj<SymMat<T, 3>>(),
+          out = A2DObj<T>()](auto& data, auto& J, auto& Ux,
+                             const GeometryFactors<T, 3> factors[]) mutable {
+    out.bvalue() = 1.0;
+    return MakeStack(
+        CachedMatInv(J, factors[0].Jinv, Jinv),
+        MatMatMult(Ux, GeometrySelect(J, factors[0].Jinv, Jinv), F),
+        MatGreenStrain<GreenStrainType::NONLINEAR>(F, E),
+        SymIsotropic(T(0.35), T(0.51), E, S), SymMatMultTrace(E, S, out));
+  };
+}
+
+/**
+ * @brief Random values for an element of the strain energy: J is a
+ * perturbation of the identity, Ux a small displacement gradient and p a
+ * direction with entries in [-1, 1]
+ */
+template <typename T>
+void RandomStrainEnergyElement(Vec<T, 1>& data, Mat<T, 3, 3>& J,
+                               Mat<T, 3, 3>& Ux, Mat<T, 3, 3>& p) {
+  data(0) = 1.0;
+  for (int i = 0; i < 9; i++) {
+    J[i] = (i % 4 == 0) + 0.1 * rand() / RAND_MAX;
+    Ux[i] = 0.2 * rand() / RAND_MAX;
+    p[i] = -1.0 + 2.0 * rand() / RAND_MAX;
+  }
+}
+
+/**
+ * @brief Stack builder for the strain energy of an element in terms of its
+ * nodal displacements U and the gradients G of its shape functions
+ *
+ * The builder provides the save()/restore() hook of the cache of
+ * HessianOperator.
+ *
+ * @tparam nodes Number of nodes of the element
+ * @tparam M Spatial dimension
+ * @tparam etype Linear or nonlinear strain
+ */
+template <typename T, int nodes, int M, GreenStrainType etype>
+class NodalStrainEnergyBuilder {
+ public:
+  using Cache = HessianCache<Mat<T, M, M>, SymMat<T, M>, SymMat<T, M>, T>;
+
+  auto operator()(A2DObj<Vec<T, 1>>& data, A2DObj<Mat<T, nodes, M>>& G,
+                  A2DObj<Mat<T, nodes, M>>& U) {
+    out.bvalue() = 1.0;
+    return MakeStack(MatMatMult<MatOp::TRANSPOSE, MatOp::NORMAL>(U, G, Ux),
+                     MatGreenStrain<etype>(Ux, E),
+                     SymIsotropic(T(0.35), T(0.51), E, S),
+                     SymMatMultTrace(E, S, out));
+  }
+
+  void save(Cache& c) const { c.save(Ux, E, S, out); }
+  void restore(const Cache& c) { c.restore(Ux, E, S, out); }
+
+ private:
+  A2DObj<Mat<T, M, M>> Ux;
+  A2DObj<SymMat<T, M>> E, S;
+  A2DObj<T> out;
+};
+
+template <typename T, int nodes, int M, GreenStrainType etype>
+auto MakeNodalStrainEnergyBuilder() {
+  return NodalStrainEnergyBuilder<T, nodes, M, etype>();
+}
+
+/**
+ * @brief Stack builder for the sum of the squares of the principal Green
+ * strains of an element, computed with SymEigs, in terms of its nodal
+ * displacements U and the gradients G of its shape functions
+ *
+ * The energy is the same as tr(E^2), but the stack is much more expensive to
+ * evaluate than MakeNodalStrainEnergyBuilder. The builder provides the
+ * save()/restore() hook of the cache of HessianOperator.
+ */
+template <typename T, int nodes, int M>
+class PrincipalStrainEnergyBuilder {
+ public:
+  using Cache = HessianCache<Mat<T, M, M>, SymMat<T, M>, Vec<T, M>, T>;
+
+  auto operator()(A2DObj<Vec<T, 1>>& data, A2DObj<Mat<T, nodes, M>>& G,
+                  A2DObj<Mat<T, nodes, M>>& U) {
+    out.bvalue() = 1.0;
+    return MakeStack(MatMatMult<MatOp::TRANSPOSE, MatOp::NORMAL>(U, G, Ux),
+                     MatGreenStrain<GreenStrainType::NONLINEAR>(Ux, E),
+                     SymEigs(E, eigs), VecDot(eigs, eigs, out));
+  }
+
+  void save(Cache& c) const { c.save(Ux, E, eigs, out); }
+  void restore(const Cache& c) { c.restore(Ux, E, eigs, out); }
+
+ private:
+  A2DObj<Mat<T, M, M>> Ux;
+  A2DObj<SymMat<T, M>> E;
+  A2DObj<Vec<T, M>> eigs;
+  A2DObj<T> out;
+};
+
+#endif  // TEST_ENERGIES_H